@@ -11,6 +11,17 @@
 #if !defined(_WIN32) || defined(__CYGWIN__)
 # include <unistd.h>
 # include <sys/wait.h>
+# include <poll.h>
+# include <fcntl.h>
+# include <sys/socket.h>
+# include <sys/un.h>
+# include <cerrno>
+// the driver reads the output pipes of its processes itself
+# define H5VL_TEST_USE_NATIVE_PIPES
+# if defined(__linux__)
+#  include <sys/epoll.h>
+#  define H5VL_TEST_USE_EPOLL
+# endif
 #endif
 
 #include <h5vl_test_sys/RegularExpression.hxx>
@@ -20,6 +31,13 @@ using std::vector;
 using std::string;
 using std::cerr;
 
+// Environment variable prefixed to the name of every file a client creates
+#define H5VL_TEST_PATH_PREFIX_VAR "HDF5_API_TEST_PATH_PREFIX"
+
+// Returned by WaitForLine, for callers that ask for it, when a process
+// has closed its output or exited rather than written a line
+#define H5VL_TEST_PIPE_CHANGED -1
+
 // The main function as this class should only be used by this program
 int
 main(int argc, char *argv[])
@@ -39,6 +57,14 @@ H5VLTestDriver::H5VLTestDriver()
     this->ClientInitArgCount = 0;
     this->ServerArgStart = 0;
     this->ServerArgCount = 0;
+    this->MergedTestsRun = 0;
+    this->MergedTestsPassed = 0;
+    this->MergedTestsFailed = 0;
+    this->MergedTestsSkipped = 0;
+    this->NumErrorPatterns = 0;
+    this->NextChild = 0;
+    this->ChildrenChanged = false;
+    this->DaemonConnectionPending = false;
     this->AllowErrorInOutput = false;
     // try to make sure that this times out before dart so it can kill all the processes
     this->TimeOut = DART_TESTING_TIMEOUT - 10.0;
@@ -85,6 +111,17 @@ H5VLTestDriver::CollectConfiguredOptions()
     this->SeparateArguments(H5VL_TEST_ENV_VARS, this->ClientEnvVars);
 #endif
 
+    // build the error scanner once, before any output arrives
+    vector<string> patterns =
+        h5vl_test_sys::SystemTools::SplitString(H5VL_TEST_ERROR_PATTERNS, ';');
+    for (unsigned int i = 0; i < patterns.size(); ++i)
+        if (this->ErrorMatcher.AddPattern(patterns[i]) >= 0)
+            this->NumErrorPatterns++;
+    patterns = h5vl_test_sys::SystemTools::SplitString(H5VL_TEST_NON_ERROR_PATTERNS, ';');
+    for (unsigned int i = 0; i < patterns.size(); ++i)
+        this->ErrorMatcher.AddPattern(patterns[i]);
+    this->ErrorMatcher.Compile();
+
     // now find all the mpi information if mpi run is set
 #ifdef MPIEXEC_EXECUTABLE
     this->MPIRun = MPIEXEC_EXECUTABLE;
@@ -188,6 +225,41 @@ H5VLTestDriver::ProcessCommandLine(int argc, char *argv[])
             ArgCountP = &this->ServerArgCount;
             continue;
         }
+        if (strcmp(argv[i], "--shard") == 0) {
+            this->ShardArgStart.push_back(i + 1);
+            this->ShardArgCount.push_back(i + 1);
+            ArgCountP = &this->ShardArgCount.back();
+            continue;
+        }
+        if (strcmp(argv[i], "--log") == 0) {
+            this->LogFile.open(argv[i + 1]);
+            if (!this->LogFile) {
+                std::cerr << "Cannot open log file " << argv[i + 1] << std::endl;
+                return 0;
+            }
+            std::cerr << "Process output will also be written to " << argv[i + 1] << std::endl;
+            ++i; /* Skip file name */
+            ArgCountP = NULL;
+            continue;
+        }
+        if (strcmp(argv[i], "--daemon") == 0) {
+            this->DaemonSocket = argv[i + 1];
+            ++i; /* Skip socket name */
+            ArgCountP = NULL;
+            continue;
+        }
+        if (strcmp(argv[i], "--attach") == 0) {
+            this->AttachSocket = argv[i + 1];
+            ++i; /* Skip socket name */
+            ArgCountP = NULL;
+            continue;
+        }
+        if (strcmp(argv[i], "--stop-daemon") == 0) {
+            this->StopSocket = argv[i + 1];
+            ++i; /* Skip socket name */
+            ArgCountP = NULL;
+            continue;
+        }
         if (strcmp(argv[i], "--timeout") == 0) {
             this->TimeOut = atoi(argv[i + 1]);
             std::cerr << "The timeout was set to " << this->TimeOut << std::endl;
@@ -266,126 +338,513 @@ H5VLTestDriver::CreateCommandLine(vector<const char*> &commandLine,
     commandLine.push_back(0);
 }
 
+#ifdef H5VL_TEST_USE_NATIVE_PIPES
+//----------------------------------------------------------------------------
+/// Creates a pipe whose ends are closed on exec, so that the processes
+/// started later do not inherit the driver's ends of the pipes of others.
+static int
+CreatePipe(int fds[2])
+{
+# if defined(__linux__)
+    return pipe2(fds, O_CLOEXEC);
+# else
+    if (pipe(fds) < 0)
+        return -1;
+    fcntl(fds[0], F_SETFD, FD_CLOEXEC);
+    fcntl(fds[1], F_SETFD, FD_CLOEXEC);
+    return 0;
+# endif
+}
+#endif
+
 //----------------------------------------------------------------------------
 int
-H5VLTestDriver::StartServer(h5vl_test_sysProcess *server, const char *name,
-    vector<char> &out, vector<char> &err)
+H5VLTestDriver::StartChild(H5VLTestChild *child)
 {
-    if (!server)
+    h5vl_test_sysProcess_SetTimeout(child->Process, this->TimeOut);
+#ifdef H5VL_TEST_USE_NATIVE_PIPES
+    // Connect the output of the process to pipes that the driver reads
+    // itself, so that it can wait for the output of all of its processes
+    // at once. kwsys closes the child's ends of the pipes once it has
+    // started the process.
+    int outPipe[2] = { -1, -1 };
+    int errPipe[2] = { -1, -1 };
+    if (::CreatePipe(outPipe) < 0 || ::CreatePipe(errPipe) < 0) {
+        cerr << "H5VLTestDriver: cannot create pipes for " << child->Name
+             << ": " << strerror(errno) << "\n";
+        if (outPipe[0] >= 0) {
+            close(outPipe[0]);
+            close(outPipe[1]);
+        }
+        return 0;
+    }
+    h5vl_test_sysProcess_SetPipeNative(child->Process,
+        h5vl_test_sysProcess_Pipe_STDOUT, outPipe);
+    h5vl_test_sysProcess_SetPipeNative(child->Process,
+        h5vl_test_sysProcess_Pipe_STDERR, errPipe);
+#endif
+    h5vl_test_sysProcess_Execute(child->Process);
+    if (h5vl_test_sysProcess_GetState(child->Process)
+        != h5vl_test_sysProcess_State_Executing) {
+#ifdef H5VL_TEST_USE_NATIVE_PIPES
+        close(outPipe[0]);
+        close(errPipe[0]);
+#endif
+        return 0;
+    }
+
+    int id = (int)this->Children.size();
+#ifdef H5VL_TEST_USE_NATIVE_PIPES
+    child->Pipes[0] = outPipe[0];
+    child->Pipes[1] = errPipe[0];
+    this->Multiplexer.Add(child->Pipes[0], 2 * id);
+    this->Multiplexer.Add(child->Pipes[1], 2 * id + 1);
+#endif
+    child->Open[0] = child->Open[1] = true;
+    if (this->TimeOut > 0)
+        child->Deadline = h5vl_test_sys::SystemTools::GetTime() + this->TimeOut;
+    this->Children.push_back(child);
+    return 1;
+}
+
+//----------------------------------------------------------------------------
+int
+H5VLTestDriver::StartServer(H5VLTestChild *server)
+{
+    if (!server->Process)
         return 1;
 
-    cerr << "H5VLTestDriver: starting process " << name << "\n";
-    h5vl_test_sysProcess_SetTimeout(server, this->TimeOut);
-    h5vl_test_sysProcess_Execute(server);
+    cerr << "H5VLTestDriver: starting process " << server->Name << "\n";
     int foundWaiting = 0;
-    string output;
-    while (!foundWaiting) {
-        int pipe = this->WaitForAndPrintLine(name, server, output, 100.0, out,
-            err, H5VL_TEST_SERVER_START_MSG, &foundWaiting);
-        if (pipe == h5vl_test_sysProcess_Pipe_None
-            || pipe == h5vl_test_sysProcess_Pipe_Timeout) {
-            break;
+    if (this->StartChild(server)) {
+        H5VLTestChild *child;
+        string output;
+        while (!foundWaiting) {
+            double timeout = 100.0;
+            int pipe = this->WaitForAndPrintLine(child, output, &timeout);
+            if (pipe == h5vl_test_sysProcess_Pipe_None
+                || pipe == h5vl_test_sysProcess_Pipe_Timeout) {
+                break;
+            }
+            if (child == server && output.find(H5VL_TEST_SERVER_START_MSG) != output.npos)
+                foundWaiting = 1;
+            else if (!server->IsOpen())
+                break;
         }
     }
     if (foundWaiting) {
-        cerr << "H5VLTestDriver: " << name << " sucessfully started.\n";
+        cerr << "H5VLTestDriver: " << server->Name << " sucessfully started.\n";
         return 1;
     } else {
-        cerr << "H5VLTestDriver: " << name << " never started.\n";
-        h5vl_test_sysProcess_Kill(server);
+        cerr << "H5VLTestDriver: " << server->Name << " never started.\n";
+        h5vl_test_sysProcess_Kill(server->Process);
         return 0;
     }
 }
 
 //----------------------------------------------------------------------------
 int
-H5VLTestDriver::StartClientHelper(h5vl_test_sysProcess *client,
-    const char *name, vector<char> &out, vector<char> &err)
+H5VLTestDriver::StartClientHelper(H5VLTestChild *client)
 {
-    if (!client)
+    if (!client->Process)
         return 1;
 
-    cerr << "H5VLTestDriver: starting process " << name << "\n";
-    h5vl_test_sysProcess_SetTimeout(client, this->TimeOut);
-    h5vl_test_sysProcess_Execute(client);
+    cerr << "H5VLTestDriver: starting process " << client->Name << "\n";
     int foundWaiting = 0;
-    string output;
-    while (!foundWaiting) {
-        int pipe = this->WaitForAndPrintLine(name, client, output, 100.0, out,
-            err, H5VL_TEST_CLIENT_HELPER_START_MSG, &foundWaiting);
-        if (pipe == h5vl_test_sysProcess_Pipe_None
-            || pipe == h5vl_test_sysProcess_Pipe_Timeout) {
-            break;
+    if (this->StartChild(client)) {
+        H5VLTestChild *child;
+        string output;
+        while (!foundWaiting) {
+            double timeout = 100.0;
+            int pipe = this->WaitForAndPrintLine(child, output, &timeout);
+            if (pipe == h5vl_test_sysProcess_Pipe_None
+                || pipe == h5vl_test_sysProcess_Pipe_Timeout) {
+                break;
+            }
+            if (child == client && output.find(H5VL_TEST_CLIENT_HELPER_START_MSG) != output.npos)
+                foundWaiting = 1;
+            else if (!client->IsOpen())
+                break;
         }
     }
     if (foundWaiting) {
-        cerr << "H5VLTestDriver: " << name << " sucessfully started.\n";
+        cerr << "H5VLTestDriver: " << client->Name << " sucessfully started.\n";
         return 1;
     } else {
-        cerr << "H5VLTestDriver: " << name << " never started.\n";
-        h5vl_test_sysProcess_Kill(client);
+        cerr << "H5VLTestDriver: " << client->Name << " never started.\n";
+        h5vl_test_sysProcess_Kill(client->Process);
         return 0;
     }
 }
 
 //----------------------------------------------------------------------------
 int
-H5VLTestDriver::StartClientInit(h5vl_test_sysProcess *client,
-    const char *name, vector<char> &out, vector<char> &err)
+H5VLTestDriver::StartClientInit(H5VLTestChild *client)
 {
-    if (!client)
+    if (!client->Process)
         return 1;
 
-    cerr << "H5VLTestDriver: starting process " << name << "\n";
-    h5vl_test_sysProcess_SetTimeout(client, this->TimeOut);
-    h5vl_test_sysProcess_Execute(client);
+    cerr << "H5VLTestDriver: starting process " << client->Name << "\n";
     int foundToken = 0;
     string output, token;
-    while (!foundToken) {
-        int pipe = this->WaitForAndPrintLine(name, client, output, 100.0, out,
-            err, NULL, NULL);
-        if (pipe == h5vl_test_sysProcess_Pipe_None
-            || pipe == h5vl_test_sysProcess_Pipe_Timeout) {
-            break;
-        }
-        if (this->OutputStringHasToken(name, H5VL_TEST_CLIENT_INIT_TOKEN_REGEX, output, token)) {
-            foundToken = 1;
-            this->ClientTokenVar = std::string(H5VL_TEST_CLIENT_INIT_TOKEN_VAR)
-                + std::string("=") + std::string(token);
-            break;
+    if (this->StartChild(client)) {
+        H5VLTestChild *child;
+        while (!foundToken) {
+            double timeout = 100.0;
+            int pipe = this->WaitForAndPrintLine(child, output, &timeout);
+            if (pipe == h5vl_test_sysProcess_Pipe_None
+                || pipe == h5vl_test_sysProcess_Pipe_Timeout) {
+                break;
+            }
+            if (child == client && this->OutputStringHasToken(client->Name.c_str(),
+                    H5VL_TEST_CLIENT_INIT_TOKEN_REGEX, output, token)) {
+                foundToken = 1;
+                this->ClientTokenVar = std::string(H5VL_TEST_CLIENT_INIT_TOKEN_VAR)
+                    + std::string("=") + std::string(token);
+                break;
+            }
+            if (!client->IsOpen())
+                break;
         }
     }
 
     if (foundToken) {
-        cerr << "H5VLTestDriver: " << name << " token: " << token << " was found.\n";
+        cerr << "H5VLTestDriver: " << client->Name << " token: " << token << " was found.\n";
         return 1;
     } else {
-        cerr << "H5VLTestDriver: " << name << " token was not found.\n";
+        cerr << "H5VLTestDriver: " << client->Name << " token was not found.\n";
         return 0;
     }
 }
 
 //----------------------------------------------------------------------------
 int
-H5VLTestDriver::StartClient(h5vl_test_sysProcess *client, const char *name)
+H5VLTestDriver::StartClient(H5VLTestChild *client)
 {
-    if (!client)
+    if (!client->Process)
         return 1;
 
-    cerr << "H5VLTestDriver: starting process " << name << "\n";
-    h5vl_test_sysProcess_SetTimeout(client, this->TimeOut);
-    h5vl_test_sysProcess_Execute(client);
-    if (h5vl_test_sysProcess_GetState(client)
-        == h5vl_test_sysProcess_State_Executing) {
-        cerr << "H5VLTestDriver: " << name << " sucessfully started.\n";
+    cerr << "H5VLTestDriver: starting process " << client->Name << "\n";
+    if (this->StartChild(client)) {
+        cerr << "H5VLTestDriver: " << client->Name << " sucessfully started.\n";
         return 1;
     } else {
-        this->ReportStatus(client, name);
-        h5vl_test_sysProcess_Kill(client);
+        this->ReportStatus(client->Process, client->Name.c_str());
+        h5vl_test_sysProcess_Kill(client->Process);
         return 0;
     }
 }
 
+#ifdef H5VL_TEST_USE_NATIVE_PIPES
+//----------------------------------------------------------------------------
+/// Fills in the address of the socket of a daemon.
+static int
+DaemonAddress(const string &path, struct sockaddr_un &address)
+{
+    memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    if (path.size() >= sizeof(address.sun_path)) {
+        cerr << "H5VLTestDriver: daemon socket name " << path << " is too long\n";
+        return 0;
+    }
+    strcpy(address.sun_path, path.c_str());
+    return 1;
+}
+
+//----------------------------------------------------------------------------
+/// Sends a command to the daemon listening on path and returns its reply,
+/// passing each line of the reply to cerr as well if echo is set.
+static int
+SendDaemonCommand(const string &path, const char *command, string &reply,
+    bool echo = false)
+{
+    struct sockaddr_un address;
+    if (!DaemonAddress(path, address))
+        return 0;
+    int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0)
+        return 0;
+    if (connect(fd, (struct sockaddr *)&address, sizeof(address)) < 0) {
+        close(fd);
+        return 0;
+    }
+    string request = string(command) + "\n";
+    if (write(fd, request.data(), request.size()) != (ssize_t)request.size()) {
+        close(fd);
+        return 0;
+    }
+
+    reply = "";
+    char data[4096];
+    ssize_t length;
+    while ((length = read(fd, data, sizeof(data))) != 0) {
+        if (length < 0) {
+            if (errno == EINTR)
+                continue;
+            break;
+        }
+        if (echo)
+            cerr.write(data, length);
+        reply.append(data, length);
+    }
+    close(fd);
+
+    // a reply ends with a newline, which is not part of it
+    if (!reply.empty() && reply[reply.size() - 1] == '\n')
+        reply.erase(reply.size() - 1);
+    return 1;
+}
+#endif
+
+//----------------------------------------------------------------------------
+int
+H5VLTestDriver::StartDaemon(int &result)
+{
+#ifdef H5VL_TEST_USE_NATIVE_PIPES
+    if (!this->TestServer) {
+        cerr << "H5VLTestDriver: --daemon needs a --server to run\n";
+        result = 1;
+        return 1;
+    }
+
+    // Output of the daemon goes to this driver until the daemon is ready,
+    // which it shows by closing it.
+    int relay[2];
+    if (pipe(relay) < 0) {
+        cerr << "H5VLTestDriver: cannot create pipe for daemon: " << strerror(errno) << "\n";
+        result = 1;
+        return 1;
+    }
+    cerr.flush();
+    std::cout.flush();
+    if (this->LogFile.is_open())
+        this->LogFile.flush();
+    pid_t pid = fork();
+    if (pid < 0) {
+        cerr << "H5VLTestDriver: cannot start daemon: " << strerror(errno) << "\n";
+        close(relay[0]);
+        close(relay[1]);
+        result = 1;
+        return 1;
+    }
+    if (pid == 0) {
+        // The daemon leaves the session of the driver that started it so
+        // that it outlives that driver, and its processes run until they
+        // are stopped rather than for the timeout of a single test.
+        setsid();
+        int devNull = open("/dev/null", O_RDWR);
+        if (devNull >= 0) {
+            dup2(devNull, 0);
+            close(devNull);
+        }
+        dup2(relay[1], 1);
+        dup2(relay[1], 2);
+        close(relay[0]);
+        close(relay[1]);
+        this->TimeOut = 0;
+        return 0;
+    }
+
+    close(relay[1]);
+    char data[4096];
+    ssize_t length;
+    while ((length = read(relay[0], data, sizeof(data))) != 0) {
+        if (length < 0) {
+            if (errno == EINTR)
+                continue;
+            break;
+        }
+        cerr.write(data, length);
+    }
+    close(relay[0]);
+
+    string reply;
+    if (SendDaemonCommand(this->DaemonSocket, "status", reply) && reply == "ok") {
+        cerr << "H5VLTestDriver: daemon " << pid << " is serving on "
+             << this->DaemonSocket << "\n";
+        result = 0;
+    } else {
+        cerr << "H5VLTestDriver: daemon never started.\n";
+        result = 1;
+    }
+    return 1;
+#else
+    cerr << "H5VLTestDriver: --daemon is not supported on this platform\n";
+    result = 1;
+    return 1;
+#endif
+}
+
+//----------------------------------------------------------------------------
+int
+H5VLTestDriver::ServeDaemon()
+{
+    int mpiError = 0;
+#ifdef H5VL_TEST_USE_NATIVE_PIPES
+    struct sockaddr_un address;
+    if (!DaemonAddress(this->DaemonSocket, address))
+        return 1;
+
+    // a socket that is left over from a daemon that died can be reused
+    string reply;
+    if (SendDaemonCommand(this->DaemonSocket, "status", reply)) {
+        cerr << "H5VLTestDriver: a daemon is already serving on "
+             << this->DaemonSocket << "\n";
+        return 1;
+    }
+    unlink(this->DaemonSocket.c_str());
+
+    int listenFd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (listenFd < 0 || fcntl(listenFd, F_SETFD, FD_CLOEXEC) < 0
+        || bind(listenFd, (struct sockaddr *)&address, sizeof(address)) < 0
+        || listen(listenFd, 16) < 0) {
+        cerr << "H5VLTestDriver: cannot serve on " << this->DaemonSocket
+             << ": " << strerror(errno) << "\n";
+        if (listenFd >= 0)
+            close(listenFd);
+        return 1;
+    }
+    this->Multiplexer.Add(listenFd, -1);
+
+    // The daemon is ready. From now on its output only goes to the log,
+    // if there is one, until a driver asks it to stop.
+    cerr << "H5VLTestDriver: serving on " << this->DaemonSocket << "\n";
+    cerr.flush();
+    int devNull = open("/dev/null", O_WRONLY);
+    if (devNull >= 0) {
+        dup2(devNull, 1);
+        dup2(devNull, 2);
+        close(devNull);
+    }
+
+    bool stopped = false;
+    while (!stopped) {
+        // Report the complete lines of output from the processes
+        for (unsigned int i = 0; i < this->Children.size(); ++i) {
+            H5VLTestChild *child = this->Children[i];
+            string output;
+            while (child->TakeLine(output)) {
+                this->PrintLine(child->OutputName.c_str(), output.c_str(),
+                    child->LinePrefix.c_str());
+                if (!mpiError && this->OutputStringHasError(child->Name.c_str(), output))
+                    mpiError = 1;
+            }
+        }
+
+        if (this->DaemonConnectionPending) {
+            this->DaemonConnectionPending = false;
+            int fd = accept(listenFd, 0, 0);
+            if (fd >= 0) {
+                // Read the command, which is a single line
+                string command;
+                char c;
+                while (read(fd, &c, 1) == 1 && c != '\n')
+                    command += c;
+
+                // The server of the daemon is always the first process
+                bool running = !this->Children.empty() && this->Children[0]->IsOpen();
+                string response;
+                if (command == "attach" && running) {
+                    response = "ok " + this->ClientTokenVar + "\n";
+                } else if (command == "status") {
+                    response = running ? "ok\n" : "server exited\n";
+                } else if (command == "stop") {
+                    // The rest of the output of the daemon, including the
+                    // result of the server, goes to the driver stopping it.
+                    dup2(fd, 1);
+                    dup2(fd, 2);
+                    stopped = true;
+                } else {
+                    response = running ? "unknown command\n" : "server exited\n";
+                }
+                if (!response.empty() && write(fd, response.data(), response.size()) < 0)
+                    cerr << "H5VLTestDriver: cannot reply to " << command << "\n";
+                close(fd);
+            }
+        } else {
+            this->ReadChildren(-1);
+        }
+    }
+
+    this->Multiplexer.Remove(listenFd);
+    close(listenFd);
+    unlink(this->DaemonSocket.c_str());
+#endif
+    return mpiError;
+}
+
+//----------------------------------------------------------------------------
+int
+H5VLTestDriver::AttachDaemon()
+{
+#ifdef H5VL_TEST_USE_NATIVE_PIPES
+    string reply;
+    if (SendDaemonCommand(this->AttachSocket, "attach", reply)
+        && reply.compare(0, 3, "ok ") == 0) {
+        // the token from the client init of the daemon, if it has one
+        this->ClientTokenVar = reply.substr(3);
+        cerr << "H5VLTestDriver: attached to the daemon on " << this->AttachSocket << "\n";
+        return 1;
+    }
+    cerr << "H5VLTestDriver: cannot attach to the daemon on " << this->AttachSocket;
+    if (!reply.empty())
+        cerr << ": " << reply;
+    cerr << "\n";
+#else
+    cerr << "H5VLTestDriver: --attach is not supported on this platform\n";
+#endif
+    return 0;
+}
+
+//----------------------------------------------------------------------------
+int
+H5VLTestDriver::DetachDaemon()
+{
+#ifdef H5VL_TEST_USE_NATIVE_PIPES
+    // the test fails if the server did not outlive it, unless server
+    // errors are allowed, as they are for a server run by the test itself
+    string reply;
+    if (SendDaemonCommand(this->AttachSocket, "status", reply)) {
+        if (reply == "ok")
+            return 1;
+        if (reply == "server exited" && this->IgnoreServerResult) {
+            cerr << "H5VLTestDriver: the server of the daemon on " << this->AttachSocket
+                 << " exited during the test, which is allowed\n";
+            return 1;
+        }
+    }
+    cerr << "H5VLTestDriver: the server of the daemon on " << this->AttachSocket
+         << " did not survive the test\n";
+#endif
+    return 0;
+}
+
+//----------------------------------------------------------------------------
+int
+H5VLTestDriver::StopDaemon()
+{
+#ifdef H5VL_TEST_USE_NATIVE_PIPES
+    cerr << "H5VLTestDriver: stopping the daemon on " << this->StopSocket << "\n";
+    string reply;
+    if (!SendDaemonCommand(this->StopSocket, "stop", reply, true)) {
+        cerr << "H5VLTestDriver: no daemon is serving on " << this->StopSocket << "\n";
+        return 1;
+    }
+
+    // the last line of the output of the daemon is its result
+    const char *token = "H5VLTestDriver: daemon returning ";
+    string::size_type pos = reply.rfind(token);
+    if (pos == reply.npos) {
+        cerr << "H5VLTestDriver: the daemon did not return a result\n";
+        return 1;
+    }
+    return atoi(reply.c_str() + pos + strlen(token));
+#else
+    cerr << "H5VLTestDriver: --stop-daemon is not supported on this platform\n";
+    return 1;
+#endif
+}
+
 //----------------------------------------------------------------------------
 void
 H5VLTestDriver::Stop(h5vl_test_sysProcess *p, const char *name)
@@ -401,46 +860,47 @@ H5VLTestDriver::Stop(h5vl_test_sysProcess *p, const char *name)
 int
 H5VLTestDriver::OutputStringHasError(const char *pname, string &output)
 {
-    const char* possibleMPIErrors[] = {"error", "Error", "Missing:",
-        "core dumped", "process in local group is dead", "Segmentation fault",
-        "erroneous", "ERROR:", "Error:",
-        "mpirun can *only* be used with MPI programs", "due to signal",
-        "failure", "abnormal termination", "failed", "FAILED", "Failed", 0};
-
-    const char* nonErrors[] = {
-        "Memcheck, a memory error detector",  //valgrind
-        0};
-
     if (this->AllowErrorInOutput)
         return 0;
 
-    vector<string> lines;
-    vector<string>::iterator it;
-    h5vl_test_sys::SystemTools::Split(output.c_str(), lines);
-
-    int i, j;
+    vector<H5VLTestPatternMatcher::Match> matches;
+    string::size_type lineStart = 0;
+
+    while (lineStart < output.size()) {
+        string::size_type lineEnd = output.find('\n', lineStart);
+        if (lineEnd == output.npos)
+            lineEnd = output.size();
+
+        matches.clear();
+        this->ErrorMatcher.Reset();
+        this->ErrorMatcher.Feed(output.data() + lineStart, lineEnd - lineStart,
+            matches);
+
+        const H5VLTestPatternMatcher::Match *error = 0;
+        bool nonError = false;
+        for (unsigned int i = 0; i < matches.size(); ++i) {
+            if (matches[i].Pattern >= this->NumErrorPatterns)
+                nonError = true;
+            else if (!error)
+                error = &matches[i];
+        }
 
-    for (it = lines.begin(); it != lines.end(); ++it) {
-        for (i = 0; possibleMPIErrors[i]; ++i) {
-            if (it->find(possibleMPIErrors[i]) != it->npos) {
-                int found = 1;
-                for (j = 0; nonErrors[j]; ++j) {
-                    if (it->find(nonErrors[j]) != it->npos) {
-                        found = 0;
-                        cerr << "Non error \"" << it->c_str()
-                            << "\" suppressed " << std::endl;
-                    }
-                }
-                if (found) {
-                    cerr
-                        << "H5VLTestDriver: ***** Test will fail, because the string: \""
-                        << possibleMPIErrors[i]
-                        << "\"\nH5VLTestDriver: ***** was found in the following output from the "
-                        << pname << ":\n\"" << it->c_str() << "\"\n";
-                    return 1;
-                }
+        if (error) {
+            string line = output.substr(lineStart, lineEnd - lineStart);
+            if (nonError) {
+                cerr << "Non error \"" << line << "\" suppressed " << std::endl;
+            } else {
+                cerr
+                    << "H5VLTestDriver: ***** Test will fail, because the string: \""
+                    << this->ErrorMatcher.GetPattern(error->Pattern)
+                    << "\"\nH5VLTestDriver: ***** was found at column "
+                    << error->Position + 1 << " in the following output from the "
+                    << pname << ":\n\"" << line << "\"\n";
+                return 1;
             }
         }
+
+        lineStart = lineEnd + 1;
     }
     return 0;
 }
@@ -467,7 +927,8 @@ H5VLTestDriver::OutputStringHasToken(const char *pname, const char *regex,
 
 //----------------------------------------------------------------------------
 #define H5VL_CLEAN_PROCESSES do {      \
-  h5vl_test_sysProcess_Delete(client); \
+  for (unsigned int cc = 0; cc < clients.size(); cc++) \
+    h5vl_test_sysProcess_Delete(clients[cc]); \
   h5vl_test_sysProcess_Delete(client_helper); \
   h5vl_test_sysProcess_Delete(client_init); \
   h5vl_test_sysProcess_Delete(server); \
@@ -491,22 +952,53 @@ H5VLTestDriver::OutputStringHasToken(const char *pname, const char *regex,
 int
 H5VLTestDriver::Main(int argc, char* argv[])
 {
+    if (!this->ProcessCommandLine(argc, argv))
+        return 1;
+    this->CollectConfiguredOptions();
+
+    // a driver that stops a daemon runs no processes of its own
+    if (!this->StopSocket.empty())
+        return this->StopDaemon();
+
 #ifdef H5VL_TEST_INIT_COMMAND
     // run user-specified commands before initialization.
     // For example: "killall -9 rsh test;"
-    H5VL_EXECUTE_CMD(H5VL_TEST_INIT_COMMAND);
+    // The clients of a daemon must leave its server running.
+    if (this->AttachSocket.empty())
+        H5VL_EXECUTE_CMD(H5VL_TEST_INIT_COMMAND);
 #endif
 
-    if (!this->ProcessCommandLine(argc, argv))
+    if (!this->AttachSocket.empty() && !this->AttachDaemon())
         return 1;
-    this->CollectConfiguredOptions();
 
+    if (!this->DaemonSocket.empty()) {
+        // only the daemon goes on to run the processes
+        int result;
+        if (this->StartDaemon(result))
+            return result;
+    }
+
+    int result = this->RunProcesses(argv);
+
+    if (!this->DaemonSocket.empty()) {
+        // the driver that stopped the daemon reads the result from this line
+        cerr << "H5VLTestDriver: daemon returning " << result << "\n";
+    } else if (!this->AttachSocket.empty() && !this->DetachDaemon() && !result) {
+        result = 1;
+    }
+    return result;
+}
+
+//----------------------------------------------------------------------------
+int
+H5VLTestDriver::RunProcesses(char *argv[])
+{
     // mpi code
     // Allocate process managers.
     h5vl_test_sysProcess *server = 0;
-    h5vl_test_sysProcess *client = 0;
     h5vl_test_sysProcess *client_helper = 0;
     h5vl_test_sysProcess *client_init = 0;
+    vector<h5vl_test_sysProcess *> clients;
 
     if (this->TestServer) {
         server = h5vl_test_sysProcess_New();
@@ -535,22 +1027,45 @@ H5VLTestDriver::Main(int argc, char* argv[])
             return 1;
         }
     }
-    client = h5vl_test_sysProcess_New();
-    if (!client) {
-        H5VL_CLEAN_PROCESSES;
-        cerr << "H5VLTestDriver: Cannot allocate h5vl_test_sysProcess to "
-            "run the client.\n";
-        return 1;
+    // One client runs all of the tests unless they were split into shards
+    unsigned int numClients = this->ShardArgStart.empty() ? 1 :
+        (unsigned int)this->ShardArgStart.size();
+    // and a daemon runs none, only the server for other drivers' clients
+    if (!this->DaemonSocket.empty())
+        numClients = 0;
+    vector<string> clientNames;
+    for (unsigned int i = 0; i < numClients; ++i) {
+        h5vl_test_sysProcess *client = h5vl_test_sysProcess_New();
+        if (!client) {
+            H5VL_CLEAN_PROCESSES;
+            cerr << "H5VLTestDriver: Cannot allocate h5vl_test_sysProcess to "
+                "run the client.\n";
+            return 1;
+        }
+        clients.push_back(client);
+
+        std::stringstream name;
+        name << "client";
+        if (!this->ShardArgStart.empty())
+            name << " shard " << i;
+        clientNames.push_back(name.str());
     }
 
-    vector<char> ClientStdOut;
-    vector<char> ClientStdErr;
-    vector<char> ClientHelperStdOut;
-    vector<char> ClientHelperStdErr;
-    vector<char> ClientInitStdOut;
-    vector<char> ClientInitStdErr;
-    vector<char> ServerStdOut;
-    vector<char> ServerStdErr;
+    H5VLTestChild serverChild("server", server);
+    H5VLTestChild clientHelperChild("client_helper", client_helper);
+    H5VLTestChild clientInitChild("client_init", client_init);
+    vector<H5VLTestChild> clientChildren;
+    for (unsigned int i = 0; i < numClients; ++i) {
+        clientChildren.push_back(H5VLTestChild(clientNames[i], clients[i]));
+        // Shards print under one header, each line tagged with its shard,
+        // rather than under a new header each time the output interleaves
+        if (!this->ShardArgStart.empty()) {
+            std::stringstream prefix;
+            prefix << "[shard " << i << "] ";
+            clientChildren.back().OutputName = "client";
+            clientChildren.back().LinePrefix = prefix.str();
+        }
+    }
 
     vector<const char *> serverCommand;
     if (server) {
@@ -591,15 +1106,14 @@ H5VLTestDriver::Main(int argc, char* argv[])
     }
 
     // Start the server if there is one
-    if (!this->StartServer(server, "server", ServerStdOut, ServerStdErr)) {
+    if (!this->StartServer(&serverChild)) {
         cerr << "H5VLTestDriver: Server never started.\n";
         H5VL_CLEAN_PROCESSES;
         return -1;
     }
 
     // Start the client helper here if there is one
-    if (!this->StartClientHelper(client_helper, "client_helper",
-        ClientHelperStdOut, ClientHelperStdErr)) {
+    if (!this->StartClientHelper(&clientHelperChild)) {
         cerr << "H5VLTestDriver: Client Helper never started.\n";
         this->Stop(server, "server");
 #ifdef H5VL_TEST_SERVER_EXIT_COMMAND
@@ -610,8 +1124,7 @@ H5VLTestDriver::Main(int argc, char* argv[])
     }
 
     // Start the client init here if there is one
-    if (!this->StartClientInit(client_init, "client_init",
-        ClientInitStdOut, ClientInitStdErr)) {
+    if (!this->StartClientInit(&clientInitChild)) {
         cerr << "H5VLTestDriver: Client Init never started.\n";
         this->Stop(server, "server");
 #ifdef H5VL_TEST_SERVER_EXIT_COMMAND
@@ -625,55 +1138,101 @@ H5VLTestDriver::Main(int argc, char* argv[])
         return -1;
     }
 
-    // Construct the client process command line.
-    vector<const char *> clientCommand;
+    // Construct the client process command lines.
+    vector< vector<const char *> > clientCommands(numClients);
     const char *clientExe = this->ClientExecutable.c_str();
-    this->CreateCommandLine(clientCommand, clientExe, 0, 0,
-        this->MPIClientNumProcessFlag.c_str(), this->ClientArgStart,
-        this->ClientArgCount, argv);
-    this->ReportCommand(&clientCommand[0], "client");
-    h5vl_test_sysProcess_SetCommand(client, &clientCommand[0]);
-    h5vl_test_sysProcess_SetWorkingDirectory(client,
-        this->GetDirectory(clientExe).c_str());
-
-    // Now run the client
-    if (!this->StartClient(client, "client")) {
-        this->Stop(server, "server");
-        this->Stop(client_helper, "client_helper");
-        this->Stop(client_init, "client_init");
-        H5VL_CLEAN_PROCESSES;
-        return -1;
+    for (unsigned int i = 0; i < numClients; ++i) {
+        vector<const char *> &clientCommand = clientCommands[i];
+        this->CreateCommandLine(clientCommand, clientExe, 0, 0,
+            this->MPIClientNumProcessFlag.c_str(), this->ClientArgStart,
+            this->ClientArgCount, argv);
+        if (!this->ShardArgStart.empty()) {
+            // append the shard's own flags after the terminating null
+            clientCommand.pop_back();
+            for (int ii = this->ShardArgStart[i]; ii < this->ShardArgCount[i]; ++ii)
+                clientCommand.push_back(argv[ii]);
+            clientCommand.push_back(0);
+        }
+        this->ReportCommand(&clientCommand[0], clientNames[i].c_str());
+        h5vl_test_sysProcess_SetCommand(clients[i], &clientCommand[0]);
+        h5vl_test_sysProcess_SetWorkingDirectory(clients[i],
+            this->GetDirectory(clientExe).c_str());
     }
 
-    // Report the output of the processes.
-    int clientPipe = 1;
+    // Give each shard its own file name prefix so that the files
+    // created by shards running at the same time never collide.
+    // Clients inherit the environment when they are started.
+    string pathPrefix;
+    bool hasPathPrefix = h5vl_test_sys::SystemTools::GetEnv(
+        H5VL_TEST_PATH_PREFIX_VAR, pathPrefix);
+
+    // Now run the clients
+    for (unsigned int i = 0; i < numClients; ++i) {
+        if (!this->ShardArgStart.empty()) {
+            std::stringstream env;
+            env << H5VL_TEST_PATH_PREFIX_VAR << "=" << pathPrefix << "shard" << i << "_";
+            h5vl_test_sys::SystemTools::PutEnv(env.str());
+        }
+        if (!this->StartClient(&clientChildren[i])) {
+            this->Stop(server, "server");
+            this->Stop(client_helper, "client_helper");
+            this->Stop(client_init, "client_init");
+            for (unsigned int cc = 0; cc < i; cc++)
+                this->Stop(clients[cc], clientNames[cc].c_str());
+            H5VL_CLEAN_PROCESSES;
+            return -1;
+        }
+    }
+    if (!this->ShardArgStart.empty()) {
+        if (hasPathPrefix)
+            h5vl_test_sys::SystemTools::PutEnv(
+                string(H5VL_TEST_PATH_PREFIX_VAR) + "=" + pathPrefix);
+        else
+            h5vl_test_sys::SystemTools::UnPutEnv(H5VL_TEST_PATH_PREFIX_VAR);
+    }
 
+    // Report the output of all of the processes as it arrives, until all
+    // of the clients have closed their output or exited. After that, wait
+    // no longer than ServerExitTimeOut for the rest of the output of the
+    // others. The wait also ends whenever a process closes its output or
+    // exits, so that the last client finishing is noticed at once even
+    // if the server stays quiet.
     string output;
     int mpiError = 0;
-    while (clientPipe) {
-        clientPipe = this->WaitForAndPrintLine("client", client, output, 0.1,
-            ClientStdOut, ClientStdErr, NULL, NULL);
-        if (!mpiError && this->OutputStringHasError("client", output)) {
-            mpiError = 1;
+    if (!this->DaemonSocket.empty())
+        mpiError = this->ServeDaemon();
+    double exitTimeout = this->ServerExitTimeOut;
+    H5VLTestChild *child;
+    while (1) {
+        bool clientsOpen = false;
+        for (unsigned int i = 0; i < numClients; ++i)
+            if (clientChildren[i].IsOpen() && !clientChildren[i].Exited)
+                clientsOpen = true;
+
+        int pipe = this->WaitForAndPrintLine(child, output,
+            clientsOpen ? 0 : &exitTimeout, true);
+        if (pipe == H5VL_TEST_PIPE_CHANGED) {
+            continue;
         }
-        // If client has died, we wait for output from the server processess
-        // for this->ServerExitTimeOut, then we'll kill the servers, if needed.
-        double timeout = (clientPipe) ? 0 : this->ServerExitTimeOut;
-        output = "";
-        this->WaitForAndPrintLine("server", server, output, timeout,
-            ServerStdOut, ServerStdErr, NULL, NULL);
-        if (!mpiError && this->OutputStringHasError("server", output)) {
+        if (pipe == h5vl_test_sysProcess_Pipe_None
+            || pipe == h5vl_test_sysProcess_Pipe_Timeout) {
+            break;
+        }
+        if (!mpiError && this->OutputStringHasError(child->Name.c_str(), output)) {
             mpiError = 1;
         }
-        output = "";
+        if (!this->ShardArgStart.empty() && child != &serverChild
+            && child != &clientHelperChild && child != &clientInitChild)
+            this->MergeClientResults(output);
     }
 
-    // Wait for the client and server to exit.
-    h5vl_test_sysProcess_WaitForExit(client, 0);
+    // Wait for the clients and server to exit.
+    for (unsigned int i = 0; i < numClients; ++i)
+        h5vl_test_sysProcess_WaitForExit(clients[i], 0);
 
-    // Once client is finished, the servers
+    // Once the clients are finished, the servers
     // must finish quickly. If not, it usually is a sign that
-    // the client crashed/exited before it attempted to connect to
+    // a client crashed/exited before it attempted to connect to
     // the server.
     if (server) {
 #ifdef H5VL_TEST_SERVER_EXIT_COMMAND
@@ -689,8 +1248,15 @@ H5VLTestDriver::Main(int argc, char* argv[])
         h5vl_test_sysProcess_WaitForExit(client_helper, 0);
     }
 
-    // Get the results.
-    int clientResult = this->ReportStatus(client, "client");
+    // Get the results. The first client to fail sets the client result.
+    int clientResult = 0;
+    for (unsigned int i = 0; i < numClients; ++i) {
+        int result = this->ReportStatus(clients[i], clientNames[i].c_str());
+        if (result && !clientResult)
+            clientResult = result;
+    }
+    if (!this->ShardArgStart.empty())
+        this->ReportMergedResults();
     int serverResult = 0;
     if (server) {
         serverResult = this->ReportStatus(server, "server");
@@ -716,6 +1282,46 @@ H5VLTestDriver::Main(int argc, char* argv[])
     return clientResult;
 }
 
+//----------------------------------------------------------------------------
+void
+H5VLTestDriver::MergeClientResults(const string &output)
+{
+    // Matches the summary lines printed by h5vl_test and h5vl_test_parallel
+    h5vl_test_sys::RegularExpression re(
+        "([0-9]+)/([0-9]+) \\([0-9.]+%\\) VOL tests (passed|did not pass|were skipped)");
+
+    if (!re.find(output))
+        return;
+
+    long count = atol(re.match(1).c_str());
+    string kind = re.match(3);
+    if (kind == "passed") {
+        this->MergedTestsPassed += count;
+        this->MergedTestsRun += atol(re.match(2).c_str());
+    } else if (kind == "did not pass") {
+        this->MergedTestsFailed += count;
+    } else {
+        this->MergedTestsSkipped += count;
+    }
+}
+
+//----------------------------------------------------------------------------
+void
+H5VLTestDriver::ReportMergedResults()
+{
+    if (!this->MergedTestsRun)
+        return;
+
+    cerr << "H5VLTestDriver: merged results of " << this->ShardArgStart.size()
+        << " shards:\n";
+    cerr << "H5VLTestDriver: " << this->MergedTestsPassed << "/"
+        << this->MergedTestsRun << " VOL tests passed\n";
+    cerr << "H5VLTestDriver: " << this->MergedTestsFailed << "/"
+        << this->MergedTestsRun << " VOL tests did not pass\n";
+    cerr << "H5VLTestDriver: " << this->MergedTestsSkipped << "/"
+        << this->MergedTestsRun << " VOL tests were skipped\n";
+}
+
 //----------------------------------------------------------------------------
 void
 H5VLTestDriver::ReportCommand(const char * const *command, const char *name)
@@ -797,107 +1403,520 @@ H5VLTestDriver::ReportStatus(h5vl_test_sysProcess *process, const char *name)
     return result;
 }
 
+//----------------------------------------------------------------------------
+H5VLTestPatternMatcher::H5VLTestPatternMatcher()
+{
+    this->State = 0;
+    this->Offset = 0;
+    this->AddState(); // root
+}
+
 //----------------------------------------------------------------------------
 int
-H5VLTestDriver::WaitForLine(h5vl_test_sysProcess *process, string &line,
-    double timeout, vector<char> &out, vector<char> &err)
+H5VLTestPatternMatcher::AddState()
 {
-    line = "";
-    vector<char>::iterator outiter = out.begin();
-    vector<char>::iterator erriter = err.begin();
-    while (1) {
-        // Check for a newline in stdout.
-        for (; outiter != out.end(); ++outiter) {
-            if ((*outiter == '\r') && ((outiter + 1) == out.end())) {
-                break;
-            } else if (*outiter == '\n' || *outiter == '\0') {
-                int length = outiter - out.begin();
-                if (length > 1 && *(outiter - 1) == '\r')
-                    --length;
-                if (length > 0)
-                    line.append(&out[0], length);
-                out.erase(out.begin(), outiter + 1);
-                return h5vl_test_sysProcess_Pipe_STDOUT;
+    int state = (int)this->Failures.size();
+    this->Transitions.insert(this->Transitions.end(), 256, -1);
+    this->Failures.push_back(0);
+    this->Outputs.push_back(vector<int>());
+    return state;
+}
+
+//----------------------------------------------------------------------------
+int
+H5VLTestPatternMatcher::AddPattern(const string &pattern)
+{
+    if (pattern.empty())
+        return -1;
+
+    // add the pattern to the trie of all the patterns
+    int state = 0;
+    for (string::size_type i = 0; i < pattern.size(); ++i) {
+        int byte = (unsigned char)pattern[i];
+        if (this->Transitions[state * 256 + byte] < 0) {
+            int next = this->AddState();
+            this->Transitions[state * 256 + byte] = next;
+        }
+        state = this->Transitions[state * 256 + byte];
+    }
+
+    this->Patterns.push_back(pattern);
+    this->Outputs[state].push_back((int)this->Patterns.size() - 1);
+    return (int)this->Patterns.size() - 1;
+}
+
+//----------------------------------------------------------------------------
+void
+H5VLTestPatternMatcher::Compile()
+{
+    // Visit the trie breadth first, so that the failure state of every
+    // state is complete before it is used, and turn the trie into a
+    // complete state machine with a transition for every byte.
+    vector<int> queue;
+    queue.push_back(0);
+    for (vector<int>::size_type q = 0; q < queue.size(); ++q) {
+        int state = queue[q];
+        int failure = this->Failures[state];
+        for (int byte = 0; byte < 256; ++byte) {
+            int &next = this->Transitions[state * 256 + byte];
+            int failureNext = state ? this->Transitions[failure * 256 + byte] : 0;
+            if (next < 0) {
+                next = failureNext;
+            } else {
+                this->Failures[next] = failureNext;
+                this->Outputs[next].insert(this->Outputs[next].end(),
+                    this->Outputs[failureNext].begin(),
+                    this->Outputs[failureNext].end());
+                queue.push_back(next);
             }
         }
+    }
+    this->Reset();
+}
 
-        // Check for a newline in stderr.
-        for (; erriter != err.end(); ++erriter) {
-            if ((*erriter == '\r') && ((erriter + 1) == err.end())) {
-                break;
-            } else if (*erriter == '\n' || *erriter == '\0') {
-                int length = erriter - err.begin();
-                if (length > 1 && *(erriter - 1) == '\r')
-                    --length;
-                if (length > 0)
-                    line.append(&err[0], length);
-                err.erase(err.begin(), erriter + 1);
-                return h5vl_test_sysProcess_Pipe_STDERR;
+//----------------------------------------------------------------------------
+const string &
+H5VLTestPatternMatcher::GetPattern(int pattern) const
+{
+    return this->Patterns[pattern];
+}
+
+//----------------------------------------------------------------------------
+void
+H5VLTestPatternMatcher::Reset()
+{
+    this->State = 0;
+    this->Offset = 0;
+}
+
+//----------------------------------------------------------------------------
+void
+H5VLTestPatternMatcher::Feed(const char *data, string::size_type length,
+    vector<Match> &matches)
+{
+    for (string::size_type i = 0; i < length; ++i) {
+        this->State = this->Transitions[this->State * 256 + (unsigned char)data[i]];
+        ++this->Offset;
+
+        const vector<int> &outputs = this->Outputs[this->State];
+        for (vector<int>::size_type o = 0; o < outputs.size(); ++o) {
+            Match match;
+            match.Pattern = outputs[o];
+            match.Position = this->Offset - this->Patterns[outputs[o]].size();
+            matches.push_back(match);
+        }
+    }
+}
+
+//----------------------------------------------------------------------------
+void
+H5VLTestOutput::Append(const char *data, int length)
+{
+    // Drop the lines already taken once they fill half of the buffer;
+    // moving the rest is then paid for by the bytes that were taken.
+    if (this->Begin > 0 && this->Begin >= this->Data.size() / 2) {
+        this->Data.erase(this->Data.begin(), this->Data.begin() + this->Begin);
+        this->Scanned -= this->Begin;
+        this->Begin = 0;
+    }
+    this->Data.insert(this->Data.end(), data, data + length);
+}
+
+//----------------------------------------------------------------------------
+int
+H5VLTestOutput::TakeLine(string &line)
+{
+    // Only the data that arrived since the last call is searched.
+    for (; this->Scanned < this->Data.size(); ++this->Scanned) {
+        char c = this->Data[this->Scanned];
+        if ((c == '\r') && ((this->Scanned + 1) == this->Data.size())) {
+            break;
+        } else if (c == '\n' || c == '\0') {
+            vector<char>::size_type length = this->Scanned - this->Begin;
+            if (length > 1 && this->Data[this->Scanned - 1] == '\r')
+                --length;
+            if (length > 0)
+                line.append(&this->Data[this->Begin], length);
+            this->Begin = ++this->Scanned;
+            return 1;
+        }
+    }
+    return 0;
+}
+
+//----------------------------------------------------------------------------
+void
+H5VLTestOutput::TakeRemainder(string &line)
+{
+    if (this->Scanned > this->Begin)
+        line.append(&this->Data[this->Begin], this->Scanned - this->Begin);
+    this->Data.clear();
+    this->Begin = 0;
+    this->Scanned = 0;
+}
+
+//----------------------------------------------------------------------------
+H5VLTestChild::H5VLTestChild(const string &name, h5vl_test_sysProcess *process)
+    : Name(name), OutputName(name), Process(process), Deadline(-1), Exited(false)
+{
+    this->Pipes[0] = this->Pipes[1] = -1;
+    this->Open[0] = this->Open[1] = false;
+}
+
+//----------------------------------------------------------------------------
+int
+H5VLTestChild::TakeLine(string &line)
+{
+    if (this->StdOut.TakeLine(line))
+        return h5vl_test_sysProcess_Pipe_STDOUT;
+    if (this->StdErr.TakeLine(line))
+        return h5vl_test_sysProcess_Pipe_STDERR;
+
+    // Once a pipe has closed, what is left of its output is the last line
+    if (!this->Open[0] && this->StdOut.Begin < this->StdOut.Data.size()) {
+        this->StdOut.TakeRemainder(line);
+        return h5vl_test_sysProcess_Pipe_STDOUT;
+    }
+    if (!this->Open[1] && this->StdErr.Begin < this->StdErr.Data.size()) {
+        this->StdErr.TakeRemainder(line);
+        return h5vl_test_sysProcess_Pipe_STDERR;
+    }
+    return 0;
+}
+
+//----------------------------------------------------------------------------
+bool
+H5VLTestChild::IsOpen() const
+{
+    return this->Open[0] || this->Open[1]
+        || this->StdOut.Begin < this->StdOut.Data.size()
+        || this->StdErr.Begin < this->StdErr.Data.size();
+}
+
+//----------------------------------------------------------------------------
+H5VLTestMultiplexer::H5VLTestMultiplexer()
+{
+    this->EpollFd = -1;
+    this->Holding = false;
+#ifdef H5VL_TEST_USE_EPOLL
+    this->EpollFd = epoll_create1(EPOLL_CLOEXEC);
+#endif
+}
+
+//----------------------------------------------------------------------------
+H5VLTestMultiplexer::~H5VLTestMultiplexer()
+{
+#ifdef H5VL_TEST_USE_EPOLL
+    if (this->EpollFd >= 0)
+        close(this->EpollFd);
+#endif
+}
+
+//----------------------------------------------------------------------------
+void
+H5VLTestMultiplexer::Add(int fd, int id)
+{
+#ifdef H5VL_TEST_USE_EPOLL
+    if (this->EpollFd >= 0) {
+        struct epoll_event event;
+        memset(&event, 0, sizeof(event));
+        event.events = EPOLLIN;
+        event.data.u32 = (unsigned int)id;
+        epoll_ctl(this->EpollFd, EPOLL_CTL_ADD, fd, &event);
+    }
+#endif
+    this->Fds.push_back(fd);
+    this->Ids.push_back(id);
+}
+
+//----------------------------------------------------------------------------
+void
+H5VLTestMultiplexer::Remove(int fd)
+{
+#ifdef H5VL_TEST_USE_EPOLL
+    if (this->EpollFd >= 0) {
+        struct epoll_event event;
+        memset(&event, 0, sizeof(event));
+        epoll_ctl(this->EpollFd, EPOLL_CTL_DEL, fd, &event);
+    }
+#endif
+    for (vector<int>::size_type i = 0; i < this->Fds.size(); ++i) {
+        if (this->Fds[i] == fd) {
+            this->Fds.erase(this->Fds.begin() + i);
+            this->Ids.erase(this->Ids.begin() + i);
+            break;
+        }
+    }
+}
+
+//----------------------------------------------------------------------------
+void
+H5VLTestMultiplexer::HoldChildExits()
+{
+#ifdef H5VL_TEST_USE_NATIVE_PIPES
+    if (this->Holding)
+        return;
+    sigset_t childSignal;
+    sigemptyset(&childSignal);
+    sigaddset(&childSignal, SIGCHLD);
+    sigprocmask(SIG_BLOCK, &childSignal, &this->WaitMask);
+    this->Holding = true;
+#endif
+}
+
+//----------------------------------------------------------------------------
+void
+H5VLTestMultiplexer::ReleaseChildExits()
+{
+#ifdef H5VL_TEST_USE_NATIVE_PIPES
+    if (!this->Holding)
+        return;
+    sigprocmask(SIG_SETMASK, &this->WaitMask, 0);
+    this->Holding = false;
+#endif
+}
+
+//----------------------------------------------------------------------------
+int
+H5VLTestMultiplexer::Wait(double timeout, vector<int> &ready)
+{
+    ready.clear();
+#ifdef H5VL_TEST_USE_NATIVE_PIPES
+    int ms = (timeout < 0) ? -1 : (int)(timeout * 1000.0 + 0.999);
+    int n = 0;
+
+    // kwsys catches SIGCHLD, which interrupts the wait. The only other
+    // signals it catches end the driver, so an interrupted wait is taken
+    // to mean that a child may have exited.
+# ifdef H5VL_TEST_USE_EPOLL
+    if (this->EpollFd >= 0) {
+        vector<struct epoll_event> events(this->Fds.size() ? this->Fds.size() : 1);
+        // let a held SIGCHLD through only while waiting
+        n = epoll_pwait(this->EpollFd, &events[0], (int)events.size(), ms,
+            this->Holding ? &this->WaitMask : 0);
+        int waitErrno = errno;
+        this->ReleaseChildExits();
+        for (int i = 0; i < n; ++i)
+            ready.push_back((int)events[i].data.u32);
+        if (n < 0 && waitErrno == EINTR) {
+            ready.push_back(ChildExit);
+            return 1;
+        }
+        return n;
+    }
+# endif
+
+    // Without epoll_pwait, an exit between the release and the wait is
+    // only noticed when the wait ends for another reason
+    this->ReleaseChildExits();
+    vector<struct pollfd> fds(this->Fds.size());
+    for (vector<int>::size_type i = 0; i < this->Fds.size(); ++i) {
+        fds[i].fd = this->Fds[i];
+        fds[i].events = POLLIN;
+        fds[i].revents = 0;
+    }
+    n = poll(fds.empty() ? 0 : &fds[0], (nfds_t)fds.size(), ms);
+    for (vector<int>::size_type i = 0; n > 0 && i < fds.size(); ++i)
+        if (fds[i].revents)
+            ready.push_back(this->Ids[i]);
+    if (n < 0 && errno == EINTR) {
+        ready.push_back(ChildExit);
+        return 1;
+    }
+    return n;
+#else
+    (void)timeout;
+    return -1;
+#endif
+}
+
+//----------------------------------------------------------------------------
+int
+H5VLTestDriver::ReadChildren(double timeout)
+{
+    int numRead = 0;
+#ifdef H5VL_TEST_USE_NATIVE_PIPES
+    // Check for processes that have exited with SIGCHLD held back, so
+    // that an exit after the check still ends the wait below. kwsys only
+    // learns of an exit from its SIGCHLD handler, so asking it with no
+    // wait is enough to check.
+    this->Multiplexer.HoldChildExits();
+    for (unsigned int i = 0; i < this->Children.size(); ++i) {
+        H5VLTestChild *child = this->Children[i];
+        double noWait = 0;
+        if (!child->Exited && h5vl_test_sysProcess_WaitForExit(child->Process, &noWait)) {
+            child->Exited = true;
+            this->ChildrenChanged = true;
+            numRead++;
+        }
+    }
+
+    // Stop waiting when the first process is due to time out
+    double now = h5vl_test_sys::SystemTools::GetTime();
+    for (unsigned int i = 0; i < this->Children.size(); ++i) {
+        H5VLTestChild *child = this->Children[i];
+        if (child->Deadline <= 0 || !(child->Open[0] || child->Open[1]))
+            continue;
+        if (child->Deadline <= now) {
+            // kwsys kills a process whose timeout has passed whenever it
+            // next waits for it. Stop reading from it, as kwsys would.
+            double noWait = 0;
+            h5vl_test_sysProcess_WaitForExit(child->Process, &noWait);
+            for (int pipe = 0; pipe < 2; ++pipe) {
+                if (child->Open[pipe]) {
+                    this->Multiplexer.Remove(child->Pipes[pipe]);
+                    close(child->Pipes[pipe]);
+                    child->Open[pipe] = false;
+                }
             }
+            child->Deadline = -1;
+            this->ChildrenChanged = true;
+            numRead++;
+        } else if (timeout < 0 || child->Deadline - now < timeout) {
+            timeout = child->Deadline - now;
         }
+    }
+    if (numRead) {
+        this->Multiplexer.ReleaseChildExits();
+        return numRead;
+    }
 
-        // No newlines found.  Wait for more data from the process.
+    vector<int> ready;
+    this->Multiplexer.Wait(timeout, ready);
+    for (unsigned int i = 0; i < ready.size(); ++i) {
+        if (ready[i] == H5VLTestMultiplexer::ChildExit) {
+            // which process exited is found by the next call
+            numRead++;
+            continue;
+        }
+        if (ready[i] < 0) {
+            // the socket of a daemon, which ServeDaemon accepts
+            this->DaemonConnectionPending = true;
+            numRead++;
+            continue;
+        }
+        H5VLTestChild *child = this->Children[ready[i] / 2];
+        int pipe = ready[i] % 2;
+        H5VLTestOutput &out = pipe ? child->StdErr : child->StdOut;
+
+        char data[65536];
+        ssize_t length = read(child->Pipes[pipe], data, sizeof(data));
+        if (length > 0) {
+            out.Append(data, (int)length);
+        } else if (length == 0 || errno != EINTR) {
+            // the process has closed the pipe
+            this->Multiplexer.Remove(child->Pipes[pipe]);
+            close(child->Pipes[pipe]);
+            child->Open[pipe] = false;
+            this->ChildrenChanged = true;
+        }
+        numRead++;
+    }
+#else
+    // Without pipes of its own the driver can only wait on one process at
+    // a time, so it waits on each in turn for a share of the timeout.
+    unsigned int numOpen = 0;
+    for (unsigned int i = 0; i < this->Children.size(); ++i)
+        if (this->Children[i]->Open[0])
+            numOpen++;
+    for (unsigned int i = 0; i < this->Children.size(); ++i) {
+        H5VLTestChild *child = this->Children[i];
+        if (!child->Open[0])
+            continue;
+        double share = 0.1 / numOpen;
+        if (timeout >= 0 && timeout < share)
+            share = timeout;
         int length;
         char *data;
-        int pipe = h5vl_test_sysProcess_WaitForData(process, &data, &length,
-            &timeout);
-        if (pipe == h5vl_test_sysProcess_Pipe_Timeout) {
-            // Timeout has been exceeded.
-            return pipe;
-        } else if (pipe == h5vl_test_sysProcess_Pipe_STDOUT) {
-            // Append to the stdout buffer.
-            vector<char>::size_type size = out.size();
-            out.insert(out.end(), data, data + length);
-            outiter = out.begin() + size;
+        int pipe = h5vl_test_sysProcess_WaitForData(child->Process, &data,
+            &length, &share);
+        if (pipe == h5vl_test_sysProcess_Pipe_STDOUT) {
+            child->StdOut.Append(data, length);
+            numRead++;
         } else if (pipe == h5vl_test_sysProcess_Pipe_STDERR) {
-            // Append to the stderr buffer.
-            vector<char>::size_type size = err.size();
-            err.insert(err.end(), data, data + length);
-            erriter = err.begin() + size;
+            child->StdErr.Append(data, length);
+            numRead++;
         } else if (pipe == h5vl_test_sysProcess_Pipe_None) {
-            // Both stdout and stderr pipes have broken.  Return leftover data.
-            if (!out.empty()) {
-                line.append(&out[0], outiter - out.begin());
-                out.erase(out.begin(), out.end());
-                return h5vl_test_sysProcess_Pipe_STDOUT;
-            } else if (!err.empty()) {
-                line.append(&err[0], erriter - err.begin());
-                err.erase(err.begin(), err.end());
-                return h5vl_test_sysProcess_Pipe_STDERR;
-            } else {
-                return h5vl_test_sysProcess_Pipe_None;
-            }
+            child->Open[0] = child->Open[1] = false;
+            this->ChildrenChanged = true;
+            numRead++;
+        }
+    }
+#endif
+    return numRead;
+}
+
+//----------------------------------------------------------------------------
+int
+H5VLTestDriver::WaitForLine(H5VLTestChild *&child, string &line,
+    double *timeout, bool reportChanges)
+{
+    line = "";
+    while (1) {
+        // Take a line from each process in turn, so that a process that
+        // writes a lot of output does not hold back the others.
+        for (unsigned int i = 0; i < this->Children.size(); ++i) {
+            this->NextChild = (this->NextChild + 1) % this->Children.size();
+            child = this->Children[this->NextChild];
+            int pipe = child->TakeLine(line);
+            if (pipe)
+                return pipe;
+        }
+
+        // Once its lines are taken, report any change in the processes
+        if (reportChanges && this->ChildrenChanged) {
+            this->ChildrenChanged = false;
+            return H5VL_TEST_PIPE_CHANGED;
+        }
+
+        bool open = false;
+        for (unsigned int i = 0; i < this->Children.size(); ++i)
+            if (this->Children[i]->Open[0] || this->Children[i]->Open[1])
+                open = true;
+        if (!open)
+            return h5vl_test_sysProcess_Pipe_None;
+
+        // No lines found. Wait for more output from any of the processes.
+        double start = h5vl_test_sys::SystemTools::GetTime();
+        int numRead = this->ReadChildren(timeout ? *timeout : -1);
+        if (timeout) {
+            *timeout -= h5vl_test_sys::SystemTools::GetTime() - start;
+            if (*timeout < 0)
+                *timeout = 0;
+            if (!numRead && *timeout <= 0)
+                return h5vl_test_sysProcess_Pipe_Timeout;
         }
     }
 }
 
 //----------------------------------------------------------------------------
 void
-H5VLTestDriver::PrintLine(const char *pname, const char *line)
+H5VLTestDriver::PrintLine(const char *pname, const char *line, const char *prefix)
 {
     // if the name changed then the line is output from a different process
     if (this->CurrentPrintLineName != pname) {
         cerr << "-------------- " << pname << " output --------------\n";
+        if (this->LogFile.is_open())
+            this->LogFile << "-------------- " << pname << " output --------------\n";
         // save the current pname
         this->CurrentPrintLineName = pname;
     }
-    cerr << line << "\n";
+    cerr << prefix << line << "\n";
     cerr.flush();
+    if (this->LogFile.is_open())
+        this->LogFile << prefix << line << "\n";
 }
 
 //----------------------------------------------------------------------------
 int
-H5VLTestDriver::WaitForAndPrintLine(const char *pname,
-    h5vl_test_sysProcess *process, string &line, double timeout,
-    vector<char> &out, vector<char> &err, const char *waitMsg,
-    int *foundWaiting)
+H5VLTestDriver::WaitForAndPrintLine(H5VLTestChild *&child, string &line,
+    double *timeout, bool reportChanges)
 {
-    int pipe = this->WaitForLine(process, line, timeout, out, err);
+    int pipe = this->WaitForLine(child, line, timeout, reportChanges);
     if (pipe == h5vl_test_sysProcess_Pipe_STDOUT
         || pipe == h5vl_test_sysProcess_Pipe_STDERR) {
-        this->PrintLine(pname, line.c_str());
-        if (foundWaiting && (line.find(waitMsg) != line.npos))
-            *foundWaiting = 1;
+        this->PrintLine(child->OutputName.c_str(), line.c_str(),
+            child->LinePrefix.c_str());
     }
     return pipe;
 }
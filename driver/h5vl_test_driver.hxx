@@ -1,11 +1,114 @@
 #ifndef H5VL_TEST_DRIVER_H
 #define H5VL_TEST_DRIVER_H
 
+#include <fstream>
 #include <string>
 #include <vector>
 
 #include <h5vl_test_sys/Process.h>
 
+#if !defined(_WIN32) || defined(__CYGWIN__)
+# include <signal.h>
+#endif
+
+// Output captured from one pipe of a process. Lines are taken from the
+// front of Data by advancing Begin rather than by erasing them, and the
+// taken bytes are only erased once they make up half of Data, so the
+// cost of splitting output into lines stays linear in its size.
+struct H5VLTestOutput {
+    std::vector<char> Data;
+    std::vector<char>::size_type Begin;   // start of the first line not yet taken
+    std::vector<char>::size_type Scanned; // end of the data searched for a newline
+
+    H5VLTestOutput() : Begin(0), Scanned(0) {}
+
+    void Append(const char *data, int length);
+    int TakeLine(std::string &line);
+    void TakeRemainder(std::string &line);
+};
+
+// A process run by the driver, with the output read from it that has
+// not been printed yet.
+struct H5VLTestChild {
+    std::string Name;
+    std::string OutputName; // name that the output is printed under
+    std::string LinePrefix; // prepended to each printed line, if not empty
+    h5vl_test_sysProcess *Process;
+    H5VLTestOutput StdOut;
+    H5VLTestOutput StdErr;
+    int Pipes[2];     // driver's ends of the stdout and stderr pipes
+    bool Open[2];     // whether stdout and stderr may still have output
+    double Deadline;  // time at which the process times out, if positive
+    bool Exited;      // whether the process is known to have exited
+
+    H5VLTestChild(const std::string &name, h5vl_test_sysProcess *process);
+
+    int TakeLine(std::string &line);
+    bool IsOpen() const;
+};
+
+// Waits for any of a set of file descriptors to become readable, with
+// epoll on Linux and poll on other POSIX systems. Each descriptor is
+// added with an id that Wait() reports when it is ready. Wait() also
+// reports ChildExit when a child process may have exited: SIGCHLD can
+// be held back with HoldChildExits() while the caller checks for exits,
+// and is then let through only for the wait, so that no exit is missed
+// between the check and the wait.
+class H5VLTestMultiplexer {
+public:
+    enum { ChildExit = -2 };
+
+    H5VLTestMultiplexer();
+    ~H5VLTestMultiplexer();
+
+    void Add(int fd, int id);
+    void Remove(int fd);
+    void HoldChildExits();
+    void ReleaseChildExits();
+    int Wait(double timeout, std::vector<int> &ready);
+
+private:
+    int EpollFd;
+    std::vector<int> Fds;
+    std::vector<int> Ids;
+    bool Holding;
+#if !defined(_WIN32) || defined(__CYGWIN__)
+    sigset_t WaitMask;  // signal mask from before HoldChildExits()
+#endif
+};
+
+// Finds every occurrence of any of a set of strings in a single pass
+// over the text, however many strings there are (Aho-Corasick). Text
+// may be fed in pieces; matches are reported with the offset of their
+// first character from the last Reset().
+class H5VLTestPatternMatcher {
+public:
+    struct Match {
+        int Pattern;                      // index of the string matched
+        std::string::size_type Position;  // offset of the match in the text
+    };
+
+    H5VLTestPatternMatcher();
+
+    int AddPattern(const std::string &pattern);
+    void Compile();
+    const std::string &GetPattern(int pattern) const;
+
+    void Reset();
+    void Feed(const char *data, std::string::size_type length,
+        std::vector<Match> &matches);
+
+private:
+    int AddState();
+
+    std::vector<std::string> Patterns;
+    std::vector<int> Transitions;               // next state for each state and byte
+    std::vector<int> Failures;                  // longest proper suffix state
+    std::vector< std::vector<int> > Outputs;    // patterns ending at each state
+    int State;
+    std::string::size_type Offset;
+};
+
 class H5VLTestDriver {
 public:
     int Main(int argc, char *argv[]);
@@ -13,6 +116,7 @@ public:
     ~H5VLTestDriver();
 
 protected:
+    int RunProcesses(char *argv[]);
     void SeparateArguments(const char* str, std::vector<std::string> &flags);
 
     void ReportCommand(const char * const *command, const char *name);
@@ -23,24 +127,29 @@ protected:
         const char *cmd, int isServer, int isHelper, const char *numProc,
         int argStart = 0, int argCount = 0, char *argv[] = 0);
 
-    int StartServer(h5vl_test_sysProcess *server, const char *name,
-        std::vector<char> &out, std::vector<char> &err);
-    int StartClientHelper(h5vl_test_sysProcess *client, const char *name,
-        std::vector<char> &out, std::vector<char> &err);
-    int StartClientInit(h5vl_test_sysProcess *client, const char *name,
-        std::vector<char> &out, std::vector<char> &err);
-    int StartClient(h5vl_test_sysProcess *client, const char *name);
+    int StartChild(H5VLTestChild *child);
+    int StartServer(H5VLTestChild *server);
+    int StartClientHelper(H5VLTestChild *client);
+    int StartClientInit(H5VLTestChild *client);
+    int StartClient(H5VLTestChild *client);
+    int StartDaemon(int &result);
+    int ServeDaemon();
+    int AttachDaemon();
+    int DetachDaemon();
+    int StopDaemon();
     void Stop(h5vl_test_sysProcess *p, const char *name);
     int OutputStringHasError(const char *pname, std::string &output);
     int OutputStringHasToken(const char *pname, const char *regex,
         std::string &output, std::string &token);
+    void MergeClientResults(const std::string &output);
+    void ReportMergedResults();
 
-    int WaitForLine(h5vl_test_sysProcess *process, std::string &line,
-        double timeout, std::vector<char> &out, std::vector<char> &err);
-    void PrintLine(const char *pname, const char *line);
-    int WaitForAndPrintLine(const char *pname, h5vl_test_sysProcess *process,
-        std::string &line, double timeout, std::vector<char> &out,
-        std::vector<char> &err, const char *waitMsg, int *foundWaiting);
+    int ReadChildren(double timeout);
+    int WaitForLine(H5VLTestChild *&child, std::string &line, double *timeout,
+        bool reportChanges = false);
+    void PrintLine(const char *pname, const char *line, const char *prefix = "");
+    int WaitForAndPrintLine(H5VLTestChild *&child, std::string &line,
+        double *timeout, bool reportChanges = false);
 
     std::string GetDirectory(std::string location);
 
@@ -71,6 +180,28 @@ private:
 
     std::string CurrentPrintLineName;
 
+    // Every process started so far. All of their output is waited for at
+    // once, and lines are taken from them in turn starting after NextChild.
+    std::vector<H5VLTestChild *> Children;
+    std::vector<H5VLTestChild *>::size_type NextChild;
+    H5VLTestMultiplexer Multiplexer;
+    bool ChildrenChanged;  // a process closed its output or exited
+
+    // With --daemon, the driver keeps its server running in the background
+    // for the clients of drivers run with --attach, until a driver run with
+    // --stop-daemon stops it. Each option names the socket of the daemon.
+    std::string DaemonSocket;
+    std::string AttachSocket;
+    std::string StopSocket;
+    bool DaemonConnectionPending;   // a driver is connecting to the daemon
+
+    // Strings that fail a test when found in a line of its output, unless
+    // one of the non-error strings is also found. Patterns below
+    // NumErrorPatterns are errors; the rest are non-errors.
+    H5VLTestPatternMatcher ErrorMatcher;
+    int NumErrorPatterns;
+    std::ofstream LogFile;      // copy of all process output, if requested
+
     double TimeOut;
     double ServerExitTimeOut;   // time to wait for servers to finish.
     bool ClientHelper;
@@ -85,6 +216,17 @@ private:
     int ClientInitArgCount;
     int ServerArgStart;
     int ServerArgCount;
+
+    // Each --shard runs another client process at the same time as the
+    // others, with the client arguments followed by the shard's arguments
+    std::vector<int> ShardArgStart;
+    std::vector<int> ShardArgCount;
+
+    // Test counts summed over the output of all shards
+    long MergedTestsRun;
+    long MergedTestsPassed;
+    long MergedTestsFailed;
+    long MergedTestsSkipped;
     bool AllowErrorInOutput;
     bool TestSerial;
     bool IgnoreServerResult;
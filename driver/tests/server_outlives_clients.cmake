@@ -0,0 +1,5 @@
+# A server that reports it is waiting for clients and then stays up, with
+# its output open, for longer than the test that runs it may take. The
+# driver must not wait for it once its clients are done.
+message("${START_MSG}")
+execute_process(COMMAND ${CMAKE_COMMAND} -E sleep 60)
@@ -7,7 +7,7 @@
 #endif
 
 /* FILENAME and filenames must have the same number of names */
-const char *FILENAME[3] = {"bigio_test.h5", "single_rank_independent_io.h5", NULL};
+const char *FILENAME[4] = {"bigio_test.h5", "single_rank_independent_io.h5", "bigio_bench.h5", NULL};
 
 uint64_t vol_cap_flags_g;
 
@@ -1856,6 +1856,390 @@ coll_chunktest(const char *filename, int chunk_factor, int select_factor, int ap
         HDfree(data_origin1);
 }
 
+/*
+ * Large count benchmark, run in place of the tests above when a size is
+ * given with --bench. Rather than allocating and checking a full buffer
+ * for every dataset, each process fills one buffer with a generated
+ * pattern once and streams its share of each dataset through it, one
+ * transfer of the whole buffer at a time, so that every transfer needs
+ * a large count when the buffer is over 2 GiB. Before each write, a few
+ * sampled elements of the buffer are stamped with values unique to the
+ * process, dataset and transfer; they are cleared before the matching
+ * read and checked against a checksum of the stamps afterwards. The
+ * bandwidth of each process and of all processes together is reported
+ * for ROW, COL, hyperslab and point decompositions.
+ */
+#define BIGIO_BENCH_WIDTH          1024               /* Elements in each row of the datasets */
+#define BIGIO_BENCH_BLOCK          16                 /* Rows in each block of the hyperslab decomposition */
+#define BIGIO_BENCH_SAMPLES        64                 /* Sampled elements checked in each transfer */
+#define BIGIO_BENCH_DEFAULT_BUFFER ((hsize_t)3 << 30) /* Over 2 GiB, so transfers need large counts */
+#define BIGIO_BENCH_DEFAULT_POINTS ((hsize_t)1 << 24)
+
+typedef enum bigio_bench_decomp_t {
+    BIGIO_BENCH_ROW,       /* Each process takes a slab of rows */
+    BIGIO_BENCH_COL,       /* Each process takes a band of columns */
+    BIGIO_BENCH_HYPERSLAB, /* Each process takes every mpi_size'th block of rows */
+    BIGIO_BENCH_POINT,     /* Each process takes every mpi_size'th row, point by point */
+    BIGIO_BENCH_NUM_DECOMPS
+} bigio_bench_decomp_t;
+
+static const char *const bigio_bench_decomp_names[] = {"ROW", "COL", "hyperslab", "point"};
+
+static hsize_t bigio_bench_size   = 0; /* Bytes transferred by each process, or 0 to run the tests */
+static hsize_t bigio_bench_buffer = 0; /* Bytes in each transfer, at most BIGIO_BENCH_DEFAULT_BUFFER */
+static hsize_t bigio_bench_points = BIGIO_BENCH_DEFAULT_POINTS; /* Elements in each point transfer */
+
+/*
+ * Parses a size given on the command line, with an optional
+ * K, M, G or T suffix (powers of 1024). Fails if the suffix
+ * would overflow the value.
+ */
+static herr_t
+parse_size(const char *str, hsize_t *size_out)
+{
+    char              *end = NULL;
+    unsigned long long size;
+
+    errno = 0;
+    size  = HDstrtoull(str, &end, 10);
+    if (errno != 0 || end == str)
+        return FAIL;
+
+    switch (*end) {
+        case 'T':
+        case 't':
+            if (size > ULLONG_MAX / 1024)
+                return FAIL;
+            size *= 1024;
+            /* FALLTHROUGH */
+        case 'G':
+        case 'g':
+            if (size > ULLONG_MAX / 1024)
+                return FAIL;
+            size *= 1024;
+            /* FALLTHROUGH */
+        case 'M':
+        case 'm':
+            if (size > ULLONG_MAX / 1024)
+                return FAIL;
+            size *= 1024;
+            /* FALLTHROUGH */
+        case 'K':
+        case 'k':
+            if (size > ULLONG_MAX / 1024)
+                return FAIL;
+            size *= 1024;
+            end++;
+            break;
+        default:
+            break;
+    }
+
+    if (*end != '\0')
+        return FAIL;
+
+    *size_out = (hsize_t)size;
+
+    return SUCCEED;
+}
+
+/*
+ * Scrambles a value, for the pattern of the buffer and the stamps
+ * of the sampled elements.
+ */
+static B_DATATYPE
+bigio_bench_mix(B_DATATYPE x)
+{
+    x += 0x9E3779B97F4A7C15ULL;
+    x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    x = (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+
+    return x ^ (x >> 31);
+}
+
+/*
+ * Returns the buffer offset of a sampled element of a transfer, one
+ * from each of BIGIO_BENCH_SAMPLES equal parts of the buffer.
+ */
+static hsize_t
+bigio_bench_sample(hsize_t nelmts, hsize_t transfer, hsize_t sample)
+{
+    hsize_t spacing = nelmts / BIGIO_BENCH_SAMPLES;
+
+    return sample * spacing + bigio_bench_mix(transfer * BIGIO_BENCH_SAMPLES + sample) % spacing;
+}
+
+/*
+ * Returns the value stamped on a sampled element of a transfer.
+ */
+static B_DATATYPE
+bigio_bench_stamp(bigio_bench_decomp_t decomp, hsize_t transfer, hsize_t offset)
+{
+    B_DATATYPE stamp;
+
+    stamp = bigio_bench_mix((B_DATATYPE)decomp);
+    stamp = bigio_bench_mix(stamp ^ (B_DATATYPE)mpi_rank_g);
+    stamp = bigio_bench_mix(stamp ^ transfer);
+
+    return bigio_bench_mix(stamp ^ offset);
+}
+
+/*
+ * Selects the elements of one transfer of a decomposition in the file
+ * dataspace, where each transfer covers `rows` rows of BIGIO_BENCH_WIDTH
+ * elements and each process makes `ntransfers` transfers.
+ */
+static void
+bigio_bench_select(bigio_bench_decomp_t decomp, hid_t file_dataspace, hsize_t rows, hsize_t ntransfers,
+                   hsize_t transfer, hsize_t *coords)
+{
+    hsize_t start[RANK], count[RANK], stride[RANK], block[RANK];
+    hsize_t nprocs = (hsize_t)mpi_size_g;
+    hsize_t rank   = (hsize_t)mpi_rank_g;
+    herr_t  ret;
+
+    count[0]  = 1;
+    count[1]  = 1;
+    stride[0] = 1;
+    stride[1] = 1;
+    block[0]  = rows;
+    block[1]  = BIGIO_BENCH_WIDTH;
+
+    switch (decomp) {
+        case BIGIO_BENCH_ROW:
+            start[0] = (rank * ntransfers + transfer) * rows;
+            start[1] = 0;
+            break;
+
+        case BIGIO_BENCH_COL:
+            start[0] = transfer * rows;
+            start[1] = rank * BIGIO_BENCH_WIDTH;
+            break;
+
+        case BIGIO_BENCH_HYPERSLAB:
+            block[0]  = BIGIO_BENCH_BLOCK;
+            count[0]  = rows / BIGIO_BENCH_BLOCK;
+            stride[0] = nprocs * BIGIO_BENCH_BLOCK;
+            start[0]  = transfer * nprocs * rows + rank * BIGIO_BENCH_BLOCK;
+            start[1]  = 0;
+            break;
+
+        case BIGIO_BENCH_POINT: {
+            hsize_t num_points = rows * BIGIO_BENCH_WIDTH;
+            hsize_t i;
+
+            for (i = 0; i < num_points; i++) {
+                coords[2 * i]     = (transfer * rows + i / BIGIO_BENCH_WIDTH) * nprocs + rank;
+                coords[2 * i + 1] = i % BIGIO_BENCH_WIDTH;
+            }
+
+            ret = H5Sselect_elements(file_dataspace, H5S_SELECT_SET, (size_t)num_points, coords);
+            VRFY_G((ret >= 0), "H5Sselect_elements succeeded");
+            return;
+        }
+
+        case BIGIO_BENCH_NUM_DECOMPS:
+        default:
+            VRFY_G(FALSE, "unknown decomposition");
+            return;
+    }
+
+    ret = H5Sselect_hyperslab(file_dataspace, H5S_SELECT_SET, start, stride, count, block);
+    VRFY_G((ret >= 0), "H5Sset_hyperslab succeeded");
+}
+
+/*
+ * Prints the bandwidth, in MB/s, of each process and of all processes
+ * together for one operation, given the time this process spent in it.
+ */
+static void
+bigio_bench_report(bigio_bench_decomp_t decomp, const char *op, hsize_t nbytes, double elapsed)
+{
+    double bw = (double)nbytes / (1024.0 * 1024.0) / elapsed;
+    double min_bw, max_bw, sum_bw, slowest;
+
+    MPI_Reduce(&bw, &min_bw, 1, MPI_DOUBLE, MPI_MIN, 0, MPI_COMM_WORLD);
+    MPI_Reduce(&bw, &max_bw, 1, MPI_DOUBLE, MPI_MAX, 0, MPI_COMM_WORLD);
+    MPI_Reduce(&bw, &sum_bw, 1, MPI_DOUBLE, MPI_SUM, 0, MPI_COMM_WORLD);
+    MPI_Reduce(&elapsed, &slowest, 1, MPI_DOUBLE, MPI_MAX, 0, MPI_COMM_WORLD);
+
+    if (MAIN_PROCESS)
+        HDprintf("    %-10s %-6s %12.2f %12.2f %12.2f %14.2f\n", bigio_bench_decomp_names[decomp], op, min_bw,
+                 sum_bw / mpi_size_g, max_bw, (double)nbytes * mpi_size_g / (1024.0 * 1024.0) / slowest);
+}
+
+static void
+big_io_bench(void)
+{
+    hid_t       xfer_plist;     /* Dataset transfer properties list */
+    hid_t       sid;            /* Dataspace ID */
+    hid_t       file_dataspace; /* File dataspace ID */
+    hid_t       mem_dataspace;  /* memory dataspace ID */
+    hid_t       dataset;
+    hid_t       fid;     /* HDF5 file ID */
+    hid_t       acc_tpl; /* File access templates */
+    hsize_t     dims[RANK];
+    hsize_t     nelmts, buf_nelmts, point_nelmts;
+    hsize_t    *coords = NULL;
+    hsize_t     i;
+    herr_t      ret; /* Generic return value */
+    B_DATATYPE *buf;
+    int         decomp;
+
+    /* Round the transfers down to whole blocks of rows */
+    nelmts     = bigio_bench_size / sizeof(B_DATATYPE);
+    buf_nelmts = MIN(bigio_bench_buffer, bigio_bench_size) / sizeof(B_DATATYPE);
+    buf_nelmts = MAX(buf_nelmts / (BIGIO_BENCH_WIDTH * BIGIO_BENCH_BLOCK), 1) *
+                 (BIGIO_BENCH_WIDTH * BIGIO_BENCH_BLOCK);
+    point_nelmts = MIN(bigio_bench_points, buf_nelmts);
+    point_nelmts = MAX(point_nelmts / (BIGIO_BENCH_WIDTH * BIGIO_BENCH_BLOCK), 1) *
+                   (BIGIO_BENCH_WIDTH * BIGIO_BENCH_BLOCK);
+
+    /* Fill the buffer once; it is reused by every transfer */
+    buf = (B_DATATYPE *)HDmalloc(buf_nelmts * sizeof(B_DATATYPE));
+    VRFY_G((buf != NULL), "buf malloc succeeded");
+    for (i = 0; i < buf_nelmts; i++)
+        buf[i] = bigio_bench_mix(i);
+
+    coords = (hsize_t *)HDmalloc(point_nelmts * RANK * sizeof(hsize_t));
+    VRFY_G((coords != NULL), "coords malloc succeeded");
+
+    /* set up the collective transfer properties list */
+    xfer_plist = H5Pcreate(H5P_DATASET_XFER);
+    VRFY_G((xfer_plist >= 0), "H5Pcreate xfer succeeded");
+    ret = H5Pset_dxpl_mpio(xfer_plist, H5FD_MPIO_COLLECTIVE);
+    VRFY_G((ret >= 0), "H5Pset_dxpl_mpio succeeded");
+    if (dxfer_coll_type == DXFER_INDEPENDENT_IO) {
+        ret = H5Pset_dxpl_mpio_collective_opt(xfer_plist, H5FD_MPIO_INDIVIDUAL_IO);
+        VRFY_G((ret >= 0), "set independent IO collectively succeeded");
+    }
+
+    if (MAIN_PROCESS) {
+        HDprintf("\nLarge count benchmark: %d processes, %" PRIuHSIZE " bytes per transfer "
+                 "(%" PRIuHSIZE " for points)\n",
+                 mpi_size_g, buf_nelmts * sizeof(B_DATATYPE), point_nelmts * sizeof(B_DATATYPE));
+        HDprintf("    %-10s %-6s %12s %12s %12s %14s\n", "decomp", "op", "min MB/s", "avg MB/s", "max MB/s",
+                 "aggregate MB/s");
+    }
+
+    for (decomp = 0; decomp < BIGIO_BENCH_NUM_DECOMPS; decomp++) {
+        hsize_t xfer_nelmts = decomp == BIGIO_BENCH_POINT ? point_nelmts : buf_nelmts;
+        hsize_t rows        = xfer_nelmts / BIGIO_BENCH_WIDTH;
+        hsize_t ntransfers  = (nelmts + xfer_nelmts - 1) / xfer_nelmts;
+        hsize_t transfer, nbytes;
+        double  write_time = 0.0, read_time = 0.0, start;
+        int     vrfyerrs   = 0;
+
+        /* setup file access template */
+        acc_tpl = H5Pcreate(H5P_FILE_ACCESS);
+        VRFY_G((acc_tpl >= 0), "H5P_FILE_ACCESS");
+        H5Pset_fapl_mpio(acc_tpl, MPI_COMM_WORLD, MPI_INFO_NULL);
+
+        /* create a file for each decomposition, so only one dataset takes up space at a time */
+        fid = H5Fcreate(FILENAME[2], H5F_ACC_TRUNC, H5P_DEFAULT, acc_tpl);
+        VRFY_G((fid >= 0), "H5Fcreate succeeded");
+
+        /* Release file-access template */
+        ret = H5Pclose(acc_tpl);
+        VRFY_G((ret >= 0), "");
+
+        if (decomp == BIGIO_BENCH_COL) {
+            dims[0] = ntransfers * rows;
+            dims[1] = (hsize_t)mpi_size_g * BIGIO_BENCH_WIDTH;
+        }
+        else {
+            dims[0] = (hsize_t)mpi_size_g * ntransfers * rows;
+            dims[1] = BIGIO_BENCH_WIDTH;
+        }
+
+        sid = H5Screate_simple(RANK, dims, NULL);
+        VRFY_G((sid >= 0), "H5Screate_simple succeeded");
+        dataset = H5Dcreate2(fid, DATASET1, H5T_NATIVE_LLONG, sid, H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT);
+        VRFY_G((dataset >= 0), "H5Dcreate2 succeeded");
+        H5Sclose(sid);
+
+        /* create a file dataspace independently */
+        file_dataspace = H5Dget_space(dataset);
+        VRFY_G((file_dataspace >= 0), "H5Dget_space succeeded");
+
+        /* create a memory dataspace independently */
+        mem_dataspace = H5Screate_simple(1, &xfer_nelmts, NULL);
+        VRFY_G((mem_dataspace >= 0), "");
+
+        for (transfer = 0; transfer < ntransfers; transfer++) {
+            bigio_bench_select((bigio_bench_decomp_t)decomp, file_dataspace, rows, ntransfers, transfer,
+                               coords);
+
+            for (i = 0; i < BIGIO_BENCH_SAMPLES; i++) {
+                hsize_t offset = bigio_bench_sample(xfer_nelmts, transfer, i);
+
+                buf[offset] = bigio_bench_stamp((bigio_bench_decomp_t)decomp, transfer, offset);
+            }
+
+            start = MPI_Wtime();
+            ret   = H5Dwrite(dataset, H5T_NATIVE_LLONG, mem_dataspace, file_dataspace, xfer_plist, buf);
+            write_time += MPI_Wtime() - start;
+            VRFY_G((ret >= 0), "H5Dwrite succeeded");
+        }
+
+        for (transfer = 0; transfer < ntransfers; transfer++) {
+            B_DATATYPE expected_sum = 0, read_sum = 0;
+
+            bigio_bench_select((bigio_bench_decomp_t)decomp, file_dataspace, rows, ntransfers, transfer,
+                               coords);
+
+            /* Clear the sampled elements, so that each must be read back to pass */
+            for (i = 0; i < BIGIO_BENCH_SAMPLES; i++) {
+                hsize_t offset = bigio_bench_sample(xfer_nelmts, transfer, i);
+
+                buf[offset] = ~bigio_bench_stamp((bigio_bench_decomp_t)decomp, transfer, offset);
+            }
+
+            start = MPI_Wtime();
+            ret   = H5Dread(dataset, H5T_NATIVE_LLONG, mem_dataspace, file_dataspace, xfer_plist, buf);
+            read_time += MPI_Wtime() - start;
+            VRFY_G((ret >= 0), "H5Dread succeeded");
+
+            for (i = 0; i < BIGIO_BENCH_SAMPLES; i++) {
+                hsize_t offset = bigio_bench_sample(xfer_nelmts, transfer, i);
+
+                expected_sum =
+                    expected_sum * 31 + bigio_bench_stamp((bigio_bench_decomp_t)decomp, transfer, offset);
+                read_sum = read_sum * 31 + buf[offset];
+            }
+
+            if (read_sum != expected_sum) {
+                if (vrfyerrs++ < MAX_ERR_REPORT || VERBOSE_MED)
+                    HDprintf("Proc %d: %s checksum of sampled elements of transfer %" PRIuHSIZE
+                             " failed: expect %" PRIuHSIZE ", got %" PRIuHSIZE "\n",
+                             mpi_rank_g, bigio_bench_decomp_names[decomp], transfer, expected_sum, read_sum);
+            }
+        }
+
+        if (vrfyerrs) {
+            HDprintf("Proc %d: %d errors found in %s benchmark\n", mpi_rank_g, vrfyerrs,
+                     bigio_bench_decomp_names[decomp]);
+            nerrors++;
+        }
+
+        nbytes = ntransfers * xfer_nelmts * sizeof(B_DATATYPE);
+        bigio_bench_report((bigio_bench_decomp_t)decomp, "write", nbytes, write_time);
+        bigio_bench_report((bigio_bench_decomp_t)decomp, "read", nbytes, read_time);
+
+        /* release all temporary handles. */
+        H5Sclose(file_dataspace);
+        H5Sclose(mem_dataspace);
+
+        ret = H5Dclose(dataset);
+        VRFY_G((ret >= 0), "H5Dclose1 succeeded");
+        H5Fclose(fid);
+    }
+
+    H5Pclose(xfer_plist);
+    HDfree(coords);
+    HDfree(buf);
+}
+
 int
 main(int argc, char **argv)
 {
@@ -1876,6 +2260,30 @@ main(int argc, char **argv)
     /* set alarm. */
     /* TestAlarmOn(); */
 
+    /* Parse the benchmark options */
+    for (int arg = 1; arg < argc; arg++) {
+        hsize_t *size_out = NULL;
+
+        if (!HDstrcmp(argv[arg], "--bench"))
+            size_out = &bigio_bench_size;
+        else if (!HDstrcmp(argv[arg], "--bench-buffer"))
+            size_out = &bigio_bench_buffer;
+        else if (!HDstrcmp(argv[arg], "--bench-points"))
+            size_out = &bigio_bench_points;
+
+        if (!size_out || ++arg >= argc || parse_size(argv[arg], size_out) < 0 || *size_out == 0) {
+            if (MAIN_PROCESS)
+                HDfprintf(stderr,
+                          "Usage: t_bigio [--bench <size per process>] [--bench-buffer <size>] "
+                          "[--bench-points <count>]\n");
+            MPI_Finalize();
+            return 1;
+        }
+    }
+
+    if (!bigio_bench_buffer)
+        bigio_bench_buffer = BIGIO_BENCH_DEFAULT_BUFFER;
+
     acc_plist = create_faccess_plist(MPI_COMM_WORLD, MPI_INFO_NULL, facc_type);
 
     /* Get the capability flag of the VOL connector being used */
@@ -1900,20 +2308,26 @@ main(int argc, char **argv)
         return 0;
     }
 
-    dataset_big_write();
-    MPI_Barrier(MPI_COMM_WORLD);
+    if (bigio_bench_size) {
+        big_io_bench();
+        MPI_Barrier(MPI_COMM_WORLD);
+    }
+    else {
+        dataset_big_write();
+        MPI_Barrier(MPI_COMM_WORLD);
 
-    dataset_big_read();
-    MPI_Barrier(MPI_COMM_WORLD);
+        dataset_big_read();
+        MPI_Barrier(MPI_COMM_WORLD);
 
-    coll_chunk1();
-    MPI_Barrier(MPI_COMM_WORLD);
-    coll_chunk2();
-    MPI_Barrier(MPI_COMM_WORLD);
-    coll_chunk3();
-    MPI_Barrier(MPI_COMM_WORLD);
+        coll_chunk1();
+        MPI_Barrier(MPI_COMM_WORLD);
+        coll_chunk2();
+        MPI_Barrier(MPI_COMM_WORLD);
+        coll_chunk3();
+        MPI_Barrier(MPI_COMM_WORLD);
 
-    single_rank_independent_io();
+        single_rank_independent_io();
+    }
 
     /* turn off alarm */
     /* TestAlarmOff(); */
@@ -1927,6 +2341,7 @@ main(int argc, char **argv)
         {
             H5Fdelete(FILENAME[0], fapl_id);
             H5Fdelete(FILENAME[1], fapl_id);
+            H5Fdelete(FILENAME[2], fapl_id);
         }
         H5E_END_TRY;
 
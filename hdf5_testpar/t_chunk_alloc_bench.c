@@ -0,0 +1,492 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * Copyright by The HDF Group.                                               *
+ * All rights reserved.                                                      *
+ *                                                                           *
+ * This file is part of HDF5.  The full HDF5 copyright notice, including     *
+ * terms governing use, modification, and redistribution, is contained in    *
+ * the COPYING file, which can be found at the root of the source code       *
+ * distribution tree, or in https://www.hdfgroup.org/licenses.               *
+ * If you do not have access to either file, you may request a copy from     *
+ * help@hdfgroup.org.                                                        *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+/*
+ * A scaling benchmark of chunk allocation, built on the extendible
+ * dataset of t_chunk_alloc.c. That test checks that a dataset of
+ * CHUNK_FACTOR chunks of CHUNK_SIZE bytes, allocated early, reads back
+ * the fill value after being reopened, extended and written in parallel.
+ * Here the same one-dimensional unlimited dataset is created collectively
+ * with a range of chunk counts, for each space allocation time set with
+ * H5Pset_alloc_time and each of these fill value settings:
+ *
+ * - default: no fill value is set, so no fill value is written
+ * - value:   a fill value is set, and written when space is allocated
+ * - alloc:   the default fill value is written when space is allocated
+ * - never:   a fill value is set, but never written
+ *
+ * For each dataset process 0 prints the time the slowest process took to
+ * create the dataset, the storage allocated by the time the dataset was
+ * created, the time the slowest process took for the first collective
+ * write of one chunk by each process, and the time the slowest process
+ * took to double the dataset with H5Dset_extent. Running the benchmark
+ * with different numbers of processes shows how the cost of allocating
+ * chunks at startup grows with the size of the job.
+ *
+ * Note that the native connector allocates the space of datasets without
+ * filters early when a file is opened with the MPI I/O file driver,
+ * whatever allocation time is set, so with that connector the incremental
+ * and late rows show what this costs.
+ */
+
+#include "hdf5.h"
+#include "testphdf5.h"
+
+const char *FILENAME[2] = {"chunk_alloc_bench.h5", NULL};
+
+uint64_t vol_cap_flags_g;
+
+int        facc_type       = FACC_MPIO; /*Test file access type */
+int        dxfer_coll_type = DXFER_COLLECTIVE_IO;
+int        nerrors         = 0;
+static int mpi_size_g, mpi_rank_g;
+
+#define MAIN_PROCESS (mpi_rank_g == 0) /* define process 0 as main process */
+
+#define CALLOC_BENCH_CHUNK_SIZE      1000 /* CHUNK_SIZE of t_chunk_alloc.c */
+#define CALLOC_BENCH_MAX_LIST_VALUES 16
+#define CALLOC_BENCH_DSET_NAME       "ExtendibleArray"
+#define CALLOC_BENCH_FILL_BYTE       ((unsigned char)0xA5)
+
+/* The fill value settings of the datasets */
+typedef enum calloc_bench_fill_t {
+    CALLOC_BENCH_FILL_DEFAULT, /* No fill value set */
+    CALLOC_BENCH_FILL_VALUE,   /* H5Pset_fill_value */
+    CALLOC_BENCH_FILL_ALLOC,   /* H5Pset_fill_time with H5D_FILL_TIME_ALLOC */
+    CALLOC_BENCH_FILL_NEVER,   /* H5Pset_fill_value and H5Pset_fill_time with H5D_FILL_TIME_NEVER */
+    CALLOC_BENCH_NUM_FILLS
+} calloc_bench_fill_t;
+
+static const char *const calloc_bench_fill_names[] = {"default", "value", "alloc", "never"};
+
+/* The space allocation times of the datasets */
+#define CALLOC_BENCH_NUM_ALLOC_TIMES 3
+
+static const H5D_alloc_time_t calloc_bench_alloc_times[] = {H5D_ALLOC_TIME_EARLY, H5D_ALLOC_TIME_INCR,
+                                                            H5D_ALLOC_TIME_LATE};
+static const char *const      calloc_bench_alloc_names[] = {"early", "incr", "late"};
+
+/* Benchmark parameters, set from the command line */
+static hsize_t calloc_bench_chunk_size_g = CALLOC_BENCH_CHUNK_SIZE;
+static hbool_t calloc_bench_alloc_enabled_g[CALLOC_BENCH_NUM_ALLOC_TIMES];
+static hbool_t calloc_bench_fill_enabled_g[CALLOC_BENCH_NUM_FILLS];
+
+static unsigned calloc_bench_chunks_g[CALLOC_BENCH_MAX_LIST_VALUES] = {1000, 10000, 100000, 1000000,
+                                                                       10000000};
+static size_t   calloc_bench_nchunks_g                              = 5;
+
+/*
+ * Parses a comma-separated list of unsigned numbers given on the command line.
+ */
+static herr_t
+calloc_bench_parse_list(const char *str, unsigned values[], size_t *nvalues)
+{
+    char *end = NULL;
+
+    *nvalues = 0;
+
+    do {
+        unsigned long value;
+
+        value = HDstrtoul(str, &end, 10);
+        if (end == str || (*end != ',' && *end != '\0') || value == 0 || value > UINT_MAX ||
+            *nvalues == CALLOC_BENCH_MAX_LIST_VALUES)
+            return FAIL;
+
+        values[(*nvalues)++] = (unsigned)value;
+        str                  = end + 1;
+    } while (*end == ',');
+
+    return SUCCEED;
+}
+
+/*
+ * Parses a comma-separated list of names given on the command line,
+ * enabling the ones that are found in a table of names.
+ */
+static herr_t
+calloc_bench_parse_names(const char *str, const char *const names[], hbool_t enabled[], int nnames)
+{
+    HDmemset(enabled, 0, (size_t)nnames * sizeof(hbool_t));
+
+    while (*str) {
+        size_t len = HDstrcspn(str, ",");
+        int    i;
+
+        for (i = 0; i < nnames; i++)
+            if (HDstrlen(names[i]) == len && !HDstrncmp(str, names[i], len))
+                break;
+        if (i == nnames)
+            return FAIL;
+
+        enabled[i] = TRUE;
+        str += len;
+        if (*str == ',')
+            str++;
+    }
+
+    return SUCCEED;
+}
+
+/*
+ * Returns the time taken by the slowest process, given the time taken by
+ * this one.
+ */
+static double
+calloc_bench_slowest(double elapsed)
+{
+    double slowest = 0.0;
+
+    MPI_Allreduce(&elapsed, &slowest, 1, MPI_DOUBLE, MPI_MAX, MPI_COMM_WORLD);
+
+    return slowest;
+}
+
+/*
+ * Creates a dataset of a number of chunks with a space allocation time
+ * and fill value setting, writes one chunk from each process and doubles
+ * the dataset, timing each step.
+ */
+static void
+calloc_bench_run(unsigned nchunks, int alloc, calloc_bench_fill_t fill)
+{
+    hid_t          fapl_id = H5I_INVALID_HID, file_id = H5I_INVALID_HID, dcpl_id = H5I_INVALID_HID;
+    hid_t          dxpl_id = H5I_INVALID_HID, dset_id = H5I_INVALID_HID;
+    hid_t          fspace_id = H5I_INVALID_HID, mspace_id = H5I_INVALID_HID;
+    hsize_t        dims[1], max_dims[1] = {H5S_UNLIMITED}, chunk_dims[1] = {calloc_bench_chunk_size_g};
+    hsize_t        start[1], count[1] = {1}, block[1] = {calloc_bench_chunk_size_g};
+    hsize_t        stride, storage_size;
+    unsigned char  fill_value = CALLOC_BENCH_FILL_BYTE;
+    unsigned char *wbuf = NULL, *rbuf = NULL;
+    hbool_t        writer;
+    double         elapsed, create_time, write_time, extend_time;
+    herr_t         ret;
+
+    dims[0] = (hsize_t)nchunks * calloc_bench_chunk_size_g;
+
+    fapl_id = create_faccess_plist(MPI_COMM_WORLD, MPI_INFO_NULL, facc_type);
+    VRFY_G((fapl_id >= 0), "create_faccess_plist succeeded");
+
+    file_id = H5Fcreate(FILENAME[0], H5F_ACC_TRUNC, H5P_DEFAULT, fapl_id);
+    VRFY_G((file_id >= 0), "H5Fcreate succeeded");
+
+    fspace_id = H5Screate_simple(1, dims, max_dims);
+    VRFY_G((fspace_id >= 0), "H5Screate_simple succeeded");
+
+    dcpl_id = H5Pcreate(H5P_DATASET_CREATE);
+    VRFY_G((dcpl_id >= 0), "H5Pcreate succeeded");
+    ret = H5Pset_chunk(dcpl_id, 1, chunk_dims);
+    VRFY_G((ret >= 0), "H5Pset_chunk succeeded");
+    ret = H5Pset_alloc_time(dcpl_id, calloc_bench_alloc_times[alloc]);
+    VRFY_G((ret >= 0), "H5Pset_alloc_time succeeded");
+
+    if (fill == CALLOC_BENCH_FILL_VALUE || fill == CALLOC_BENCH_FILL_NEVER) {
+        ret = H5Pset_fill_value(dcpl_id, H5T_NATIVE_UCHAR, &fill_value);
+        VRFY_G((ret >= 0), "H5Pset_fill_value succeeded");
+    }
+    if (fill == CALLOC_BENCH_FILL_ALLOC) {
+        ret = H5Pset_fill_time(dcpl_id, H5D_FILL_TIME_ALLOC);
+        VRFY_G((ret >= 0), "H5Pset_fill_time succeeded");
+    }
+    else if (fill == CALLOC_BENCH_FILL_NEVER) {
+        ret = H5Pset_fill_time(dcpl_id, H5D_FILL_TIME_NEVER);
+        VRFY_G((ret >= 0), "H5Pset_fill_time succeeded");
+    }
+
+    /* Dataset creation */
+    MPI_Barrier(MPI_COMM_WORLD);
+    elapsed = MPI_Wtime();
+    dset_id = H5Dcreate2(file_id, CALLOC_BENCH_DSET_NAME, H5T_NATIVE_UCHAR, fspace_id, H5P_DEFAULT, dcpl_id,
+                         H5P_DEFAULT);
+    elapsed = MPI_Wtime() - elapsed;
+    VRFY_G((dset_id >= 0), "H5Dcreate2 succeeded");
+    create_time = calloc_bench_slowest(elapsed);
+
+    /* Connectors that don't track allocated storage report 0 */
+    H5E_BEGIN_TRY
+    {
+        storage_size = H5Dget_storage_size(dset_id);
+    }
+    H5E_END_TRY;
+
+    /* Spread the chunks written by the processes over the dataset, leaving
+     * out processes beyond the number of chunks */
+    stride   = MAX((hsize_t)nchunks / (hsize_t)mpi_size_g, 1);
+    writer   = ((hsize_t)mpi_rank_g < (hsize_t)nchunks);
+    start[0] = (hsize_t)mpi_rank_g * stride * calloc_bench_chunk_size_g;
+
+    mspace_id = H5Screate_simple(1, chunk_dims, NULL);
+    VRFY_G((mspace_id >= 0), "H5Screate_simple succeeded");
+
+    if (writer) {
+        ret = H5Sselect_hyperslab(fspace_id, H5S_SELECT_SET, start, NULL, count, block);
+        VRFY_G((ret >= 0), "H5Sselect_hyperslab succeeded");
+    }
+    else {
+        ret = H5Sselect_none(fspace_id);
+        VRFY_G((ret >= 0), "H5Sselect_none succeeded");
+        ret = H5Sselect_none(mspace_id);
+        VRFY_G((ret >= 0), "H5Sselect_none succeeded");
+    }
+
+    wbuf = (unsigned char *)HDmalloc((size_t)calloc_bench_chunk_size_g);
+    VRFY_G((wbuf != NULL), "HDmalloc succeeded");
+    rbuf = (unsigned char *)HDmalloc((size_t)calloc_bench_chunk_size_g);
+    VRFY_G((rbuf != NULL), "HDmalloc succeeded");
+    HDmemset(wbuf, mpi_rank_g + 1, (size_t)calloc_bench_chunk_size_g);
+
+    dxpl_id = H5Pcreate(H5P_DATASET_XFER);
+    VRFY_G((dxpl_id >= 0), "H5Pcreate succeeded");
+    ret = H5Pset_dxpl_mpio(dxpl_id, H5FD_MPIO_COLLECTIVE);
+    VRFY_G((ret >= 0), "H5Pset_dxpl_mpio succeeded");
+
+    /* First write */
+    MPI_Barrier(MPI_COMM_WORLD);
+    elapsed = MPI_Wtime();
+    ret     = H5Dwrite(dset_id, H5T_NATIVE_UCHAR, mspace_id, fspace_id, dxpl_id, wbuf);
+    elapsed = MPI_Wtime() - elapsed;
+    VRFY_G((ret >= 0), "H5Dwrite succeeded");
+    write_time = calloc_bench_slowest(elapsed);
+
+    /* Extension to twice the number of chunks */
+    dims[0] *= 2;
+
+    MPI_Barrier(MPI_COMM_WORLD);
+    elapsed = MPI_Wtime();
+    ret     = H5Dset_extent(dset_id, dims);
+    elapsed = MPI_Wtime() - elapsed;
+    VRFY_G((ret >= 0), "H5Dset_extent succeeded");
+    extend_time = calloc_bench_slowest(elapsed);
+
+    /* Make sure the chunk written survived the extension */
+    ret = H5Sclose(fspace_id);
+    VRFY_G((ret >= 0), "H5Sclose succeeded");
+    fspace_id = H5Dget_space(dset_id);
+    VRFY_G((fspace_id >= 0), "H5Dget_space succeeded");
+
+    if (writer) {
+        ret = H5Sselect_hyperslab(fspace_id, H5S_SELECT_SET, start, NULL, count, block);
+        VRFY_G((ret >= 0), "H5Sselect_hyperslab succeeded");
+    }
+    else {
+        ret = H5Sselect_none(fspace_id);
+        VRFY_G((ret >= 0), "H5Sselect_none succeeded");
+    }
+
+    HDmemset(rbuf, 0, (size_t)calloc_bench_chunk_size_g);
+    ret = H5Dread(dset_id, H5T_NATIVE_UCHAR, mspace_id, fspace_id, dxpl_id, rbuf);
+    VRFY_G((ret >= 0), "H5Dread succeeded");
+    if (writer)
+        VRFY_G((HDmemcmp(wbuf, rbuf, (size_t)calloc_bench_chunk_size_g) == 0), "data verification");
+
+    if (MAIN_PROCESS)
+        HDprintf("    %10u  %-6s  %-8s  %12.3f  %12.2f  %12.3f  %12.3f\n", nchunks,
+                 calloc_bench_alloc_names[alloc], calloc_bench_fill_names[fill], create_time * 1000.0,
+                 (double)storage_size / (1024.0 * 1024.0), write_time * 1000.0, extend_time * 1000.0);
+
+    HDfree(wbuf);
+    HDfree(rbuf);
+
+    ret = H5Pclose(dxpl_id);
+    VRFY_G((ret >= 0), "H5Pclose succeeded");
+    ret = H5Sclose(mspace_id);
+    VRFY_G((ret >= 0), "H5Sclose succeeded");
+    ret = H5Sclose(fspace_id);
+    VRFY_G((ret >= 0), "H5Sclose succeeded");
+    ret = H5Pclose(dcpl_id);
+    VRFY_G((ret >= 0), "H5Pclose succeeded");
+    ret = H5Dclose(dset_id);
+    VRFY_G((ret >= 0), "H5Dclose succeeded");
+    ret = H5Fclose(file_id);
+    VRFY_G((ret >= 0), "H5Fclose succeeded");
+    ret = H5Pclose(fapl_id);
+    VRFY_G((ret >= 0), "H5Pclose succeeded");
+}
+
+/*
+ * Create the appropriate File access property list
+ */
+hid_t
+create_faccess_plist(MPI_Comm comm, MPI_Info info, int l_facc_type)
+{
+    hid_t  ret_pl = -1;
+    herr_t ret; /* generic return value */
+
+    ret_pl = H5Pcreate(H5P_FILE_ACCESS);
+    VRFY_G((ret_pl >= 0), "H5P_FILE_ACCESS");
+
+    if (l_facc_type == FACC_DEFAULT)
+        return (ret_pl);
+
+    /* set Parallel access with communicator */
+    ret = H5Pset_fapl_mpio(ret_pl, comm, info);
+    VRFY_G((ret >= 0), "");
+    ret = H5Pset_all_coll_metadata_ops(ret_pl, TRUE);
+    VRFY_G((ret >= 0), "");
+    ret = H5Pset_coll_metadata_write(ret_pl, TRUE);
+    VRFY_G((ret >= 0), "");
+
+    return (ret_pl);
+}
+
+static void
+usage(void)
+{
+    HDprintf("Usage: t_chunk_alloc_bench [--chunks <list>] [--chunk-size <n>] [--alloc <list>]\n"
+             "                           [--fill <list>]\n"
+             "\n"
+             "    --chunks <list>     Numbers of chunks of the datasets\n"
+             "                        (default 1000,10000,100000,1000000,10000000)\n"
+             "    --chunk-size <n>    Size of the chunks in bytes (default %d)\n"
+             "    --alloc <list>      Space allocation times: early, incr or late (default all)\n"
+             "    --fill <list>       Fill value settings: default, value, alloc or never (default all)\n",
+             CALLOC_BENCH_CHUNK_SIZE);
+}
+
+int
+main(int argc, char **argv)
+{
+    hid_t  acc_plist = H5I_INVALID_HID;
+    size_t i;
+    int    alloc, fill;
+
+    MPI_Init(&argc, &argv);
+    MPI_Comm_size(MPI_COMM_WORLD, &mpi_size_g);
+    MPI_Comm_rank(MPI_COMM_WORLD, &mpi_rank_g);
+
+    /* Attempt to turn off atexit post processing so that in case errors
+     * happen during the test and the process is aborted, it will not get
+     * hang in the atexit post processing in which it may try to make MPI
+     * calls.  By then, MPI calls may not work.
+     */
+    if (H5dont_atexit() < 0)
+        HDprintf("Failed to turn off atexit processing. Continue.\n");
+
+    for (alloc = 0; alloc < CALLOC_BENCH_NUM_ALLOC_TIMES; alloc++)
+        calloc_bench_alloc_enabled_g[alloc] = TRUE;
+    for (fill = 0; fill < CALLOC_BENCH_NUM_FILLS; fill++)
+        calloc_bench_fill_enabled_g[fill] = TRUE;
+
+    for (int arg = 1; arg < argc; arg++) {
+        herr_t parse_ret = SUCCEED;
+
+        if (!HDstrcmp(argv[arg], "--chunk-size")) {
+            char              *end   = NULL;
+            unsigned long long value = 0;
+
+            if (arg + 1 < argc)
+                value = HDstrtoull(argv[arg + 1], &end, 10);
+            if (!end || end == argv[arg + 1] || *end != '\0' || value == 0 || value > UINT_MAX)
+                parse_ret = FAIL;
+            else
+                calloc_bench_chunk_size_g = (hsize_t)value;
+            arg++;
+        }
+        else if (!HDstrcmp(argv[arg], "--chunks")) {
+            if (++arg >= argc ||
+                calloc_bench_parse_list(argv[arg], calloc_bench_chunks_g, &calloc_bench_nchunks_g) < 0)
+                parse_ret = FAIL;
+        }
+        else if (!HDstrcmp(argv[arg], "--alloc")) {
+            if (++arg >= argc || calloc_bench_parse_names(argv[arg], calloc_bench_alloc_names,
+                                                          calloc_bench_alloc_enabled_g,
+                                                          CALLOC_BENCH_NUM_ALLOC_TIMES) < 0)
+                parse_ret = FAIL;
+        }
+        else if (!HDstrcmp(argv[arg], "--fill")) {
+            if (++arg >= argc || calloc_bench_parse_names(argv[arg], calloc_bench_fill_names,
+                                                          calloc_bench_fill_enabled_g,
+                                                          CALLOC_BENCH_NUM_FILLS) < 0)
+                parse_ret = FAIL;
+        }
+        else
+            parse_ret = FAIL;
+
+        if (parse_ret < 0) {
+            if (MAIN_PROCESS) {
+                HDfprintf(stderr, "Invalid argument '%s'\n", argv[MIN(arg, argc - 1)]);
+                usage();
+            }
+            MPI_Finalize();
+            HDexit(EXIT_FAILURE);
+        }
+    }
+
+    acc_plist = create_faccess_plist(MPI_COMM_WORLD, MPI_INFO_NULL, facc_type);
+
+    /* Get the capability flag of the VOL connector being used */
+    if (H5Pget_vol_cap_flags(acc_plist, &vol_cap_flags_g) < 0) {
+        if (MAIN_PROCESS)
+            HDprintf("Failed to get the capability flag of the VOL connector being used\n");
+
+        MPI_Finalize();
+        return 0;
+    }
+
+    /* Make sure the connector supports the API functions being tested */
+    if (!(vol_cap_flags_g & H5VL_CAP_FLAG_FILE_BASIC) || !(vol_cap_flags_g & H5VL_CAP_FLAG_DATASET_BASIC) ||
+        !(vol_cap_flags_g & H5VL_CAP_FLAG_DATASET_MORE)) {
+        if (MAIN_PROCESS)
+            HDprintf("API functions for basic file, dataset, or dataset more aren't supported with this "
+                     "connector\n");
+
+        MPI_Finalize();
+        return 0;
+    }
+
+    /* Only the default fill value setting can be run without fill value support */
+    if (!(vol_cap_flags_g & H5VL_CAP_FLAG_FILL_VALUES)) {
+        for (fill = 0; fill < CALLOC_BENCH_NUM_FILLS; fill++)
+            if (fill != CALLOC_BENCH_FILL_DEFAULT)
+                calloc_bench_fill_enabled_g[fill] = FALSE;
+    }
+
+    if (MAIN_PROCESS) {
+        HDprintf("Chunk allocation benchmark: %d processes, chunks of %llu bytes\n\n", mpi_size_g,
+                 (unsigned long long)calloc_bench_chunk_size_g);
+        HDprintf("    %10s  %-6s  %-8s  %12s  %12s  %12s  %12s\n", "chunks", "alloc", "fill", "create ms",
+                 "storage MB", "1st write ms", "extend ms");
+    }
+
+    for (i = 0; i < calloc_bench_nchunks_g; i++)
+        for (alloc = 0; alloc < CALLOC_BENCH_NUM_ALLOC_TIMES; alloc++)
+            for (fill = 0; fill < CALLOC_BENCH_NUM_FILLS; fill++) {
+                if (!calloc_bench_alloc_enabled_g[alloc] || !calloc_bench_fill_enabled_g[fill])
+                    continue;
+
+                calloc_bench_run(calloc_bench_chunks_g[i], alloc, (calloc_bench_fill_t)fill);
+                MPI_Barrier(MPI_COMM_WORLD);
+            }
+
+    if (mpi_rank_g == 0) {
+        hid_t fapl_id = H5Pcreate(H5P_FILE_ACCESS);
+
+        H5Pset_fapl_mpio(fapl_id, MPI_COMM_SELF, MPI_INFO_NULL);
+
+        H5E_BEGIN_TRY
+        {
+            H5Fdelete(FILENAME[0], fapl_id);
+        }
+        H5E_END_TRY;
+
+        H5Pclose(fapl_id);
+    }
+
+    H5Pclose(acc_plist);
+
+    /* close HDF5 library */
+    H5close();
+
+    MPI_Finalize();
+
+    return nerrors ? 1 : 0;
+}
@@ -0,0 +1,793 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * Copyright by The HDF Group.                                               *
+ * All rights reserved.                                                      *
+ *                                                                           *
+ * This file is part of HDF5.  The full HDF5 copyright notice, including     *
+ * terms governing use, modification, and redistribution, is contained in    *
+ * the COPYING file, which can be found at the root of the source code       *
+ * distribution tree, or in https://www.hdfgroup.org/licenses.               *
+ * If you do not have access to either file, you may request a copy from     *
+ * help@hdfgroup.org.                                                        *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+/*
+ * A benchmark of collective and independent I/O, built on the selections
+ * of the collective chunk tests in t_coll_chunk.c and the irregular
+ * hyperslab tests in t_span_tree.c. Those tests only check that each
+ * selection is transferred correctly on datasets of a few hundred
+ * elements per process; here every dimension of the same selections is
+ * grown by a scale factor, and each selection is written and read with:
+ *
+ * - independent I/O
+ * - collective I/O, leaving the choice of chunk I/O to the library
+ * - collective I/O that is carried out independently
+ * - collective link chunk I/O and multi chunk I/O, chosen with
+ *   H5Pset_dxpl_mpio_chunk_opt
+ * - collective I/O with each of a number of link chunk thresholds, set
+ *   with H5Pset_dxpl_mpio_chunk_opt_num
+ * - collective multi chunk I/O with each of a number of collective
+ *   ratios, set with H5Pset_dxpl_mpio_chunk_opt_ratio
+ *
+ * on a contiguous dataset and on chunked datasets holding a number of
+ * chunks for each process. Process 0 prints the aggregate bandwidth of
+ * each mode, taken from the time of the slowest process in the fastest
+ * iteration, along with the chunk I/O and I/O mode the library actually
+ * used, so that the points at which collective I/O overtakes independent
+ * I/O, and link chunk I/O overtakes multi chunk I/O, can be read off for
+ * the number of processes run.
+ */
+
+#include <float.h>
+
+#include "hdf5.h"
+#include "testphdf5.h"
+
+const char *FILENAME[2] = {"coll_bench.h5", NULL};
+
+uint64_t vol_cap_flags_g;
+
+int        facc_type       = FACC_MPIO; /*Test file access type */
+int        dxfer_coll_type = DXFER_COLLECTIVE_IO;
+int        nerrors         = 0;
+static int mpi_size_g, mpi_rank_g;
+
+#define MAIN_PROCESS (mpi_rank_g == 0) /* define process 0 as main process */
+
+#define COLL_BENCH_DEFAULT_SCALE      256 /* 6144 x 1024 elements for each process */
+#define COLL_BENCH_DEFAULT_ITERATIONS 3
+#define COLL_BENCH_MAX_LIST_VALUES    16
+#define COLL_BENCH_MAX_MODES          (5 + 2 * COLL_BENCH_MAX_LIST_VALUES)
+#define COLL_BENCH_DSET_NAME          "coll_bench"
+#define COLL_BENCH_MODE_NAME_LEN      32
+#define COLL_BENCH_ACTUAL_NAME_LEN    64
+
+/* The selection shapes of the collective chunk and irregular hyperslab tests */
+typedef enum coll_bench_shape_t {
+    COLL_BENCH_CONTIGUOUS,   /* BYROW_CONT */
+    COLL_BENCH_CHECKERBOARD, /* BYROW_DISCONT */
+    COLL_BENCH_SELECT_NONE,  /* BYROW_SELECTNONE */
+    COLL_BENCH_UNBALANCED,   /* BYROW_SELECTUNBALANCE */
+    COLL_BENCH_IN_CHUNK,     /* BYROW_SELECTINCHUNK */
+    COLL_BENCH_IRREGULAR,    /* The two hyperslabs of coll_write_test */
+    COLL_BENCH_NUM_SHAPES
+} coll_bench_shape_t;
+
+static const char *const coll_bench_shape_names[] = {"contiguous", "checkerboard", "select-none",
+                                                     "unbalanced", "in-chunk",     "irregular"};
+
+/* The ways a selection is transferred */
+typedef enum coll_bench_mode_t {
+    COLL_BENCH_INDEPENDENT,     /* H5FD_MPIO_INDEPENDENT */
+    COLL_BENCH_COLLECTIVE,      /* H5FD_MPIO_COLLECTIVE */
+    COLL_BENCH_COLLECTIVE_IND,  /* H5FD_MPIO_COLLECTIVE with H5FD_MPIO_INDIVIDUAL_IO */
+    COLL_BENCH_LINK_HARD,       /* H5FD_MPIO_CHUNK_ONE_IO */
+    COLL_BENCH_MULTI_HARD,      /* H5FD_MPIO_CHUNK_MULTI_IO */
+    COLL_BENCH_LINK_THRESHOLD,  /* H5Pset_dxpl_mpio_chunk_opt_num */
+    COLL_BENCH_MULTI_THRESHOLD, /* H5Pset_dxpl_mpio_chunk_opt_ratio */
+} coll_bench_mode_t;
+
+/* Benchmark parameters, set from the command line */
+static hsize_t  coll_bench_scale_g      = COLL_BENCH_DEFAULT_SCALE;
+static unsigned coll_bench_iterations_g = COLL_BENCH_DEFAULT_ITERATIONS;
+static hbool_t  coll_bench_shape_enabled_g[COLL_BENCH_NUM_SHAPES];
+
+static unsigned coll_bench_chunks_g[COLL_BENCH_MAX_LIST_VALUES] = {1, 4, 16};
+static size_t   coll_bench_nchunks_g                            = 3;
+
+static unsigned coll_bench_opt_nums_g[COLL_BENCH_MAX_LIST_VALUES] = {2, 8, 32};
+static size_t   coll_bench_nopt_nums_g                            = 3;
+
+static unsigned coll_bench_opt_ratios_g[COLL_BENCH_MAX_LIST_VALUES] = {0, 50, 100};
+static size_t   coll_bench_nopt_ratios_g                            = 3;
+
+/*
+ * Parses a comma-separated list of unsigned numbers given on the command line.
+ */
+static herr_t
+coll_bench_parse_list(const char *str, unsigned values[], size_t *nvalues)
+{
+    char *end = NULL;
+
+    *nvalues = 0;
+
+    do {
+        unsigned long value;
+
+        value = HDstrtoul(str, &end, 10);
+        if (end == str || (*end != ',' && *end != '\0') || value > UINT_MAX ||
+            *nvalues == COLL_BENCH_MAX_LIST_VALUES)
+            return FAIL;
+
+        values[(*nvalues)++] = (unsigned)value;
+        str                  = end + 1;
+    } while (*end == ',');
+
+    return SUCCEED;
+}
+
+/*
+ * Sets up the dimensions of the dataset for a selection shape. The row
+ * shapes give each process SPACE_DIM1 x SPACE_DIM2 elements, and the
+ * irregular shape gives each process FSPACE_DIM1 x FSPACE_DIM2 elements,
+ * with every dimension but the first of the irregular shape multiplied by
+ * the scale factor.
+ */
+static void
+coll_bench_dims_set(coll_bench_shape_t shape, hsize_t dims[])
+{
+    if (shape == COLL_BENCH_IRREGULAR) {
+        dims[0] = FSPACE_DIM1;
+        dims[1] = (hsize_t)FSPACE_DIM2 * coll_bench_scale_g * (hsize_t)mpi_size_g;
+    }
+    else {
+        dims[0] = (hsize_t)SPACE_DIM1 * coll_bench_scale_g * (hsize_t)mpi_size_g;
+        dims[1] = (hsize_t)SPACE_DIM2 * coll_bench_scale_g;
+    }
+}
+
+/*
+ * Selects the part of the dataset this process accesses for a selection
+ * shape. The row shapes follow ccslab_set in t_coll_chunk.c, with the
+ * single rows selected there grown to as many rows as the scale factor;
+ * the irregular shape is the union of the two hyperslabs selected by
+ * coll_write_test in t_span_tree.c.
+ */
+static void
+coll_bench_select(coll_bench_shape_t shape, hid_t fspace_id)
+{
+    hsize_t scale = coll_bench_scale_g;
+    hsize_t rows  = (hsize_t)SPACE_DIM1 * scale;
+    hsize_t cols  = (hsize_t)SPACE_DIM2 * scale;
+    hsize_t start[RANK], count[RANK], stride[RANK], block[RANK];
+    herr_t  ret;
+
+    switch (shape) {
+        case COLL_BENCH_CONTIGUOUS:
+            /* Each process takes a slab of rows. */
+            block[0]  = rows;
+            block[1]  = cols;
+            stride[0] = 1;
+            stride[1] = 1;
+            count[0]  = 1;
+            count[1]  = 1;
+            start[0]  = (hsize_t)mpi_rank_g * rows;
+            start[1]  = 0;
+
+            break;
+
+        case COLL_BENCH_CHECKERBOARD:
+            /* Each process takes several disjoint blocks of its slab of rows. */
+            block[0]  = 1;
+            block[1]  = 1;
+            stride[0] = 3;
+            stride[1] = 3;
+            count[0]  = rows / (stride[0] * block[0]);
+            count[1]  = cols / (stride[1] * block[1]);
+            start[0]  = (hsize_t)mpi_rank_g * rows;
+            start[1]  = 0;
+
+            break;
+
+        case COLL_BENCH_SELECT_NONE:
+            /* Each process takes a slab of rows, except for the last processes, which select nothing. */
+            block[0]  = rows;
+            block[1]  = cols;
+            stride[0] = 1;
+            stride[1] = 1;
+            count[0]  = ((mpi_rank_g >= MAX(1, (mpi_size_g - 2))) ? 0 : 1);
+            count[1]  = 1;
+            start[0]  = (hsize_t)mpi_rank_g * rows;
+            start[1]  = 0;
+
+            break;
+
+        case COLL_BENCH_UNBALANCED:
+            /* The first two-thirds of the processes select rows from the top half of the
+               dataset; the rest select rows from the bottom half. */
+            block[0]  = scale;
+            count[0]  = 2;
+            stride[0] = rows * (hsize_t)mpi_size_g / 4 + 1;
+            block[1]  = cols;
+            count[1]  = 1;
+            stride[1] = 1;
+            start[1]  = 0;
+            if ((mpi_rank_g * 3) < (mpi_size_g * 2))
+                start[0] = (hsize_t)mpi_rank_g * scale;
+            else
+                start[0] = scale + rows * (hsize_t)mpi_size_g / 2 +
+                           (hsize_t)(mpi_rank_g - 2 * mpi_size_g / 3) * scale;
+
+            break;
+
+        case COLL_BENCH_IN_CHUNK:
+            /* Each process selects the first rows of its slab only. */
+            block[0]  = scale;
+            count[0]  = 1;
+            start[0]  = (hsize_t)mpi_rank_g * rows;
+            stride[0] = 1;
+            block[1]  = cols;
+            count[1]  = 1;
+            stride[1] = 1;
+            start[1]  = 0;
+
+            break;
+
+        case COLL_BENCH_IRREGULAR:
+            /* Strided blocks of the top rows of the dataset... */
+            start[0]  = FHSTART0;
+            start[1]  = FHSTART1 + (hsize_t)mpi_rank_g * FHSTRIDE1 * FHCOUNT1 * scale;
+            stride[0] = FHSTRIDE0;
+            stride[1] = FHSTRIDE1;
+            count[0]  = FHCOUNT0;
+            count[1]  = FHCOUNT1 * scale;
+            block[0]  = FHBLOCK0;
+            block[1]  = FHBLOCK1;
+
+            ret = H5Sselect_hyperslab(fspace_id, H5S_SELECT_SET, start, stride, count, block);
+            VRFY_G((ret >= 0), "hyperslab selection succeeded");
+
+            /* ...along with a single block of the middle rows */
+            start[0]  = SHSTART0;
+            start[1]  = SHSTART1 + SHCOUNT1 * SHBLOCK1 * scale * (hsize_t)mpi_rank_g;
+            stride[0] = SHSTRIDE0;
+            stride[1] = SHSTRIDE1;
+            count[0]  = SHCOUNT0;
+            count[1]  = SHCOUNT1;
+            block[0]  = SHBLOCK0;
+            block[1]  = SHBLOCK1 * scale;
+
+            ret = H5Sselect_hyperslab(fspace_id, H5S_SELECT_OR, start, stride, count, block);
+            VRFY_G((ret >= 0), "hyperslab selection succeeded");
+
+            return;
+
+        case COLL_BENCH_NUM_SHAPES:
+        default:
+            VRFY_G(FALSE, "unknown selection shape");
+            return;
+    }
+
+    ret = H5Sselect_hyperslab(fspace_id, H5S_SELECT_SET, start, stride, count, block);
+    VRFY_G((ret >= 0), "hyperslab selection succeeded");
+}
+
+/*
+ * Sets up the transfer property list for a mode and writes the name of
+ * the mode to name.
+ */
+static void
+coll_bench_set_mode(hid_t dxpl_id, coll_bench_mode_t mode, unsigned value, char *name, size_t name_len)
+{
+    herr_t ret;
+
+    ret = H5Pset_dxpl_mpio(dxpl_id,
+                           mode == COLL_BENCH_INDEPENDENT ? H5FD_MPIO_INDEPENDENT : H5FD_MPIO_COLLECTIVE);
+    VRFY_G((ret >= 0), "H5Pset_dxpl_mpio succeeded");
+
+    switch (mode) {
+        case COLL_BENCH_INDEPENDENT:
+            HDsnprintf(name, name_len, "independent");
+            break;
+
+        case COLL_BENCH_COLLECTIVE:
+            HDsnprintf(name, name_len, "collective");
+            break;
+
+        case COLL_BENCH_COLLECTIVE_IND:
+            ret = H5Pset_dxpl_mpio_collective_opt(dxpl_id, H5FD_MPIO_INDIVIDUAL_IO);
+            VRFY_G((ret >= 0), "H5Pset_dxpl_mpio_collective_opt succeeded");
+            HDsnprintf(name, name_len, "collective-ind-io");
+            break;
+
+        case COLL_BENCH_LINK_HARD:
+            ret = H5Pset_dxpl_mpio_chunk_opt(dxpl_id, H5FD_MPIO_CHUNK_ONE_IO);
+            VRFY_G((ret >= 0), "H5Pset_dxpl_mpio_chunk_opt succeeded");
+            HDsnprintf(name, name_len, "link-hard");
+            break;
+
+        case COLL_BENCH_MULTI_HARD:
+            ret = H5Pset_dxpl_mpio_chunk_opt(dxpl_id, H5FD_MPIO_CHUNK_MULTI_IO);
+            VRFY_G((ret >= 0), "H5Pset_dxpl_mpio_chunk_opt succeeded");
+            HDsnprintf(name, name_len, "multi-hard");
+            break;
+
+        case COLL_BENCH_LINK_THRESHOLD:
+            ret = H5Pset_dxpl_mpio_chunk_opt_num(dxpl_id, value);
+            VRFY_G((ret >= 0), "H5Pset_dxpl_mpio_chunk_opt_num succeeded");
+            HDsnprintf(name, name_len, "link-num=%u", value);
+            break;
+
+        case COLL_BENCH_MULTI_THRESHOLD:
+            /* Make sure multi chunk I/O is chosen without hard-wiring it, which would ignore the ratio */
+            ret = H5Pset_dxpl_mpio_chunk_opt_num(dxpl_id, UINT_MAX);
+            VRFY_G((ret >= 0), "H5Pset_dxpl_mpio_chunk_opt_num succeeded");
+            ret = H5Pset_dxpl_mpio_chunk_opt_ratio(dxpl_id, value);
+            VRFY_G((ret >= 0), "H5Pset_dxpl_mpio_chunk_opt_ratio succeeded");
+            HDsnprintf(name, name_len, "multi-ratio=%u", value);
+            break;
+
+        default:
+            VRFY_G(FALSE, "unknown transfer mode");
+            break;
+    }
+}
+
+/*
+ * Describes the chunk I/O and I/O mode used by the last transfer made
+ * with a transfer property list, as seen by this process. Connectors
+ * other than the native one may not record these, in which case "-" is
+ * returned.
+ */
+static void
+coll_bench_actual_mode(hid_t dxpl_id, char *name, size_t name_len)
+{
+    H5D_mpio_actual_chunk_opt_mode_t chunk_opt_mode;
+    H5D_mpio_actual_io_mode_t        io_mode;
+    const char                      *chunk_opt_name = "-";
+    const char                      *io_name        = "-";
+    herr_t                           chunk_opt_ret, io_ret;
+
+    H5E_BEGIN_TRY
+    {
+        chunk_opt_ret = H5Pget_mpio_actual_chunk_opt_mode(dxpl_id, &chunk_opt_mode);
+        io_ret        = H5Pget_mpio_actual_io_mode(dxpl_id, &io_mode);
+    }
+    H5E_END_TRY;
+
+    if (chunk_opt_ret >= 0) {
+        switch (chunk_opt_mode) {
+            case H5D_MPIO_NO_CHUNK_OPTIMIZATION:
+                chunk_opt_name = "none";
+                break;
+            case H5D_MPIO_LINK_CHUNK:
+                chunk_opt_name = "link";
+                break;
+            case H5D_MPIO_MULTI_CHUNK:
+                chunk_opt_name = "multi";
+                break;
+            default:
+                break;
+        }
+    }
+
+    if (io_ret >= 0) {
+        switch (io_mode) {
+            case H5D_MPIO_NO_COLLECTIVE:
+                io_name = "independent";
+                break;
+            case H5D_MPIO_CHUNK_INDEPENDENT:
+                io_name = "chunk-independent";
+                break;
+            case H5D_MPIO_CHUNK_COLLECTIVE:
+                io_name = "chunk-collective";
+                break;
+            case H5D_MPIO_CHUNK_MIXED:
+                io_name = "chunk-mixed";
+                break;
+            case H5D_MPIO_CONTIGUOUS_COLLECTIVE:
+                io_name = "contiguous-collective";
+                break;
+            default:
+                break;
+        }
+    }
+
+    HDsnprintf(name, name_len, "%s/%s", chunk_opt_name, io_name);
+}
+
+/*
+ * Times a number of writes or reads of the selection with a transfer
+ * property list, returning the time taken by the slowest process in the
+ * fastest iteration.
+ */
+static double
+coll_bench_time_io(hid_t dset_id, hid_t mspace_id, hid_t fspace_id, hid_t dxpl_id, hbool_t write,
+                   DATATYPE *buf)
+{
+    double   best = DBL_MAX;
+    unsigned i;
+
+    for (i = 0; i < coll_bench_iterations_g; i++) {
+        double elapsed, slowest;
+        herr_t ret;
+
+        MPI_Barrier(MPI_COMM_WORLD);
+
+        elapsed = MPI_Wtime();
+        if (write) {
+            ret     = H5Dwrite(dset_id, H5T_NATIVE_INT, mspace_id, fspace_id, dxpl_id, buf);
+            elapsed = MPI_Wtime() - elapsed;
+            VRFY_G((ret >= 0), "H5Dwrite succeeded");
+        }
+        else {
+            ret     = H5Dread(dset_id, H5T_NATIVE_INT, mspace_id, fspace_id, dxpl_id, buf);
+            elapsed = MPI_Wtime() - elapsed;
+            VRFY_G((ret >= 0), "H5Dread succeeded");
+        }
+
+        MPI_Allreduce(&elapsed, &slowest, 1, MPI_DOUBLE, MPI_MAX, MPI_COMM_WORLD);
+        if (slowest < best)
+            best = slowest;
+    }
+
+    return best;
+}
+
+/*
+ * Writes and reads a selection shape on a dataset with the given number
+ * of chunks for each process, or on a contiguous dataset if that number
+ * is 0, with every transfer mode that applies to the dataset's layout.
+ * The selected elements are transferred to and from a contiguous buffer,
+ * so that only the selection in the file differs between the shapes.
+ */
+static void
+coll_bench_run(coll_bench_shape_t shape, unsigned chunks_per_proc)
+{
+    hid_t              fapl_id = H5I_INVALID_HID, file_id = H5I_INVALID_HID, dcpl_id = H5I_INVALID_HID;
+    hid_t              dset_id = H5I_INVALID_HID, fspace_id = H5I_INVALID_HID, mspace_id = H5I_INVALID_HID;
+    hsize_t            dims[RANK], chunk_dims[RANK];
+    hsize_t            npoints;
+    unsigned long long nbytes, total_nbytes;
+    DATATYPE          *wbuf = NULL, *rbuf = NULL;
+    char               layout_name[COLL_BENCH_MODE_NAME_LEN];
+    const char        *best_write_name = NULL, *best_read_name = NULL;
+    char               mode_names[COLL_BENCH_MAX_MODES][COLL_BENCH_MODE_NAME_LEN];
+    double             best_write_bw = 0.0, best_read_bw = 0.0;
+    size_t             nmodes, i;
+    herr_t             ret;
+
+    /* Every mode run on this layout, with the threshold it sets, if any */
+    struct {
+        coll_bench_mode_t mode;
+        unsigned          value;
+    } modes[COLL_BENCH_MAX_MODES];
+
+    nmodes               = 0;
+    modes[nmodes++].mode = COLL_BENCH_INDEPENDENT;
+    modes[nmodes++].mode = COLL_BENCH_COLLECTIVE;
+    modes[nmodes++].mode = COLL_BENCH_COLLECTIVE_IND;
+    if (chunks_per_proc) {
+        modes[nmodes++].mode = COLL_BENCH_LINK_HARD;
+        modes[nmodes++].mode = COLL_BENCH_MULTI_HARD;
+        for (i = 0; i < coll_bench_nopt_nums_g; i++) {
+            modes[nmodes].mode    = COLL_BENCH_LINK_THRESHOLD;
+            modes[nmodes++].value = coll_bench_opt_nums_g[i];
+        }
+        for (i = 0; i < coll_bench_nopt_ratios_g; i++) {
+            modes[nmodes].mode    = COLL_BENCH_MULTI_THRESHOLD;
+            modes[nmodes++].value = coll_bench_opt_ratios_g[i];
+        }
+    }
+
+    fapl_id = create_faccess_plist(MPI_COMM_WORLD, MPI_INFO_NULL, facc_type);
+    VRFY_G((fapl_id >= 0), "create_faccess_plist succeeded");
+
+    file_id = H5Fcreate(FILENAME[0], H5F_ACC_TRUNC, H5P_DEFAULT, fapl_id);
+    VRFY_G((file_id >= 0), "H5Fcreate succeeded");
+
+    coll_bench_dims_set(shape, dims);
+
+    fspace_id = H5Screate_simple(RANK, dims, NULL);
+    VRFY_G((fspace_id >= 0), "file dataspace created succeeded");
+
+    dcpl_id = H5Pcreate(H5P_DATASET_CREATE);
+    VRFY_G((dcpl_id >= 0), "H5Pcreate succeeded");
+
+    if (chunks_per_proc) {
+        /* Split the longest dimension into the given number of chunks for each process */
+        int split = dims[0] >= dims[1] ? 0 : 1;
+
+        chunk_dims[0]     = dims[0];
+        chunk_dims[1]     = dims[1];
+        chunk_dims[split] = MAX(1, dims[split] / ((hsize_t)mpi_size_g * chunks_per_proc));
+
+        ret = H5Pset_chunk(dcpl_id, RANK, chunk_dims);
+        VRFY_G((ret >= 0), "chunk creation property list succeeded");
+
+        HDsnprintf(layout_name, sizeof(layout_name), "chunked x%u", chunks_per_proc);
+    }
+    else
+        HDsnprintf(layout_name, sizeof(layout_name), "contiguous");
+
+    dset_id = H5Dcreate2(file_id, COLL_BENCH_DSET_NAME, H5T_NATIVE_INT, fspace_id, H5P_DEFAULT, dcpl_id,
+                         H5P_DEFAULT);
+    VRFY_G((dset_id >= 0), "dataset created succeeded");
+
+    coll_bench_select(shape, fspace_id);
+
+    npoints = (hsize_t)H5Sget_select_npoints(fspace_id);
+
+    mspace_id = H5Screate_simple(1, &npoints, NULL);
+    VRFY_G((mspace_id >= 0), "memory dataspace created succeeded");
+
+    wbuf = (DATATYPE *)HDmalloc(MAX(npoints, 1) * sizeof(DATATYPE));
+    VRFY_G((wbuf != NULL), "HDmalloc succeeded");
+    rbuf = (DATATYPE *)HDmalloc(MAX(npoints, 1) * sizeof(DATATYPE));
+    VRFY_G((rbuf != NULL), "HDmalloc succeeded");
+
+    for (i = 0; i < npoints; i++)
+        wbuf[i] = (DATATYPE)((hsize_t)mpi_rank_g * npoints + i);
+
+    nbytes = (unsigned long long)(npoints * sizeof(DATATYPE));
+    MPI_Allreduce(&nbytes, &total_nbytes, 1, MPI_UNSIGNED_LONG_LONG, MPI_SUM, MPI_COMM_WORLD);
+
+    for (i = 0; i < nmodes; i++) {
+        hid_t  dxpl_id;
+        double write_time, read_time, write_bw, read_bw;
+        char   actual_name[COLL_BENCH_ACTUAL_NAME_LEN];
+
+        dxpl_id = H5Pcreate(H5P_DATASET_XFER);
+        VRFY_G((dxpl_id >= 0), "H5Pcreate succeeded");
+
+        coll_bench_set_mode(dxpl_id, modes[i].mode, modes[i].value, mode_names[i], COLL_BENCH_MODE_NAME_LEN);
+
+        write_time = coll_bench_time_io(dset_id, mspace_id, fspace_id, dxpl_id, TRUE, wbuf);
+        coll_bench_actual_mode(dxpl_id, actual_name, sizeof(actual_name));
+
+        HDmemset(rbuf, 0, MAX(npoints, 1) * sizeof(DATATYPE));
+        read_time = coll_bench_time_io(dset_id, mspace_id, fspace_id, dxpl_id, FALSE, rbuf);
+
+        if (HDmemcmp(wbuf, rbuf, npoints * sizeof(DATATYPE))) {
+            HDprintf("Proc %d: data read back with %s I/O doesn't match data written\n", mpi_rank_g,
+                     mode_names[i]);
+            nerrors++;
+        }
+
+        ret = H5Pclose(dxpl_id);
+        VRFY_G((ret >= 0), "H5Pclose succeeded");
+
+        write_bw = (double)total_nbytes / (1024.0 * 1024.0) / write_time;
+        read_bw  = (double)total_nbytes / (1024.0 * 1024.0) / read_time;
+
+        if (write_bw > best_write_bw) {
+            best_write_bw   = write_bw;
+            best_write_name = mode_names[i];
+        }
+        if (read_bw > best_read_bw) {
+            best_read_bw   = read_bw;
+            best_read_name = mode_names[i];
+        }
+
+        if (MAIN_PROCESS)
+            HDprintf("    %-12s  %-12s  %-18s  %12.2f  %12.2f  %s\n", coll_bench_shape_names[shape],
+                     layout_name, mode_names[i], write_bw, read_bw, actual_name);
+    }
+
+    if (MAIN_PROCESS)
+        HDprintf("    %-12s  %-12s  fastest write: %s, fastest read: %s\n\n", coll_bench_shape_names[shape],
+                 layout_name, best_write_name, best_read_name);
+
+    HDfree(wbuf);
+    HDfree(rbuf);
+
+    ret = H5Sclose(mspace_id);
+    VRFY_G((ret >= 0), "H5Sclose succeeded");
+    ret = H5Sclose(fspace_id);
+    VRFY_G((ret >= 0), "H5Sclose succeeded");
+    ret = H5Pclose(dcpl_id);
+    VRFY_G((ret >= 0), "H5Pclose succeeded");
+    ret = H5Dclose(dset_id);
+    VRFY_G((ret >= 0), "H5Dclose succeeded");
+    ret = H5Fclose(file_id);
+    VRFY_G((ret >= 0), "H5Fclose succeeded");
+    ret = H5Pclose(fapl_id);
+    VRFY_G((ret >= 0), "H5Pclose succeeded");
+}
+
+/*
+ * Create the appropriate File access property list
+ */
+hid_t
+create_faccess_plist(MPI_Comm comm, MPI_Info info, int l_facc_type)
+{
+    hid_t  ret_pl = -1;
+    herr_t ret; /* generic return value */
+
+    ret_pl = H5Pcreate(H5P_FILE_ACCESS);
+    VRFY_G((ret_pl >= 0), "H5P_FILE_ACCESS");
+
+    if (l_facc_type == FACC_DEFAULT)
+        return (ret_pl);
+
+    /* set Parallel access with communicator */
+    ret = H5Pset_fapl_mpio(ret_pl, comm, info);
+    VRFY_G((ret >= 0), "");
+    ret = H5Pset_all_coll_metadata_ops(ret_pl, TRUE);
+    VRFY_G((ret >= 0), "");
+    ret = H5Pset_coll_metadata_write(ret_pl, TRUE);
+    VRFY_G((ret >= 0), "");
+
+    return (ret_pl);
+}
+
+static void
+usage(void)
+{
+    HDprintf("Usage: t_coll_bench [<shape> ...] [--scale <n>] [--iterations <n>] [--chunks <list>]\n"
+             "                    [--opt-num <list>] [--opt-ratio <list>]\n"
+             "\n"
+             "    <shape>             Run only the given selection shapes: contiguous, checkerboard,\n"
+             "                        select-none, unbalanced, in-chunk or irregular\n"
+             "    --scale <n>         Grow each dimension of the selections by <n> (default %d)\n"
+             "    --iterations <n>    Time the best of <n> writes and reads of each mode (default %d)\n"
+             "    --chunks <list>     Numbers of chunks per process of the chunked datasets\n"
+             "                        (default 1,4,16)\n"
+             "    --opt-num <list>    Link chunk thresholds, in average chunks per process\n"
+             "                        (default 2,8,32)\n"
+             "    --opt-ratio <list>  Multi chunk collective ratios, in percent of processes\n"
+             "                        (default 0,50,100)\n",
+             COLL_BENCH_DEFAULT_SCALE, COLL_BENCH_DEFAULT_ITERATIONS);
+}
+
+int
+main(int argc, char **argv)
+{
+    hid_t   acc_plist      = H5I_INVALID_HID;
+    hbool_t shape_selected = FALSE;
+    size_t  i;
+    int     shape;
+
+    MPI_Init(&argc, &argv);
+    MPI_Comm_size(MPI_COMM_WORLD, &mpi_size_g);
+    MPI_Comm_rank(MPI_COMM_WORLD, &mpi_rank_g);
+
+    /* Attempt to turn off atexit post processing so that in case errors
+     * happen during the test and the process is aborted, it will not get
+     * hang in the atexit post processing in which it may try to make MPI
+     * calls.  By then, MPI calls may not work.
+     */
+    if (H5dont_atexit() < 0)
+        HDprintf("Failed to turn off atexit processing. Continue.\n");
+
+    for (shape = 0; shape < COLL_BENCH_NUM_SHAPES; shape++)
+        coll_bench_shape_enabled_g[shape] = TRUE;
+
+    for (int arg = 1; arg < argc; arg++) {
+        herr_t parse_ret = SUCCEED;
+
+        if (!HDstrcmp(argv[arg], "--scale") || !HDstrcmp(argv[arg], "--iterations")) {
+            char         *end   = NULL;
+            unsigned long value = 0;
+
+            if (arg + 1 < argc)
+                value = HDstrtoul(argv[arg + 1], &end, 10);
+            if (!end || end == argv[arg + 1] || *end != '\0' || value == 0 || value > UINT_MAX)
+                parse_ret = FAIL;
+            else if (!HDstrcmp(argv[arg], "--scale"))
+                coll_bench_scale_g = (hsize_t)value;
+            else
+                coll_bench_iterations_g = (unsigned)value;
+            arg++;
+        }
+        else if (!HDstrcmp(argv[arg], "--chunks")) {
+            if (++arg >= argc ||
+                coll_bench_parse_list(argv[arg], coll_bench_chunks_g, &coll_bench_nchunks_g) < 0)
+                parse_ret = FAIL;
+            for (i = 0; parse_ret >= 0 && i < coll_bench_nchunks_g; i++)
+                if (coll_bench_chunks_g[i] == 0)
+                    parse_ret = FAIL;
+        }
+        else if (!HDstrcmp(argv[arg], "--opt-num")) {
+            if (++arg >= argc ||
+                coll_bench_parse_list(argv[arg], coll_bench_opt_nums_g, &coll_bench_nopt_nums_g) < 0)
+                parse_ret = FAIL;
+        }
+        else if (!HDstrcmp(argv[arg], "--opt-ratio")) {
+            if (++arg >= argc ||
+                coll_bench_parse_list(argv[arg], coll_bench_opt_ratios_g, &coll_bench_nopt_ratios_g) < 0)
+                parse_ret = FAIL;
+            for (i = 0; parse_ret >= 0 && i < coll_bench_nopt_ratios_g; i++)
+                if (coll_bench_opt_ratios_g[i] > 100)
+                    parse_ret = FAIL;
+        }
+        else {
+            for (shape = 0; shape < COLL_BENCH_NUM_SHAPES; shape++)
+                if (!HDstrcmp(argv[arg], coll_bench_shape_names[shape]))
+                    break;
+
+            if (shape == COLL_BENCH_NUM_SHAPES)
+                parse_ret = FAIL;
+            else {
+                /* Run only specific selection shapes */
+                if (!shape_selected) {
+                    HDmemset(coll_bench_shape_enabled_g, 0, sizeof(coll_bench_shape_enabled_g));
+                    shape_selected = TRUE;
+                }
+                coll_bench_shape_enabled_g[shape] = TRUE;
+            }
+        }
+
+        if (parse_ret < 0) {
+            if (MAIN_PROCESS) {
+                HDfprintf(stderr, "Invalid argument '%s'\n", argv[MIN(arg, argc - 1)]);
+                usage();
+            }
+            MPI_Finalize();
+            HDexit(EXIT_FAILURE);
+        }
+    }
+
+    acc_plist = create_faccess_plist(MPI_COMM_WORLD, MPI_INFO_NULL, facc_type);
+
+    /* Get the capability flag of the VOL connector being used */
+    if (H5Pget_vol_cap_flags(acc_plist, &vol_cap_flags_g) < 0) {
+        if (MAIN_PROCESS)
+            HDprintf("Failed to get the capability flag of the VOL connector being used\n");
+
+        MPI_Finalize();
+        return 0;
+    }
+
+    /* Make sure the connector supports the API functions being tested.  This test only
+     * uses a few API functions, such as H5Fcreate/close/delete, H5Dcreate/write/read/close. */
+    if (!(vol_cap_flags_g & H5VL_CAP_FLAG_FILE_BASIC) || !(vol_cap_flags_g & H5VL_CAP_FLAG_DATASET_BASIC)) {
+        if (MAIN_PROCESS)
+            HDprintf("API functions for basic file and dataset aren't supported with this connector\n");
+
+        MPI_Finalize();
+        return 0;
+    }
+
+    if (MAIN_PROCESS) {
+        HDprintf("Collective I/O benchmark: %d processes, scale %llu, best of %u iterations\n\n", mpi_size_g,
+                 (unsigned long long)coll_bench_scale_g, coll_bench_iterations_g);
+        HDprintf("    %-12s  %-12s  %-18s  %12s  %12s  %s\n", "shape", "layout", "mode", "write MB/s",
+                 "read MB/s", "actual chunk/io mode");
+    }
+
+    for (shape = 0; shape < COLL_BENCH_NUM_SHAPES; shape++) {
+        if (!coll_bench_shape_enabled_g[shape])
+            continue;
+
+        coll_bench_run((coll_bench_shape_t)shape, 0);
+        MPI_Barrier(MPI_COMM_WORLD);
+
+        for (i = 0; i < coll_bench_nchunks_g; i++) {
+            coll_bench_run((coll_bench_shape_t)shape, coll_bench_chunks_g[i]);
+            MPI_Barrier(MPI_COMM_WORLD);
+        }
+    }
+
+    if (mpi_rank_g == 0) {
+        hid_t fapl_id = H5Pcreate(H5P_FILE_ACCESS);
+
+        H5Pset_fapl_mpio(fapl_id, MPI_COMM_SELF, MPI_INFO_NULL);
+
+        H5E_BEGIN_TRY
+        {
+            H5Fdelete(FILENAME[0], fapl_id);
+        }
+        H5E_END_TRY;
+
+        H5Pclose(fapl_id);
+    }
+
+    H5Pclose(acc_plist);
+
+    /* close HDF5 library */
+    H5close();
+
+    MPI_Finalize();
+
+    return nerrors ? 1 : 0;
+}
@@ -0,0 +1,566 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * Copyright by The HDF Group.                                               *
+ * All rights reserved.                                                      *
+ *                                                                           *
+ * This file is part of HDF5.  The full HDF5 copyright notice, including     *
+ * terms governing use, modification, and redistribution, is contained in    *
+ * the COPYING file, which can be found at the root of the source code       *
+ * distribution tree, or in https://www.hdfgroup.org/licenses.               *
+ * If you do not have access to either file, you may request a copy from     *
+ * help@hdfgroup.org.                                                        *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+/*
+ * A benchmark of collective metadata reads, built on the group trees of
+ * multiple_group_write and multiple_group_read in t_mdset.c. Those tests
+ * create NGROUPS groups under the root group and a chain of GROUP_DEPTH
+ * nested groups, and check that every process reads the same objects
+ * back; t_coll_md_read.c checks that collective metadata reads, enabled
+ * with H5Pset_all_coll_metadata_ops and H5Pset_coll_metadata_write, don't
+ * hang or corrupt the file. Here a file holding a wide tree and a deep
+ * tree of groups, each group with a number of attributes, is created
+ * once, and then reopened by a growing number of processes, with
+ * collective metadata operations off and on, to time:
+ *
+ * - opening the file
+ * - opening every group of a tree by its full path
+ * - visiting every link of a tree with H5Lvisit2
+ * - reading every attribute of every group of a tree
+ *
+ * Process 0 prints the time the slowest process took for each step in
+ * the fastest iteration. Without collective metadata reads every process
+ * reads the same metadata from the file, so the time of these steps
+ * grows with the number of processes, while with them one process reads
+ * the metadata and broadcasts it to the others.
+ */
+
+#include <float.h>
+
+#include "hdf5.h"
+#include "testphdf5.h"
+
+const char *FILENAME[2] = {"coll_md_bench.h5", NULL};
+
+uint64_t vol_cap_flags_g;
+
+int        facc_type       = FACC_MPIO; /*Test file access type */
+int        dxfer_coll_type = DXFER_COLLECTIVE_IO;
+int        nerrors         = 0;
+static int mpi_size_g, mpi_rank_g;
+
+#define MAIN_PROCESS (mpi_rank_g == 0) /* define process 0 as main process */
+
+#define COLL_MD_BENCH_DEFAULT_GROUPS     256 /* NGROUPS of t_mdset.c */
+#define COLL_MD_BENCH_DEFAULT_DEPTH      32  /* GROUP_DEPTH of t_mdset.c */
+#define COLL_MD_BENCH_DEFAULT_ATTRS      4
+#define COLL_MD_BENCH_DEFAULT_ITERATIONS 3
+#define COLL_MD_BENCH_MAX_LIST_VALUES    32
+#define COLL_MD_BENCH_ATTR_NELEMS        8 /* As written by write_attribute in t_mdset.c */
+#define COLL_MD_BENCH_NAME_LEN           32
+
+/* The shapes of the group trees */
+typedef enum coll_md_bench_tree_t {
+    COLL_MD_BENCH_WIDE, /* All groups under one parent, as in multiple_group_write */
+    COLL_MD_BENCH_DEEP, /* A chain of nested groups, as in create_group_recursive */
+    COLL_MD_BENCH_NUM_TREES
+} coll_md_bench_tree_t;
+
+static const char *const coll_md_bench_tree_names[] = {"wide", "deep"};
+
+/* The times of the steps of a run */
+typedef struct coll_md_bench_times_t {
+    double file_open;
+    double group_open;
+    double visit;
+    double attr_read;
+} coll_md_bench_times_t;
+
+/* Benchmark parameters, set from the command line */
+static unsigned coll_md_bench_groups_g     = COLL_MD_BENCH_DEFAULT_GROUPS;
+static unsigned coll_md_bench_depth_g      = COLL_MD_BENCH_DEFAULT_DEPTH;
+static unsigned coll_md_bench_attrs_g      = COLL_MD_BENCH_DEFAULT_ATTRS;
+static unsigned coll_md_bench_iterations_g = COLL_MD_BENCH_DEFAULT_ITERATIONS;
+
+static unsigned coll_md_bench_procs_g[COLL_MD_BENCH_MAX_LIST_VALUES];
+static size_t   coll_md_bench_nprocs_g = 0;
+
+/*
+ * Parses a comma-separated list of unsigned numbers given on the command line.
+ */
+static herr_t
+coll_md_bench_parse_list(const char *str, unsigned values[], size_t *nvalues)
+{
+    char *end = NULL;
+
+    *nvalues = 0;
+
+    do {
+        unsigned long value;
+
+        value = HDstrtoul(str, &end, 10);
+        if (end == str || (*end != ',' && *end != '\0') || value == 0 || value > UINT_MAX ||
+            *nvalues == COLL_MD_BENCH_MAX_LIST_VALUES)
+            return FAIL;
+
+        values[(*nvalues)++] = (unsigned)value;
+        str                  = end + 1;
+    } while (*end == ',');
+
+    return SUCCEED;
+}
+
+/*
+ * Returns the number of groups in a tree.
+ */
+static unsigned
+coll_md_bench_ngroups(coll_md_bench_tree_t tree)
+{
+    return tree == COLL_MD_BENCH_WIDE ? coll_md_bench_groups_g : coll_md_bench_depth_g;
+}
+
+/*
+ * Returns the full path of each group of a tree. The wide tree holds
+ * "/wide/group<n>" and the deep tree "/deep/1th_child_group/2th_child_group/..."
+ */
+static char **
+coll_md_bench_paths(coll_md_bench_tree_t tree)
+{
+    unsigned ngroups = coll_md_bench_ngroups(tree);
+    char   **paths;
+    unsigned i;
+
+    paths = (char **)HDcalloc(ngroups, sizeof(char *));
+    VRFY_G((paths != NULL), "HDcalloc succeeded");
+
+    for (i = 0; i < ngroups; i++) {
+        size_t len;
+
+        if (tree == COLL_MD_BENCH_WIDE) {
+            len      = sizeof("/wide/") + COLL_MD_BENCH_NAME_LEN;
+            paths[i] = (char *)HDmalloc(len);
+            VRFY_G((paths[i] != NULL), "HDmalloc succeeded");
+            HDsnprintf(paths[i], len, "/wide/group%u", i);
+        }
+        else {
+            const char *parent = i ? paths[i - 1] : "/deep";
+
+            len      = HDstrlen(parent) + 1 + COLL_MD_BENCH_NAME_LEN;
+            paths[i] = (char *)HDmalloc(len);
+            VRFY_G((paths[i] != NULL), "HDmalloc succeeded");
+            HDsnprintf(paths[i], len, "%s/%uth_child_group", parent, i + 1);
+        }
+    }
+
+    return paths;
+}
+
+static void
+coll_md_bench_free_paths(coll_md_bench_tree_t tree, char **paths)
+{
+    unsigned i;
+
+    for (i = 0; i < coll_md_bench_ngroups(tree); i++)
+        HDfree(paths[i]);
+    HDfree(paths);
+}
+
+/*
+ * Creates the groups of a tree collectively, each with a number of
+ * attributes holding values derived from the group and attribute numbers.
+ */
+static void
+coll_md_bench_create_tree(hid_t file_id, coll_md_bench_tree_t tree)
+{
+    hsize_t  dims[1] = {COLL_MD_BENCH_ATTR_NELEMS};
+    hid_t    gid = H5I_INVALID_HID, aid = H5I_INVALID_HID, sid = H5I_INVALID_HID;
+    char   **paths;
+    char     attr_name[COLL_MD_BENCH_NAME_LEN];
+    int      attr_data[COLL_MD_BENCH_ATTR_NELEMS];
+    unsigned i, j;
+    int      k;
+    herr_t   ret;
+
+    paths = coll_md_bench_paths(tree);
+
+    gid = H5Gcreate2(file_id, coll_md_bench_tree_names[tree], H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT);
+    VRFY_G((gid >= 0), "H5Gcreate2 succeeded");
+    ret = H5Gclose(gid);
+    VRFY_G((ret >= 0), "H5Gclose succeeded");
+
+    sid = H5Screate_simple(1, dims, NULL);
+    VRFY_G((sid >= 0), "H5Screate_simple succeeded");
+
+    for (i = 0; i < coll_md_bench_ngroups(tree); i++) {
+        gid = H5Gcreate2(file_id, paths[i], H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT);
+        VRFY_G((gid >= 0), "H5Gcreate2 succeeded");
+
+        for (j = 0; j < coll_md_bench_attrs_g; j++) {
+            HDsnprintf(attr_name, sizeof(attr_name), "attribute%u", j);
+            for (k = 0; k < COLL_MD_BENCH_ATTR_NELEMS; k++)
+                attr_data[k] = (int)(i * 1000 + j * 10) + k;
+
+            aid = H5Acreate2(gid, attr_name, H5T_NATIVE_INT, sid, H5P_DEFAULT, H5P_DEFAULT);
+            VRFY_G((aid >= 0), "H5Acreate2 succeeded");
+            ret = H5Awrite(aid, H5T_NATIVE_INT, attr_data);
+            VRFY_G((ret >= 0), "H5Awrite succeeded");
+            ret = H5Aclose(aid);
+            VRFY_G((ret >= 0), "H5Aclose succeeded");
+        }
+
+        ret = H5Gclose(gid);
+        VRFY_G((ret >= 0), "H5Gclose succeeded");
+    }
+
+    ret = H5Sclose(sid);
+    VRFY_G((ret >= 0), "H5Sclose succeeded");
+
+    coll_md_bench_free_paths(tree, paths);
+}
+
+/*
+ * Counts the links visited by H5Lvisit2.
+ */
+static herr_t
+coll_md_bench_visit_cb(hid_t H5_ATTR_UNUSED group_id, const char H5_ATTR_UNUSED *name,
+                       const H5L_info2_t H5_ATTR_UNUSED *info, void *op_data)
+{
+    (*(unsigned *)op_data)++;
+
+    return H5_ITER_CONT;
+}
+
+/*
+ * Returns the time taken by the slowest process of a communicator, given
+ * the time taken by this one.
+ */
+static double
+coll_md_bench_slowest(double elapsed, MPI_Comm comm)
+{
+    double slowest = 0.0;
+
+    MPI_Allreduce(&elapsed, &slowest, 1, MPI_DOUBLE, MPI_MAX, comm);
+
+    return slowest;
+}
+
+/*
+ * Reopens the file on the processes of a communicator, with collective
+ * metadata operations on or off, and times opening it, opening every
+ * group of a tree, visiting the tree and reading every attribute, keeping
+ * the fastest time of each step over the iterations.
+ */
+static void
+coll_md_bench_run(coll_md_bench_tree_t tree, MPI_Comm comm, hbool_t coll_md, coll_md_bench_times_t *best)
+{
+    unsigned ngroups = coll_md_bench_ngroups(tree);
+    hid_t    fapl_id = H5I_INVALID_HID, file_id = H5I_INVALID_HID, tree_id = H5I_INVALID_HID;
+    hid_t   *gids    = NULL;
+    char   **paths;
+    char     attr_name[COLL_MD_BENCH_NAME_LEN];
+    int      attr_data[COLL_MD_BENCH_ATTR_NELEMS];
+    unsigned iter, i, j, nlinks;
+    int      k;
+    double   elapsed;
+    herr_t   ret;
+
+    best->file_open = best->group_open = best->visit = best->attr_read = DBL_MAX;
+
+    paths = coll_md_bench_paths(tree);
+
+    gids = (hid_t *)HDmalloc(ngroups * sizeof(hid_t));
+    VRFY_G((gids != NULL), "HDmalloc succeeded");
+
+    fapl_id = H5Pcreate(H5P_FILE_ACCESS);
+    VRFY_G((fapl_id >= 0), "H5Pcreate succeeded");
+    ret = H5Pset_fapl_mpio(fapl_id, comm, MPI_INFO_NULL);
+    VRFY_G((ret >= 0), "H5Pset_fapl_mpio succeeded");
+    ret = H5Pset_all_coll_metadata_ops(fapl_id, coll_md);
+    VRFY_G((ret >= 0), "H5Pset_all_coll_metadata_ops succeeded");
+    ret = H5Pset_coll_metadata_write(fapl_id, coll_md);
+    VRFY_G((ret >= 0), "H5Pset_coll_metadata_write succeeded");
+
+    /* Each iteration reopens the file, so that no metadata is cached */
+    for (iter = 0; iter < coll_md_bench_iterations_g; iter++) {
+        /* File open */
+        MPI_Barrier(comm);
+        elapsed = MPI_Wtime();
+        file_id = H5Fopen(FILENAME[0], H5F_ACC_RDONLY, fapl_id);
+        elapsed = MPI_Wtime() - elapsed;
+        VRFY_G((file_id >= 0), "H5Fopen succeeded");
+        elapsed         = coll_md_bench_slowest(elapsed, comm);
+        best->file_open = MIN(best->file_open, elapsed);
+
+        /* Group open */
+        MPI_Barrier(comm);
+        elapsed = MPI_Wtime();
+        for (i = 0; i < ngroups; i++)
+            if ((gids[i] = H5Gopen2(file_id, paths[i], H5P_DEFAULT)) < 0)
+                break;
+        elapsed = MPI_Wtime() - elapsed;
+        VRFY_G((i == ngroups), "H5Gopen2 succeeded");
+        elapsed          = coll_md_bench_slowest(elapsed, comm);
+        best->group_open = MIN(best->group_open, elapsed);
+
+        /* Link visit */
+        tree_id = H5Gopen2(file_id, coll_md_bench_tree_names[tree], H5P_DEFAULT);
+        VRFY_G((tree_id >= 0), "H5Gopen2 succeeded");
+
+        nlinks = 0;
+        MPI_Barrier(comm);
+        elapsed = MPI_Wtime();
+        ret     = H5Lvisit2(tree_id, H5_INDEX_NAME, H5_ITER_INC, coll_md_bench_visit_cb, &nlinks);
+        elapsed = MPI_Wtime() - elapsed;
+        VRFY_G((ret >= 0), "H5Lvisit2 succeeded");
+        VRFY_G((nlinks == ngroups), "H5Lvisit2 visited every group");
+        elapsed     = coll_md_bench_slowest(elapsed, comm);
+        best->visit = MIN(best->visit, elapsed);
+
+        ret = H5Gclose(tree_id);
+        VRFY_G((ret >= 0), "H5Gclose succeeded");
+
+        /* Attribute read */
+        MPI_Barrier(comm);
+        elapsed = MPI_Wtime();
+        for (i = 0; i < ngroups; i++) {
+            for (j = 0; j < coll_md_bench_attrs_g; j++) {
+                hid_t aid;
+
+                HDsnprintf(attr_name, sizeof(attr_name), "attribute%u", j);
+
+                aid = H5Aopen(gids[i], attr_name, H5P_DEFAULT);
+                VRFY_G((aid >= 0), "H5Aopen succeeded");
+                ret = H5Aread(aid, H5T_NATIVE_INT, attr_data);
+                VRFY_G((ret >= 0), "H5Aread succeeded");
+                ret = H5Aclose(aid);
+                VRFY_G((ret >= 0), "H5Aclose succeeded");
+
+                /* Checking one element keeps the timing close to the cost of the reads */
+                k = (int)(i + j) % COLL_MD_BENCH_ATTR_NELEMS;
+                VRFY_G((attr_data[k] == (int)(i * 1000 + j * 10) + k), "attribute data verification");
+            }
+        }
+        elapsed         = MPI_Wtime() - elapsed;
+        elapsed         = coll_md_bench_slowest(elapsed, comm);
+        best->attr_read = MIN(best->attr_read, elapsed);
+
+        for (i = 0; i < ngroups; i++) {
+            ret = H5Gclose(gids[i]);
+            VRFY_G((ret >= 0), "H5Gclose succeeded");
+        }
+        ret = H5Fclose(file_id);
+        VRFY_G((ret >= 0), "H5Fclose succeeded");
+    }
+
+    ret = H5Pclose(fapl_id);
+    VRFY_G((ret >= 0), "H5Pclose succeeded");
+
+    HDfree(gids);
+    coll_md_bench_free_paths(tree, paths);
+}
+
+/*
+ * Create the appropriate File access property list
+ */
+hid_t
+create_faccess_plist(MPI_Comm comm, MPI_Info info, int l_facc_type)
+{
+    hid_t  ret_pl = -1;
+    herr_t ret; /* generic return value */
+
+    ret_pl = H5Pcreate(H5P_FILE_ACCESS);
+    VRFY_G((ret_pl >= 0), "H5P_FILE_ACCESS");
+
+    if (l_facc_type == FACC_DEFAULT)
+        return (ret_pl);
+
+    /* set Parallel access with communicator */
+    ret = H5Pset_fapl_mpio(ret_pl, comm, info);
+    VRFY_G((ret >= 0), "");
+    ret = H5Pset_all_coll_metadata_ops(ret_pl, TRUE);
+    VRFY_G((ret >= 0), "");
+    ret = H5Pset_coll_metadata_write(ret_pl, TRUE);
+    VRFY_G((ret >= 0), "");
+
+    return (ret_pl);
+}
+
+static void
+usage(void)
+{
+    HDprintf("Usage: t_coll_md_bench [--groups <n>] [--depth <n>] [--attrs <n>] [--iterations <n>]\n"
+             "                       [--procs <list>]\n"
+             "\n"
+             "    --groups <n>        Number of groups of the wide tree (default %d)\n"
+             "    --depth <n>         Number of nested groups of the deep tree (default %d)\n"
+             "    --attrs <n>         Number of attributes of each group (default %d)\n"
+             "    --iterations <n>    Time the best of <n> runs of each step (default %d)\n"
+             "    --procs <list>      Numbers of processes to reopen the file with\n"
+             "                        (default 1, 2, 4, ... up to all of them)\n",
+             COLL_MD_BENCH_DEFAULT_GROUPS, COLL_MD_BENCH_DEFAULT_DEPTH, COLL_MD_BENCH_DEFAULT_ATTRS,
+             COLL_MD_BENCH_DEFAULT_ITERATIONS);
+}
+
+int
+main(int argc, char **argv)
+{
+    hid_t  acc_plist = H5I_INVALID_HID;
+    hid_t  file_id   = H5I_INVALID_HID;
+    herr_t ret;
+    size_t i;
+    int    tree;
+
+    MPI_Init(&argc, &argv);
+    MPI_Comm_size(MPI_COMM_WORLD, &mpi_size_g);
+    MPI_Comm_rank(MPI_COMM_WORLD, &mpi_rank_g);
+
+    /* Attempt to turn off atexit post processing so that in case errors
+     * happen during the test and the process is aborted, it will not get
+     * hang in the atexit post processing in which it may try to make MPI
+     * calls.  By then, MPI calls may not work.
+     */
+    if (H5dont_atexit() < 0)
+        HDprintf("Failed to turn off atexit processing. Continue.\n");
+
+    for (int arg = 1; arg < argc; arg++) {
+        herr_t parse_ret = SUCCEED;
+
+        if (!HDstrcmp(argv[arg], "--groups") || !HDstrcmp(argv[arg], "--depth") ||
+            !HDstrcmp(argv[arg], "--attrs") || !HDstrcmp(argv[arg], "--iterations")) {
+            char         *end   = NULL;
+            unsigned long value = 0;
+
+            if (arg + 1 < argc)
+                value = HDstrtoul(argv[arg + 1], &end, 10);
+            if (!end || end == argv[arg + 1] || *end != '\0' || value == 0 || value > UINT_MAX)
+                parse_ret = FAIL;
+            else if (!HDstrcmp(argv[arg], "--groups"))
+                coll_md_bench_groups_g = (unsigned)value;
+            else if (!HDstrcmp(argv[arg], "--depth"))
+                coll_md_bench_depth_g = (unsigned)value;
+            else if (!HDstrcmp(argv[arg], "--attrs"))
+                coll_md_bench_attrs_g = (unsigned)value;
+            else
+                coll_md_bench_iterations_g = (unsigned)value;
+            arg++;
+        }
+        else if (!HDstrcmp(argv[arg], "--procs")) {
+            if (++arg >= argc ||
+                coll_md_bench_parse_list(argv[arg], coll_md_bench_procs_g, &coll_md_bench_nprocs_g) < 0)
+                parse_ret = FAIL;
+            for (i = 0; parse_ret >= 0 && i < coll_md_bench_nprocs_g; i++)
+                if (coll_md_bench_procs_g[i] > (unsigned)mpi_size_g)
+                    parse_ret = FAIL;
+        }
+        else
+            parse_ret = FAIL;
+
+        if (parse_ret < 0) {
+            if (MAIN_PROCESS) {
+                HDfprintf(stderr, "Invalid argument '%s'\n", argv[MIN(arg, argc - 1)]);
+                usage();
+            }
+            MPI_Finalize();
+            HDexit(EXIT_FAILURE);
+        }
+    }
+
+    /* By default, double the number of processes up to all of them */
+    if (coll_md_bench_nprocs_g == 0) {
+        unsigned nprocs;
+
+        for (nprocs = 1; nprocs < (unsigned)mpi_size_g; nprocs *= 2)
+            coll_md_bench_procs_g[coll_md_bench_nprocs_g++] = nprocs;
+        coll_md_bench_procs_g[coll_md_bench_nprocs_g++] = (unsigned)mpi_size_g;
+    }
+
+    acc_plist = create_faccess_plist(MPI_COMM_WORLD, MPI_INFO_NULL, facc_type);
+
+    /* Get the capability flag of the VOL connector being used */
+    if (H5Pget_vol_cap_flags(acc_plist, &vol_cap_flags_g) < 0) {
+        if (MAIN_PROCESS)
+            HDprintf("Failed to get the capability flag of the VOL connector being used\n");
+
+        MPI_Finalize();
+        return 0;
+    }
+
+    /* Make sure the connector supports the API functions being tested */
+    if (!(vol_cap_flags_g & H5VL_CAP_FLAG_FILE_BASIC) || !(vol_cap_flags_g & H5VL_CAP_FLAG_GROUP_BASIC) ||
+        !(vol_cap_flags_g & H5VL_CAP_FLAG_LINK_MORE) || !(vol_cap_flags_g & H5VL_CAP_FLAG_ATTR_BASIC)) {
+        if (MAIN_PROCESS)
+            HDprintf("API functions for basic file, group, or attribute, or link more aren't supported with "
+                     "this connector\n");
+
+        MPI_Finalize();
+        return 0;
+    }
+
+    /* Create the wide and deep trees once, on all processes */
+    file_id = H5Fcreate(FILENAME[0], H5F_ACC_TRUNC, H5P_DEFAULT, acc_plist);
+    VRFY_G((file_id >= 0), "H5Fcreate succeeded");
+    for (tree = 0; tree < COLL_MD_BENCH_NUM_TREES; tree++)
+        coll_md_bench_create_tree(file_id, (coll_md_bench_tree_t)tree);
+    ret = H5Fclose(file_id);
+    VRFY_G((ret >= 0), "H5Fclose succeeded");
+
+    if (MAIN_PROCESS) {
+        HDprintf("Collective metadata benchmark: %u wide groups, %u deep groups, %u attributes per group, "
+                 "best of %u iterations\n\n",
+                 coll_md_bench_groups_g, coll_md_bench_depth_g, coll_md_bench_attrs_g,
+                 coll_md_bench_iterations_g);
+        HDprintf("    %-5s  %6s  %-7s  %12s  %12s  %12s  %12s\n", "tree", "procs", "coll md", "file open ms",
+                 "open ms", "visit ms", "attr read ms");
+    }
+
+    for (tree = 0; tree < COLL_MD_BENCH_NUM_TREES; tree++) {
+        for (i = 0; i < coll_md_bench_nprocs_g; i++) {
+            MPI_Comm comm = MPI_COMM_NULL;
+            int      coll_md;
+
+            /* Reopen the file on the first processes only, the others wait */
+            MPI_Comm_split(MPI_COMM_WORLD, mpi_rank_g < (int)coll_md_bench_procs_g[i] ? 0 : MPI_UNDEFINED,
+                           mpi_rank_g, &comm);
+
+            if (comm != MPI_COMM_NULL) {
+                for (coll_md = 0; coll_md < 2; coll_md++) {
+                    coll_md_bench_times_t best;
+
+                    coll_md_bench_run((coll_md_bench_tree_t)tree, comm, (hbool_t)coll_md, &best);
+
+                    if (MAIN_PROCESS)
+                        HDprintf("    %-5s  %6u  %-7s  %12.3f  %12.3f  %12.3f  %12.3f\n",
+                                 coll_md_bench_tree_names[tree], coll_md_bench_procs_g[i],
+                                 coll_md ? "on" : "off", best.file_open * 1000.0, best.group_open * 1000.0,
+                                 best.visit * 1000.0, best.attr_read * 1000.0);
+                }
+
+                MPI_Comm_free(&comm);
+            }
+
+            MPI_Barrier(MPI_COMM_WORLD);
+        }
+    }
+
+    if (mpi_rank_g == 0) {
+        hid_t fapl_id = H5Pcreate(H5P_FILE_ACCESS);
+
+        H5Pset_fapl_mpio(fapl_id, MPI_COMM_SELF, MPI_INFO_NULL);
+
+        H5E_BEGIN_TRY
+        {
+            H5Fdelete(FILENAME[0], fapl_id);
+        }
+        H5E_END_TRY;
+
+        H5Pclose(fapl_id);
+    }
+
+    H5Pclose(acc_plist);
+
+    /* close HDF5 library */
+    H5close();
+
+    MPI_Finalize();
+
+    return nerrors ? 1 : 0;
+}
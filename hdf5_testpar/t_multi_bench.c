@@ -0,0 +1,412 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * Copyright by The HDF Group.                                               *
+ * All rights reserved.                                                      *
+ *                                                                           *
+ * This file is part of HDF5.  The full HDF5 copyright notice, including     *
+ * terms governing use, modification, and redistribution, is contained in    *
+ * the COPYING file, which can be found at the root of the source code       *
+ * distribution tree, or in https://www.hdfgroup.org/licenses.               *
+ * If you do not have access to either file, you may request a copy from     *
+ * help@hdfgroup.org.                                                        *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+/*
+ * A benchmark of collective multi-dataset I/O, the parallel counterpart
+ * of the "multi" benchmark of h5vl_bench. The collective multi-dataset
+ * test of h5vl_test_parallel only checks that data written with
+ * H5Dwrite_multi matches data written with H5Dwrite; here, for each
+ * number of datasets given with --dsets, the elements given to each
+ * process with --elems are split evenly across that many datasets of
+ * one row per process. Every process writes and reads its own row of
+ * each dataset with collective I/O, both by calling H5Dwrite or H5Dread
+ * once for each dataset and by a single call to H5Dwrite_multi or
+ * H5Dread_multi. Process 0 prints the aggregate bandwidth of each,
+ * taken from the time of the slowest process in the fastest iteration,
+ * and the speedup of the multi-dataset calls.
+ */
+
+#include <float.h>
+
+#include "hdf5.h"
+#include "testphdf5.h"
+
+const char *FILENAME[2] = {"multi_bench.h5", NULL};
+
+uint64_t vol_cap_flags_g;
+
+int        facc_type       = FACC_MPIO; /*Test file access type */
+int        dxfer_coll_type = DXFER_COLLECTIVE_IO;
+int        nerrors         = 0;
+static int mpi_size_g, mpi_rank_g;
+
+#define MAIN_PROCESS (mpi_rank_g == 0) /* define process 0 as main process */
+
+#define MULTI_BENCH_DEFAULT_ELEMS      (1024 * 1024) /* 4 MiB of ints for each process */
+#define MULTI_BENCH_DEFAULT_ITERATIONS 3
+#define MULTI_BENCH_MAX_LIST_VALUES    16
+#define MULTI_BENCH_DSET_NAME_LEN      32
+
+/* Benchmark parameters, set from the command line */
+static hsize_t  multi_bench_elems_g      = MULTI_BENCH_DEFAULT_ELEMS;
+static unsigned multi_bench_iterations_g = MULTI_BENCH_DEFAULT_ITERATIONS;
+
+static unsigned multi_bench_dsets_g[MULTI_BENCH_MAX_LIST_VALUES] = {1, 16, 256};
+static size_t   multi_bench_ndsets_g                             = 3;
+
+/*
+ * Parses a comma-separated list of unsigned numbers given on the command line.
+ */
+static herr_t
+multi_bench_parse_list(const char *str, unsigned values[], size_t *nvalues)
+{
+    char *end = NULL;
+
+    *nvalues = 0;
+
+    do {
+        unsigned long value;
+
+        value = HDstrtoul(str, &end, 10);
+        if (end == str || (*end != ',' && *end != '\0') || value == 0 || value > UINT_MAX ||
+            *nvalues == MULTI_BENCH_MAX_LIST_VALUES)
+            return FAIL;
+
+        values[(*nvalues)++] = (unsigned)value;
+        str                  = end + 1;
+    } while (*end == ',');
+
+    return SUCCEED;
+}
+
+/*
+ * Makes a single pass over all of the datasets, either with one I/O
+ * call per dataset or with a single multi-dataset I/O call, and returns
+ * the time taken by the slowest process.
+ */
+static double
+multi_bench_pass(size_t ndsets, hid_t dset_ids[], hid_t type_ids[], hid_t mspace_ids[], hid_t fspace_ids[],
+                 hid_t dxpl_id, void *bufs[], const void *const_bufs[], hbool_t write, hbool_t multi)
+{
+    double elapsed, slowest = 0.0;
+    herr_t ret = SUCCEED;
+    size_t i;
+
+    MPI_Barrier(MPI_COMM_WORLD);
+
+    elapsed = MPI_Wtime();
+    if (multi) {
+        if (write)
+            ret = H5Dwrite_multi(ndsets, dset_ids, type_ids, mspace_ids, fspace_ids, dxpl_id, const_bufs);
+        else
+            ret = H5Dread_multi(ndsets, dset_ids, type_ids, mspace_ids, fspace_ids, dxpl_id, bufs);
+    }
+    else {
+        for (i = 0; i < ndsets && ret >= 0; i++) {
+            if (write)
+                ret = H5Dwrite(dset_ids[i], type_ids[i], mspace_ids[i], fspace_ids[i], dxpl_id, bufs[i]);
+            else
+                ret = H5Dread(dset_ids[i], type_ids[i], mspace_ids[i], fspace_ids[i], dxpl_id, bufs[i]);
+        }
+    }
+    elapsed = MPI_Wtime() - elapsed;
+
+    if (multi)
+        VRFY_G((ret >= 0), "H5Dwrite_multi/H5Dread_multi succeeded");
+    else
+        VRFY_G((ret >= 0), "H5Dwrite/H5Dread succeeded");
+
+    MPI_Allreduce(&elapsed, &slowest, 1, MPI_DOUBLE, MPI_MAX, MPI_COMM_WORLD);
+
+    return slowest;
+}
+
+/*
+ * Creates a number of datasets sharing the elements of each process,
+ * and writes and reads them with per-dataset and multi-dataset calls.
+ */
+static void
+multi_bench_run(size_t ndsets)
+{
+    hid_t        fapl_id = H5I_INVALID_HID, file_id = H5I_INVALID_HID, dxpl_id = H5I_INVALID_HID;
+    hid_t        fspace_id = H5I_INVALID_HID, mspace_id = H5I_INVALID_HID;
+    hid_t       *dset_ids = NULL, *type_ids = NULL, *mspace_ids = NULL, *fspace_ids = NULL;
+    void       **bufs       = NULL;
+    const void **const_bufs = NULL;
+    DATATYPE    *wbuf = NULL, *rbuf = NULL;
+    hsize_t      nelems, dims[2], start[2], count[2];
+    double       best[2][2]; /* [write][multi] */
+    double       total_mb;
+    size_t       i;
+    unsigned     iter;
+    int          write, multi;
+    herr_t       ret;
+
+    /* Every dataset has at least one element for each process */
+    nelems = MAX(multi_bench_elems_g / ndsets, 1);
+
+    dims[0]  = (hsize_t)mpi_size_g;
+    dims[1]  = nelems;
+    start[0] = (hsize_t)mpi_rank_g;
+    start[1] = 0;
+    count[0] = 1;
+    count[1] = nelems;
+
+    fapl_id = create_faccess_plist(MPI_COMM_WORLD, MPI_INFO_NULL, facc_type);
+    VRFY_G((fapl_id >= 0), "create_faccess_plist succeeded");
+
+    file_id = H5Fcreate(FILENAME[0], H5F_ACC_TRUNC, H5P_DEFAULT, fapl_id);
+    VRFY_G((file_id >= 0), "H5Fcreate succeeded");
+
+    fspace_id = H5Screate_simple(2, dims, NULL);
+    VRFY_G((fspace_id >= 0), "H5Screate_simple succeeded");
+    ret = H5Sselect_hyperslab(fspace_id, H5S_SELECT_SET, start, NULL, count, NULL);
+    VRFY_G((ret >= 0), "H5Sselect_hyperslab succeeded");
+
+    mspace_id = H5Screate_simple(1, &nelems, NULL);
+    VRFY_G((mspace_id >= 0), "H5Screate_simple succeeded");
+
+    dxpl_id = H5Pcreate(H5P_DATASET_XFER);
+    VRFY_G((dxpl_id >= 0), "H5Pcreate succeeded");
+    ret = H5Pset_dxpl_mpio(dxpl_id, H5FD_MPIO_COLLECTIVE);
+    VRFY_G((ret >= 0), "H5Pset_dxpl_mpio succeeded");
+
+    dset_ids   = (hid_t *)HDmalloc(ndsets * sizeof(hid_t));
+    type_ids   = (hid_t *)HDmalloc(ndsets * sizeof(hid_t));
+    mspace_ids = (hid_t *)HDmalloc(ndsets * sizeof(hid_t));
+    fspace_ids = (hid_t *)HDmalloc(ndsets * sizeof(hid_t));
+    bufs       = (void **)HDmalloc(ndsets * sizeof(void *));
+    const_bufs = (const void **)HDmalloc(ndsets * sizeof(const void *));
+    wbuf       = (DATATYPE *)HDmalloc(ndsets * (size_t)nelems * sizeof(DATATYPE));
+    rbuf       = (DATATYPE *)HDmalloc(ndsets * (size_t)nelems * sizeof(DATATYPE));
+    VRFY_G((dset_ids && type_ids && mspace_ids && fspace_ids && bufs && const_bufs && wbuf && rbuf),
+           "HDmalloc succeeded");
+
+    for (i = 0; i < ndsets * (size_t)nelems; i++)
+        wbuf[i] = (DATATYPE)(mpi_rank_g * 1000 + (int)(i % 1000));
+
+    for (i = 0; i < ndsets; i++) {
+        char dset_name[MULTI_BENCH_DSET_NAME_LEN];
+
+        HDsnprintf(dset_name, sizeof(dset_name), "multi_%zu", i);
+
+        dset_ids[i] =
+            H5Dcreate2(file_id, dset_name, H5T_NATIVE_INT, fspace_id, H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT);
+        VRFY_G((dset_ids[i] >= 0), "H5Dcreate2 succeeded");
+
+        type_ids[i]   = H5T_NATIVE_INT;
+        mspace_ids[i] = mspace_id;
+        fspace_ids[i] = fspace_id;
+    }
+
+    for (write = 1; write >= 0; write--)
+        for (multi = 0; multi <= 1; multi++)
+            best[write][multi] = DBL_MAX;
+
+    /* Alternate between per-dataset and multi-dataset calls in each iteration */
+    for (write = 1; write >= 0; write--) {
+        for (iter = 0; iter < multi_bench_iterations_g; iter++) {
+            for (multi = 0; multi <= 1; multi++) {
+                DATATYPE *buf = write ? wbuf : rbuf;
+                double    slowest;
+
+                for (i = 0; i < ndsets; i++) {
+                    bufs[i]       = buf + i * (size_t)nelems;
+                    const_bufs[i] = bufs[i];
+                }
+
+                if (!write)
+                    HDmemset(rbuf, 0, ndsets * (size_t)nelems * sizeof(DATATYPE));
+
+                slowest = multi_bench_pass(ndsets, dset_ids, type_ids, mspace_ids, fspace_ids, dxpl_id, bufs,
+                                           const_bufs, (hbool_t)write, (hbool_t)multi);
+                best[write][multi] = MIN(best[write][multi], slowest);
+
+                if (!write)
+                    VRFY_G((HDmemcmp(wbuf, rbuf, ndsets * (size_t)nelems * sizeof(DATATYPE)) == 0),
+                           "data verification");
+            }
+        }
+    }
+
+    total_mb = (double)ndsets * (double)nelems * (double)sizeof(DATATYPE) * (double)mpi_size_g /
+               (1024.0 * 1024.0);
+
+    if (MAIN_PROCESS)
+        for (write = 1; write >= 0; write--)
+            HDprintf("    %8zu  %-5s  %12.2f  %12.2f  %8.2fx\n", ndsets, write ? "write" : "read",
+                     total_mb / best[write][0], total_mb / best[write][1],
+                     best[write][1] > 0.0 ? best[write][0] / best[write][1] : 0.0);
+
+    for (i = 0; i < ndsets; i++) {
+        ret = H5Dclose(dset_ids[i]);
+        VRFY_G((ret >= 0), "H5Dclose succeeded");
+    }
+
+    HDfree(dset_ids);
+    HDfree(type_ids);
+    HDfree(mspace_ids);
+    HDfree(fspace_ids);
+    HDfree(bufs);
+    HDfree(const_bufs);
+    HDfree(wbuf);
+    HDfree(rbuf);
+
+    ret = H5Pclose(dxpl_id);
+    VRFY_G((ret >= 0), "H5Pclose succeeded");
+    ret = H5Sclose(mspace_id);
+    VRFY_G((ret >= 0), "H5Sclose succeeded");
+    ret = H5Sclose(fspace_id);
+    VRFY_G((ret >= 0), "H5Sclose succeeded");
+    ret = H5Fclose(file_id);
+    VRFY_G((ret >= 0), "H5Fclose succeeded");
+    ret = H5Pclose(fapl_id);
+    VRFY_G((ret >= 0), "H5Pclose succeeded");
+}
+
+/*
+ * Create the appropriate File access property list
+ */
+hid_t
+create_faccess_plist(MPI_Comm comm, MPI_Info info, int l_facc_type)
+{
+    hid_t  ret_pl = -1;
+    herr_t ret; /* generic return value */
+
+    ret_pl = H5Pcreate(H5P_FILE_ACCESS);
+    VRFY_G((ret_pl >= 0), "H5P_FILE_ACCESS");
+
+    if (l_facc_type == FACC_DEFAULT)
+        return (ret_pl);
+
+    /* set Parallel access with communicator */
+    ret = H5Pset_fapl_mpio(ret_pl, comm, info);
+    VRFY_G((ret >= 0), "");
+    ret = H5Pset_all_coll_metadata_ops(ret_pl, TRUE);
+    VRFY_G((ret >= 0), "");
+    ret = H5Pset_coll_metadata_write(ret_pl, TRUE);
+    VRFY_G((ret >= 0), "");
+
+    return (ret_pl);
+}
+
+static void
+usage(void)
+{
+    HDprintf("Usage: t_multi_bench [--elems <n>] [--dsets <list>] [--iterations <n>]\n"
+             "\n"
+             "    --elems <n>         Number of elements of each process, split across the datasets\n"
+             "                        (default %d)\n"
+             "    --dsets <list>      Numbers of datasets to split the elements across (default 1,16,256)\n"
+             "    --iterations <n>    Time the best of <n> writes and reads of each (default %d)\n",
+             MULTI_BENCH_DEFAULT_ELEMS, MULTI_BENCH_DEFAULT_ITERATIONS);
+}
+
+int
+main(int argc, char **argv)
+{
+    hid_t  acc_plist = H5I_INVALID_HID;
+    size_t i;
+
+    MPI_Init(&argc, &argv);
+    MPI_Comm_size(MPI_COMM_WORLD, &mpi_size_g);
+    MPI_Comm_rank(MPI_COMM_WORLD, &mpi_rank_g);
+
+    /* Attempt to turn off atexit post processing so that in case errors
+     * happen during the test and the process is aborted, it will not get
+     * hang in the atexit post processing in which it may try to make MPI
+     * calls.  By then, MPI calls may not work.
+     */
+    if (H5dont_atexit() < 0)
+        HDprintf("Failed to turn off atexit processing. Continue.\n");
+
+    for (int arg = 1; arg < argc; arg++) {
+        herr_t parse_ret = SUCCEED;
+
+        if (!HDstrcmp(argv[arg], "--elems") || !HDstrcmp(argv[arg], "--iterations")) {
+            char         *end   = NULL;
+            unsigned long value = 0;
+
+            if (arg + 1 < argc)
+                value = HDstrtoul(argv[arg + 1], &end, 10);
+            if (!end || end == argv[arg + 1] || *end != '\0' || value == 0 || value > UINT_MAX)
+                parse_ret = FAIL;
+            else if (!HDstrcmp(argv[arg], "--elems"))
+                multi_bench_elems_g = (hsize_t)value;
+            else
+                multi_bench_iterations_g = (unsigned)value;
+            arg++;
+        }
+        else if (!HDstrcmp(argv[arg], "--dsets")) {
+            if (++arg >= argc ||
+                multi_bench_parse_list(argv[arg], multi_bench_dsets_g, &multi_bench_ndsets_g) < 0)
+                parse_ret = FAIL;
+        }
+        else
+            parse_ret = FAIL;
+
+        if (parse_ret < 0) {
+            if (MAIN_PROCESS) {
+                HDfprintf(stderr, "Invalid argument '%s'\n", argv[MIN(arg, argc - 1)]);
+                usage();
+            }
+            MPI_Finalize();
+            HDexit(EXIT_FAILURE);
+        }
+    }
+
+    acc_plist = create_faccess_plist(MPI_COMM_WORLD, MPI_INFO_NULL, facc_type);
+
+    /* Get the capability flag of the VOL connector being used */
+    if (H5Pget_vol_cap_flags(acc_plist, &vol_cap_flags_g) < 0) {
+        if (MAIN_PROCESS)
+            HDprintf("Failed to get the capability flag of the VOL connector being used\n");
+
+        MPI_Finalize();
+        return 0;
+    }
+
+    /* Make sure the connector supports the API functions being tested */
+    if (!(vol_cap_flags_g & H5VL_CAP_FLAG_FILE_BASIC) || !(vol_cap_flags_g & H5VL_CAP_FLAG_DATASET_BASIC)) {
+        if (MAIN_PROCESS)
+            HDprintf("API functions for basic file and dataset aren't supported with this connector\n");
+
+        MPI_Finalize();
+        return 0;
+    }
+
+    if (MAIN_PROCESS) {
+        HDprintf("Collective multi-dataset I/O benchmark: %d processes, %llu elements per process, "
+                 "best of %u iterations\n\n",
+                 mpi_size_g, (unsigned long long)multi_bench_elems_g, multi_bench_iterations_g);
+        HDprintf("    %8s  %-5s  %12s  %12s  %9s\n", "datasets", "op", "looped MB/s", "multi MB/s",
+                 "speedup");
+    }
+
+    for (i = 0; i < multi_bench_ndsets_g; i++) {
+        multi_bench_run((size_t)multi_bench_dsets_g[i]);
+        MPI_Barrier(MPI_COMM_WORLD);
+    }
+
+    if (mpi_rank_g == 0) {
+        hid_t fapl_id = H5Pcreate(H5P_FILE_ACCESS);
+
+        H5Pset_fapl_mpio(fapl_id, MPI_COMM_SELF, MPI_INFO_NULL);
+
+        H5E_BEGIN_TRY
+        {
+            H5Fdelete(FILENAME[0], fapl_id);
+        }
+        H5E_END_TRY;
+
+        H5Pclose(fapl_id);
+    }
+
+    H5Pclose(acc_plist);
+
+    /* close HDF5 library */
+    H5close();
+
+    MPI_Finalize();
+
+    return nerrors ? 1 : 0;
+}
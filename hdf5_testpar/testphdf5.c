@@ -103,6 +103,196 @@ MPI_Init(int *argc, char ***argv)
 }
 #endif /* USE_PAUSE */
 
+/*
+ * A lightweight registry of the tests run by this program, in place of
+ * the HDF5 library's testframe, so that tests can be picked by name on
+ * the command line, run a number of times and timed on every process.
+ */
+#define MAX_NUM_TESTS 64
+
+typedef struct phdf5_test_t {
+    const char *name;
+    void (*call)(void); /* NULL if the test is currently skipped */
+    const char *description;
+    int         min_procs; /* Fewest processes the test can run with */
+    hbool_t     selected;
+    unsigned    nruns;
+    int         nerrors;   /* Most errors detected by the test on any process */
+    double      min_time;  /* Mean time of a run on the fastest process */
+    double      avg_time;  /* Mean time of a run, averaged over all processes */
+    double      max_time;  /* Mean time of a run on the slowest process */
+    double      best_time; /* Time of the fastest run, taken by its slowest process */
+} phdf5_test_t;
+
+static phdf5_test_t phdf5_tests[MAX_NUM_TESTS];
+static int          num_tests      = 0;
+static hbool_t      tests_selected = FALSE; /* Whether tests have been picked by name */
+static unsigned     test_runs      = 1;     /* Number of times each test is run */
+static hbool_t      list_tests     = FALSE;
+
+/*
+ * Adds a test to the registry. Tests are run in the order they are added.
+ */
+static void
+AddTest(const char *name, void (*call)(void), const char *description, int min_procs)
+{
+    phdf5_test_t *test;
+
+    if (num_tests >= MAX_NUM_TESTS) {
+        HDprintf("Too many tests added, increase MAX_NUM_TESTS(%d)\n", MAX_NUM_TESTS);
+        MPI_Abort(MPI_COMM_WORLD, -1);
+    }
+
+    test              = &phdf5_tests[num_tests++];
+    test->name        = name;
+    test->call        = call;
+    test->description = description;
+    test->min_procs   = min_procs;
+    test->selected    = TRUE;
+    test->nruns       = 0;
+}
+
+/*
+ * Picks a test to run by name. Once any test has been picked, only the
+ * tests picked are run.
+ */
+static int
+SelectTest(const char *name)
+{
+    int i;
+
+    for (i = 0; i < num_tests; i++)
+        if (!HDstrcmp(phdf5_tests[i].name, name))
+            break;
+
+    if (i == num_tests)
+        return -1;
+
+    if (!tests_selected) {
+        for (int j = 0; j < num_tests; j++)
+            phdf5_tests[j].selected = FALSE;
+        tests_selected = TRUE;
+    }
+
+    phdf5_tests[i].selected = TRUE;
+
+    return 0;
+}
+
+/*
+ * Prints the name and description of every test.
+ */
+static void
+TestList(void)
+{
+    HDprintf("Tests:\n");
+    for (int i = 0; i < num_tests; i++)
+        HDprintf("    %-16s %s%s\n", phdf5_tests[i].name, phdf5_tests[i].description,
+                 phdf5_tests[i].call ? "" : " (skipped)");
+}
+
+/*
+ * Runs each selected test the requested number of times. Every process
+ * times each run of a test between barriers; the mean time of a run on
+ * each process and the time of each run on its slowest process are then
+ * reduced across the processes for TestSummary.
+ */
+static void
+PerformTests(void)
+{
+    int mpi_size, mpi_rank; /* mpi variables */
+
+    MPI_Comm_size(MPI_COMM_WORLD, &mpi_size);
+    MPI_Comm_rank(MPI_COMM_WORLD, &mpi_rank);
+
+    for (int i = 0; i < num_tests; i++) {
+        phdf5_test_t *test = &phdf5_tests[i];
+        double        total_time = 0.0, mean_time, sum_time;
+        int           test_errors;
+
+        if (!test->selected)
+            continue;
+
+        if (mpi_size < test->min_procs) {
+            if (MAINPROCESS) {
+                HDprintf("%s needs at least %d processes - SKIPPED\n", test->description, test->min_procs);
+                fflush(stdout);
+            }
+            continue;
+        }
+
+        if (!test->call) {
+            if (MAINPROCESS) {
+                HDprintf("%s - SKIPPED currently due to native-specific testing\n", test->description);
+                fflush(stdout);
+            }
+            continue;
+        }
+
+        test_errors     = nerrors;
+        test->best_time = DBL_MAX;
+
+        for (unsigned run = 0; run < test_runs; run++) {
+            double start, elapsed, slowest;
+
+            if (MAINPROCESS) {
+                if (test_runs > 1)
+                    HDprintf("%s (run %u of %u)\n", test->description, run + 1, test_runs);
+                else
+                    HDprintf("%s\n", test->description);
+                fflush(stdout);
+            }
+
+            MPI_Barrier(MPI_COMM_WORLD);
+            start = MPI_Wtime();
+
+            test->call();
+
+            elapsed = MPI_Wtime() - start;
+            total_time += elapsed;
+
+            MPI_Allreduce(&elapsed, &slowest, 1, MPI_DOUBLE, MPI_MAX, MPI_COMM_WORLD);
+            if (slowest < test->best_time)
+                test->best_time = slowest;
+        }
+
+        test->nruns = test_runs;
+        test_errors = nerrors - test_errors;
+        mean_time   = total_time / test_runs;
+
+        MPI_Reduce(&mean_time, &test->min_time, 1, MPI_DOUBLE, MPI_MIN, 0, MPI_COMM_WORLD);
+        MPI_Reduce(&mean_time, &test->max_time, 1, MPI_DOUBLE, MPI_MAX, 0, MPI_COMM_WORLD);
+        MPI_Reduce(&mean_time, &sum_time, 1, MPI_DOUBLE, MPI_SUM, 0, MPI_COMM_WORLD);
+        MPI_Reduce(&test_errors, &test->nerrors, 1, MPI_INT, MPI_MAX, 0, MPI_COMM_WORLD);
+        test->avg_time = sum_time / mpi_size;
+    }
+}
+
+/*
+ * Prints the times reduced by PerformTests for each test that was run.
+ * Only meaningful on process 0. The header avoids the words, such as
+ * "Error", that the test driver takes to mean a test has failed.
+ */
+static void
+TestSummary(void)
+{
+    HDprintf("===================================\n");
+    HDprintf("%-16s %5s %4s %11s %11s %11s %11s\n", "Test", "Runs", "Nerr", "Min (s)", "Avg (s)", "Max (s)",
+             "Best (s)");
+    for (int i = 0; i < num_tests; i++) {
+        phdf5_test_t *test = &phdf5_tests[i];
+
+        if (!test->nruns)
+            continue;
+
+        HDprintf("%-16s %5u %4d %11.4f %11.4f %11.4f %11.4f\n", test->name, test->nruns, test->nerrors,
+                 test->min_time, test->avg_time, test->max_time, test->best_time);
+    }
+    HDprintf("\nMin, Avg and Max are the mean time of a run on the fastest process, averaged over\n"
+             "all processes and on the slowest process. Best is the fastest run, timed by its slowest\n"
+             "process.\n");
+}
+
 /*
  * Show command usage
  */
@@ -110,7 +300,10 @@ static void
 usage(void)
 {
     HDprintf("    [-r] [-w] [-m<n_datasets>] [-n<n_groups>] "
-             "[-o] [-f <prefix>] [-d <dim0> <dim1>]\n");
+             "[-o] [-f <prefix>] [-d <dim0> <dim1>] [-t <n_runs>] [-l] [<test> ...]\n");
+    HDprintf("\t<test>\t\trun only the named tests, e.g. cdsetw cchunk5 bigdset\n");
+    HDprintf("\t-t <n_runs>\trun each test <n_runs> times and report the times taken\n");
+    HDprintf("\t-l\t\tlist the names of the tests\n");
     HDprintf("\t-m<n_datasets>"
              "\tset number of datasets for the multiple dataset test\n");
     HDprintf("\t-n<n_groups>"
@@ -143,7 +336,13 @@ parse_options(int argc, char **argv)
 
     while (--argc) {
         if (**(++argv) != '-') {
-            break;
+            /* Run only the tests named */
+            if (SelectTest(*argv) < 0) {
+                if (MAINPROCESS)
+                    HDprintf("Unknown test(%s)\n", *argv);
+                nerrors++;
+                return (1);
+            }
         }
         else {
             switch (*(*argv + 1)) {
@@ -202,6 +401,21 @@ parse_options(int argc, char **argv)
                     argc--;
                     chunkdim1 = atoi(*(++argv));
                     break;
+                case 't': /* number of runs of each test */
+                    if (--argc < 1) {
+                        nerrors++;
+                        return (1);
+                    }
+                    if (atoi(*(++argv)) <= 0) {
+                        HDprintf("Illegal number of runs(%s)\n", *argv);
+                        nerrors++;
+                        return (1);
+                    }
+                    test_runs = (unsigned)atoi(*argv);
+                    break;
+                case 'l': /* list the tests */
+                    list_tests = TRUE;
+                    break;
                 case 'h': /* print help message--return with nerrors set */
                     return (1);
                 default:
@@ -316,13 +530,6 @@ main(int argc, char **argv)
     int    mpi_size, mpi_rank; /* mpi variables */
     herr_t ret;
 
-#if 0
-    H5Ptest_param_t ndsets_params, ngroups_params;
-    H5Ptest_param_t collngroups_params;
-    H5Ptest_param_t io_mode_confusion_params;
-    H5Ptest_param_t rr_obj_flush_confusion_params;
-#endif
-
 #ifndef H5_HAVE_WIN32_API
     /* Un-buffer the stdout and stderr */
     HDsetbuf(stderr, NULL);
@@ -373,580 +580,122 @@ main(int argc, char **argv)
     ret = H5Pget_vol_cap_flags(fapl, &vol_cap_flags_g);
     VRFY((ret >= 0), "H5Pget_vol_cap_flags succeeded");
 
-    /* Initialize testing framework */
-    /* TestInit(argv[0], usage, parse_options); */
-
-    if (parse_options(argc, argv)) {
-        usage();
-        return 1;
-    }
-
     /* Tests are generally arranged from least to most complexity... */
-#if 0
-    AddTest("mpiodup", test_fapl_mpio_dup, NULL,
-            "fapl_mpio duplicate", NULL);
-#endif
+    AddTest("mpiodup", test_fapl_mpio_dup, "fapl_mpio duplicate", 1);
 
-    if (MAINPROCESS) {
-        printf("fapl_mpio duplicate\n");
-        fflush(stdout);
-    }
-    test_fapl_mpio_dup();
+    AddTest("split", test_split_comm_access, "dataset using split communicators", 1);
+    AddTest("props", test_file_properties, "Coll Metadata file property settings", 1);
 
-#if 0
-    AddTest("split", test_split_comm_access, NULL,
-            "dataset using split communicators", PARATESTFILE);
-    AddTest("props", test_file_properties, NULL,
-            "Coll Metadata file property settings", PARATESTFILE);
-#endif
-
-    if (MAINPROCESS) {
-        printf("dataset using split communicators\n");
-        fflush(stdout);
-    }
-    test_split_comm_access();
+    AddTest("idsetw", dataset_writeInd, "dataset independent write", 1);
+    AddTest("idsetr", dataset_readInd, "dataset independent read", 1);
 
-    if (MAINPROCESS) {
-        printf("Coll Metadata file property settings\n");
-        fflush(stdout);
-    }
-    test_file_properties();
+    AddTest("cdsetw", dataset_writeAll, "dataset collective write", 1);
+    AddTest("cdsetr", dataset_readAll, "dataset collective read", 1);
 
-#if 0
-    AddTest("idsetw", dataset_writeInd, NULL,
-            "dataset independent write", PARATESTFILE);
-    AddTest("idsetr", dataset_readInd, NULL,
-            "dataset independent read", PARATESTFILE);
-#endif
-
-    if (MAINPROCESS) {
-        printf("dataset independent write\n");
-        fflush(stdout);
-    }
-    dataset_writeInd();
-    if (MAINPROCESS) {
-        printf("dataset independent read\n");
-        fflush(stdout);
-    }
-    dataset_readInd();
-
-#if 0
-    AddTest("cdsetw", dataset_writeAll, NULL,
-            "dataset collective write", PARATESTFILE);
-    AddTest("cdsetr", dataset_readAll, NULL,
-            "dataset collective read", PARATESTFILE);
-#endif
-
-    if (MAINPROCESS) {
-        printf("dataset collective write\n");
-        fflush(stdout);
-    }
-    dataset_writeAll();
-    if (MAINPROCESS) {
-        printf("dataset collective read\n");
-        fflush(stdout);
-    }
-    dataset_readAll();
-
-#if 0
-    AddTest("eidsetw", extend_writeInd, NULL,
-            "extendible dataset independent write", PARATESTFILE);
-    AddTest("eidsetr", extend_readInd, NULL,
-            "extendible dataset independent read", PARATESTFILE);
-    AddTest("ecdsetw", extend_writeAll, NULL,
-            "extendible dataset collective write", PARATESTFILE);
-    AddTest("ecdsetr", extend_readAll, NULL,
-            "extendible dataset collective read", PARATESTFILE);
-    AddTest("eidsetw2", extend_writeInd2, NULL,
-            "extendible dataset independent write #2", PARATESTFILE);
-    AddTest("selnone", none_selection_chunk, NULL,
-            "chunked dataset with none-selection", PARATESTFILE);
-    AddTest("calloc", test_chunk_alloc, NULL,
-            "parallel extend Chunked allocation on serial file", PARATESTFILE);
-    AddTest("fltread", test_filter_read, NULL,
-            "parallel read of dataset written serially with filters", PARATESTFILE);
-#endif
-
-    if (MAINPROCESS) {
-        printf("extendible dataset independent write\n");
-        fflush(stdout);
-    }
-    extend_writeInd();
-    if (MAINPROCESS) {
-        printf("extendible dataset independent read\n");
-        fflush(stdout);
-    }
-    extend_readInd();
-    if (MAINPROCESS) {
-        printf("extendible dataset collective write\n");
-        fflush(stdout);
-    }
-    extend_writeAll();
-    if (MAINPROCESS) {
-        printf("extendible dataset collective read\n");
-        fflush(stdout);
-    }
-    extend_readAll();
-    if (MAINPROCESS) {
-        printf("extendible dataset independent write #2\n");
-        fflush(stdout);
-    }
-    extend_writeInd2();
-    if (MAINPROCESS) {
-        printf("chunked dataset with none-selection\n");
-        fflush(stdout);
-    }
-    none_selection_chunk();
-    if (MAINPROCESS) {
-        printf("parallel extend Chunked allocation on serial file\n");
-        fflush(stdout);
-    }
-    test_chunk_alloc();
-    if (MAINPROCESS) {
-        printf("parallel read of dataset written serially with filters\n");
-        fflush(stdout);
-    }
-    test_filter_read();
+    AddTest("eidsetw", extend_writeInd, "extendible dataset independent write", 1);
+    AddTest("eidsetr", extend_readInd, "extendible dataset independent read", 1);
+    AddTest("ecdsetw", extend_writeAll, "extendible dataset collective write", 1);
+    AddTest("ecdsetr", extend_readAll, "extendible dataset collective read", 1);
+    AddTest("eidsetw2", extend_writeInd2, "extendible dataset independent write #2", 1);
+    AddTest("selnone", none_selection_chunk, "chunked dataset with none-selection", 1);
+    AddTest("calloc", test_chunk_alloc, "parallel extend Chunked allocation on serial file", 1);
+    AddTest("fltread", test_filter_read, "parallel read of dataset written serially with filters", 1);
 
 #ifdef H5_HAVE_FILTER_DEFLATE
-#if 0
-    AddTest("cmpdsetr", compress_readAll, NULL,
-            "compressed dataset collective read", PARATESTFILE);
-#endif
-
-    if (MAINPROCESS) {
-        printf("compressed dataset collective read\n");
-        fflush(stdout);
-    }
-    compress_readAll();
+    AddTest("cmpdsetr", compress_readAll, "compressed dataset collective read", 1);
 #endif /* H5_HAVE_FILTER_DEFLATE */
 
-#if 0
-    AddTest("zerodsetr", zero_dim_dset, NULL,
-            "zero dim dset", PARATESTFILE);
-#endif
-
-    if (MAINPROCESS) {
-        printf("zero dim dset\n");
-        fflush(stdout);
-    }
-    zero_dim_dset();
-
-#if 0
-    ndsets_params.name = PARATESTFILE;
-    ndsets_params.count = ndatasets;
-    AddTest("ndsetw", multiple_dset_write, NULL,
-            "multiple datasets write", &ndsets_params);
-#endif
-
-    if (MAINPROCESS) {
-        printf("multiple datasets write\n");
-        fflush(stdout);
-    }
-    multiple_dset_write();
+    AddTest("zerodsetr", zero_dim_dset, "zero dim dset", 1);
 
-#if 0
-    ngroups_params.name = PARATESTFILE;
-    ngroups_params.count = ngroups;
-    AddTest("ngrpw", multiple_group_write, NULL,
-            "multiple groups write", &ngroups_params);
-    AddTest("ngrpr", multiple_group_read, NULL,
-            "multiple groups read", &ngroups_params);
-#endif
+    AddTest("ndsetw", multiple_dset_write, "multiple datasets write", 1);
 
-    if (MAINPROCESS) {
-        printf("multiple groups write\n");
-        fflush(stdout);
-    }
-    multiple_group_write();
-    if (MAINPROCESS) {
-        printf("multiple groups read\n");
-        fflush(stdout);
-    }
-    multiple_group_read();
-
-#if 0
-    AddTest("compact", compact_dataset, NULL,
-            "compact dataset test", PARATESTFILE);
-#endif
+    AddTest("ngrpw", multiple_group_write, "multiple groups write", 1);
+    AddTest("ngrpr", multiple_group_read, "multiple groups read", 1);
 
-    if (MAINPROCESS) {
-        printf("compact dataset test\n");
-        fflush(stdout);
-    }
-    compact_dataset();
+    AddTest("compact", compact_dataset, "compact dataset test", 1);
 
-#if 0
-    collngroups_params.name = PARATESTFILE;
-    collngroups_params.count = ngroups;
     /* combined cngrpw and ingrpr tests because ingrpr reads file created by cngrpw. */
-    AddTest("cngrpw-ingrpr", collective_group_write_independent_group_read, NULL,
-            "collective grp/dset write - independent grp/dset read",
-            &collngroups_params);
-#ifndef H5_HAVE_WIN32_API
-    AddTest("bigdset", big_dataset, NULL,
-            "big dataset test", PARATESTFILE);
-#else
-    HDprintf("big dataset test will be skipped on Windows (JIRA HDDFV-8064)\n");
-#endif
-#endif
-
-    if (MAINPROCESS) {
-        printf("collective grp/dset write - independent grp/dset read\n");
-        fflush(stdout);
-    }
-    collective_group_write_independent_group_read();
-    if (MAINPROCESS) {
-        printf("big dataset test\n");
-        fflush(stdout);
-    }
-    big_dataset();
+    AddTest("cngrpw-ingrpr", collective_group_write_independent_group_read,
+            "collective grp/dset write - independent grp/dset read", 1);
+    AddTest("bigdset", big_dataset, "big dataset test", 1);
 
-#if 0
-    AddTest("fill", dataset_fillvalue, NULL,
-            "dataset fill value", PARATESTFILE);
-#endif
+    AddTest("fill", dataset_fillvalue, "dataset fill value", 1);
 
-    if (MAINPROCESS) {
-        printf("dataset fill value\n");
-        fflush(stdout);
-    }
-    dataset_fillvalue();
+    AddTest("cchunk1", coll_chunk1, "simple collective chunk io", 1);
+    AddTest("cchunk2", coll_chunk2, "noncontiguous collective chunk io", 1);
+    AddTest("cchunk3", coll_chunk3, "multi-chunk collective chunk io", 1);
+    AddTest("cchunk4", coll_chunk4, "collective chunk io with partial non-selection", 1);
 
-#if 0
-    AddTest("cchunk1",
-            coll_chunk1,NULL, "simple collective chunk io",PARATESTFILE);
-    AddTest("cchunk2",
-            coll_chunk2,NULL, "noncontiguous collective chunk io",PARATESTFILE);
-    AddTest("cchunk3",
-            coll_chunk3,NULL, "multi-chunk collective chunk io",PARATESTFILE);
-    AddTest("cchunk4",
-            coll_chunk4,NULL, "collective chunk io with partial non-selection ",PARATESTFILE);
-#endif
+    /* Collective chunk IO optimization APIs need at least 3 processes to participate */
+    AddTest("cchunk5", coll_chunk5, "linked chunk collective IO without optimization", 3);
+    AddTest("cchunk6", coll_chunk6, "multi-chunk collective IO with direct request", 3);
+    AddTest("cchunk7", coll_chunk7, "linked chunk collective IO with optimization", 3);
+    AddTest("cchunk8", coll_chunk8, "linked chunk collective IO transferring to multi-chunk", 3);
+    AddTest("cchunk9", coll_chunk9, "multiple chunk collective IO with optimization", 3);
+    AddTest("cchunk10", coll_chunk10, "multiple chunk collective IO transferring to independent IO", 3);
 
-    if (MAINPROCESS) {
-        printf("simple collective chunk io\n");
-        fflush(stdout);
-    }
-    coll_chunk1();
-    if (MAINPROCESS) {
-        printf("noncontiguous collective chunk io\n");
-        fflush(stdout);
-    }
-    coll_chunk2();
-    if (MAINPROCESS) {
-        printf("multi-chunk collective chunk io\n");
-        fflush(stdout);
-    }
-    coll_chunk3();
-    if (MAINPROCESS) {
-        printf("collective chunk io with partial non-selection\n");
-        fflush(stdout);
-    }
-    coll_chunk4();
-
-    if ((mpi_size < 3) && MAINPROCESS) {
-        HDprintf("Collective chunk IO optimization APIs ");
-        HDprintf("needs at least 3 processes to participate\n");
-        HDprintf("Collective chunk IO API tests will be skipped \n");
-    }
-
-#if 0
-    AddTest((mpi_size <3)? "-cchunk5":"cchunk5" ,
-            coll_chunk5,NULL,
-            "linked chunk collective IO without optimization",PARATESTFILE);
-    AddTest((mpi_size < 3)? "-cchunk6" : "cchunk6",
-            coll_chunk6,NULL,
-            "multi-chunk collective IO with direct request",PARATESTFILE);
-    AddTest((mpi_size < 3)? "-cchunk7" : "cchunk7",
-            coll_chunk7,NULL,
-            "linked chunk collective IO with optimization",PARATESTFILE);
-    AddTest((mpi_size < 3)? "-cchunk8" : "cchunk8",
-            coll_chunk8,NULL,
-            "linked chunk collective IO transferring to multi-chunk",PARATESTFILE);
-    AddTest((mpi_size < 3)? "-cchunk9" : "cchunk9",
-            coll_chunk9,NULL,
-            "multiple chunk collective IO with optimization",PARATESTFILE);
-    AddTest((mpi_size < 3)? "-cchunk10" : "cchunk10",
-            coll_chunk10,NULL,
-            "multiple chunk collective IO transferring to independent IO",PARATESTFILE);
-#endif
-
-    if (mpi_size >= 3) {
-        if (MAINPROCESS) {
-            printf("linked chunk collective IO without optimization\n");
-            fflush(stdout);
-        }
-        coll_chunk5();
-        if (MAINPROCESS) {
-            printf("multi-chunk collective IO with direct request\n");
-            fflush(stdout);
-        }
-        coll_chunk6();
-        if (MAINPROCESS) {
-            printf("linked chunk collective IO with optimization\n");
-            fflush(stdout);
-        }
-        coll_chunk7();
-        if (MAINPROCESS) {
-            printf("linked chunk collective IO transferring to multi-chunk\n");
-            fflush(stdout);
-        }
-        coll_chunk8();
-        if (MAINPROCESS) {
-            printf("multiple chunk collective IO with optimization\n");
-            fflush(stdout);
-        }
-        coll_chunk9();
-        if (MAINPROCESS) {
-            printf("multiple chunk collective IO transferring to independent IO\n");
-            fflush(stdout);
-        }
-        coll_chunk10();
-    }
-
-#if 0
     /* irregular collective IO tests*/
-    AddTest("ccontw",
-            coll_irregular_cont_write,NULL,
-            "collective irregular contiguous write",PARATESTFILE);
-    AddTest("ccontr",
-            coll_irregular_cont_read,NULL,
-            "collective irregular contiguous read",PARATESTFILE);
-    AddTest("cschunkw",
-            coll_irregular_simple_chunk_write,NULL,
-            "collective irregular simple chunk write",PARATESTFILE);
-    AddTest("cschunkr",
-            coll_irregular_simple_chunk_read,NULL,
-            "collective irregular simple chunk read",PARATESTFILE);
-    AddTest("ccchunkw",
-            coll_irregular_complex_chunk_write,NULL,
-            "collective irregular complex chunk write",PARATESTFILE);
-    AddTest("ccchunkr",
-            coll_irregular_complex_chunk_read,NULL,
-            "collective irregular complex chunk read",PARATESTFILE);
-#endif
-
-    if (MAINPROCESS) {
-        printf("collective irregular contiguous write\n");
-        fflush(stdout);
-    }
-    coll_irregular_cont_write();
-    if (MAINPROCESS) {
-        printf("collective irregular contiguous read\n");
-        fflush(stdout);
-    }
-    coll_irregular_cont_read();
-    if (MAINPROCESS) {
-        printf("collective irregular simple chunk write\n");
-        fflush(stdout);
-    }
-    coll_irregular_simple_chunk_write();
-    if (MAINPROCESS) {
-        printf("collective irregular simple chunk read\n");
-        fflush(stdout);
-    }
-    coll_irregular_simple_chunk_read();
-    if (MAINPROCESS) {
-        printf("collective irregular complex chunk write\n");
-        fflush(stdout);
-    }
-    coll_irregular_complex_chunk_write();
-    if (MAINPROCESS) {
-        printf("collective irregular complex chunk read\n");
-        fflush(stdout);
-    }
-    coll_irregular_complex_chunk_read();
+    AddTest("ccontw", coll_irregular_cont_write, "collective irregular contiguous write", 1);
+    AddTest("ccontr", coll_irregular_cont_read, "collective irregular contiguous read", 1);
+    AddTest("cschunkw", coll_irregular_simple_chunk_write, "collective irregular simple chunk write", 1);
+    AddTest("cschunkr", coll_irregular_simple_chunk_read, "collective irregular simple chunk read", 1);
+    AddTest("ccchunkw", coll_irregular_complex_chunk_write, "collective irregular complex chunk write", 1);
+    AddTest("ccchunkr", coll_irregular_complex_chunk_read, "collective irregular complex chunk read", 1);
 
-#if 0
-    AddTest("null", null_dataset, NULL,
-            "null dataset test", PARATESTFILE);
-#endif
+    AddTest("null", null_dataset, "null dataset test", 1);
 
-    if (MAINPROCESS) {
-        printf("null dataset test\n");
-        fflush(stdout);
-    }
-    null_dataset();
+    AddTest("I/Omodeconf", io_mode_confusion, "I/O mode confusion test", 1);
 
-#if 0
-    io_mode_confusion_params.name  = PARATESTFILE;
-    io_mode_confusion_params.count = 0; /* value not used */
+    AddTest("rrobjflushconf", rr_obj_hdr_flush_confusion, "round robin object header flush confusion test",
+            3);
 
-    AddTest("I/Omodeconf", io_mode_confusion, NULL,
-            "I/O mode confusion test",
-            &io_mode_confusion_params);
-#endif
+    AddTest("alnbg1", chunk_align_bug_1, "Chunk allocation with alignment bug", 1);
 
-    if (MAINPROCESS) {
-        printf("I/O mode confusion test\n");
-        fflush(stdout);
-    }
-    io_mode_confusion();
+    AddTest("tldsc", lower_dim_size_comp_test, "test lower dim size comp in span tree to mpi derived type",
+            1);
 
-    if ((mpi_size < 3) && MAINPROCESS) {
-        HDprintf("rr_obj_hdr_flush_confusion test needs at least 3 processes.\n");
-        HDprintf("rr_obj_hdr_flush_confusion test will be skipped \n");
-    }
+    AddTest("lccio", link_chunk_collective_io_test, "test mpi derived type management", 1);
 
-    if (mpi_size > 2) {
-#if 0
-        rr_obj_flush_confusion_params.name = PARATESTFILE;
-        rr_obj_flush_confusion_params.count = 0; /* value not used */
-        AddTest("rrobjflushconf", rr_obj_hdr_flush_confusion, NULL,
-                "round robin object header flush confusion test",
-                &rr_obj_flush_confusion_params);
-#endif
+    /* The tests below without a test function are currently skipped due to native-specific testing */
+    AddTest("actualio", NULL /* actual_io_mode_tests */, "test actual io mode property", 1);
 
-        if (MAINPROCESS) {
-            printf("round robin object header flush confusion test\n");
-            fflush(stdout);
-        }
-        rr_obj_hdr_flush_confusion();
-    }
+    AddTest("nocolcause", NULL /* no_collective_cause_tests */, "test cause for broken collective io", 1);
 
-#if 0
-    AddTest("alnbg1",
-            chunk_align_bug_1, NULL,
-            "Chunk allocation with alignment bug.",
-            PARATESTFILE);
-
-    AddTest("tldsc",
-            lower_dim_size_comp_test, NULL,
-            "test lower dim size comp in span tree to mpi derived type",
-            PARATESTFILE);
-
-    AddTest("lccio",
-            link_chunk_collective_io_test, NULL,
-            "test mpi derived type management",
-            PARATESTFILE);
-
-    AddTest("actualio", actual_io_mode_tests, NULL,
-            "test actual io mode proprerty",
-            PARATESTFILE);
-
-    AddTest("nocolcause", no_collective_cause_tests, NULL,
-            "test cause for broken collective io",
-            PARATESTFILE);
-
-    AddTest("edpl", test_plist_ed, NULL,
-            "encode/decode Property Lists", NULL);
-#endif
+    AddTest("edpl", test_plist_ed, "encode/decode Property Lists", 1);
 
-    if (MAINPROCESS) {
-        printf("Chunk allocation with alignment bug\n");
-        fflush(stdout);
-    }
-    chunk_align_bug_1();
-    if (MAINPROCESS) {
-        printf("test lower dim size comp in span tree to mpi derived type\n");
-        fflush(stdout);
-    }
-    lower_dim_size_comp_test();
-    if (MAINPROCESS) {
-        printf("test mpi derived type management\n");
-        fflush(stdout);
-    }
-    link_chunk_collective_io_test();
-    if (MAINPROCESS) {
-        printf("test actual io mode property - SKIPPED currently due to native-specific testing\n");
-        fflush(stdout);
-    }
-    /* actual_io_mode_tests(); */
-    if (MAINPROCESS) {
-        printf("test cause for broken collective io - SKIPPED currently due to native-specific testing\n");
-        fflush(stdout);
-    }
-    /* no_collective_cause_tests(); */
-    if (MAINPROCESS) {
-        printf("encode/decode Property Lists\n");
-        fflush(stdout);
-    }
-    test_plist_ed();
+    AddTest("fiodc", NULL /* file_image_daisy_chain_test */, "file image ops daisy chain", 2);
 
-    if ((mpi_size < 2) && MAINPROCESS) {
-        HDprintf("File Image Ops daisy chain test needs at least 2 processes.\n");
-        HDprintf("File Image Ops daisy chain test will be skipped \n");
-    }
-
-#if 0
-    AddTest((mpi_size < 2)? "-fiodc" : "fiodc", file_image_daisy_chain_test, NULL,
-            "file image ops daisy chain", NULL);
-#endif
-
-    if (mpi_size >= 2) {
-        if (MAINPROCESS) {
-            printf("file image ops daisy chain - SKIPPED currently due to native-specific testing\n");
-            fflush(stdout);
-        }
-        /* file_image_daisy_chain_test(); */
-    }
-
-    if ((mpi_size < 2) && MAINPROCESS) {
-        HDprintf("Atomicity tests need at least 2 processes to participate\n");
-        HDprintf("8 is more recommended.. Atomicity tests will be skipped \n");
-    }
-    else if (facc_type != FACC_MPIO && MAINPROCESS) {
-        HDprintf("Atomicity tests will not work with a non MPIO VFD\n");
-    }
-    else if (mpi_size >= 2 && facc_type == FACC_MPIO) {
-#if 0
-        AddTest("atomicity", dataset_atomicity, NULL,
-                "dataset atomic updates", PARATESTFILE);
-#endif
+    /* Atomicity tests will not work with a non MPIO VFD; 8 processes are recommended */
+    AddTest("atomicity", NULL /* dataset_atomicity */, "dataset atomic updates", 2);
 
-        if (MAINPROCESS) {
-            printf("dataset atomic updates - SKIPPED currently due to native-specific testing\n");
-            fflush(stdout);
-        }
-        /* dataset_atomicity(); */
-    }
+    AddTest("denseattr", test_dense_attr, "Store Dense Attributes", 1);
 
-#if 0
-    AddTest("denseattr", test_dense_attr, NULL,
-            "Store Dense Attributes", PARATESTFILE);
-#endif
+    AddTest("noselcollmdread", test_partial_no_selection_coll_md_read,
+            "Collective Metadata read with some ranks having no selection", 1);
+    AddTest("MC_coll_MD_read", test_multi_chunk_io_addrmap_issue, "Collective MD read with multi chunk I/O",
+            1);
+    AddTest("LC_coll_MD_read", test_link_chunk_io_sort_chunk_issue, "Collective MD read with link chunk I/O",
+            1);
 
-    if (MAINPROCESS) {
-        printf("Store Dense Attributes\n");
-        fflush(stdout);
+    /* Parse command line arguments, which may pick tests by name */
+    if (parse_options(argc, argv)) {
+        usage();
+        return 1;
     }
-    test_dense_attr();
 
-#if 0
-    AddTest("noselcollmdread", test_partial_no_selection_coll_md_read, NULL,
-            "Collective Metadata read with some ranks having no selection", PARATESTFILE);
-    AddTest("MC_coll_MD_read", test_multi_chunk_io_addrmap_issue, NULL,
-            "Collective MD read with multi chunk I/O (H5D__chunk_addrmap)", PARATESTFILE);
-    AddTest("LC_coll_MD_read", test_link_chunk_io_sort_chunk_issue, NULL,
-            "Collective MD read with link chunk I/O (H5D__sort_chunk)", PARATESTFILE);
-#endif
+    if (list_tests) {
+        if (MAINPROCESS)
+            TestList();
 
-    if (MAINPROCESS) {
-        printf("Collective Metadata read with some ranks having no selection\n");
-        fflush(stdout);
+        H5Pclose(fapl);
+        H5close();
+        MPI_Finalize();
+        return 0;
     }
-    test_partial_no_selection_coll_md_read();
-    if (MAINPROCESS) {
-        printf("Collective MD read with multi chunk I/O\n");
-        fflush(stdout);
-    }
-    test_multi_chunk_io_addrmap_issue();
-    if (MAINPROCESS) {
-        printf("Collective MD read with link chunk I/O\n");
-        fflush(stdout);
-    }
-    test_link_chunk_io_sort_chunk_issue();
-
-    /* Display testing information */
-    /* TestInfo(argv[0]); */
 
     /* setup file access property list */
     H5Pset_fapl_mpio(fapl, MPI_COMM_WORLD, MPI_INFO_NULL);
 
-    /* Parse command line arguments */
-    /* TestParseCmdLine(argc, argv); */
-
     if (dxfer_coll_type == DXFER_INDEPENDENT_IO && MAINPROCESS) {
         HDprintf("===================================\n"
                  "   Using Independent I/O with file set view to replace collective I/O \n"
@@ -954,24 +703,22 @@ main(int argc, char **argv)
     }
 
     /* Perform requested testing */
-    /* PerformTests(); */
+    PerformTests();
 
     /* make sure all processes are finished before final report, cleanup
      * and exit.
      */
     MPI_Barrier(MPI_COMM_WORLD);
 
-    /* Display test summary, if requested */
-    /* if (MAINPROCESS && GetTestSummary())
-        TestSummary(); */
+    /* Display the time taken by each test */
+    if (MAINPROCESS)
+        TestSummary();
 
     /* Clean up test files */
     /* h5_clean_files(FILENAME, fapl); */
     H5Fdelete(FILENAME[0], fapl);
     H5Pclose(fapl);
 
-    /* nerrors += GetTestNumErrs(); */
-
     /* Gather errors from all processes */
     {
         int temp;
@@ -998,9 +745,6 @@ main(int argc, char **argv)
     /* close HDF5 library */
     H5close();
 
-    /* Release test infrastructure */
-    /* TestShutdown(); */
-
     /* MPI_Finalize must be called AFTER H5close which may use MPI calls */
     MPI_Finalize();
 
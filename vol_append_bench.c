@@ -0,0 +1,455 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * Copyright by The HDF Group.                                               *
+ * All rights reserved.                                                      *
+ *                                                                           *
+ * This file is part of HDF5.  The full HDF5 copyright notice, including     *
+ * terms governing use, modification, and redistribution, is contained in    *
+ * the COPYING file, which can be found at the root of the source code       *
+ * distribution tree, or in https://support.hdfgroup.org/ftp/HDF5/releases.  *
+ * If you do not have access to either file, you may request a copy from     *
+ * help@hdfgroup.org.                                                        *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+/*
+ * Benchmarks for appending a stream of records to a dataset. For each
+ * batch size given with --append-batches and chunk size given with
+ * --append-chunks, a one-dimensional chunked dataset with an unlimited
+ * maximum size is created in a file of its own. Its extent is then grown
+ * by a batch of records (elements of --type) with H5Dset_extent and the
+ * new records are written, --appends times over, with the dataset
+ * flushed with H5Dflush after every --flush-every appends.
+ *
+ * Each result reports the sustained rate of the appends, including the
+ * time spent flushing, the latency of each append, and the size of the
+ * file beyond that of the records appended, as a fraction of the records'
+ * size. With --append-reader, the dataset is also opened through a second
+ * file ID, and after each flush it is refreshed with H5Drefresh and the
+ * records appended since the last refresh are read. The reader takes its
+ * turn between the appends rather than running in a thread of its own,
+ * so that it doesn't need a thread-safe build of HDF5.
+ */
+
+#include "vol_append_bench.h"
+
+/* The handles and buffers used by a single run of appends */
+typedef struct append_bench_run_t {
+    hid_t   type_id;
+    size_t  type_size;
+    hsize_t batch;    /* Number of records in each append */
+    hsize_t nrecords; /* Number of records appended so far */
+    hsize_t nread;    /* Number of records read so far by the reader */
+    hid_t   file_id;
+    hid_t   dset_id;
+    hid_t   mspace_id;
+    hid_t   reader_file_id;
+    hid_t   reader_dset_id;
+    void   *buf;
+    void   *rbuf;
+    size_t  rbuf_nelems;
+} append_bench_run_t;
+
+/*
+ * Grows the dataset by a batch of records and writes them, returning
+ * the time taken in seconds, or a negative value on failure.
+ */
+static double
+append_bench_append(append_bench_run_t *run)
+{
+    hsize_t new_size = run->nrecords + run->batch;
+    hid_t   fspace_id;
+    double  t0;
+
+    vol_bench_fill_buffer(run->buf, (size_t)run->batch * run->type_size, run->nrecords * run->type_size);
+
+    t0 = vol_bench_now();
+
+    if (H5Dset_extent(run->dset_id, &new_size) < 0) {
+        HDprintf("    couldn't extend dataset to %llu records\n", (unsigned long long)new_size);
+        return -1.0;
+    }
+
+    if ((fspace_id = H5Dget_space(run->dset_id)) < 0)
+        return -1.0;
+
+    if (H5Sselect_hyperslab(fspace_id, H5S_SELECT_SET, &run->nrecords, NULL, &run->batch, NULL) < 0 ||
+        H5Dwrite(run->dset_id, run->type_id, run->mspace_id, fspace_id, H5P_DEFAULT, run->buf) < 0) {
+        HDprintf("    couldn't write records %llu to %llu\n", (unsigned long long)run->nrecords,
+                 (unsigned long long)(new_size - 1));
+        H5Sclose(fspace_id);
+        return -1.0;
+    }
+
+    if (H5Sclose(fspace_id) < 0)
+        return -1.0;
+
+    run->nrecords = new_size;
+
+    return vol_bench_now() - t0;
+}
+
+/*
+ * Refreshes the reader's view of the dataset and reads the records
+ * appended since it last did, returning the time taken in seconds and
+ * the number of records read, or a negative value on failure.
+ */
+static double
+append_bench_read(append_bench_run_t *run, hsize_t *nread_out)
+{
+    hsize_t size;
+    hsize_t count;
+    hid_t   fspace_id = H5I_INVALID_HID;
+    hid_t   mspace_id = H5I_INVALID_HID;
+    double  t0        = vol_bench_now();
+    double  seconds;
+
+    *nread_out = 0;
+
+    if (H5Drefresh(run->reader_dset_id) < 0) {
+        HDprintf("    couldn't refresh dataset\n");
+        BENCH_ERROR;
+    }
+
+    if ((fspace_id = H5Dget_space(run->reader_dset_id)) < 0)
+        BENCH_ERROR;
+    if (H5Sget_simple_extent_dims(fspace_id, &size, NULL) < 0)
+        BENCH_ERROR;
+
+    if (size < run->nrecords) {
+        HDprintf("    reader saw %llu records rather than %llu\n", (unsigned long long)size,
+                 (unsigned long long)run->nrecords);
+        BENCH_ERROR;
+    }
+
+    count = size - run->nread;
+    if (count > run->rbuf_nelems) {
+        HDprintf("    reader can't hold %llu records\n", (unsigned long long)count);
+        BENCH_ERROR;
+    }
+
+    if (count > 0) {
+        if (H5Sselect_hyperslab(fspace_id, H5S_SELECT_SET, &run->nread, NULL, &count, NULL) < 0)
+            BENCH_ERROR;
+        if ((mspace_id = H5Screate_simple(1, &count, NULL)) < 0)
+            BENCH_ERROR;
+
+        if (H5Dread(run->reader_dset_id, run->type_id, mspace_id, fspace_id, H5P_DEFAULT, run->rbuf) < 0) {
+            HDprintf("    couldn't read records %llu to %llu\n", (unsigned long long)run->nread,
+                     (unsigned long long)(size - 1));
+            BENCH_ERROR;
+        }
+    }
+
+    seconds = vol_bench_now() - t0;
+
+    if (count > 0 && vol_bench_params_g.verify) {
+        hsize_t nmismatch;
+
+        if ((nmismatch = vol_bench_check_buffer(run->rbuf, (size_t)count * run->type_size,
+                                                run->nread * run->type_size)) > 0) {
+            HDprintf("    %llu bytes read by reader didn't match what was written\n",
+                     (unsigned long long)nmismatch);
+            BENCH_ERROR;
+        }
+    }
+
+    run->nread = size;
+    *nread_out = count;
+
+    H5Sclose(mspace_id);
+    H5Sclose(fspace_id);
+
+    return seconds;
+
+error:
+    H5E_BEGIN_TRY
+    {
+        H5Sclose(mspace_id);
+        H5Sclose(fspace_id);
+    }
+    H5E_END_TRY;
+
+    return -1.0;
+}
+
+/*
+ * Reads back all of the records appended and checks them.
+ */
+static herr_t
+append_bench_verify(append_bench_run_t *run)
+{
+    void   *buf = NULL;
+    hsize_t nmismatch;
+
+    if (NULL == (buf = HDmalloc((size_t)run->nrecords * run->type_size)))
+        BENCH_ERROR;
+
+    if (H5Dread(run->dset_id, run->type_id, H5S_ALL, H5S_ALL, H5P_DEFAULT, buf) < 0) {
+        HDprintf("    couldn't read back dataset\n");
+        BENCH_ERROR;
+    }
+
+    if ((nmismatch = vol_bench_check_buffer(buf, (size_t)run->nrecords * run->type_size, 0)) > 0) {
+        HDprintf("    %llu bytes read from dataset didn't match what was appended\n",
+                 (unsigned long long)nmismatch);
+        BENCH_ERROR;
+    }
+
+    HDfree(buf);
+
+    return SUCCEED;
+
+error:
+    HDfree(buf);
+
+    return FAIL;
+}
+
+/*
+ * Appends to a new dataset with the given batch and chunk sizes,
+ * flushing it after every given number of appends (or never if 0),
+ * and reports the results.
+ */
+static int
+append_bench_run(hid_t type_id, hsize_t batch, hsize_t chunk, unsigned flush_every)
+{
+    append_bench_run_t run;
+    vol_bench_stats_t  append_stats;
+    vol_bench_stats_t  flush_stats;
+    vol_bench_stats_t  reader_stats;
+    hbool_t            reader        = vol_bench_params_g.append_reader && flush_every > 0;
+    hsize_t            dims          = 0;
+    hsize_t            max_dims      = H5S_UNLIMITED;
+    hsize_t            reader_nbytes = 0;
+    hsize_t            file_size     = 0;
+    hid_t              space_id      = H5I_INVALID_HID;
+    hid_t              dcpl_id       = H5I_INVALID_HID;
+    char               filename[VOL_TEST_FILENAME_MAX_LENGTH];
+    char               name[APPEND_BENCH_NAME_LENGTH];
+
+    HDmemset(&run, 0, sizeof(run));
+    run.type_id        = type_id;
+    run.batch          = batch;
+    run.file_id        = H5I_INVALID_HID;
+    run.dset_id        = H5I_INVALID_HID;
+    run.mspace_id      = H5I_INVALID_HID;
+    run.reader_file_id = H5I_INVALID_HID;
+    run.reader_dset_id = H5I_INVALID_HID;
+
+    vol_bench_stats_init(&append_stats);
+    vol_bench_stats_init(&flush_stats);
+    vol_bench_stats_init(&reader_stats);
+
+    HDsnprintf(filename, sizeof(filename), "%s%s", test_path_prefix, APPEND_BENCH_FILE_NAME);
+
+    if (0 == (run.type_size = H5Tget_size(type_id)))
+        BENCH_ERROR;
+
+    if ((run.file_id = H5Fcreate(filename, H5F_ACC_TRUNC, H5P_DEFAULT, H5P_DEFAULT)) < 0) {
+        HDprintf("    couldn't create file '%s'\n", filename);
+        BENCH_ERROR;
+    }
+
+    if ((space_id = H5Screate_simple(1, &dims, &max_dims)) < 0)
+        BENCH_ERROR;
+    if ((dcpl_id = H5Pcreate(H5P_DATASET_CREATE)) < 0)
+        BENCH_ERROR;
+    if (H5Pset_chunk(dcpl_id, 1, &chunk) < 0)
+        BENCH_ERROR;
+
+    if ((run.dset_id = H5Dcreate2(run.file_id, APPEND_BENCH_DSET_NAME, type_id, space_id, H5P_DEFAULT,
+                                  dcpl_id, H5P_DEFAULT)) < 0) {
+        HDprintf("    couldn't create dataset '%s'\n", APPEND_BENCH_DSET_NAME);
+        BENCH_ERROR;
+    }
+
+    if ((run.mspace_id = H5Screate_simple(1, &batch, NULL)) < 0)
+        BENCH_ERROR;
+    if (NULL == (run.buf = HDmalloc((size_t)batch * run.type_size)))
+        BENCH_ERROR;
+
+    /* The reader opens the dataset once it has been flushed, and reads at most the records between flushes */
+    if (reader) {
+        if (H5Dflush(run.dset_id) < 0)
+            BENCH_ERROR;
+
+        if ((run.reader_file_id = H5Fopen(filename, H5F_ACC_RDONLY, H5P_DEFAULT)) < 0) {
+            HDprintf("    couldn't open file '%s' for reader\n", filename);
+            BENCH_ERROR;
+        }
+        if ((run.reader_dset_id = H5Dopen2(run.reader_file_id, APPEND_BENCH_DSET_NAME, H5P_DEFAULT)) < 0) {
+            HDprintf("    couldn't open dataset '%s' for reader\n", APPEND_BENCH_DSET_NAME);
+            BENCH_ERROR;
+        }
+
+        run.rbuf_nelems = (size_t)batch * flush_every;
+        if (NULL == (run.rbuf = HDmalloc(run.rbuf_nelems * run.type_size)))
+            BENCH_ERROR;
+    }
+
+    for (unsigned i = 0; i < vol_bench_params_g.appends; i++) {
+        double seconds;
+
+        if ((seconds = append_bench_append(&run)) < 0.0)
+            BENCH_ERROR;
+        if (vol_bench_stats_add(&append_stats, seconds) < 0)
+            BENCH_ERROR;
+
+        if (flush_every > 0 && (i + 1) % flush_every == 0) {
+            double t0 = vol_bench_now();
+
+            if (H5Dflush(run.dset_id) < 0) {
+                HDprintf("    couldn't flush dataset\n");
+                BENCH_ERROR;
+            }
+            if (vol_bench_stats_add(&flush_stats, vol_bench_now() - t0) < 0)
+                BENCH_ERROR;
+
+            if (reader) {
+                hsize_t nread;
+
+                if ((seconds = append_bench_read(&run, &nread)) < 0.0)
+                    BENCH_ERROR;
+                if (vol_bench_stats_add(&reader_stats, seconds) < 0)
+                    BENCH_ERROR;
+
+                reader_nbytes += nread * run.type_size;
+            }
+        }
+    }
+
+    if (vol_bench_params_g.verify && append_bench_verify(&run) < 0)
+        BENCH_ERROR;
+
+    /* Flush everything out first, so that the size is that of the file as it would be left */
+    if (vol_cap_flags_g & H5VL_CAP_FLAG_FILE_MORE) {
+        if (H5Fflush(run.file_id, H5F_SCOPE_LOCAL) < 0)
+            BENCH_ERROR;
+        if (H5Fget_filesize(run.file_id, &file_size) < 0)
+            BENCH_ERROR;
+    }
+
+    /* The sustained rate of the appends includes the time spent flushing */
+    append_stats.total += flush_stats.total;
+
+    HDsnprintf(name, sizeof(name), "append %llu records chunk %llu", (unsigned long long)batch,
+               (unsigned long long)chunk);
+    if (file_size > 0) {
+        double data_size = (double)(run.nrecords * run.type_size);
+
+        vol_bench_report_metric("append", name, run.nrecords * run.type_size, &append_stats, "file_overhead",
+                                ((double)file_size - data_size) / data_size);
+    }
+    else
+        vol_bench_report("append", name, run.nrecords * run.type_size, &append_stats);
+
+    if (flush_stats.nsamples > 0) {
+        HDsnprintf(name, sizeof(name), "flush every %u appends chunk %llu", flush_every,
+                   (unsigned long long)chunk);
+        vol_bench_report("append", name, 0, &flush_stats);
+    }
+
+    if (reader_stats.nsamples > 0) {
+        HDsnprintf(name, sizeof(name), "refresh and read chunk %llu", (unsigned long long)chunk);
+        vol_bench_report("append", name, reader_nbytes, &reader_stats);
+    }
+
+    if (run.reader_dset_id >= 0 && H5Dclose(run.reader_dset_id) < 0)
+        BENCH_ERROR;
+    if (run.reader_file_id >= 0 && H5Fclose(run.reader_file_id) < 0)
+        BENCH_ERROR;
+    if (H5Sclose(run.mspace_id) < 0)
+        BENCH_ERROR;
+    if (H5Pclose(dcpl_id) < 0)
+        BENCH_ERROR;
+    if (H5Sclose(space_id) < 0)
+        BENCH_ERROR;
+    if (H5Dclose(run.dset_id) < 0)
+        BENCH_ERROR;
+    if (H5Fclose(run.file_id) < 0)
+        BENCH_ERROR;
+
+    H5Fdelete(filename, H5P_DEFAULT);
+
+    HDfree(run.buf);
+    HDfree(run.rbuf);
+    vol_bench_stats_free(&append_stats);
+    vol_bench_stats_free(&flush_stats);
+    vol_bench_stats_free(&reader_stats);
+
+    return 0;
+
+error:
+    H5E_BEGIN_TRY
+    {
+        H5Dclose(run.reader_dset_id);
+        H5Fclose(run.reader_file_id);
+        H5Sclose(run.mspace_id);
+        H5Pclose(dcpl_id);
+        H5Sclose(space_id);
+        H5Dclose(run.dset_id);
+        H5Fclose(run.file_id);
+        H5Fdelete(filename, H5P_DEFAULT);
+    }
+    H5E_END_TRY;
+
+    HDfree(run.buf);
+    HDfree(run.rbuf);
+    vol_bench_stats_free(&append_stats);
+    vol_bench_stats_free(&flush_stats);
+    vol_bench_stats_free(&reader_stats);
+
+    return 1;
+}
+
+int
+vol_append_bench(void)
+{
+    hsize_t  batches[VOL_BENCH_MAX_LIST_VALUES];
+    hsize_t  chunks[VOL_BENCH_MAX_LIST_VALUES];
+    size_t   nbatches;
+    size_t   nchunks;
+    unsigned flush_every = vol_bench_params_g.flush_every;
+    int      nerrors     = 0;
+    hid_t    type_id     = vol_bench_type();
+
+    HDprintf("**********************************************\n");
+    HDprintf("*                                            *\n");
+    HDprintf("*       VOL Append Stream Benchmarks         *\n");
+    HDprintf("*                                            *\n");
+    HDprintf("**********************************************\n\n");
+
+    /* Make sure the connector supports the API functions being benchmarked */
+    if (!(vol_cap_flags_g & H5VL_CAP_FLAG_FILE_BASIC) || !(vol_cap_flags_g & H5VL_CAP_FLAG_DATASET_BASIC) ||
+        !(vol_cap_flags_g & H5VL_CAP_FLAG_DATASET_MORE)) {
+        BENCH_SKIPPED("append stream",
+                      "API functions for basic file, basic dataset, or more dataset aren't supported with "
+                      "this connector");
+        HDprintf("\n");
+        return 0;
+    }
+
+    if (flush_every > 0 && !(vol_cap_flags_g & H5VL_CAP_FLAG_FLUSH_REFRESH)) {
+        BENCH_SKIPPED("append stream flushes and reader",
+                      "API functions for flush or refresh aren't supported with this connector");
+        flush_every = 0;
+    }
+
+    /* These were checked when the command line was parsed */
+    if (vol_bench_parse_size_list(vol_bench_params_g.append_batches, batches, &nbatches) < 0)
+        BENCH_ERROR;
+    if (vol_bench_parse_size_list(vol_bench_params_g.append_chunks, chunks, &nchunks) < 0)
+        BENCH_ERROR;
+
+    for (size_t c = 0; c < nchunks; c++)
+        for (size_t b = 0; b < nbatches; b++)
+            nerrors += append_bench_run(type_id, batches[b], chunks[c], flush_every);
+
+    HDprintf("\n");
+
+    return nerrors;
+
+error:
+    HDprintf("\n");
+
+    return nerrors + 1;
+}
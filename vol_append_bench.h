@@ -0,0 +1,31 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * Copyright by The HDF Group.                                               *
+ * All rights reserved.                                                      *
+ *                                                                           *
+ * This file is part of HDF5.  The full HDF5 copyright notice, including     *
+ * terms governing use, modification, and redistribution, is contained in    *
+ * the COPYING file, which can be found at the root of the source code       *
+ * distribution tree, or in https://support.hdfgroup.org/ftp/HDF5/releases.  *
+ * If you do not have access to either file, you may request a copy from     *
+ * help@hdfgroup.org.                                                        *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#ifndef VOL_APPEND_BENCH_H
+#define VOL_APPEND_BENCH_H
+
+#include "vol_bench.h"
+
+int vol_append_bench(void);
+
+/********************************************************
+ *                                                      *
+ *      VOL connector append stream benchmark defines   *
+ *                                                      *
+ *******************************************************/
+
+#define APPEND_BENCH_FILE_NAME "append_bench.h5"
+#define APPEND_BENCH_DSET_NAME "records"
+
+#define APPEND_BENCH_NAME_LENGTH 128
+
+#endif
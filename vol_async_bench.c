@@ -0,0 +1,455 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * Copyright by The HDF Group.                                               *
+ * All rights reserved.                                                      *
+ *                                                                           *
+ * This file is part of HDF5.  The full HDF5 copyright notice, including     *
+ * terms governing use, modification, and redistribution, is contained in    *
+ * the COPYING file, which can be found at the root of the source code       *
+ * distribution tree, or in https://support.hdfgroup.org/ftp/HDF5/releases.  *
+ * If you do not have access to either file, you may request a copy from     *
+ * help@hdfgroup.org.                                                        *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+
+/*
+ * Benchmarks for the event set (async) API. A one-dimensional dataset
+ * of --size bytes is written and read back in --xfer-size blocks,
+ * with a synthetic compute kernel run after each block is issued, as
+ * an application would between I/O calls:
+ *
+ * - synchronously, without the compute kernel, to measure the time
+ *   taken by the I/O alone
+ * - synchronously, with the compute kernel, as the baseline
+ * - with H5Dwrite_async/H5Dread_async, for each depth K given with
+ *   --async-depths, waiting on the event set with H5ESwait each time
+ *   K operations are in flight
+ *
+ * By default, the compute kernel runs for as long as a synchronous
+ * I/O operation takes, so that perfect overlap would halve the time
+ * taken; --compute-usec sets it explicitly. Each async result reports
+ * the overlap achieved: the fraction of the shorter of the total I/O
+ * and compute times hidden behind the other, from 0 (no overlap) to
+ * 1 (perfect overlap). The latency of each H5ESwait call is reported
+ * separately.
+ */
+
+#include "vol_async_bench.h"
+
+#ifdef H5ESpublic_H
+
+/* The dataset being benchmarked and the buffers for each operation in flight */
+typedef struct async_bench_ctx_t {
+    hid_t    dset_id;
+    hid_t    type_id;
+    size_t   type_size;
+    hsize_t  nelems;       /* Number of elements in the dataset */
+    hsize_t  block_nelems; /* Number of elements in each full block */
+    hsize_t  nblocks;
+    void   **bufs;
+    size_t   nbufs;
+    double   compute_seconds;
+} async_bench_ctx_t;
+
+/* The ways in which each pass over the dataset is made */
+typedef enum async_bench_mode_t {
+    ASYNC_BENCH_SYNC,         /* Synchronous I/O only */
+    ASYNC_BENCH_SYNC_COMPUTE, /* Synchronous I/O followed by the compute kernel */
+    ASYNC_BENCH_ASYNC_COMPUTE /* Async I/O followed by the compute kernel */
+} async_bench_mode_t;
+
+/* Keeps the compute kernel from being optimized away */
+static volatile double async_bench_sink;
+
+/*
+ * The synthetic compute kernel, which spins doing
+ * floating-point work for the given number of seconds.
+ */
+static void
+async_bench_compute(double seconds)
+{
+    double start = vol_bench_now();
+    double x     = 1.0;
+
+    if (seconds <= 0.0)
+        return;
+
+    do {
+        for (int i = 0; i < 1024; i++)
+            x = x * 1.000001 + 0.000001;
+    } while (vol_bench_now() - start < seconds);
+
+    async_bench_sink = x;
+}
+
+/*
+ * Makes one pass over the dataset in the given mode, adding the
+ * latency of each synchronous I/O operation or H5ESwait call to the
+ * given stats. Returns the time taken, in seconds, not counting the time
+ * spent filling or verifying buffers, or a negative value on failure.
+ */
+static double
+async_bench_pass(async_bench_ctx_t *ctx, hbool_t write, async_bench_mode_t mode, size_t depth,
+                 vol_bench_stats_t *stats)
+{
+    hid_t   es_id     = H5I_INVALID_HID;
+    hid_t   fspace_id = H5I_INVALID_HID;
+    hid_t   mspace_id = H5I_INVALID_HID;
+    size_t  in_flight = 0;
+    size_t  num_in_progress;
+    hbool_t op_failed = FALSE;
+    double  excluded  = 0.0;
+    double  start;
+
+    if (mode == ASYNC_BENCH_ASYNC_COMPUTE && (es_id = H5EScreate()) < 0)
+        BENCH_ERROR;
+
+    start = vol_bench_now();
+
+    for (hsize_t block = 0; block < ctx->nblocks; block++) {
+        hsize_t offset = block * ctx->block_nelems;
+        hsize_t count  = MIN(ctx->block_nelems, ctx->nelems - offset);
+        void   *buf    = ctx->bufs[in_flight];
+        herr_t  err;
+
+        if ((fspace_id = H5Dget_space(ctx->dset_id)) < 0)
+            BENCH_ERROR;
+        if (H5Sselect_hyperslab(fspace_id, H5S_SELECT_SET, &offset, NULL, &count, NULL) < 0)
+            BENCH_ERROR;
+        if ((mspace_id = H5Screate_simple(1, &count, NULL)) < 0)
+            BENCH_ERROR;
+
+        if (write) {
+            double t0 = vol_bench_now();
+
+            vol_bench_fill_buffer(buf, (size_t)count * ctx->type_size, offset * ctx->type_size);
+            excluded += vol_bench_now() - t0;
+        }
+
+        if (mode == ASYNC_BENCH_ASYNC_COMPUTE) {
+            if (write)
+                err = H5Dwrite_async(ctx->dset_id, ctx->type_id, mspace_id, fspace_id, H5P_DEFAULT, buf,
+                                     es_id);
+            else
+                err = H5Dread_async(ctx->dset_id, ctx->type_id, mspace_id, fspace_id, H5P_DEFAULT, buf,
+                                    es_id);
+        }
+        else {
+            double t0 = vol_bench_now();
+
+            if (write)
+                err = H5Dwrite(ctx->dset_id, ctx->type_id, mspace_id, fspace_id, H5P_DEFAULT, buf);
+            else
+                err = H5Dread(ctx->dset_id, ctx->type_id, mspace_id, fspace_id, H5P_DEFAULT, buf);
+
+            if (err >= 0 && vol_bench_stats_add(stats, vol_bench_now() - t0) < 0)
+                BENCH_ERROR;
+        }
+
+        if (err < 0) {
+            HDprintf("    couldn't %s dataset\n", write ? "write to" : "read from");
+            BENCH_ERROR;
+        }
+
+        /* The async VOL connector keeps its own copies of the dataspaces */
+        if (H5Sclose(mspace_id) < 0)
+            BENCH_ERROR;
+        mspace_id = H5I_INVALID_HID;
+        if (H5Sclose(fspace_id) < 0)
+            BENCH_ERROR;
+        fspace_id = H5I_INVALID_HID;
+
+        if (mode != ASYNC_BENCH_SYNC)
+            async_bench_compute(ctx->compute_seconds);
+
+        /* Drain the pipeline once it is full, or at the end of the pass */
+        in_flight++;
+        if (in_flight == depth || block == ctx->nblocks - 1) {
+            if (mode == ASYNC_BENCH_ASYNC_COMPUTE) {
+                double t0 = vol_bench_now();
+
+                if (H5ESwait(es_id, VOL_TEST_WAIT_FOREVER, &num_in_progress, &op_failed) < 0 || op_failed) {
+                    HDprintf("    async %s failed\n", write ? "write" : "read");
+                    BENCH_ERROR;
+                }
+
+                if (vol_bench_stats_add(stats, vol_bench_now() - t0) < 0)
+                    BENCH_ERROR;
+            }
+
+            if (!write && vol_bench_params_g.verify) {
+                double t0 = vol_bench_now();
+
+                for (size_t i = 0; i < in_flight; i++) {
+                    hsize_t buf_block  = block + 1 - in_flight + i;
+                    hsize_t buf_offset = buf_block * ctx->block_nelems;
+                    hsize_t buf_count  = MIN(ctx->block_nelems, ctx->nelems - buf_offset);
+                    hsize_t nmismatch;
+
+                    if ((nmismatch = vol_bench_check_buffer(ctx->bufs[i], (size_t)buf_count * ctx->type_size,
+                                                            buf_offset * ctx->type_size)) > 0) {
+                        HDprintf("    %llu bytes read from dataset didn't match what was written\n",
+                                 (unsigned long long)nmismatch);
+                        BENCH_ERROR;
+                    }
+                }
+
+                excluded += vol_bench_now() - t0;
+            }
+
+            in_flight = 0;
+        }
+    }
+
+    if (es_id >= 0 && H5ESclose(es_id) < 0)
+        BENCH_ERROR;
+
+    return vol_bench_now() - start - excluded;
+
+error:
+    H5E_BEGIN_TRY
+    {
+        H5Sclose(mspace_id);
+        H5Sclose(fspace_id);
+        if (es_id >= 0) {
+            H5ESwait(es_id, VOL_TEST_WAIT_FOREVER, &num_in_progress, &op_failed);
+            H5ESclose(es_id);
+        }
+    }
+    H5E_END_TRY;
+
+    return -1.0;
+}
+
+/*
+ * Runs the synchronous passes and then the async passes
+ * at each depth, for either writes or reads.
+ */
+static int
+async_bench_io(async_bench_ctx_t *ctx, hbool_t write, const hsize_t *depths, size_t ndepths)
+{
+    vol_bench_stats_t io_stats;
+    vol_bench_stats_t sync_stats;
+    vol_bench_stats_t wait_stats;
+    vol_bench_stats_t pass_stats;
+    hsize_t           nbytes = ctx->nelems * ctx->type_size * vol_bench_params_g.iterations;
+    double            io_seconds, sync_seconds, compute_seconds;
+    const char       *op = write ? "write" : "read";
+    char              name[ASYNC_BENCH_NAME_LENGTH];
+
+    vol_bench_stats_init(&io_stats);
+    vol_bench_stats_init(&sync_stats);
+    vol_bench_stats_init(&wait_stats);
+    vol_bench_stats_init(&pass_stats);
+
+    /* I/O alone, which also sets the default time taken by the compute kernel */
+    io_seconds = 0.0;
+    for (unsigned i = 0; i < vol_bench_params_g.iterations; i++) {
+        double seconds;
+
+        if ((seconds = async_bench_pass(ctx, write, ASYNC_BENCH_SYNC, 1, &io_stats)) < 0.0)
+            BENCH_ERROR;
+        io_seconds += seconds;
+    }
+
+    HDsnprintf(name, sizeof(name), "%s sync", op);
+    vol_bench_report("async", name, nbytes, &io_stats);
+
+    if (vol_bench_params_g.compute_usec > 0)
+        ctx->compute_seconds = (double)vol_bench_params_g.compute_usec / 1.0E6;
+    else
+        ctx->compute_seconds = io_stats.total / (double)io_stats.nsamples;
+
+    compute_seconds = ctx->compute_seconds * (double)ctx->nblocks * vol_bench_params_g.iterations;
+
+    /* The synchronous baseline */
+    for (unsigned i = 0; i < vol_bench_params_g.iterations; i++) {
+        double seconds;
+
+        if ((seconds = async_bench_pass(ctx, write, ASYNC_BENCH_SYNC_COMPUTE, 1, &sync_stats)) < 0.0)
+            BENCH_ERROR;
+        if (vol_bench_stats_add(&pass_stats, seconds) < 0)
+            BENCH_ERROR;
+    }
+
+    sync_seconds = pass_stats.total;
+
+    HDsnprintf(name, sizeof(name), "%s sync+compute", op);
+    vol_bench_report("async", name, nbytes, &pass_stats);
+    vol_bench_stats_free(&pass_stats);
+
+    for (size_t d = 0; d < ndepths; d++) {
+        double hideable = MIN(io_seconds, compute_seconds);
+        double overlap;
+
+        for (unsigned i = 0; i < vol_bench_params_g.iterations; i++) {
+            double seconds;
+
+            if ((seconds = async_bench_pass(ctx, write, ASYNC_BENCH_ASYNC_COMPUTE, (size_t)depths[d],
+                                            &wait_stats)) < 0.0)
+                BENCH_ERROR;
+            if (vol_bench_stats_add(&pass_stats, seconds) < 0)
+                BENCH_ERROR;
+        }
+
+        overlap = (hideable > 0.0) ? (sync_seconds - pass_stats.total) / hideable : 0.0;
+        overlap = MAX(0.0, MIN(1.0, overlap));
+
+        HDsnprintf(name, sizeof(name), "%s async+compute depth %llu", op, (unsigned long long)depths[d]);
+        vol_bench_report_metric("async", name, nbytes, &pass_stats, "overlap", overlap);
+
+        HDsnprintf(name, sizeof(name), "%s H5ESwait depth %llu", op, (unsigned long long)depths[d]);
+        vol_bench_report("async", name, 0, &wait_stats);
+
+        vol_bench_stats_free(&pass_stats);
+        vol_bench_stats_free(&wait_stats);
+    }
+
+    vol_bench_stats_free(&io_stats);
+    vol_bench_stats_free(&sync_stats);
+
+    return 0;
+
+error:
+    vol_bench_stats_free(&io_stats);
+    vol_bench_stats_free(&sync_stats);
+    vol_bench_stats_free(&wait_stats);
+    vol_bench_stats_free(&pass_stats);
+
+    return 1;
+}
+
+int
+vol_async_bench(void)
+{
+    async_bench_ctx_t ctx;
+    hsize_t           depths[VOL_BENCH_MAX_LIST_VALUES];
+    size_t            ndepths;
+    int               nerrors   = 0;
+    hid_t             file_id   = H5I_INVALID_HID;
+    hid_t             group_id  = H5I_INVALID_HID;
+    hid_t             fspace_id = H5I_INVALID_HID;
+
+    HDmemset(&ctx, 0, sizeof(ctx));
+    ctx.dset_id = H5I_INVALID_HID;
+
+    HDprintf("**********************************************\n");
+    HDprintf("*                                            *\n");
+    HDprintf("*            VOL Async Benchmarks            *\n");
+    HDprintf("*                                            *\n");
+    HDprintf("**********************************************\n\n");
+
+    /* Make sure the connector supports the API functions being benchmarked */
+    if (!(vol_cap_flags_g & H5VL_CAP_FLAG_FILE_BASIC) || !(vol_cap_flags_g & H5VL_CAP_FLAG_GROUP_BASIC) ||
+        !(vol_cap_flags_g & H5VL_CAP_FLAG_DATASET_BASIC) || !(vol_cap_flags_g & H5VL_CAP_FLAG_ASYNC)) {
+        BENCH_SKIPPED("async dataset I/O",
+                      "API functions for basic file, group, dataset, or async aren't supported with this "
+                      "connector");
+        HDprintf("\n");
+        return 0;
+    }
+
+    /* This was checked when the command line was parsed */
+    if (vol_bench_parse_size_list(vol_bench_params_g.async_depths, depths, &ndepths) < 0)
+        BENCH_ERROR;
+
+    ctx.type_id = vol_bench_type();
+    if (0 == (ctx.type_size = H5Tget_size(ctx.type_id)))
+        BENCH_ERROR;
+
+    ctx.nelems       = vol_bench_params_g.dataset_size / ctx.type_size;
+    ctx.block_nelems = MAX(1, vol_bench_params_g.xfer_size / ctx.type_size);
+    if (ctx.nelems == 0) {
+        HDprintf("    dataset size of %llu bytes is smaller than a single element\n",
+                 (unsigned long long)vol_bench_params_g.dataset_size);
+        BENCH_ERROR;
+    }
+    ctx.nblocks = (ctx.nelems + ctx.block_nelems - 1) / ctx.block_nelems;
+
+    /* One buffer for each operation that can be in flight at once */
+    ctx.nbufs = 1;
+    for (size_t i = 0; i < ndepths; i++)
+        ctx.nbufs = MAX(ctx.nbufs, (size_t)MIN(depths[i], ctx.nblocks));
+
+    if (NULL == (ctx.bufs = HDcalloc(ctx.nbufs, sizeof(void *))))
+        BENCH_ERROR;
+    for (size_t i = 0; i < ctx.nbufs; i++)
+        if (NULL == (ctx.bufs[i] = HDmalloc((size_t)ctx.block_nelems * ctx.type_size)))
+            BENCH_ERROR;
+
+    if ((file_id = H5Fopen(vol_bench_filename, H5F_ACC_RDWR, H5P_DEFAULT)) < 0) {
+        HDprintf("    couldn't open file '%s'\n", vol_bench_filename);
+        BENCH_ERROR;
+    }
+
+    if ((group_id = H5Gcreate2(file_id, ASYNC_BENCH_GROUP_NAME, H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT)) < 0) {
+        HDprintf("    couldn't create container group '%s'\n", ASYNC_BENCH_GROUP_NAME);
+        BENCH_ERROR;
+    }
+
+    if ((fspace_id = H5Screate_simple(1, &ctx.nelems, NULL)) < 0)
+        BENCH_ERROR;
+
+    if ((ctx.dset_id = H5Dcreate2(group_id, ASYNC_BENCH_DSET_NAME, ctx.type_id, fspace_id, H5P_DEFAULT,
+                                  H5P_DEFAULT, H5P_DEFAULT)) < 0) {
+        HDprintf("    couldn't create dataset '%s'\n", ASYNC_BENCH_DSET_NAME);
+        BENCH_ERROR;
+    }
+
+    nerrors += async_bench_io(&ctx, TRUE, depths, ndepths);
+    nerrors += async_bench_io(&ctx, FALSE, depths, ndepths);
+
+    if (H5Dclose(ctx.dset_id) < 0)
+        BENCH_ERROR;
+    if (H5Sclose(fspace_id) < 0)
+        BENCH_ERROR;
+    if (H5Gclose(group_id) < 0)
+        BENCH_ERROR;
+    if (H5Fclose(file_id) < 0)
+        BENCH_ERROR;
+
+    for (size_t i = 0; i < ctx.nbufs; i++)
+        HDfree(ctx.bufs[i]);
+    HDfree(ctx.bufs);
+
+    HDprintf("\n");
+
+    return nerrors;
+
+error:
+    H5E_BEGIN_TRY
+    {
+        H5Dclose(ctx.dset_id);
+        H5Sclose(fspace_id);
+        H5Gclose(group_id);
+        H5Fclose(file_id);
+    }
+    H5E_END_TRY;
+
+    if (ctx.bufs) {
+        for (size_t i = 0; i < ctx.nbufs; i++)
+            HDfree(ctx.bufs[i]);
+        HDfree(ctx.bufs);
+    }
+
+    HDprintf("\n");
+
+    return nerrors + 1;
+}
+
+#else /* H5ESpublic_H */
+
+int
+vol_async_bench(void)
+{
+    HDprintf("**********************************************\n");
+    HDprintf("*                                            *\n");
+    HDprintf("*            VOL Async Benchmarks            *\n");
+    HDprintf("*                                            *\n");
+    HDprintf("**********************************************\n\n");
+
+    HDprintf("SKIPPED due to no async support in HDF5 library\n\n");
+
+    return 0;
+}
+
+#endif /* H5ESpublic_H */
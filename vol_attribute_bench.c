@@ -0,0 +1,386 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * Copyright by The HDF Group.                                               *
+ * All rights reserved.                                                      *
+ *                                                                           *
+ * This file is part of HDF5.  The full HDF5 copyright notice, including     *
+ * terms governing use, modification, and redistribution, is contained in    *
+ * the COPYING file, which can be found at the root of the source code       *
+ * distribution tree, or in https://support.hdfgroup.org/ftp/HDF5/releases.  *
+ * If you do not have access to either file, you may request a copy from     *
+ * help@hdfgroup.org.                                                        *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+
+/*
+ * Benchmarks for objects carrying many attributes. For each attribute
+ * count given with --attr-counts and each compact storage threshold
+ * given with --attr-phase-change, a group is created with that
+ * threshold set by H5Pset_attr_phase_change and that many attributes
+ * are attached to it. The attributes are then opened by name, opened
+ * by index with H5Aopen_by_idx on the name index and, if the connector
+ * supports it, the creation order index, iterated over with
+ * H5Aiterate2 and finally deleted by name.
+ *
+ * As the thresholds decide where the attributes move from compact
+ * storage in the object header to dense storage, sweeping them shows
+ * how the cost of each operation changes across that switch.
+ */
+
+#include "vol_attribute_bench.h"
+
+/* A single point in the sweep */
+typedef struct attribute_bench_config_t {
+    hsize_t  nattrs;
+    unsigned max_compact;
+    unsigned min_dense;
+    hbool_t  crt_order; /* Whether the creation order of the attributes is tracked */
+} attribute_bench_config_t;
+
+typedef struct attribute_bench_iter_ud_t {
+    vol_bench_stats_t *stats;
+    double             last;
+    hsize_t            nattrs;
+} attribute_bench_iter_ud_t;
+
+static const char *
+attribute_bench_attr_name(hsize_t idx, char *buf, size_t buf_size)
+{
+    HDsnprintf(buf, buf_size, "attr%llu", (unsigned long long)idx);
+
+    return buf;
+}
+
+static void
+attribute_bench_report(const char *op, const attribute_bench_config_t *config, vol_bench_stats_t *stats)
+{
+    char name[ATTRIBUTE_BENCH_NAME_LENGTH];
+
+    HDsnprintf(name, sizeof(name), "%s %llu attrs compact<=%u", op, (unsigned long long)config->nattrs,
+               config->max_compact);
+
+    vol_bench_report("attribute", name, 0, stats);
+}
+
+/*
+ * Times each step of H5Aiterate2 as the time since the previous
+ * attribute was visited, or since the iteration began for the first.
+ */
+static herr_t
+attribute_bench_iter_cb(hid_t location_id, const char *attr_name, const H5A_info_t *ainfo, void *op_data)
+{
+    attribute_bench_iter_ud_t *udata = (attribute_bench_iter_ud_t *)op_data;
+    double                     now   = vol_bench_now();
+
+    (void)location_id;
+    (void)attr_name;
+    (void)ainfo;
+
+    if (vol_bench_stats_add(udata->stats, now - udata->last) < 0)
+        return H5_ITER_ERROR;
+
+    udata->last = now;
+    udata->nattrs++;
+
+    return H5_ITER_CONT;
+}
+
+/*
+ * Opens every attribute of the object by its position in the given
+ * index, the given number of times, and reports the results.
+ */
+static int
+attribute_bench_open_by_idx(hid_t obj_id, const attribute_bench_config_t *config, H5_index_t idx_type)
+{
+    vol_bench_stats_t stats;
+    hid_t             attr_id = H5I_INVALID_HID;
+
+    vol_bench_stats_init(&stats);
+
+    for (unsigned n = 0; n < vol_bench_params_g.iterations; n++)
+        for (hsize_t i = 0; i < config->nattrs; i++) {
+            double t0 = vol_bench_now();
+
+            if ((attr_id = H5Aopen_by_idx(obj_id, ".", idx_type, H5_ITER_INC, i, H5P_DEFAULT, H5P_DEFAULT)) <
+                0) {
+                HDprintf("    couldn't open attribute at index %llu by %s\n", (unsigned long long)i,
+                         (idx_type == H5_INDEX_CRT_ORDER) ? "creation order" : "name");
+                BENCH_ERROR;
+            }
+
+            if (vol_bench_stats_add(&stats, vol_bench_now() - t0) < 0)
+                BENCH_ERROR;
+
+            if (H5Aclose(attr_id) < 0)
+                BENCH_ERROR;
+            attr_id = H5I_INVALID_HID;
+        }
+
+    attribute_bench_report((idx_type == H5_INDEX_CRT_ORDER) ? "open-idx-crt" : "open-idx-name", config,
+                           &stats);
+    vol_bench_stats_free(&stats);
+
+    return 0;
+
+error:
+    H5E_BEGIN_TRY
+    {
+        H5Aclose(attr_id);
+    }
+    H5E_END_TRY;
+
+    vol_bench_stats_free(&stats);
+
+    return 1;
+}
+
+/*
+ * Attaches the attributes of a single configuration to the given
+ * object, then opens, iterates over and deletes them.
+ */
+static int
+attribute_bench_config(hid_t obj_id, const attribute_bench_config_t *config)
+{
+    attribute_bench_iter_ud_t iter_udata;
+    vol_bench_stats_t         stats;
+    char                      attr_name[ATTRIBUTE_BENCH_ATTR_NAME_LENGTH];
+    hid_t                     space_id = H5I_INVALID_HID;
+    hid_t                     attr_id  = H5I_INVALID_HID;
+    int                       nerrors  = 0;
+
+    vol_bench_stats_init(&stats);
+
+    if ((space_id = H5Screate(H5S_SCALAR)) < 0)
+        BENCH_ERROR;
+
+    for (hsize_t i = 0; i < config->nattrs; i++) {
+        double t0 = vol_bench_now();
+
+        if ((attr_id = H5Acreate2(obj_id, attribute_bench_attr_name(i, attr_name, sizeof(attr_name)),
+                                  H5T_NATIVE_INT, space_id, H5P_DEFAULT, H5P_DEFAULT)) < 0) {
+            HDprintf("    couldn't create attribute '%s'\n", attr_name);
+            BENCH_ERROR;
+        }
+
+        if (vol_bench_stats_add(&stats, vol_bench_now() - t0) < 0)
+            BENCH_ERROR;
+
+        if (H5Aclose(attr_id) < 0)
+            BENCH_ERROR;
+        attr_id = H5I_INVALID_HID;
+    }
+
+    attribute_bench_report("create", config, &stats);
+    vol_bench_stats_free(&stats);
+
+    for (unsigned n = 0; n < vol_bench_params_g.iterations; n++)
+        for (hsize_t i = 0; i < config->nattrs; i++) {
+            double t0;
+
+            attribute_bench_attr_name(i, attr_name, sizeof(attr_name));
+            t0 = vol_bench_now();
+
+            if ((attr_id = H5Aopen(obj_id, attr_name, H5P_DEFAULT)) < 0) {
+                HDprintf("    couldn't open attribute '%s'\n", attr_name);
+                BENCH_ERROR;
+            }
+
+            if (vol_bench_stats_add(&stats, vol_bench_now() - t0) < 0)
+                BENCH_ERROR;
+
+            if (H5Aclose(attr_id) < 0)
+                BENCH_ERROR;
+            attr_id = H5I_INVALID_HID;
+        }
+
+    attribute_bench_report("open-name", config, &stats);
+    vol_bench_stats_free(&stats);
+
+    nerrors += attribute_bench_open_by_idx(obj_id, config, H5_INDEX_NAME);
+    if (config->crt_order)
+        nerrors += attribute_bench_open_by_idx(obj_id, config, H5_INDEX_CRT_ORDER);
+
+    for (unsigned n = 0; n < vol_bench_params_g.iterations; n++) {
+        iter_udata.stats  = &stats;
+        iter_udata.nattrs = 0;
+        iter_udata.last   = vol_bench_now();
+
+        if (H5Aiterate2(obj_id, H5_INDEX_NAME, H5_ITER_NATIVE, NULL, attribute_bench_iter_cb, &iter_udata) <
+            0) {
+            HDprintf("    couldn't iterate over attributes\n");
+            BENCH_ERROR;
+        }
+
+        if (iter_udata.nattrs != config->nattrs) {
+            HDprintf("    iteration visited %llu attributes instead of %llu\n",
+                     (unsigned long long)iter_udata.nattrs, (unsigned long long)config->nattrs);
+            BENCH_ERROR;
+        }
+    }
+
+    attribute_bench_report("iterate", config, &stats);
+    vol_bench_stats_free(&stats);
+
+    for (hsize_t i = 0; i < config->nattrs; i++) {
+        double t0;
+
+        attribute_bench_attr_name(i, attr_name, sizeof(attr_name));
+        t0 = vol_bench_now();
+
+        if (H5Adelete(obj_id, attr_name) < 0) {
+            HDprintf("    couldn't delete attribute '%s'\n", attr_name);
+            BENCH_ERROR;
+        }
+
+        if (vol_bench_stats_add(&stats, vol_bench_now() - t0) < 0)
+            BENCH_ERROR;
+    }
+
+    attribute_bench_report("delete", config, &stats);
+    vol_bench_stats_free(&stats);
+
+    if (H5Sclose(space_id) < 0)
+        BENCH_ERROR;
+
+    return nerrors;
+
+error:
+    H5E_BEGIN_TRY
+    {
+        H5Aclose(attr_id);
+        H5Sclose(space_id);
+    }
+    H5E_END_TRY;
+
+    vol_bench_stats_free(&stats);
+
+    return nerrors + 1;
+}
+
+int
+vol_attribute_bench(void)
+{
+    attribute_bench_config_t config;
+    hsize_t                  attr_counts[VOL_BENCH_MAX_LIST_VALUES];
+    hsize_t                  phase_changes[VOL_BENCH_MAX_LIST_VALUES];
+    size_t                   nattr_counts, nphase_changes;
+    int                      nerrors  = 0;
+    hid_t                    fapl_id  = H5I_INVALID_HID;
+    hid_t                    file_id  = H5I_INVALID_HID;
+    hid_t                    group_id = H5I_INVALID_HID;
+    hid_t                    gcpl_id  = H5I_INVALID_HID;
+    hid_t                    obj_id   = H5I_INVALID_HID;
+
+    HDprintf("**********************************************\n");
+    HDprintf("*                                            *\n");
+    HDprintf("*         VOL Attribute Benchmarks           *\n");
+    HDprintf("*                                            *\n");
+    HDprintf("**********************************************\n\n");
+
+    /* Make sure the connector supports the API functions being benchmarked */
+    if (!(vol_cap_flags_g & H5VL_CAP_FLAG_FILE_BASIC) || !(vol_cap_flags_g & H5VL_CAP_FLAG_GROUP_BASIC) ||
+        !(vol_cap_flags_g & H5VL_CAP_FLAG_ATTR_BASIC) || !(vol_cap_flags_g & H5VL_CAP_FLAG_ATTR_MORE) ||
+        !(vol_cap_flags_g & H5VL_CAP_FLAG_BY_IDX) || !(vol_cap_flags_g & H5VL_CAP_FLAG_ITERATE)) {
+        BENCH_SKIPPED("attribute operations",
+                      "API functions for basic file, group, attribute, by index, or iterate aren't "
+                      "supported with this connector");
+        HDprintf("\n");
+        return 0;
+    }
+
+    /* These were checked when the command line was parsed */
+    if (vol_bench_parse_size_list(vol_bench_params_g.attr_counts, attr_counts, &nattr_counts) < 0 ||
+        vol_bench_parse_size_list(vol_bench_params_g.attr_phase_change, phase_changes, &nphase_changes) < 0)
+        BENCH_ERROR;
+
+    /*
+     * As with the group benchmarks, use the latest library version
+     * bounds so that the native connector is able to move attributes
+     * into dense storage.
+     */
+    if ((fapl_id = H5Pcreate(H5P_FILE_ACCESS)) < 0)
+        BENCH_ERROR;
+
+    if (H5Pset_libver_bounds(fapl_id, H5F_LIBVER_LATEST, H5F_LIBVER_LATEST) < 0) {
+        HDprintf("    couldn't set library version bounds on FAPL\n");
+        BENCH_ERROR;
+    }
+
+    if ((file_id = H5Fopen(vol_bench_filename, H5F_ACC_RDWR, fapl_id)) < 0) {
+        HDprintf("    couldn't open file '%s'\n", vol_bench_filename);
+        BENCH_ERROR;
+    }
+
+    if ((group_id = H5Gcreate2(file_id, ATTRIBUTE_BENCH_GROUP_NAME, H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT)) <
+        0) {
+        HDprintf("    couldn't create container group '%s'\n", ATTRIBUTE_BENCH_GROUP_NAME);
+        BENCH_ERROR;
+    }
+
+    for (size_t i = 0; i < nattr_counts; i++)
+        for (size_t j = 0; j < nphase_changes; j++) {
+            char obj_name[ATTRIBUTE_BENCH_NAME_LENGTH];
+
+            /* Use the same ratio between the thresholds as the library's defaults of 8 and 6 */
+            config.nattrs      = attr_counts[i];
+            config.max_compact = (unsigned)phase_changes[j];
+            config.min_dense   = (config.max_compact * 3) / 4;
+            config.crt_order   = (vol_cap_flags_g & H5VL_CAP_FLAG_CREATION_ORDER) ? TRUE : FALSE;
+
+            if ((gcpl_id = H5Pcreate(H5P_GROUP_CREATE)) < 0)
+                BENCH_ERROR;
+
+            if (H5Pset_attr_phase_change(gcpl_id, config.max_compact, config.min_dense) < 0) {
+                HDprintf("    couldn't set attribute phase change on GCPL\n");
+                BENCH_ERROR;
+            }
+
+            if (config.crt_order &&
+                H5Pset_attr_creation_order(gcpl_id, H5P_CRT_ORDER_TRACKED | H5P_CRT_ORDER_INDEXED) < 0) {
+                HDprintf("    couldn't set attribute creation order tracking on GCPL\n");
+                BENCH_ERROR;
+            }
+
+            HDsnprintf(obj_name, sizeof(obj_name), "attrs_%zu_%zu", i, j);
+
+            if ((obj_id = H5Gcreate2(group_id, obj_name, H5P_DEFAULT, gcpl_id, H5P_DEFAULT)) < 0) {
+                HDprintf("    couldn't create group '%s'\n", obj_name);
+                BENCH_ERROR;
+            }
+
+            nerrors += attribute_bench_config(obj_id, &config);
+
+            if (H5Gclose(obj_id) < 0)
+                BENCH_ERROR;
+            obj_id = H5I_INVALID_HID;
+
+            if (H5Pclose(gcpl_id) < 0)
+                BENCH_ERROR;
+            gcpl_id = H5I_INVALID_HID;
+        }
+
+    if (H5Gclose(group_id) < 0)
+        BENCH_ERROR;
+    if (H5Fclose(file_id) < 0)
+        BENCH_ERROR;
+    if (H5Pclose(fapl_id) < 0)
+        BENCH_ERROR;
+
+    HDprintf("\n");
+
+    return nerrors;
+
+error:
+    H5E_BEGIN_TRY
+    {
+        H5Gclose(obj_id);
+        H5Pclose(gcpl_id);
+        H5Gclose(group_id);
+        H5Fclose(file_id);
+        H5Pclose(fapl_id);
+    }
+    H5E_END_TRY;
+
+    HDprintf("\n");
+
+    return nerrors + 1;
+}
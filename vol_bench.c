@@ -0,0 +1,375 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * Copyright by The HDF Group.                                               *
+ * All rights reserved.                                                      *
+ *                                                                           *
+ * This file is part of HDF5.  The full HDF5 copyright notice, including     *
+ * terms governing use, modification, and redistribution, is contained in    *
+ * the COPYING file, which can be found at the root of the source code       *
+ * distribution tree, or in https://support.hdfgroup.org/ftp/HDF5/releases.  *
+ * If you do not have access to either file, you may request a copy from     *
+ * help@hdfgroup.org.                                                        *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+/*
+ * A set of benchmarks which only make public HDF5 API calls and which
+ * measure the performance of the native VOL connector or a specified
+ * HDF5 VOL connector. As with the VOL tests, each benchmark checks that
+ * the functionality it uses is supported by the VOL connector before
+ * running and is skipped otherwise.
+ */
+
+#include "vol_bench.h"
+
+#include "vol_dataset_bench.h"
+#include "vol_chunk_bench.h"
+#include "vol_multi_bench.h"
+#include "vol_group_bench.h"
+#include "vol_attribute_bench.h"
+#include "vol_link_bench.h"
+#include "vol_contention_bench.h"
+#include "vol_tconv_bench.h"
+#include "vol_compound_bench.h"
+#include "vol_append_bench.h"
+
+#ifdef H5VL_TEST_HAS_ASYNC
+#include "vol_async_bench.h"
+#endif
+
+char vol_bench_filename[VOL_TEST_FILENAME_MAX_LENGTH];
+
+const char *test_path_prefix;
+
+VOL_TEST_THREAD_LOCAL size_t n_tests_run_g;
+VOL_TEST_THREAD_LOCAL size_t n_tests_passed_g;
+VOL_TEST_THREAD_LOCAL size_t n_tests_failed_g;
+VOL_TEST_THREAD_LOCAL size_t n_tests_skipped_g;
+
+uint64_t vol_cap_flags_g;
+
+/* X-macro to define the following for each benchmark:
+ * - enum type
+ * - name
+ * - benchmark function
+ * - enabled by default
+ */
+#ifdef H5VL_TEST_HAS_ASYNC
+#define VOL_BENCHES                                                                                          \
+    X(VOL_BENCH_NULL, "", NULL, 0)                                                                           \
+    X(VOL_BENCH_DATASET, "dataset", vol_dataset_bench, 1)                                                    \
+    X(VOL_BENCH_CHUNK, "chunk", vol_chunk_bench, 1)                                                          \
+    X(VOL_BENCH_MULTI, "multi", vol_multi_bench, 1)                                                          \
+    X(VOL_BENCH_GROUP, "group", vol_group_bench, 1)                                                          \
+    X(VOL_BENCH_ATTRIBUTE, "attribute", vol_attribute_bench, 1)                                              \
+    X(VOL_BENCH_LINK, "link", vol_link_bench, 1)                                                             \
+    X(VOL_BENCH_CONTENTION, "contention", vol_contention_bench, 1)                                           \
+    X(VOL_BENCH_TCONV, "tconv", vol_tconv_bench, 1)                                                          \
+    X(VOL_BENCH_COMPOUND, "compound", vol_compound_bench, 1)                                                 \
+    X(VOL_BENCH_APPEND, "append", vol_append_bench, 1)                                                       \
+    X(VOL_BENCH_ASYNC, "async", vol_async_bench, 1)                                                          \
+    X(VOL_BENCH_MAX, "", NULL, 0)
+#else
+#define VOL_BENCHES                                                                                          \
+    X(VOL_BENCH_NULL, "", NULL, 0)                                                                           \
+    X(VOL_BENCH_DATASET, "dataset", vol_dataset_bench, 1)                                                    \
+    X(VOL_BENCH_CHUNK, "chunk", vol_chunk_bench, 1)                                                          \
+    X(VOL_BENCH_MULTI, "multi", vol_multi_bench, 1)                                                          \
+    X(VOL_BENCH_GROUP, "group", vol_group_bench, 1)                                                          \
+    X(VOL_BENCH_ATTRIBUTE, "attribute", vol_attribute_bench, 1)                                              \
+    X(VOL_BENCH_LINK, "link", vol_link_bench, 1)                                                             \
+    X(VOL_BENCH_CONTENTION, "contention", vol_contention_bench, 1)                                           \
+    X(VOL_BENCH_TCONV, "tconv", vol_tconv_bench, 1)                                                          \
+    X(VOL_BENCH_COMPOUND, "compound", vol_compound_bench, 1)                                                 \
+    X(VOL_BENCH_APPEND, "append", vol_append_bench, 1)                                                       \
+    X(VOL_BENCH_MAX, "", NULL, 0)
+#endif
+
+#define X(a, b, c, d) a,
+enum vol_bench_type { VOL_BENCHES };
+#undef X
+#define X(a, b, c, d) b,
+static char *const vol_bench_name[] = {VOL_BENCHES};
+#undef X
+#define X(a, b, c, d) c,
+static int (*vol_bench_func[])(void) = {VOL_BENCHES};
+#undef X
+#define X(a, b, c, d) d,
+static int vol_bench_enabled[] = {VOL_BENCHES};
+#undef X
+
+static hbool_t bench_selected = FALSE;
+
+static enum vol_bench_type
+vol_bench_name_to_type(const char *bench_name)
+{
+    enum vol_bench_type i = 0;
+
+    while (strcmp(vol_bench_name[i], bench_name) && i != VOL_BENCH_MAX)
+        i++;
+
+    return ((i == VOL_BENCH_MAX) ? VOL_BENCH_NULL : i);
+}
+
+/*
+ * Callback for vol_bench_parse_options() which enables
+ * only the benchmarks named on the command line.
+ */
+static int
+vol_bench_select(const char *bench_name)
+{
+    enum vol_bench_type i;
+
+    if ((i = vol_bench_name_to_type(bench_name)) == VOL_BENCH_NULL)
+        return -1;
+
+    if (!bench_selected) {
+        memset(vol_bench_enabled, 0, sizeof(vol_bench_enabled));
+        bench_selected = TRUE;
+    }
+    vol_bench_enabled[i] = 1;
+
+    return 0;
+}
+
+static int
+vol_bench_run(void)
+{
+    enum vol_bench_type i;
+    int                 nerrors = 0;
+
+    for (i = VOL_BENCH_DATASET; i < VOL_BENCH_MAX; i++)
+        if (vol_bench_enabled[i])
+            nerrors += vol_bench_func[i]();
+
+    return nerrors;
+}
+
+/******************************************************************************/
+
+int
+main(int argc, char **argv)
+{
+    const char *vol_connector_string;
+    const char *vol_connector_name;
+    hid_t       fapl_id                   = H5I_INVALID_HID;
+    hid_t       file_id                   = H5I_INVALID_HID;
+    hid_t       default_con_id            = H5I_INVALID_HID;
+    hid_t       registered_con_id         = H5I_INVALID_HID;
+    char       *vol_connector_string_copy = NULL;
+    char       *vol_connector_info        = NULL;
+    int         nerrors                   = 0;
+    int         parse_ret;
+    hbool_t     err_occurred = FALSE;
+
+    if ((parse_ret = vol_bench_parse_options(argc, argv, vol_bench_select)) != 0) {
+        vol_bench_usage(argv[0]);
+        HDexit((parse_ret > 0) ? EXIT_SUCCESS : EXIT_FAILURE);
+    }
+
+#ifdef H5_HAVE_PARALLEL
+    /* As with the serial VOL tests, call MPI_Init in case HDF5
+     * or the VOL connector requires it.
+     */
+    MPI_Init(&argc, &argv);
+#endif
+
+    H5open();
+
+    if (NULL == (vol_connector_string = HDgetenv("HDF5_VOL_CONNECTOR"))) {
+        HDprintf("No VOL connector selected; using native VOL connector\n");
+        vol_connector_name = "native";
+        vol_connector_info = NULL;
+    }
+    else {
+        char *token;
+
+        if (NULL == (vol_connector_string_copy = HDstrdup(vol_connector_string))) {
+            HDfprintf(stderr, "Unable to copy VOL connector string\n");
+            err_occurred = TRUE;
+            goto done;
+        }
+
+        if (NULL == (token = HDstrtok(vol_connector_string_copy, " "))) {
+            HDfprintf(stderr, "Error while parsing VOL connector string\n");
+            err_occurred = TRUE;
+            goto done;
+        }
+
+        vol_connector_name = token;
+
+        if (NULL != (token = HDstrtok(NULL, " "))) {
+            vol_connector_info = token;
+        }
+    }
+
+    if (NULL == (test_path_prefix = HDgetenv(HDF5_API_TEST_PATH_PREFIX)))
+        test_path_prefix = "";
+
+    HDsnprintf(vol_bench_filename, VOL_TEST_FILENAME_MAX_LENGTH, "%s%s", test_path_prefix, BENCH_FILE_NAME);
+
+    HDprintf("Running VOL benchmarks with VOL connector '%s' and info string '%s'\n\n", vol_connector_name,
+             vol_connector_info ? vol_connector_info : "");
+    HDprintf("Benchmark parameters:\n");
+    HDprintf("  - Benchmark file name: '%s'\n", vol_bench_filename);
+    HDprintf("  - Dataset size: %llu bytes\n", (unsigned long long)vol_bench_params_g.dataset_size);
+    HDprintf("  - Transfer size: %llu bytes\n", (unsigned long long)vol_bench_params_g.xfer_size);
+    HDprintf("  - Element type: %s\n", vol_bench_params_g.type_name);
+    HDprintf("  - Iterations: %u\n", vol_bench_params_g.iterations);
+    HDprintf("  - Maximum points per selection: %llu\n", (unsigned long long)vol_bench_params_g.max_points);
+    HDprintf("  - Verify data: %s\n", vol_bench_params_g.verify ? "yes" : "no");
+    HDprintf("  - Chunk dimensions: %s\n", vol_bench_params_g.chunk_dims);
+    HDprintf("  - Chunk cache sizes: %s\n", vol_bench_params_g.cache_nbytes);
+    HDprintf("  - Chunk cache slots: %s\n", vol_bench_params_g.cache_nslots);
+    HDprintf("  - Chunk cache w0: %s\n", vol_bench_params_g.cache_w0);
+    HDprintf("  - Multi-dataset I/O dataset counts: %s\n", vol_bench_params_g.multi_dsets);
+    HDprintf("  - Group counts: %s\n", vol_bench_params_g.group_counts);
+    HDprintf("  - Group depths: %s\n", vol_bench_params_g.group_depths);
+    HDprintf("  - Attribute counts: %s\n", vol_bench_params_g.attr_counts);
+    HDprintf("  - Attribute phase change thresholds: %s\n", vol_bench_params_g.attr_phase_change);
+    HDprintf("  - Link graph fanout: %u\n", vol_bench_params_g.link_fanout);
+    HDprintf("  - Link graph depth: %u\n", vol_bench_params_g.link_depth);
+    HDprintf("  - Link graph soft/external/cycle link fractions: %.2f/%.2f/%.2f\n",
+             vol_bench_params_g.link_soft, vol_bench_params_g.link_external, vol_bench_params_g.link_cycles);
+    HDprintf("  - Async pipeline depths: %s\n", vol_bench_params_g.async_depths);
+    if (vol_bench_params_g.compute_usec > 0)
+        HDprintf("  - Async compute time per operation: %u usec\n", vol_bench_params_g.compute_usec);
+    else
+        HDprintf("  - Async compute time per operation: matched to synchronous I/O\n");
+    HDprintf("  - Contention thread counts: %s\n", vol_bench_params_g.thread_counts);
+    HDprintf("  - Contention operations per thread: %u\n", vol_bench_params_g.contention_ops);
+    HDprintf("  - Type conversion pairs per path: %u\n", vol_bench_params_g.tconv_pairs);
+    HDprintf("  - Compound field counts: %s\n", vol_bench_params_g.compound_fields);
+    HDprintf("  - Compound fields per partial read: %s\n", vol_bench_params_g.compound_reads);
+    HDprintf("  - Append batch sizes: %s\n", vol_bench_params_g.append_batches);
+    HDprintf("  - Append chunk sizes: %s\n", vol_bench_params_g.append_chunks);
+    HDprintf("  - Appends per dataset: %u\n", vol_bench_params_g.appends);
+    if (vol_bench_params_g.flush_every > 0)
+        HDprintf("  - Appends between flushes: %u\n", vol_bench_params_g.flush_every);
+    else
+        HDprintf("  - Appends between flushes: never flushed\n");
+    HDprintf("  - Append reader: %s\n", vol_bench_params_g.append_reader ? "yes" : "no");
+    if (vol_bench_params_g.report_filename)
+        HDprintf("  - Benchmark report: '%s'\n", vol_bench_params_g.report_filename);
+    HDprintf("\n\n");
+
+    if ((fapl_id = H5Pcreate(H5P_FILE_ACCESS)) < 0) {
+        HDfprintf(stderr, "Unable to create FAPL\n");
+        err_occurred = TRUE;
+        goto done;
+    }
+
+    /*
+     * If using a VOL connector other than the native
+     * connector, check whether the VOL connector was
+     * successfully registered before running the benchmarks.
+     * Otherwise, HDF5 will default to running them with
+     * the native connector, which could be misleading.
+     */
+    if (0 != HDstrcmp(vol_connector_name, "native")) {
+        htri_t is_registered;
+
+        if ((is_registered = H5VLis_connector_registered_by_name(vol_connector_name)) < 0) {
+            HDfprintf(stderr, "Unable to determine if VOL connector is registered\n");
+            err_occurred = TRUE;
+            goto done;
+        }
+
+        if (!is_registered) {
+            HDfprintf(stderr, "Specified VOL connector '%s' wasn't correctly registered!\n",
+                      vol_connector_name);
+            err_occurred = TRUE;
+            goto done;
+        }
+        else {
+            if (H5Pget_vol_id(fapl_id, &default_con_id) < 0) {
+                HDfprintf(stderr, "Couldn't retrieve ID of VOL connector set on default FAPL\n");
+                err_occurred = TRUE;
+                goto done;
+            }
+
+            if ((registered_con_id = H5VLget_connector_id_by_name(vol_connector_name)) < 0) {
+                HDfprintf(stderr, "Couldn't retrieve ID of registered VOL connector\n");
+                err_occurred = TRUE;
+                goto done;
+            }
+
+            if (default_con_id != registered_con_id) {
+                HDfprintf(stderr, "VOL connector set on default FAPL didn't match specified VOL connector\n");
+                err_occurred = TRUE;
+                goto done;
+            }
+        }
+    }
+
+    vol_cap_flags_g = H5VL_CAP_FLAG_NONE;
+    if (H5Pget_vol_cap_flags(fapl_id, &vol_cap_flags_g) < 0) {
+        HDfprintf(stderr, "Unable to retrieve VOL connector capability flags\n");
+        err_occurred = TRUE;
+        goto done;
+    }
+
+    if (!(vol_cap_flags_g & H5VL_CAP_FLAG_FILE_BASIC)) {
+        HDfprintf(stderr, "VOL connector doesn't support basic file operations; no benchmarks can be run\n");
+        err_occurred = TRUE;
+        goto done;
+    }
+
+    /* Create the file that all of the benchmarks will operate on */
+    if ((file_id = H5Fcreate(vol_bench_filename, H5F_ACC_TRUNC, H5P_DEFAULT, H5P_DEFAULT)) < 0) {
+        HDfprintf(stderr, "Unable to create benchmark file '%s'\n", vol_bench_filename);
+        err_occurred = TRUE;
+        goto done;
+    }
+
+    if (H5Fclose(file_id) < 0) {
+        HDfprintf(stderr, "Unable to close benchmark file '%s'\n", vol_bench_filename);
+        err_occurred = TRUE;
+        goto done;
+    }
+
+    /* Run all the benchmarks that are enabled */
+    nerrors = vol_bench_run();
+
+    HDprintf("Cleaning up benchmark files\n");
+    H5Fdelete(vol_bench_filename, fapl_id);
+
+    if (vol_bench_params_g.report_filename) {
+        if (vol_bench_write_report(vol_bench_params_g.report_filename) < 0) {
+            HDfprintf(stderr, "Unable to write benchmark report '%s'\n", vol_bench_params_g.report_filename);
+            err_occurred = TRUE;
+        }
+        else
+            HDprintf("Wrote benchmark report to '%s'\n", vol_bench_params_g.report_filename);
+    }
+
+    if (nerrors > 0)
+        HDprintf("%d VOL benchmark%s failed with VOL connector '%s'\n", nerrors, (nerrors > 1) ? "s" : "",
+                 vol_connector_name);
+
+done:
+    HDfree(vol_connector_string_copy);
+
+    vol_bench_free_results();
+
+    if (default_con_id >= 0 && H5VLclose(default_con_id) < 0) {
+        HDfprintf(stderr, "Unable to close VOL connector ID\n");
+        err_occurred = TRUE;
+    }
+
+    if (registered_con_id >= 0 && H5VLclose(registered_con_id) < 0) {
+        HDfprintf(stderr, "Unable to close VOL connector ID\n");
+        err_occurred = TRUE;
+    }
+
+    if (fapl_id >= 0 && H5Pclose(fapl_id) < 0) {
+        HDfprintf(stderr, "Unable to close FAPL\n");
+        err_occurred = TRUE;
+    }
+
+    H5close();
+
+#ifdef H5_HAVE_PARALLEL
+    MPI_Finalize();
+#endif
+
+    HDexit(((err_occurred || nerrors > 0) ? EXIT_FAILURE : EXIT_SUCCESS));
+}
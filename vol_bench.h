@@ -0,0 +1,43 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * Copyright by The HDF Group.                                               *
+ * All rights reserved.                                                      *
+ *                                                                           *
+ * This file is part of HDF5.  The full HDF5 copyright notice, including     *
+ * terms governing use, modification, and redistribution, is contained in    *
+ * the COPYING file, which can be found at the root of the source code       *
+ * distribution tree, or in https://support.hdfgroup.org/ftp/HDF5/releases.  *
+ * If you do not have access to either file, you may request a copy from     *
+ * help@hdfgroup.org.                                                        *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#ifndef VOL_BENCH_H
+#define VOL_BENCH_H
+
+#include "vol_test.h"
+#include "vol_bench_util.h"
+
+/*
+ * Print the name of a benchmark that couldn't be run, along
+ * with the reason, in the same way as the SKIPPED() macro.
+ */
+#define BENCH_SKIPPED(WHAT, WHY)                                                                             \
+    {                                                                                                        \
+        HDprintf("  %-44s -SKIP-\n    %s\n", WHAT, WHY);                                                     \
+        fflush(stdout);                                                                                      \
+    }
+
+/*
+ * Jump to a benchmark's 'error' cleanup section, printing
+ * the current location on the standard output stream.
+ */
+#define BENCH_ERROR                                                                                          \
+    {                                                                                                        \
+        AT();                                                                                                \
+        goto error;                                                                                          \
+    }
+
+/* The name of the file that all of the benchmarks will operate on */
+#define BENCH_FILE_NAME "vol_bench.h5"
+extern char vol_bench_filename[];
+
+#endif
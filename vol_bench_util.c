@@ -0,0 +1,770 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * Copyright by The HDF Group.                                               *
+ * All rights reserved.                                                      *
+ *                                                                           *
+ * This file is part of HDF5.  The full HDF5 copyright notice, including     *
+ * terms governing use, modification, and redistribution, is contained in    *
+ * the COPYING file, which can be found at the root of the source code       *
+ * distribution tree, or in https://support.hdfgroup.org/ftp/HDF5/releases.  *
+ * If you do not have access to either file, you may request a copy from     *
+ * help@hdfgroup.org.                                                        *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#include "vol_bench.h"
+
+/*
+ * Default benchmark parameters. These are kept small so that
+ * running the benchmarks without any options is quick; real
+ * measurements should set them from the command line.
+ */
+vol_bench_params_t vol_bench_params_g = {
+    4 * 1024 * 1024, /* dataset_size */
+    1024 * 1024,     /* xfer_size */
+    "int",           /* type_name */
+    5,               /* iterations */
+    65536,           /* max_points */
+    FALSE,           /* verify */
+    NULL,            /* report_filename */
+    "64,256",        /* chunk_dims */
+    "1M,16M",        /* cache_nbytes */
+    "521",           /* cache_nslots */
+    "0.75",          /* cache_w0 */
+    "1,16,256",      /* multi_dsets */
+    "100,1000",      /* group_counts */
+    "1,8",           /* group_depths */
+    "10,100",        /* attr_counts */
+    "0,8,64",        /* attr_phase_change */
+    8,               /* link_fanout */
+    3,               /* link_depth */
+    0.5,             /* link_soft */
+    0.1,             /* link_external */
+    0.1,             /* link_cycles */
+    "1,8,64",        /* async_depths */
+    0,               /* compute_usec */
+    "1,2,4",         /* thread_counts */
+    120,             /* contention_ops */
+    2,               /* tconv_pairs */
+    "50,200",        /* compound_fields */
+    "1,3",           /* compound_reads */
+    "1,64",          /* append_batches */
+    "1K,64K",        /* append_chunks */
+    1000,            /* appends */
+    100,             /* flush_every */
+    FALSE,           /* append_reader */
+};
+
+/*
+ * The kinds of values taken by benchmark command-line options
+ */
+typedef enum vol_bench_option_kind_t {
+    VOL_BENCH_OPTION_SIZE,     /* hsize_t, with an optional K/M/G/T suffix */
+    VOL_BENCH_OPTION_UNSIGNED, /* unsigned */
+    VOL_BENCH_OPTION_DOUBLE,   /* double */
+    VOL_BENCH_OPTION_STRING,   /* const char * */
+    VOL_BENCH_OPTION_FLAG      /* hbool_t, set to TRUE when present */
+} vol_bench_option_kind_t;
+
+typedef struct vol_bench_option_t {
+    const char             *name;
+    vol_bench_option_kind_t kind;
+    void                   *value;
+    const char             *help;
+} vol_bench_option_t;
+
+static vol_bench_option_t vol_bench_options[] = {
+    {"--size", VOL_BENCH_OPTION_SIZE, &vol_bench_params_g.dataset_size,
+     "total size of each benchmark dataset, e.g. 64M or 10G"},
+    {"--xfer-size", VOL_BENCH_OPTION_SIZE, &vol_bench_params_g.xfer_size,
+     "size of each hyperslab I/O operation"},
+    {"--type", VOL_BENCH_OPTION_STRING, &vol_bench_params_g.type_name,
+     "dataset element type: char, short, int, long, llong, float or double (optionally prefixed with 'u')"},
+    {"--iterations", VOL_BENCH_OPTION_UNSIGNED, &vol_bench_params_g.iterations,
+     "number of times each measurement is repeated"},
+    {"--max-points", VOL_BENCH_OPTION_SIZE, &vol_bench_params_g.max_points,
+     "maximum number of elements in each point selection"},
+    {"--verify", VOL_BENCH_OPTION_FLAG, &vol_bench_params_g.verify, "verify all data that is read back"},
+    {"--report", VOL_BENCH_OPTION_STRING, &vol_bench_params_g.report_filename,
+     "write results to the given file (JSON if it ends in '.json', CSV otherwise)"},
+    {"--chunk-dims", VOL_BENCH_OPTION_STRING, &vol_bench_params_g.chunk_dims,
+     "comma-separated list of chunk edge lengths, in elements, to sweep"},
+    {"--cache-nbytes", VOL_BENCH_OPTION_STRING, &vol_bench_params_g.cache_nbytes,
+     "comma-separated list of chunk cache sizes (rdcc_nbytes) to sweep"},
+    {"--cache-nslots", VOL_BENCH_OPTION_STRING, &vol_bench_params_g.cache_nslots,
+     "comma-separated list of chunk cache slot counts (rdcc_nslots) to sweep"},
+    {"--cache-w0", VOL_BENCH_OPTION_STRING, &vol_bench_params_g.cache_w0,
+     "comma-separated list of chunk cache preemption policies (rdcc_w0) to sweep"},
+    {"--multi-dsets", VOL_BENCH_OPTION_STRING, &vol_bench_params_g.multi_dsets,
+     "comma-separated list of the number of datasets accessed by each multi-dataset I/O call"},
+    {"--group-counts", VOL_BENCH_OPTION_STRING, &vol_bench_params_g.group_counts,
+     "comma-separated list of the number of groups to create in a single parent group"},
+    {"--group-depths", VOL_BENCH_OPTION_STRING, &vol_bench_params_g.group_depths,
+     "comma-separated list of the depths below the file's root group at which groups are created"},
+    {"--attr-counts", VOL_BENCH_OPTION_STRING, &vol_bench_params_g.attr_counts,
+     "comma-separated list of the number of attributes attached to a single object"},
+    {"--attr-phase-change", VOL_BENCH_OPTION_STRING, &vol_bench_params_g.attr_phase_change,
+     "comma-separated list of the maximum number of attributes in compact storage (max_compact) to sweep"},
+    {"--link-fanout", VOL_BENCH_OPTION_UNSIGNED, &vol_bench_params_g.link_fanout,
+     "number of child groups of each group in the link graph"},
+    {"--link-depth", VOL_BENCH_OPTION_UNSIGNED, &vol_bench_params_g.link_depth,
+     "number of levels of groups in the link graph"},
+    {"--link-soft", VOL_BENCH_OPTION_DOUBLE, &vol_bench_params_g.link_soft,
+     "fraction of groups in the link graph with a soft link to another group"},
+    {"--link-external", VOL_BENCH_OPTION_DOUBLE, &vol_bench_params_g.link_external,
+     "fraction of groups in the link graph with an external link"},
+    {"--link-cycles", VOL_BENCH_OPTION_DOUBLE, &vol_bench_params_g.link_cycles,
+     "fraction of groups in the link graph with a hard link back to the top of the graph"},
+    {"--async-depths", VOL_BENCH_OPTION_STRING, &vol_bench_params_g.async_depths,
+     "comma-separated list of the number of async operations kept in flight on each event set"},
+    {"--compute-usec", VOL_BENCH_OPTION_UNSIGNED, &vol_bench_params_g.compute_usec,
+     "microseconds of synthetic compute after each async operation (0 to match the synchronous I/O time)"},
+    {"--threads", VOL_BENCH_OPTION_STRING, &vol_bench_params_g.thread_counts,
+     "comma-separated list of the number of threads accessing HDF5 at once (thread-safe HDF5 only)"},
+    {"--contention-ops", VOL_BENCH_OPTION_UNSIGNED, &vol_bench_params_g.contention_ops,
+     "number of operations made by each thread in the contention benchmark"},
+    {"--tconv-pairs", VOL_BENCH_OPTION_UNSIGNED, &vol_bench_params_g.tconv_pairs,
+     "number of random datatype pairs benchmarked for each type conversion path"},
+    {"--compound-fields", VOL_BENCH_OPTION_STRING, &vol_bench_params_g.compound_fields,
+     "comma-separated list of the number of fields in each compound datatype"},
+    {"--compound-reads", VOL_BENCH_OPTION_STRING, &vol_bench_params_g.compound_reads,
+     "comma-separated list of the number of compound fields read by each partial read"},
+    {"--append-batches", VOL_BENCH_OPTION_STRING, &vol_bench_params_g.append_batches,
+     "comma-separated list of the number of records added to a dataset by each append"},
+    {"--append-chunks", VOL_BENCH_OPTION_STRING, &vol_bench_params_g.append_chunks,
+     "comma-separated list of the chunk sizes, in records, of the datasets appended to"},
+    {"--appends", VOL_BENCH_OPTION_UNSIGNED, &vol_bench_params_g.appends,
+     "number of appends made to each dataset"},
+    {"--flush-every", VOL_BENCH_OPTION_UNSIGNED, &vol_bench_params_g.flush_every,
+     "number of appends between each flush of the dataset with H5Dflush (0 to never flush)"},
+    {"--append-reader", VOL_BENCH_OPTION_FLAG, &vol_bench_params_g.append_reader,
+     "refresh the dataset with H5Drefresh and read the new records after each flush"},
+};
+
+/*
+ * The element types that can be selected with the --type option
+ */
+static const char *const vol_bench_type_names[] = {"char",   "uchar", "short", "ushort", "int",
+                                                   "uint",   "long",  "ulong", "llong",  "ullong",
+                                                   "float",  "double"};
+
+/* A single benchmark measurement, as reported by vol_bench_report() */
+typedef struct vol_bench_result_t {
+    char   *interface_name;
+    char   *name;
+    char   *metric_name;
+    double  metric_value;
+    size_t  nops;
+    hsize_t nbytes;
+    double  total_seconds;
+    double  p50;
+    double  p90;
+    double  p99;
+    double  max;
+} vol_bench_result_t;
+
+static vol_bench_result_t *results_g       = NULL;
+static size_t              nresults_g      = 0;
+static size_t              results_alloc_g = 0;
+
+/*
+ * Returns the current value of a monotonic clock, in seconds.
+ */
+double
+vol_bench_now(void)
+{
+    struct timespec ts;
+
+    if (HDclock_gettime(CLOCK_MONOTONIC, &ts) < 0)
+        return 0.0;
+
+    return (double)ts.tv_sec + ((double)ts.tv_nsec / 1.0E9);
+}
+
+void
+vol_bench_stats_init(vol_bench_stats_t *stats)
+{
+    HDmemset(stats, 0, sizeof(*stats));
+}
+
+herr_t
+vol_bench_stats_add(vol_bench_stats_t *stats, double seconds)
+{
+    if (stats->nsamples == stats->nalloc) {
+        size_t  new_alloc = stats->nalloc ? 2 * stats->nalloc : 64;
+        double *tmp_realloc;
+
+        if (NULL == (tmp_realloc = HDrealloc(stats->samples, new_alloc * sizeof(double)))) {
+            HDprintf("    couldn't allocate space for benchmark samples\n");
+            return FAIL;
+        }
+
+        stats->samples = tmp_realloc;
+        stats->nalloc  = new_alloc;
+    }
+
+    stats->samples[stats->nsamples++] = seconds;
+    stats->total += seconds;
+
+    return SUCCEED;
+}
+
+static int
+vol_bench_cmp_double(const void *a, const void *b)
+{
+    double x = *(const double *)a;
+    double y = *(const double *)b;
+
+    return (x < y) ? -1 : ((x > y) ? 1 : 0);
+}
+
+/*
+ * Returns the given percentile (0-100) of the samples collected,
+ * using the nearest-rank method. Sorts the samples in place.
+ */
+double
+vol_bench_stats_percentile(vol_bench_stats_t *stats, double percentile)
+{
+    size_t rank;
+
+    if (stats->nsamples == 0)
+        return 0.0;
+
+    HDqsort(stats->samples, stats->nsamples, sizeof(double), vol_bench_cmp_double);
+
+    rank = (size_t)((percentile / 100.0) * (double)stats->nsamples + 0.5);
+    if (rank > 0)
+        rank--;
+    if (rank >= stats->nsamples)
+        rank = stats->nsamples - 1;
+
+    return stats->samples[rank];
+}
+
+void
+vol_bench_stats_free(vol_bench_stats_t *stats)
+{
+    HDfree(stats->samples);
+    vol_bench_stats_init(stats);
+}
+
+/*
+ * Prints a histogram of the latency samples in a set of stats,
+ * with one power-of-two bucket of nanoseconds per line, to show
+ * the shape of the latency distribution beyond its percentiles.
+ */
+void
+vol_bench_stats_histogram(const vol_bench_stats_t *stats)
+{
+    size_t counts[VOL_BENCH_HISTOGRAM_BUCKETS];
+    size_t max_count = 0;
+    int    first     = VOL_BENCH_HISTOGRAM_BUCKETS;
+    int    last      = -1;
+
+    if (stats->nsamples == 0)
+        return;
+
+    HDmemset(counts, 0, sizeof(counts));
+
+    for (size_t i = 0; i < stats->nsamples; i++) {
+        double ns     = stats->samples[i] * 1.0E9;
+        int    bucket = 0;
+
+        while (ns >= 2.0 && bucket < VOL_BENCH_HISTOGRAM_BUCKETS - 1) {
+            ns /= 2.0;
+            bucket++;
+        }
+
+        counts[bucket]++;
+    }
+
+    for (int i = 0; i < VOL_BENCH_HISTOGRAM_BUCKETS; i++) {
+        if (counts[i] == 0)
+            continue;
+        if (i < first)
+            first = i;
+        last      = i;
+        max_count = MAX(max_count, counts[i]);
+    }
+
+    for (int i = first; i <= last; i++) {
+        char   bar[VOL_BENCH_HISTOGRAM_WIDTH + 1];
+        size_t bar_len = (counts[i] * VOL_BENCH_HISTOGRAM_WIDTH + max_count - 1) / max_count;
+
+        HDmemset(bar, '#', bar_len);
+        bar[bar_len] = '\0';
+
+        HDprintf("    >= 2^%-2d ns %12zu %s\n", i, counts[i], bar);
+    }
+}
+
+/*
+ * Prints the results of a measurement and records them for the
+ * report written by vol_bench_write_report(). nbytes is the total
+ * number of bytes moved across all of the samples, or 0 for
+ * operations that don't move raw data, in which case only an
+ * operation rate is shown.
+ */
+void
+vol_bench_report(const char *interface_name, const char *name, hsize_t nbytes, vol_bench_stats_t *stats)
+{
+    vol_bench_report_metric(interface_name, name, nbytes, stats, NULL, 0.0);
+}
+
+/*
+ * As vol_bench_report(), but also records an additional named
+ * value measured by the benchmark, such as a cache hit ratio.
+ */
+void
+vol_bench_report_metric(const char *interface_name, const char *name, hsize_t nbytes,
+                        vol_bench_stats_t *stats, const char *metric_name, double metric_value)
+{
+    vol_bench_result_t result;
+
+    HDmemset(&result, 0, sizeof(result));
+    result.nops          = stats->nsamples;
+    result.nbytes        = nbytes;
+    result.total_seconds = stats->total;
+    result.p50           = vol_bench_stats_percentile(stats, 50.0);
+    result.p90           = vol_bench_stats_percentile(stats, 90.0);
+    result.p99           = vol_bench_stats_percentile(stats, 99.0);
+    result.max           = vol_bench_stats_percentile(stats, 100.0);
+
+    HDprintf("  %-44s", name);
+    if (stats->total <= 0.0)
+        HDprintf("%14s", "-");
+    else if (nbytes > 0)
+        HDprintf("%9.2f MB/s", ((double)nbytes / 1.0E6) / stats->total);
+    else
+        HDprintf("%8.0f ops/s", (double)stats->nsamples / stats->total);
+    HDprintf("  p50 %.3es  p90 %.3es  p99 %.3es  max %.3es", result.p50, result.p90, result.p99, result.max);
+    if (metric_name)
+        HDprintf("  %s %.3f", metric_name, metric_value);
+    HDprintf("\n");
+    fflush(stdout);
+
+    if (nresults_g == results_alloc_g) {
+        size_t              new_alloc = results_alloc_g ? 2 * results_alloc_g : 64;
+        vol_bench_result_t *tmp_realloc;
+
+        if (NULL == (tmp_realloc = HDrealloc(results_g, new_alloc * sizeof(*results_g))))
+            return;
+
+        results_g       = tmp_realloc;
+        results_alloc_g = new_alloc;
+    }
+
+    result.interface_name    = HDstrdup(interface_name);
+    result.name              = HDstrdup(name);
+    result.metric_name       = metric_name ? HDstrdup(metric_name) : NULL;
+    result.metric_value      = metric_value;
+    results_g[nresults_g++] = result;
+}
+
+void
+vol_bench_usage(const char *progname)
+{
+    HDprintf("usage: %s [options] [benchmark ...]\n\n", progname);
+    HDprintf("options:\n");
+    for (size_t i = 0; i < ARRAY_LENGTH(vol_bench_options); i++)
+        HDprintf("  %-20s %s\n", vol_bench_options[i].name, vol_bench_options[i].help);
+    HDprintf("  %-20s %s\n", "-h, --help", "print this message");
+    HDprintf("\nSizes may be given with a K, M, G or T suffix (powers of 1024).\n");
+}
+
+/*
+ * Parses a comma-separated list of sizes, such as "64K,1M,16M",
+ * into at most VOL_BENCH_MAX_LIST_VALUES values.
+ */
+herr_t
+vol_bench_parse_size_list(const char *str, hsize_t *values, size_t *nvalues_out)
+{
+    char  *str_copy;
+    char  *token;
+    char  *saveptr = NULL;
+    size_t nvalues = 0;
+    herr_t ret_value = SUCCEED;
+
+    if (NULL == (str_copy = HDstrdup(str)))
+        return FAIL;
+
+    for (token = HDstrtok_r(str_copy, ",", &saveptr); token; token = HDstrtok_r(NULL, ",", &saveptr)) {
+        if (nvalues == VOL_BENCH_MAX_LIST_VALUES || vol_test_parse_size(token, &values[nvalues]) < 0) {
+            ret_value = FAIL;
+            break;
+        }
+        nvalues++;
+    }
+
+    HDfree(str_copy);
+
+    if (nvalues == 0)
+        ret_value = FAIL;
+
+    *nvalues_out = nvalues;
+
+    return ret_value;
+}
+
+/*
+ * Parses a comma-separated list of floating-point values, such
+ * as "0.0,0.75,1.0", into at most VOL_BENCH_MAX_LIST_VALUES values.
+ */
+herr_t
+vol_bench_parse_double_list(const char *str, double *values, size_t *nvalues_out)
+{
+    const char *p       = str;
+    size_t      nvalues = 0;
+
+    while (*p) {
+        char *end = NULL;
+
+        if (nvalues == VOL_BENCH_MAX_LIST_VALUES)
+            return FAIL;
+
+        values[nvalues] = HDstrtod(p, &end);
+        if (end == p || (*end != ',' && *end != '\0'))
+            return FAIL;
+        nvalues++;
+
+        p = (*end == ',') ? end + 1 : end;
+    }
+
+    *nvalues_out = nvalues;
+
+    return (nvalues > 0) ? SUCCEED : FAIL;
+}
+
+/*
+ * Checks that a comma-separated list of sizes given for the
+ * option `name` parses and that every value lies between
+ * min_value and max_value, printing `bounds_msg` if one doesn't.
+ */
+static herr_t
+vol_bench_check_size_list(const char *str, const char *name, hsize_t min_value, hsize_t max_value,
+                          const char *bounds_msg)
+{
+    hsize_t sizes[VOL_BENCH_MAX_LIST_VALUES];
+    size_t  nvalues;
+
+    if (vol_bench_parse_size_list(str, sizes, &nvalues) < 0) {
+        HDfprintf(stderr, "Invalid list '%s' for option '%s'\n", str, name);
+        return FAIL;
+    }
+    for (size_t i = 0; i < nvalues; i++)
+        if (sizes[i] < min_value || sizes[i] > max_value) {
+            HDfprintf(stderr, "%s\n", bounds_msg);
+            return FAIL;
+        }
+
+    return SUCCEED;
+}
+
+/*
+ * Parses the command line, setting the fields of vol_bench_params_g.
+ * Any argument that isn't an option is passed to select_cb, which
+ * should return a negative value if it doesn't name a benchmark.
+ * Returns 0 on success, 1 if help was requested and -1 on error.
+ */
+int
+vol_bench_parse_options(int argc, char **argv, int (*select_cb)(const char *name))
+{
+    for (int arg = 1; arg < argc; arg++) {
+        vol_bench_option_t *opt = NULL;
+
+        if (!HDstrcmp(argv[arg], "-h") || !HDstrcmp(argv[arg], "--help"))
+            return 1;
+
+        if (HDstrncmp(argv[arg], "--", 2)) {
+            if (select_cb(argv[arg]) < 0) {
+                HDfprintf(stderr, "Unknown benchmark '%s'\n", argv[arg]);
+                return -1;
+            }
+            continue;
+        }
+
+        for (size_t i = 0; i < ARRAY_LENGTH(vol_bench_options); i++)
+            if (!HDstrcmp(argv[arg], vol_bench_options[i].name)) {
+                opt = &vol_bench_options[i];
+                break;
+            }
+
+        if (!opt) {
+            HDfprintf(stderr, "Unknown option '%s'\n", argv[arg]);
+            return -1;
+        }
+
+        if (opt->kind == VOL_BENCH_OPTION_FLAG) {
+            *((hbool_t *)opt->value) = TRUE;
+            continue;
+        }
+
+        if (++arg >= argc) {
+            HDfprintf(stderr, "Option '%s' requires a value\n", opt->name);
+            return -1;
+        }
+
+        switch (opt->kind) {
+            case VOL_BENCH_OPTION_SIZE:
+                if (vol_test_parse_size(argv[arg], (hsize_t *)opt->value) < 0) {
+                    HDfprintf(stderr, "Invalid size '%s' for option '%s'\n", argv[arg], opt->name);
+                    return -1;
+                }
+                break;
+            case VOL_BENCH_OPTION_UNSIGNED: {
+                char         *end = NULL;
+                unsigned long value;
+
+                /* strtoul() would negate a leading '-' rather than reject it */
+                errno = 0;
+                value = HDstrtoul(argv[arg], &end, 10);
+                if (errno || end == argv[arg] || *end != '\0' || HDstrchr(argv[arg], '-') ||
+                    value > UINT_MAX) {
+                    HDfprintf(stderr, "Invalid value '%s' for option '%s'\n", argv[arg], opt->name);
+                    return -1;
+                }
+
+                *((unsigned *)opt->value) = (unsigned)value;
+                break;
+            }
+            case VOL_BENCH_OPTION_DOUBLE: {
+                char  *end = NULL;
+                double value;
+
+                value = HDstrtod(argv[arg], &end);
+                if (end == argv[arg] || *end != '\0') {
+                    HDfprintf(stderr, "Invalid value '%s' for option '%s'\n", argv[arg], opt->name);
+                    return -1;
+                }
+
+                *((double *)opt->value) = value;
+                break;
+            }
+            case VOL_BENCH_OPTION_STRING:
+                *((const char **)opt->value) = argv[arg];
+                break;
+            case VOL_BENCH_OPTION_FLAG:
+            default:
+                break;
+        }
+    }
+
+    if (vol_bench_params_g.iterations == 0 || vol_bench_params_g.xfer_size == 0 ||
+        vol_bench_params_g.max_points == 0) {
+        HDfprintf(stderr, "--iterations, --xfer-size and --max-points must be greater than 0\n");
+        return -1;
+    }
+
+    if (vol_bench_params_g.link_fanout == 0 || vol_bench_params_g.link_depth == 0) {
+        HDfprintf(stderr, "--link-fanout and --link-depth must be greater than 0\n");
+        return -1;
+    }
+
+    if (vol_bench_params_g.contention_ops == 0 || vol_bench_params_g.tconv_pairs == 0 ||
+        vol_bench_params_g.appends == 0) {
+        HDfprintf(stderr, "--contention-ops, --tconv-pairs and --appends must be greater than 0\n");
+        return -1;
+    }
+
+    if (vol_bench_params_g.link_soft < 0.0 || vol_bench_params_g.link_soft > 1.0 ||
+        vol_bench_params_g.link_external < 0.0 || vol_bench_params_g.link_external > 1.0 ||
+        vol_bench_params_g.link_cycles < 0.0 || vol_bench_params_g.link_cycles > 1.0) {
+        HDfprintf(stderr, "--link-soft, --link-external and --link-cycles must be between 0 and 1\n");
+        return -1;
+    }
+
+    if (vol_bench_type() < 0) {
+        HDfprintf(stderr, "Unknown element type '%s'\n", vol_bench_params_g.type_name);
+        return -1;
+    }
+
+    /* Check the list-valued options up front rather than partway through a run */
+    {
+        double doubles[VOL_BENCH_MAX_LIST_VALUES];
+        size_t nvalues;
+
+        if (vol_bench_check_size_list(vol_bench_params_g.chunk_dims, "--chunk-dims", 1, HSIZET_MAX,
+                                      "Chunk dimensions must be greater than 0") < 0)
+            return -1;
+        if (vol_bench_check_size_list(vol_bench_params_g.cache_nbytes, "--cache-nbytes", 0, HSIZET_MAX,
+                                      NULL) < 0)
+            return -1;
+        if (vol_bench_check_size_list(vol_bench_params_g.cache_nslots, "--cache-nslots", 1, HSIZET_MAX,
+                                      "Chunk cache slot counts must be greater than 0") < 0)
+            return -1;
+
+        if (vol_bench_parse_double_list(vol_bench_params_g.cache_w0, doubles, &nvalues) < 0) {
+            HDfprintf(stderr, "Invalid list '%s' for option '--cache-w0'\n", vol_bench_params_g.cache_w0);
+            return -1;
+        }
+        for (size_t i = 0; i < nvalues; i++)
+            if (doubles[i] < 0.0 || doubles[i] > 1.0) {
+                HDfprintf(stderr, "Chunk cache preemption policies must be between 0 and 1\n");
+                return -1;
+            }
+
+        if (vol_bench_check_size_list(vol_bench_params_g.multi_dsets, "--multi-dsets", 1, HSIZET_MAX,
+                                      "Dataset counts must be greater than 0") < 0)
+            return -1;
+        if (vol_bench_check_size_list(vol_bench_params_g.group_counts, "--group-counts", 1, HSIZET_MAX,
+                                      "Group counts must be greater than 0") < 0)
+            return -1;
+        if (vol_bench_check_size_list(vol_bench_params_g.group_depths, "--group-depths", 1, HSIZET_MAX,
+                                      "Group depths must be greater than 0") < 0)
+            return -1;
+        if (vol_bench_check_size_list(vol_bench_params_g.attr_counts, "--attr-counts", 1, HSIZET_MAX,
+                                      "Attribute counts must be greater than 0") < 0)
+            return -1;
+        if (vol_bench_check_size_list(vol_bench_params_g.attr_phase_change, "--attr-phase-change", 0, 65535,
+                                      "Attribute phase change thresholds may not be greater than 65535") < 0)
+            return -1;
+        if (vol_bench_check_size_list(vol_bench_params_g.async_depths, "--async-depths", 1, HSIZET_MAX,
+                                      "Async pipeline depths must be greater than 0") < 0)
+            return -1;
+        if (vol_bench_check_size_list(vol_bench_params_g.thread_counts, "--threads", 1, HSIZET_MAX,
+                                      "Thread counts must be greater than 0") < 0)
+            return -1;
+        if (vol_bench_check_size_list(vol_bench_params_g.compound_fields, "--compound-fields", 1, UINT_MAX,
+                                      "Compound field counts must be greater than 0") < 0)
+            return -1;
+        if (vol_bench_check_size_list(vol_bench_params_g.compound_reads, "--compound-reads", 1, HSIZET_MAX,
+                                      "Compound read field counts must be greater than 0") < 0)
+            return -1;
+        if (vol_bench_check_size_list(vol_bench_params_g.append_batches, "--append-batches", 1, HSIZET_MAX,
+                                      "Append batch sizes must be greater than 0") < 0)
+            return -1;
+        if (vol_bench_check_size_list(vol_bench_params_g.append_chunks, "--append-chunks", 1, UINT32_MAX,
+                                      "Append chunk sizes must be between 1 and 4G records") < 0)
+            return -1;
+    }
+
+    return 0;
+}
+
+/*
+ * Returns the native datatype selected with the --type option.
+ */
+hid_t
+vol_bench_type(void)
+{
+    const hid_t types[] = {H5T_NATIVE_CHAR,  H5T_NATIVE_UCHAR, H5T_NATIVE_SHORT, H5T_NATIVE_USHORT,
+                           H5T_NATIVE_INT,   H5T_NATIVE_UINT,  H5T_NATIVE_LONG,  H5T_NATIVE_ULONG,
+                           H5T_NATIVE_LLONG, H5T_NATIVE_ULLONG, H5T_NATIVE_FLOAT, H5T_NATIVE_DOUBLE};
+
+    for (size_t i = 0; i < ARRAY_LENGTH(vol_bench_type_names); i++)
+        if (!HDstrcmp(vol_bench_params_g.type_name, vol_bench_type_names[i]))
+            return types[i];
+
+    return H5I_INVALID_HID;
+}
+
+/*
+ * Fills a buffer with a byte pattern determined by the offset of
+ * each byte within the dataset being written, so that any block of
+ * data read back can be checked with vol_bench_check_buffer().
+ */
+void
+vol_bench_fill_buffer(void *buf, size_t nbytes, hsize_t offset)
+{
+    unsigned char *bytes = (unsigned char *)buf;
+
+    for (size_t i = 0; i < nbytes; i++)
+        bytes[i] = (unsigned char)((offset + i) % 251);
+}
+
+/*
+ * Returns the number of bytes in a buffer that don't match the
+ * pattern written by vol_bench_fill_buffer() for the same offset.
+ */
+hsize_t
+vol_bench_check_buffer(const void *buf, size_t nbytes, hsize_t offset)
+{
+    const unsigned char *bytes     = (const unsigned char *)buf;
+    hsize_t              nmismatch = 0;
+
+    for (size_t i = 0; i < nbytes; i++)
+        if (bytes[i] != (unsigned char)((offset + i) % 251))
+            nmismatch++;
+
+    return nmismatch;
+}
+
+/*
+ * Writes the results recorded by vol_bench_report() to the given
+ * file, as JSON if the filename ends in ".json" and as CSV otherwise.
+ */
+herr_t
+vol_bench_write_report(const char *filename)
+{
+    size_t  name_len;
+    hbool_t json;
+    FILE   *f         = NULL;
+    herr_t  ret_value = SUCCEED;
+
+    name_len = HDstrlen(filename);
+    json     = (name_len > 5) && !HDstrcmp(filename + name_len - 5, ".json");
+
+    if (NULL == (f = HDfopen(filename, "w"))) {
+        HDprintf("    couldn't open report file '%s'\n", filename);
+        ret_value = FAIL;
+        goto done;
+    }
+
+    if (json)
+        HDfprintf(f, "{\n  \"results\": [\n");
+    else
+        HDfprintf(f, "interface,benchmark,ops,bytes,seconds,mb_per_sec,ops_per_sec,p50,p90,p99,max,metric,"
+                     "metric_value\n");
+
+    for (size_t i = 0; i < nresults_g; i++) {
+        vol_bench_result_t *r    = &results_g[i];
+        double              mbps =
+            (r->total_seconds > 0.0) ? ((double)r->nbytes / 1.0E6) / r->total_seconds : 0.0;
+        double              opps = (r->total_seconds > 0.0) ? (double)r->nops / r->total_seconds : 0.0;
+
+        if (json) {
+            HDfprintf(f,
+                      "    {\"interface\": \"%s\", \"benchmark\": \"%s\", \"ops\": %zu, \"bytes\": %llu, "
+                      "\"seconds\": %.9f, \"mb_per_sec\": %.6f, \"ops_per_sec\": %.6f, \"p50\": %.9f, "
+                      "\"p90\": %.9f, \"p99\": %.9f, \"max\": %.9f",
+                      r->interface_name, r->name, r->nops, (unsigned long long)r->nbytes, r->total_seconds,
+                      mbps, opps, r->p50, r->p90, r->p99, r->max);
+            if (r->metric_name)
+                HDfprintf(f, ", \"%s\": %.6f", r->metric_name, r->metric_value);
+            HDfprintf(f, "}%s\n", (i < nresults_g - 1) ? "," : "");
+        }
+        else {
+            HDfprintf(f, "\"%s\",\"%s\",%zu,%llu,%.9f,%.6f,%.6f,%.9f,%.9f,%.9f,%.9f,", r->interface_name,
+                      r->name, r->nops, (unsigned long long)r->nbytes, r->total_seconds, mbps, opps, r->p50,
+                      r->p90, r->p99, r->max);
+            if (r->metric_name)
+                HDfprintf(f, "\"%s\",%.6f\n", r->metric_name, r->metric_value);
+            else
+                HDfprintf(f, ",\n");
+        }
+    }
+
+    if (json)
+        HDfprintf(f, "  ]\n}\n");
+
+done:
+    if (f && HDfclose(f) < 0) {
+        HDprintf("    couldn't close report file '%s'\n", filename);
+        ret_value = FAIL;
+    }
+
+    return ret_value;
+}
+
+void
+vol_bench_free_results(void)
+{
+    for (size_t i = 0; i < nresults_g; i++) {
+        HDfree(results_g[i].interface_name);
+        HDfree(results_g[i].name);
+        HDfree(results_g[i].metric_name);
+    }
+
+    HDfree(results_g);
+    results_g       = NULL;
+    nresults_g      = 0;
+    results_alloc_g = 0;
+}
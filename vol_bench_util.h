@@ -0,0 +1,102 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * Copyright by The HDF Group.                                               *
+ * All rights reserved.                                                      *
+ *                                                                           *
+ * This file is part of HDF5.  The full HDF5 copyright notice, including     *
+ * terms governing use, modification, and redistribution, is contained in    *
+ * the COPYING file, which can be found at the root of the source code       *
+ * distribution tree, or in https://support.hdfgroup.org/ftp/HDF5/releases.  *
+ * If you do not have access to either file, you may request a copy from     *
+ * help@hdfgroup.org.                                                        *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#ifndef VOL_BENCH_UTIL_H_
+#define VOL_BENCH_UTIL_H_
+
+#include "hdf5.h"
+
+/*
+ * Parameters shared by all of the benchmarks, settable from
+ * the command line. See vol_bench_usage() for the option
+ * corresponding to each parameter.
+ */
+typedef struct vol_bench_params_t {
+    hsize_t     dataset_size;      /* Total size in bytes of each benchmark dataset */
+    hsize_t     xfer_size;         /* Size in bytes of each partial I/O operation */
+    const char *type_name;         /* Name of the dataset element type */
+    unsigned    iterations;        /* Number of times each measurement is repeated */
+    hsize_t     max_points;        /* Maximum number of points in a point selection */
+    hbool_t     verify;            /* Whether to verify all data read back */
+    const char *report_filename;   /* File to write benchmark results to */
+    const char *chunk_dims;        /* Comma-separated list of chunk edge lengths to sweep */
+    const char *cache_nbytes;      /* Comma-separated list of chunk cache sizes to sweep */
+    const char *cache_nslots;      /* Comma-separated list of chunk cache slot counts to sweep */
+    const char *cache_w0;          /* Comma-separated list of chunk cache preemption policies to sweep */
+    const char *multi_dsets;       /* Comma-separated list of dataset counts for multi-dataset I/O */
+    const char *group_counts;      /* Comma-separated list of the number of groups to create */
+    const char *group_depths;      /* Comma-separated list of the depths at which groups are created */
+    const char *attr_counts;       /* Comma-separated list of the number of attributes per object */
+    const char *attr_phase_change; /* Comma-separated list of maximum compact attribute counts to sweep */
+    unsigned    link_fanout;       /* Number of child groups of each group in the link graph */
+    unsigned    link_depth;        /* Number of levels of groups in the link graph */
+    double      link_soft;         /* Fraction of groups in the link graph with a soft link */
+    double      link_external;     /* Fraction of groups in the link graph with an external link */
+    double      link_cycles;       /* Fraction of groups in the link graph with a link back to its top */
+    const char *async_depths;      /* Comma-separated list of the number of async operations in flight */
+    unsigned    compute_usec;      /* Microseconds of compute per async operation, 0 to match the I/O time */
+    const char *thread_counts;     /* Comma-separated list of the number of threads accessing HDF5 at once */
+    unsigned    contention_ops;    /* Number of operations made by each thread */
+    unsigned    tconv_pairs;       /* Number of datatype pairs benchmarked for each conversion path */
+    const char *compound_fields;   /* Comma-separated list of the number of fields in a compound type */
+    const char *compound_reads;    /* Comma-separated list of the number of compound fields read at once */
+    const char *append_batches;    /* Comma-separated list of the number of records in each append */
+    const char *append_chunks;     /* Comma-separated list of chunk sizes, in records, of appended datasets */
+    unsigned    appends;           /* Number of appends made to each dataset */
+    unsigned    flush_every;       /* Number of appends between flushes of the dataset, 0 for none */
+    hbool_t     append_reader;     /* Whether to read the records appended after each flush */
+} vol_bench_params_t;
+
+extern vol_bench_params_t vol_bench_params_g;
+
+/* The maximum number of values in a list-valued option */
+#define VOL_BENCH_MAX_LIST_VALUES 16
+
+/* The number of buckets and width in characters of a latency histogram */
+#define VOL_BENCH_HISTOGRAM_BUCKETS 48
+#define VOL_BENCH_HISTOGRAM_WIDTH   40
+
+/*
+ * A set of latency samples, in seconds, for one measured operation.
+ */
+typedef struct vol_bench_stats_t {
+    double *samples;
+    size_t  nsamples;
+    size_t  nalloc;
+    double  total;
+} vol_bench_stats_t;
+
+double vol_bench_now(void);
+
+void   vol_bench_stats_init(vol_bench_stats_t *stats);
+herr_t vol_bench_stats_add(vol_bench_stats_t *stats, double seconds);
+double vol_bench_stats_percentile(vol_bench_stats_t *stats, double percentile);
+void   vol_bench_stats_free(vol_bench_stats_t *stats);
+void   vol_bench_stats_histogram(const vol_bench_stats_t *stats);
+
+void vol_bench_report(const char *interface_name, const char *name, hsize_t nbytes,
+                      vol_bench_stats_t *stats);
+void vol_bench_report_metric(const char *interface_name, const char *name, hsize_t nbytes,
+                             vol_bench_stats_t *stats, const char *metric_name, double metric_value);
+
+int    vol_bench_parse_options(int argc, char **argv, int (*select_cb)(const char *name));
+void   vol_bench_usage(const char *progname);
+hid_t  vol_bench_type(void);
+herr_t vol_bench_parse_size_list(const char *str, hsize_t *values, size_t *nvalues_out);
+herr_t vol_bench_parse_double_list(const char *str, double *values, size_t *nvalues_out);
+void   vol_bench_fill_buffer(void *buf, size_t nbytes, hsize_t offset);
+hsize_t vol_bench_check_buffer(const void *buf, size_t nbytes, hsize_t offset);
+
+herr_t vol_bench_write_report(const char *filename);
+void   vol_bench_free_results(void);
+
+#endif /* VOL_BENCH_UTIL_H_ */
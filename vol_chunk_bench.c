@@ -0,0 +1,641 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * Copyright by The HDF Group.                                               *
+ * All rights reserved.                                                      *
+ *                                                                           *
+ * This file is part of HDF5.  The full HDF5 copyright notice, including     *
+ * terms governing use, modification, and redistribution, is contained in    *
+ * the COPYING file, which can be found at the root of the source code       *
+ * distribution tree, or in https://support.hdfgroup.org/ftp/HDF5/releases.  *
+ * If you do not have access to either file, you may request a copy from     *
+ * help@hdfgroup.org.                                                        *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+/*
+ * Benchmarks for chunked datasets. For each chunk shape given with
+ * --chunk-dims, a square two-dimensional dataset of --size bytes is
+ * written and read back with several access patterns under each
+ * combination of the chunk cache parameters given with --cache-nbytes,
+ * --cache-nslots and --cache-w0.
+ *
+ * HDF5 doesn't expose chunk cache statistics through its public API,
+ * so each result is accompanied by the hit ratio of a simple model
+ * of the chunk cache: a hash table of rdcc_nslots slots indexed by
+ * the linear index of each chunk, holding at most rdcc_nbytes worth of
+ * chunks and evicting the least recently used chunk when full. The
+ * model ignores rdcc_w0, so it serves to spot configurations where
+ * an access pattern can't fit its working set of chunks in the cache,
+ * rather than to predict the exact behavior of any connector.
+ */
+
+#include "vol_chunk_bench.h"
+
+typedef enum chunk_bench_pattern_t {
+    CHUNK_BENCH_ROW_MAJOR,     /* One row of the dataset at a time, crossing every chunk in a row of chunks */
+    CHUNK_BENCH_COLUMN_MAJOR,  /* One column of the dataset at a time, crossing every chunk in a column */
+    CHUNK_BENCH_RANDOM_CHUNK,  /* Whole chunks, chosen at random */
+    CHUNK_BENCH_PARTIAL_CHUNK, /* Chunk-sized blocks offset by half a chunk, each touching up to 4 chunks */
+    CHUNK_BENCH_NPATTERNS
+} chunk_bench_pattern_t;
+
+static const char *const chunk_bench_pattern_names[] = {"row-major", "column-major", "random-chunk",
+                                                        "partial-chunk"};
+
+/* The shape of the dataset and its chunks for a single chunk shape in the sweep */
+typedef struct chunk_bench_geom_t {
+    hsize_t dims[CHUNK_BENCH_DSET_SPACE_RANK];
+    hsize_t chunk_dims[CHUNK_BENCH_DSET_SPACE_RANK];
+    hsize_t nchunks[CHUNK_BENCH_DSET_SPACE_RANK];
+    size_t  type_size;
+} chunk_bench_geom_t;
+
+/* The chunk cache settings for a single point in the sweep */
+typedef struct chunk_bench_cache_t {
+    size_t nbytes;
+    size_t nslots;
+    double w0;
+} chunk_bench_cache_t;
+
+/* The model of the chunk cache described above */
+typedef struct chunk_bench_cache_model_t {
+    size_t   nslots;
+    size_t   max_chunks; /* The number of chunks that fit in rdcc_nbytes */
+    size_t   nused;
+    hsize_t *slot_chunk; /* The chunk held in each slot, or HSIZE_UNDEF */
+    size_t  *prev;       /* Least-recently-used list, linked through the slots */
+    size_t  *next;
+    size_t   head; /* Most recently used slot */
+    size_t   tail; /* Least recently used slot */
+    hsize_t  hits;
+    hsize_t  misses;
+} chunk_bench_cache_model_t;
+
+#define CHUNK_BENCH_NO_SLOT ((size_t)-1)
+
+static herr_t
+chunk_bench_model_init(chunk_bench_cache_model_t *model, const chunk_bench_cache_t *cache,
+                       const chunk_bench_geom_t *geom)
+{
+    size_t chunk_bytes = (size_t)(geom->chunk_dims[0] * geom->chunk_dims[1]) * geom->type_size;
+
+    HDmemset(model, 0, sizeof(*model));
+
+    model->nslots     = cache->nslots;
+    model->max_chunks = cache->nbytes / chunk_bytes;
+    model->head       = CHUNK_BENCH_NO_SLOT;
+    model->tail       = CHUNK_BENCH_NO_SLOT;
+
+    if (NULL == (model->slot_chunk = HDmalloc(model->nslots * sizeof(hsize_t))))
+        return FAIL;
+    if (NULL == (model->prev = HDmalloc(model->nslots * sizeof(size_t))))
+        return FAIL;
+    if (NULL == (model->next = HDmalloc(model->nslots * sizeof(size_t))))
+        return FAIL;
+
+    for (size_t i = 0; i < model->nslots; i++)
+        model->slot_chunk[i] = HSIZE_UNDEF;
+
+    return SUCCEED;
+}
+
+static void
+chunk_bench_model_unlink(chunk_bench_cache_model_t *model, size_t slot)
+{
+    if (model->prev[slot] != CHUNK_BENCH_NO_SLOT)
+        model->next[model->prev[slot]] = model->next[slot];
+    else
+        model->head = model->next[slot];
+
+    if (model->next[slot] != CHUNK_BENCH_NO_SLOT)
+        model->prev[model->next[slot]] = model->prev[slot];
+    else
+        model->tail = model->prev[slot];
+}
+
+static void
+chunk_bench_model_push(chunk_bench_cache_model_t *model, size_t slot)
+{
+    model->prev[slot] = CHUNK_BENCH_NO_SLOT;
+    model->next[slot] = model->head;
+    if (model->head != CHUNK_BENCH_NO_SLOT)
+        model->prev[model->head] = slot;
+    model->head = slot;
+    if (model->tail == CHUNK_BENCH_NO_SLOT)
+        model->tail = slot;
+}
+
+static void
+chunk_bench_model_evict(chunk_bench_cache_model_t *model, size_t slot)
+{
+    chunk_bench_model_unlink(model, slot);
+    model->slot_chunk[slot] = HSIZE_UNDEF;
+    model->nused--;
+}
+
+static void
+chunk_bench_model_access(chunk_bench_cache_model_t *model, hsize_t chunk)
+{
+    size_t slot = (size_t)(chunk % model->nslots);
+
+    /* Chunks larger than the cache are never cached */
+    if (model->max_chunks == 0) {
+        model->misses++;
+        return;
+    }
+
+    if (model->slot_chunk[slot] == chunk) {
+        model->hits++;
+        chunk_bench_model_unlink(model, slot);
+        chunk_bench_model_push(model, slot);
+        return;
+    }
+
+    model->misses++;
+
+    /* A chunk that hashes to an occupied slot evicts the chunk there */
+    if (model->slot_chunk[slot] != HSIZE_UNDEF)
+        chunk_bench_model_evict(model, slot);
+    while (model->nused >= model->max_chunks)
+        chunk_bench_model_evict(model, model->tail);
+
+    model->slot_chunk[slot] = chunk;
+    model->nused++;
+    chunk_bench_model_push(model, slot);
+}
+
+/*
+ * Records an access to every chunk overlapped by a block of the dataset
+ */
+static void
+chunk_bench_model_access_block(chunk_bench_cache_model_t *model, const chunk_bench_geom_t *geom,
+                               const hsize_t *start, const hsize_t *count)
+{
+    for (hsize_t row = start[0] / geom->chunk_dims[0]; row <= (start[0] + count[0] - 1) / geom->chunk_dims[0];
+         row++)
+        for (hsize_t col = start[1] / geom->chunk_dims[1];
+             col <= (start[1] + count[1] - 1) / geom->chunk_dims[1]; col++)
+            chunk_bench_model_access(model, (row * geom->nchunks[1]) + col);
+}
+
+static void
+chunk_bench_model_free(chunk_bench_cache_model_t *model)
+{
+    HDfree(model->slot_chunk);
+    HDfree(model->prev);
+    HDfree(model->next);
+}
+
+/*
+ * Returns the number of I/O operations making up a single
+ * pass of the given access pattern over the dataset.
+ */
+static hsize_t
+chunk_bench_nblocks(chunk_bench_pattern_t pattern, const chunk_bench_geom_t *geom)
+{
+    hsize_t nblocks = 0;
+
+    switch (pattern) {
+        case CHUNK_BENCH_ROW_MAJOR:
+            nblocks = geom->dims[0];
+            break;
+        case CHUNK_BENCH_COLUMN_MAJOR:
+            nblocks = geom->dims[1];
+            break;
+        case CHUNK_BENCH_RANDOM_CHUNK:
+            nblocks = geom->nchunks[0] * geom->nchunks[1];
+            break;
+        case CHUNK_BENCH_PARTIAL_CHUNK:
+            nblocks = 1;
+            for (int i = 0; i < CHUNK_BENCH_DSET_SPACE_RANK; i++) {
+                hsize_t offset = geom->chunk_dims[i] / 2;
+
+                nblocks *= (geom->dims[i] - offset + geom->chunk_dims[i] - 1) / geom->chunk_dims[i];
+            }
+            break;
+        case CHUNK_BENCH_NPATTERNS:
+        default:
+            break;
+    }
+
+    return nblocks;
+}
+
+/*
+ * Returns the block of the dataset accessed by the given I/O
+ * operation of a pass of the given access pattern.
+ */
+static void
+chunk_bench_block(chunk_bench_pattern_t pattern, const chunk_bench_geom_t *geom, hsize_t block, hsize_t *start,
+                  hsize_t *count)
+{
+    switch (pattern) {
+        case CHUNK_BENCH_ROW_MAJOR:
+            start[0] = block;
+            start[1] = 0;
+            count[0] = 1;
+            count[1] = geom->dims[1];
+            break;
+        case CHUNK_BENCH_COLUMN_MAJOR:
+            start[0] = 0;
+            start[1] = block;
+            count[0] = geom->dims[0];
+            count[1] = 1;
+            break;
+        case CHUNK_BENCH_RANDOM_CHUNK: {
+            hsize_t chunk = (hsize_t)vol_test_random() % (geom->nchunks[0] * geom->nchunks[1]);
+
+            start[0] = (chunk / geom->nchunks[1]) * geom->chunk_dims[0];
+            start[1] = (chunk % geom->nchunks[1]) * geom->chunk_dims[1];
+            count[0] = MIN(geom->chunk_dims[0], geom->dims[0] - start[0]);
+            count[1] = MIN(geom->chunk_dims[1], geom->dims[1] - start[1]);
+            break;
+        }
+        case CHUNK_BENCH_PARTIAL_CHUNK: {
+            hsize_t offset[CHUNK_BENCH_DSET_SPACE_RANK];
+            hsize_t nblocks_col;
+
+            offset[0]   = geom->chunk_dims[0] / 2;
+            offset[1]   = geom->chunk_dims[1] / 2;
+            nblocks_col = (geom->dims[1] - offset[1] + geom->chunk_dims[1] - 1) / geom->chunk_dims[1];
+
+            start[0] = offset[0] + (block / nblocks_col) * geom->chunk_dims[0];
+            start[1] = offset[1] + (block % nblocks_col) * geom->chunk_dims[1];
+            count[0] = MIN(geom->chunk_dims[0], geom->dims[0] - start[0]);
+            count[1] = MIN(geom->chunk_dims[1], geom->dims[1] - start[1]);
+            break;
+        }
+        case CHUNK_BENCH_NPATTERNS:
+        default:
+            start[0] = start[1] = 0;
+            count[0] = count[1] = 0;
+            break;
+    }
+}
+
+/*
+ * Fills a buffer for a block of the dataset with the benchmark
+ * data pattern or, if check is TRUE, returns the number of bytes
+ * in the buffer that don't match the pattern.
+ */
+static hsize_t
+chunk_bench_block_data(void *buf, const chunk_bench_geom_t *geom, const hsize_t *start, const hsize_t *count,
+                       hbool_t check)
+{
+    size_t  row_size  = (size_t)count[1] * geom->type_size;
+    hsize_t nmismatch = 0;
+
+    for (hsize_t i = 0; i < count[0]; i++) {
+        unsigned char *row    = (unsigned char *)buf + (i * row_size);
+        hsize_t        offset = (((start[0] + i) * geom->dims[1]) + start[1]) * geom->type_size;
+
+        if (check)
+            nmismatch += vol_bench_check_buffer(row, row_size, offset);
+        else
+            vol_bench_fill_buffer(row, row_size, offset);
+    }
+
+    return nmismatch;
+}
+
+static void
+chunk_bench_format_size(hsize_t size, char *buf, size_t buf_size)
+{
+    const char *suffixes = "KMGT";
+    int         i        = -1;
+
+    while (i < 3 && size >= 1024 && (size % 1024) == 0) {
+        size /= 1024;
+        i++;
+    }
+
+    if (i < 0)
+        HDsnprintf(buf, buf_size, "%llu", (unsigned long long)size);
+    else
+        HDsnprintf(buf, buf_size, "%llu%c", (unsigned long long)size, suffixes[i]);
+}
+
+/*
+ * Runs the given access pattern over an open chunked dataset,
+ * writing or reading every block in each pass, and reports the
+ * results along with the hit ratio of the chunk cache model.
+ */
+static int
+chunk_bench_pattern(hid_t dset_id, hid_t type_id, const chunk_bench_geom_t *geom,
+                    const chunk_bench_cache_t *cache, chunk_bench_pattern_t pattern, hbool_t write)
+{
+    chunk_bench_cache_model_t model;
+    vol_bench_stats_t         stats;
+    hsize_t                   nblocks = chunk_bench_nblocks(pattern, geom);
+    hsize_t                   nbytes  = 0;
+    size_t                    buf_size;
+    hid_t                     mspace_id = H5I_INVALID_HID;
+    hid_t                     fspace_id = H5I_INVALID_HID;
+    void                     *buf       = NULL;
+    char                      nbytes_str[32];
+    char                      name[CHUNK_BENCH_NAME_LENGTH];
+
+    vol_bench_stats_init(&stats);
+
+    if (chunk_bench_model_init(&model, cache, geom) < 0)
+        BENCH_ERROR;
+
+    buf_size = (size_t)MAX(MAX(geom->dims[0], geom->dims[1]), geom->chunk_dims[0] * geom->chunk_dims[1]) *
+               geom->type_size;
+    if (NULL == (buf = HDmalloc(buf_size)))
+        BENCH_ERROR;
+
+    if ((fspace_id = H5Dget_space(dset_id)) < 0)
+        BENCH_ERROR;
+
+    for (unsigned i = 0; i < vol_bench_params_g.iterations; i++) {
+        for (hsize_t block = 0; block < nblocks; block++) {
+            hsize_t start[CHUNK_BENCH_DSET_SPACE_RANK];
+            hsize_t count[CHUNK_BENCH_DSET_SPACE_RANK];
+            herr_t  err;
+            double  t0;
+
+            chunk_bench_block(pattern, geom, block, start, count);
+
+            if ((mspace_id = H5Screate_simple(CHUNK_BENCH_DSET_SPACE_RANK, count, NULL)) < 0)
+                BENCH_ERROR;
+            if (H5Sselect_hyperslab(fspace_id, H5S_SELECT_SET, start, NULL, count, NULL) < 0)
+                BENCH_ERROR;
+
+            if (write)
+                chunk_bench_block_data(buf, geom, start, count, FALSE);
+
+            t0 = vol_bench_now();
+
+            if (write)
+                err = H5Dwrite(dset_id, type_id, mspace_id, fspace_id, H5P_DEFAULT, buf);
+            else
+                err = H5Dread(dset_id, type_id, mspace_id, fspace_id, H5P_DEFAULT, buf);
+
+            if (err < 0) {
+                HDprintf("    couldn't %s chunked dataset\n", write ? "write to" : "read from");
+                BENCH_ERROR;
+            }
+
+            if (vol_bench_stats_add(&stats, vol_bench_now() - t0) < 0)
+                BENCH_ERROR;
+
+            if (!write && vol_bench_params_g.verify) {
+                hsize_t nmismatch;
+
+                if ((nmismatch = chunk_bench_block_data(buf, geom, start, count, TRUE)) > 0) {
+                    HDprintf("    %llu bytes read from chunked dataset didn't match what was written\n",
+                             (unsigned long long)nmismatch);
+                    BENCH_ERROR;
+                }
+            }
+
+            chunk_bench_model_access_block(&model, geom, start, count);
+            nbytes += count[0] * count[1] * geom->type_size;
+
+            if (H5Sclose(mspace_id) < 0)
+                BENCH_ERROR;
+            mspace_id = H5I_INVALID_HID;
+        }
+    }
+
+    chunk_bench_format_size((hsize_t)cache->nbytes, nbytes_str, sizeof(nbytes_str));
+    HDsnprintf(name, sizeof(name), "%s %s %llux%llu %s/%zu/%.2f", write ? "write" : "read",
+               chunk_bench_pattern_names[pattern], (unsigned long long)geom->chunk_dims[0],
+               (unsigned long long)geom->chunk_dims[1], nbytes_str, cache->nslots, cache->w0);
+
+    vol_bench_report_metric("chunk", name, nbytes, &stats, "est-hit-ratio",
+                            (model.hits + model.misses) > 0
+                                ? (double)model.hits / (double)(model.hits + model.misses)
+                                : 0.0);
+
+    if (H5Sclose(fspace_id) < 0)
+        BENCH_ERROR;
+
+    HDfree(buf);
+    chunk_bench_model_free(&model);
+    vol_bench_stats_free(&stats);
+
+    return 0;
+
+error:
+    H5E_BEGIN_TRY
+    {
+        H5Sclose(mspace_id);
+        H5Sclose(fspace_id);
+    }
+    H5E_END_TRY;
+
+    HDfree(buf);
+    chunk_bench_model_free(&model);
+    vol_bench_stats_free(&stats);
+
+    return 1;
+}
+
+/*
+ * Runs every access pattern, writing and then reading, over the
+ * given chunked dataset with the given chunk cache settings. The
+ * dataset is reopened before each pass so that each starts with
+ * an empty chunk cache.
+ */
+static int
+chunk_bench_cache_config(hid_t group_id, const char *dset_name, hid_t type_id, const chunk_bench_geom_t *geom,
+                         const chunk_bench_cache_t *cache)
+{
+    hid_t dapl_id = H5I_INVALID_HID;
+    hid_t dset_id = H5I_INVALID_HID;
+    int   nerrors = 0;
+
+    if ((dapl_id = H5Pcreate(H5P_DATASET_ACCESS)) < 0)
+        BENCH_ERROR;
+
+    if (H5Pset_chunk_cache(dapl_id, cache->nslots, cache->nbytes, cache->w0) < 0) {
+        HDprintf("    couldn't set chunk cache parameters\n");
+        BENCH_ERROR;
+    }
+
+    for (int pattern = 0; pattern < CHUNK_BENCH_NPATTERNS; pattern++) {
+        for (int write = 1; write >= 0; write--) {
+            /* The random chunks are read back in the order they were written */
+            vol_test_random_begin(VOL_TEST_TIMER_TEST, chunk_bench_pattern_names[pattern]);
+
+            if ((dset_id = H5Dopen2(group_id, dset_name, dapl_id)) < 0) {
+                HDprintf("    couldn't open dataset '%s'\n", dset_name);
+                BENCH_ERROR;
+            }
+
+            nerrors += chunk_bench_pattern(dset_id, type_id, geom, cache, (chunk_bench_pattern_t)pattern,
+                                           (hbool_t)write);
+
+            if (H5Dclose(dset_id) < 0)
+                BENCH_ERROR;
+            dset_id = H5I_INVALID_HID;
+        }
+    }
+
+    if (H5Pclose(dapl_id) < 0)
+        BENCH_ERROR;
+
+    return nerrors;
+
+error:
+    H5E_BEGIN_TRY
+    {
+        H5Dclose(dset_id);
+        H5Pclose(dapl_id);
+    }
+    H5E_END_TRY;
+
+    return nerrors + 1;
+}
+
+int
+vol_chunk_bench(void)
+{
+    chunk_bench_geom_t geom;
+    hsize_t            chunk_dims[VOL_BENCH_MAX_LIST_VALUES];
+    hsize_t            cache_nbytes[VOL_BENCH_MAX_LIST_VALUES];
+    hsize_t            cache_nslots[VOL_BENCH_MAX_LIST_VALUES];
+    double             cache_w0[VOL_BENCH_MAX_LIST_VALUES];
+    size_t             nchunk_dims, ncache_nbytes, ncache_nslots, ncache_w0;
+    hsize_t            nelems;
+    int                nerrors   = 0;
+    hid_t              file_id   = H5I_INVALID_HID;
+    hid_t              group_id  = H5I_INVALID_HID;
+    hid_t              dset_id   = H5I_INVALID_HID;
+    hid_t              dcpl_id   = H5I_INVALID_HID;
+    hid_t              fspace_id = H5I_INVALID_HID;
+    hid_t              type_id   = vol_bench_type();
+
+    HDprintf("**********************************************\n");
+    HDprintf("*                                            *\n");
+    HDprintf("*       VOL Chunked Dataset Benchmarks       *\n");
+    HDprintf("*                                            *\n");
+    HDprintf("**********************************************\n\n");
+
+    /* Make sure the connector supports the API functions being benchmarked */
+    if (!(vol_cap_flags_g & H5VL_CAP_FLAG_FILE_BASIC) || !(vol_cap_flags_g & H5VL_CAP_FLAG_GROUP_BASIC) ||
+        !(vol_cap_flags_g & H5VL_CAP_FLAG_DATASET_BASIC) || !(vol_cap_flags_g & H5VL_CAP_FLAG_DATASET_MORE)) {
+        BENCH_SKIPPED("chunked dataset I/O",
+                      "API functions for basic file, group, or dataset aren't supported with this connector");
+        HDprintf("\n");
+        return 0;
+    }
+
+    /* These were checked when the command line was parsed */
+    if (vol_bench_parse_size_list(vol_bench_params_g.chunk_dims, chunk_dims, &nchunk_dims) < 0 ||
+        vol_bench_parse_size_list(vol_bench_params_g.cache_nbytes, cache_nbytes, &ncache_nbytes) < 0 ||
+        vol_bench_parse_size_list(vol_bench_params_g.cache_nslots, cache_nslots, &ncache_nslots) < 0 ||
+        vol_bench_parse_double_list(vol_bench_params_g.cache_w0, cache_w0, &ncache_w0) < 0)
+        BENCH_ERROR;
+
+    if (0 == (geom.type_size = H5Tget_size(type_id)))
+        BENCH_ERROR;
+
+    /* Use the largest square dataset that fits in --size bytes */
+    nelems       = vol_bench_params_g.dataset_size / geom.type_size;
+    geom.dims[0] = (hsize_t)HDsqrt((double)nelems);
+    while (geom.dims[0] * geom.dims[0] > nelems)
+        geom.dims[0]--;
+    geom.dims[1] = geom.dims[0];
+
+    if (geom.dims[0] == 0) {
+        HDprintf("    dataset size of %llu bytes is smaller than a single element\n",
+                 (unsigned long long)vol_bench_params_g.dataset_size);
+        BENCH_ERROR;
+    }
+
+    if ((file_id = H5Fopen(vol_bench_filename, H5F_ACC_RDWR, H5P_DEFAULT)) < 0) {
+        HDprintf("    couldn't open file '%s'\n", vol_bench_filename);
+        BENCH_ERROR;
+    }
+
+    if ((group_id = H5Gcreate2(file_id, CHUNK_BENCH_GROUP_NAME, H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT)) < 0) {
+        HDprintf("    couldn't create container group '%s'\n", CHUNK_BENCH_GROUP_NAME);
+        BENCH_ERROR;
+    }
+
+    if ((fspace_id = H5Screate_simple(CHUNK_BENCH_DSET_SPACE_RANK, geom.dims, NULL)) < 0)
+        BENCH_ERROR;
+
+    /* Each configuration visits the same random chunks from run to run */
+    vol_test_random_begin(VOL_TEST_TIMER_INTERFACE, "chunk");
+
+    for (size_t i = 0; i < nchunk_dims; i++) {
+        char dset_name[CHUNK_BENCH_DSET_NAME_LENGTH];
+
+        /* Chunks may not be larger than the dataset's dimensions */
+        for (int j = 0; j < CHUNK_BENCH_DSET_SPACE_RANK; j++) {
+            geom.chunk_dims[j] = MIN(chunk_dims[i], geom.dims[j]);
+            geom.nchunks[j]    = (geom.dims[j] + geom.chunk_dims[j] - 1) / geom.chunk_dims[j];
+        }
+
+        HDsnprintf(dset_name, sizeof(dset_name), "chunk_%llu", (unsigned long long)geom.chunk_dims[0]);
+
+        if ((dcpl_id = H5Pcreate(H5P_DATASET_CREATE)) < 0)
+            BENCH_ERROR;
+
+        if (H5Pset_chunk(dcpl_id, CHUNK_BENCH_DSET_SPACE_RANK, geom.chunk_dims) < 0) {
+            HDprintf("    couldn't set chunking on DCPL\n");
+            BENCH_ERROR;
+        }
+
+        H5E_BEGIN_TRY
+        {
+            dset_id = H5Dopen2(group_id, dset_name, H5P_DEFAULT);
+        }
+        H5E_END_TRY;
+
+        /* The same chunk shape may result from more than one value in the list */
+        if (dset_id < 0 && (dset_id = H5Dcreate2(group_id, dset_name, type_id, fspace_id, H5P_DEFAULT,
+                                                 dcpl_id, H5P_DEFAULT)) < 0) {
+            HDprintf("    couldn't create dataset '%s'\n", dset_name);
+            BENCH_ERROR;
+        }
+
+        if (H5Dclose(dset_id) < 0)
+            BENCH_ERROR;
+        dset_id = H5I_INVALID_HID;
+
+        if (H5Pclose(dcpl_id) < 0)
+            BENCH_ERROR;
+        dcpl_id = H5I_INVALID_HID;
+
+        for (size_t j = 0; j < ncache_nbytes; j++)
+            for (size_t k = 0; k < ncache_nslots; k++)
+                for (size_t l = 0; l < ncache_w0; l++) {
+                    chunk_bench_cache_t cache;
+
+                    cache.nbytes = (size_t)cache_nbytes[j];
+                    cache.nslots = (size_t)cache_nslots[k];
+                    cache.w0     = cache_w0[l];
+
+                    nerrors += chunk_bench_cache_config(group_id, dset_name, type_id, &geom, &cache);
+                }
+    }
+
+    if (H5Sclose(fspace_id) < 0)
+        BENCH_ERROR;
+    if (H5Gclose(group_id) < 0)
+        BENCH_ERROR;
+    if (H5Fclose(file_id) < 0)
+        BENCH_ERROR;
+
+    HDprintf("\n");
+
+    return nerrors;
+
+error:
+    H5E_BEGIN_TRY
+    {
+        H5Sclose(fspace_id);
+        H5Pclose(dcpl_id);
+        H5Dclose(dset_id);
+        H5Gclose(group_id);
+        H5Fclose(file_id);
+    }
+    H5E_END_TRY;
+
+    HDprintf("\n");
+
+    return nerrors + 1;
+}
@@ -0,0 +1,440 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * Copyright by The HDF Group.                                               *
+ * All rights reserved.                                                      *
+ *                                                                           *
+ * This file is part of HDF5.  The full HDF5 copyright notice, including     *
+ * terms governing use, modification, and redistribution, is contained in    *
+ * the COPYING file, which can be found at the root of the source code       *
+ * distribution tree, or in https://support.hdfgroup.org/ftp/HDF5/releases.  *
+ * If you do not have access to either file, you may request a copy from     *
+ * help@hdfgroup.org.                                                        *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+/*
+ * Benchmarks for partial I/O on wide compound datatypes. For each field
+ * count given with --compound-fields, a compound type is built with that
+ * many fields of mixed sizes, laid out with the padding a C compiler
+ * would add to align them, and a dataset of about --size bytes of it is
+ * written. The dataset is then read whole and, for each count given with
+ * --compound-reads, through a compound type holding only that many
+ * of the fields, spread across the struct.
+ *
+ * Each partial read reports its speedup over reading the whole struct.
+ * A connector which picks out the fields where the data is stored should
+ * speed up roughly in proportion to the fraction of each record read,
+ * while one which brings whole records into memory first won't.
+ */
+
+#include "vol_compound_bench.h"
+
+/* The types of the fields, in turn, chosen to leave gaps between them when aligned */
+#define COMPOUND_BENCH_NFIELD_TYPES 6
+
+/* A wide compound type and the dataset written with it */
+typedef struct compound_bench_dset_t {
+    unsigned nfields;
+    hid_t    type_id;
+    size_t   type_size;
+    hsize_t  nelems;
+    hid_t    dset_id;
+    void    *wbuf;
+    void    *rbuf;
+} compound_bench_dset_t;
+
+/*
+ * Returns the native type of the given field, cycling through
+ * fields of different sizes.
+ */
+static hid_t
+compound_bench_field_type(unsigned field_idx)
+{
+    switch (field_idx % COMPOUND_BENCH_NFIELD_TYPES) {
+        case 0:
+            return H5T_NATIVE_DOUBLE;
+        case 1:
+            return H5T_NATIVE_CHAR;
+        case 2:
+            return H5T_NATIVE_INT;
+        case 3:
+            return H5T_NATIVE_SHORT;
+        case 4:
+            return H5T_NATIVE_LLONG;
+        case 5:
+        default:
+            return H5T_NATIVE_FLOAT;
+    }
+}
+
+/*
+ * Creates a compound type with the given fields of the full struct,
+ * either aligned as a C compiler would or packed.
+ */
+static hid_t
+compound_bench_type(const unsigned *fields, unsigned nfields, hbool_t aligned)
+{
+    size_t offset = 0;
+    size_t align  = 1;
+    hid_t  type_id;
+
+    /* Lay the fields out first, as the size of a compound type can't be less than its fields' extent */
+    for (unsigned i = 0; i < nfields; i++) {
+        size_t size = H5Tget_size(compound_bench_field_type(fields[i]));
+
+        if (aligned) {
+            offset = (offset + size - 1) / size * size;
+            align  = MAX(align, size);
+        }
+        offset += size;
+    }
+    offset = (offset + align - 1) / align * align;
+
+    if ((type_id = H5Tcreate(H5T_COMPOUND, offset)) < 0)
+        return H5I_INVALID_HID;
+
+    offset = 0;
+    for (unsigned i = 0; i < nfields; i++) {
+        hid_t  field_type_id = compound_bench_field_type(fields[i]);
+        size_t size          = H5Tget_size(field_type_id);
+        char   field_name[COMPOUND_BENCH_FIELD_NAME_LENGTH];
+
+        if (aligned)
+            offset = (offset + size - 1) / size * size;
+
+        HDsnprintf(field_name, sizeof(field_name), "field%u", fields[i]);
+        if (H5Tinsert(type_id, field_name, offset, field_type_id) < 0) {
+            H5Tclose(type_id);
+            return H5I_INVALID_HID;
+        }
+
+        offset += size;
+    }
+
+    return type_id;
+}
+
+static void
+compound_bench_dset_free(compound_bench_dset_t *dset)
+{
+    H5E_BEGIN_TRY
+    {
+        H5Dclose(dset->dset_id);
+        H5Tclose(dset->type_id);
+    }
+    H5E_END_TRY;
+
+    HDfree(dset->wbuf);
+    HDfree(dset->rbuf);
+
+    HDmemset(dset, 0, sizeof(*dset));
+    dset->type_id = H5I_INVALID_HID;
+    dset->dset_id = H5I_INVALID_HID;
+}
+
+/*
+ * Creates a compound type with the given number of fields and a
+ * dataset of it, and writes the dataset, reporting the time taken.
+ */
+static herr_t
+compound_bench_dset_create(compound_bench_dset_t *dset, hid_t group_id, size_t list_idx, unsigned nfields)
+{
+    vol_bench_stats_t stats;
+    unsigned         *fields   = NULL;
+    hid_t             space_id = H5I_INVALID_HID;
+    char              name[COMPOUND_BENCH_NAME_LENGTH];
+
+    HDmemset(dset, 0, sizeof(*dset));
+    dset->type_id = H5I_INVALID_HID;
+    dset->dset_id = H5I_INVALID_HID;
+    vol_bench_stats_init(&stats);
+
+    if (NULL == (fields = HDmalloc(nfields * sizeof(unsigned))))
+        BENCH_ERROR;
+    for (unsigned i = 0; i < nfields; i++)
+        fields[i] = i;
+
+    dset->nfields = nfields;
+    if ((dset->type_id = compound_bench_type(fields, nfields, TRUE)) < 0)
+        BENCH_ERROR;
+    if (0 == (dset->type_size = H5Tget_size(dset->type_id)))
+        BENCH_ERROR;
+
+    dset->nelems = MAX(1, vol_bench_params_g.dataset_size / dset->type_size);
+
+    if (NULL == (dset->wbuf = HDmalloc((size_t)dset->nelems * dset->type_size)))
+        BENCH_ERROR;
+    if (NULL == (dset->rbuf = HDmalloc((size_t)dset->nelems * dset->type_size)))
+        BENCH_ERROR;
+    vol_bench_fill_buffer(dset->wbuf, (size_t)dset->nelems * dset->type_size, 0);
+
+    if ((space_id = H5Screate_simple(1, &dset->nelems, NULL)) < 0)
+        BENCH_ERROR;
+
+    /* Named after the index of the field count, as the same count may be given more than once */
+    HDsnprintf(name, sizeof(name), "compound_%zu", list_idx);
+    if ((dset->dset_id = H5Dcreate2(group_id, name, dset->type_id, space_id, H5P_DEFAULT, H5P_DEFAULT,
+                                    H5P_DEFAULT)) < 0) {
+        HDprintf("    couldn't create dataset '%s'\n", name);
+        BENCH_ERROR;
+    }
+
+    for (unsigned i = 0; i < vol_bench_params_g.iterations; i++) {
+        double t0 = vol_bench_now();
+
+        if (H5Dwrite(dset->dset_id, dset->type_id, H5S_ALL, H5S_ALL, H5P_DEFAULT, dset->wbuf) < 0) {
+            HDprintf("    couldn't write to dataset '%s'\n", name);
+            BENCH_ERROR;
+        }
+
+        if (vol_bench_stats_add(&stats, vol_bench_now() - t0) < 0)
+            BENCH_ERROR;
+    }
+
+    HDsnprintf(name, sizeof(name), "write %u fields", nfields);
+    vol_bench_report("compound", name, dset->nelems * dset->type_size * vol_bench_params_g.iterations,
+                     &stats);
+
+    if (H5Sclose(space_id) < 0)
+        BENCH_ERROR;
+
+    vol_bench_stats_free(&stats);
+    HDfree(fields);
+
+    return SUCCEED;
+
+error:
+    H5E_BEGIN_TRY
+    {
+        H5Sclose(space_id);
+    }
+    H5E_END_TRY;
+
+    vol_bench_stats_free(&stats);
+    HDfree(fields);
+    compound_bench_dset_free(dset);
+
+    return FAIL;
+}
+
+/*
+ * Reads the given fields of the dataset into a packed buffer, or
+ * the whole struct if all of them are given, adding the time taken
+ * by each iteration to the given stats.
+ */
+static int
+compound_bench_read(compound_bench_dset_t *dset, const unsigned *fields, unsigned nfields,
+                    vol_bench_stats_t *stats)
+{
+    hid_t  mem_type_id = H5I_INVALID_HID;
+    size_t mem_type_size;
+
+    if (nfields < dset->nfields) {
+        if ((mem_type_id = compound_bench_type(fields, nfields, FALSE)) < 0)
+            BENCH_ERROR;
+    }
+    else if ((mem_type_id = H5Tcopy(dset->type_id)) < 0)
+        BENCH_ERROR;
+    if (0 == (mem_type_size = H5Tget_size(mem_type_id)))
+        BENCH_ERROR;
+
+    for (unsigned i = 0; i < vol_bench_params_g.iterations; i++) {
+        double t0;
+
+        HDmemset(dset->rbuf, 0, (size_t)dset->nelems * mem_type_size);
+
+        t0 = vol_bench_now();
+
+        if (H5Dread(dset->dset_id, mem_type_id, H5S_ALL, H5S_ALL, H5P_DEFAULT, dset->rbuf) < 0) {
+            HDprintf("    couldn't read %u fields from dataset\n", nfields);
+            BENCH_ERROR;
+        }
+
+        if (vol_bench_stats_add(stats, vol_bench_now() - t0) < 0)
+            BENCH_ERROR;
+
+        /* Each field read should match the same field of the whole struct written */
+        if (vol_bench_params_g.verify) {
+            hsize_t nmismatch = 0;
+
+            for (unsigned f = 0; f < nfields; f++) {
+                size_t mem_offset  = H5Tget_member_offset(mem_type_id, f);
+                size_t file_offset = H5Tget_member_offset(dset->type_id, fields[f]);
+                size_t size        = H5Tget_size(compound_bench_field_type(fields[f]));
+
+                for (size_t j = 0; j < (size_t)dset->nelems; j++)
+                    if (HDmemcmp((unsigned char *)dset->rbuf + j * mem_type_size + mem_offset,
+                                 (unsigned char *)dset->wbuf + j * dset->type_size + file_offset, size))
+                        nmismatch += size;
+            }
+
+            if (nmismatch > 0) {
+                HDprintf("    %llu bytes of %u fields read from dataset didn't match what was written\n",
+                         (unsigned long long)nmismatch, nfields);
+                BENCH_ERROR;
+            }
+        }
+    }
+
+    if (H5Tclose(mem_type_id) < 0)
+        BENCH_ERROR;
+
+    return 0;
+
+error:
+    H5E_BEGIN_TRY
+    {
+        H5Tclose(mem_type_id);
+    }
+    H5E_END_TRY;
+
+    return 1;
+}
+
+/*
+ * Reads the whole struct, then each number of fields given, and
+ * reports the speedup of each partial read over the full read.
+ */
+static int
+compound_bench_io(compound_bench_dset_t *dset, const hsize_t *read_counts, size_t nread_counts)
+{
+    vol_bench_stats_t full_stats;
+    vol_bench_stats_t stats;
+    unsigned         *fields  = NULL;
+    int               nerrors = 0;
+    char              name[COMPOUND_BENCH_NAME_LENGTH];
+
+    vol_bench_stats_init(&full_stats);
+    vol_bench_stats_init(&stats);
+
+    if (NULL == (fields = HDmalloc(dset->nfields * sizeof(unsigned))))
+        BENCH_ERROR;
+    for (unsigned f = 0; f < dset->nfields; f++)
+        fields[f] = f;
+
+    if (compound_bench_read(dset, fields, dset->nfields, &full_stats) > 0)
+        BENCH_ERROR;
+
+    HDsnprintf(name, sizeof(name), "read %u of %u fields", dset->nfields, dset->nfields);
+    vol_bench_report("compound", name, dset->nelems * dset->type_size * vol_bench_params_g.iterations,
+                     &full_stats);
+
+    for (size_t i = 0; i < nread_counts; i++) {
+        unsigned nfields = (unsigned)read_counts[i];
+        hsize_t  nbytes  = 0;
+
+        if (nfields >= dset->nfields)
+            continue;
+
+        /* Spread the fields read evenly over the struct */
+        for (unsigned f = 0; f < nfields; f++) {
+            fields[f] = (unsigned)(((size_t)f * dset->nfields + dset->nfields / 2) / nfields);
+            nbytes += H5Tget_size(compound_bench_field_type(fields[f]));
+        }
+
+        if (compound_bench_read(dset, fields, nfields, &stats) > 0) {
+            nerrors++;
+            vol_bench_stats_free(&stats);
+            continue;
+        }
+
+        HDsnprintf(name, sizeof(name), "read %u of %u fields", nfields, dset->nfields);
+        vol_bench_report_metric("compound", name, nbytes * dset->nelems * vol_bench_params_g.iterations,
+                                &stats, "speedup", stats.total > 0.0 ? full_stats.total / stats.total : 0.0);
+
+        vol_bench_stats_free(&stats);
+    }
+
+    vol_bench_stats_free(&full_stats);
+    HDfree(fields);
+
+    return nerrors;
+
+error:
+    vol_bench_stats_free(&full_stats);
+    vol_bench_stats_free(&stats);
+    HDfree(fields);
+
+    return nerrors + 1;
+}
+
+int
+vol_compound_bench(void)
+{
+    compound_bench_dset_t dset;
+    hsize_t               field_counts[VOL_BENCH_MAX_LIST_VALUES];
+    hsize_t               read_counts[VOL_BENCH_MAX_LIST_VALUES];
+    size_t                nfield_counts;
+    size_t                nread_counts;
+    int                   nerrors  = 0;
+    hid_t                 file_id  = H5I_INVALID_HID;
+    hid_t                 group_id = H5I_INVALID_HID;
+
+    HDmemset(&dset, 0, sizeof(dset));
+    dset.type_id = H5I_INVALID_HID;
+    dset.dset_id = H5I_INVALID_HID;
+
+    HDprintf("**********************************************\n");
+    HDprintf("*                                            *\n");
+    HDprintf("*     VOL Compound Partial I/O Benchmarks    *\n");
+    HDprintf("*                                            *\n");
+    HDprintf("**********************************************\n\n");
+
+    /* Make sure the connector supports the API functions being benchmarked */
+    if (!(vol_cap_flags_g & H5VL_CAP_FLAG_FILE_BASIC) || !(vol_cap_flags_g & H5VL_CAP_FLAG_GROUP_BASIC) ||
+        !(vol_cap_flags_g & H5VL_CAP_FLAG_DATASET_BASIC)) {
+        BENCH_SKIPPED("compound partial I/O",
+                      "API functions for basic file, group, or dataset aren't supported with this connector");
+        HDprintf("\n");
+        return 0;
+    }
+
+    /* These were checked when the command line was parsed */
+    if (vol_bench_parse_size_list(vol_bench_params_g.compound_fields, field_counts, &nfield_counts) < 0)
+        BENCH_ERROR;
+    if (vol_bench_parse_size_list(vol_bench_params_g.compound_reads, read_counts, &nread_counts) < 0)
+        BENCH_ERROR;
+
+    if ((file_id = H5Fopen(vol_bench_filename, H5F_ACC_RDWR, H5P_DEFAULT)) < 0) {
+        HDprintf("    couldn't open file '%s'\n", vol_bench_filename);
+        BENCH_ERROR;
+    }
+
+    if ((group_id = H5Gcreate2(file_id, COMPOUND_BENCH_GROUP_NAME, H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT)) <
+        0) {
+        HDprintf("    couldn't create container group '%s'\n", COMPOUND_BENCH_GROUP_NAME);
+        BENCH_ERROR;
+    }
+
+    for (size_t i = 0; i < nfield_counts; i++) {
+        if (compound_bench_dset_create(&dset, group_id, i, (unsigned)field_counts[i]) < 0) {
+            nerrors++;
+            continue;
+        }
+
+        nerrors += compound_bench_io(&dset, read_counts, nread_counts);
+
+        compound_bench_dset_free(&dset);
+    }
+
+    if (H5Gclose(group_id) < 0)
+        BENCH_ERROR;
+    if (H5Fclose(file_id) < 0)
+        BENCH_ERROR;
+
+    HDprintf("\n");
+
+    return nerrors;
+
+error:
+    compound_bench_dset_free(&dset);
+
+    H5E_BEGIN_TRY
+    {
+        H5Gclose(group_id);
+        H5Fclose(file_id);
+    }
+    H5E_END_TRY;
+
+    HDprintf("\n");
+
+    return nerrors + 1;
+}
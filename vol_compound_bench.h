@@ -0,0 +1,31 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * Copyright by The HDF Group.                                               *
+ * All rights reserved.                                                      *
+ *                                                                           *
+ * This file is part of HDF5.  The full HDF5 copyright notice, including     *
+ * terms governing use, modification, and redistribution, is contained in    *
+ * the COPYING file, which can be found at the root of the source code       *
+ * distribution tree, or in https://support.hdfgroup.org/ftp/HDF5/releases.  *
+ * If you do not have access to either file, you may request a copy from     *
+ * help@hdfgroup.org.                                                        *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#ifndef VOL_COMPOUND_BENCH_H
+#define VOL_COMPOUND_BENCH_H
+
+#include "vol_bench.h"
+
+int vol_compound_bench(void);
+
+/**************************************************************
+ *                                                            *
+ *      VOL connector compound partial I/O benchmark defines  *
+ *                                                            *
+ **************************************************************/
+
+#define COMPOUND_BENCH_GROUP_NAME "compound_bench"
+
+#define COMPOUND_BENCH_FIELD_NAME_LENGTH 32
+#define COMPOUND_BENCH_NAME_LENGTH       128
+
+#endif
@@ -0,0 +1,483 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * Copyright by The HDF Group.                                               *
+ * All rights reserved.                                                      *
+ *                                                                           *
+ * This file is part of HDF5.  The full HDF5 copyright notice, including     *
+ * terms governing use, modification, and redistribution, is contained in    *
+ * the COPYING file, which can be found at the root of the source code       *
+ * distribution tree, or in https://support.hdfgroup.org/ftp/HDF5/releases.  *
+ * If you do not have access to either file, you may request a copy from     *
+ * help@hdfgroup.org.                                                        *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+/*
+ * Benchmarks for concurrent access to the VOL connector from several
+ * threads, which require a thread-safe build of HDF5. For each thread
+ * count given with --threads, that many threads each make
+ * --contention-ops calls, cycling through a write and a read of a
+ * dataset of --xfer-size bytes, the creation and opening of a dataset,
+ * and the creation and reading of an attribute. This is done with each
+ * thread working in a group of its own in one shared file, and again
+ * with each thread working in a file of its own.
+ *
+ * Each result reports the rate of operations of all threads together,
+ * so that how it scales with the number of threads shows how much of
+ * the work the library and connector let run at once. A thread-safe
+ * build of HDF5 runs API calls one at a time behind a global lock, so
+ * the time an operation takes beyond its latency on a single thread is
+ * mostly spent waiting for that lock. Each result's lock_wait is that
+ * excess as a fraction of all of the time spent in HDF5 calls, from 0
+ * (no waiting) towards 1. A single thread is always run first to measure
+ * the baseline latency.
+ */
+
+#include "vol_contention_bench.h"
+
+#ifdef H5_HAVE_THREADSAFE
+
+/* The operations made by each thread, in turn */
+typedef enum contention_bench_op_t {
+    CONTENTION_BENCH_WRITE,
+    CONTENTION_BENCH_READ,
+    CONTENTION_BENCH_CREATE_DSET,
+    CONTENTION_BENCH_OPEN_DSET,
+    CONTENTION_BENCH_CREATE_ATTR,
+    CONTENTION_BENCH_READ_ATTR,
+    CONTENTION_BENCH_NOPS
+} contention_bench_op_t;
+
+static const char *const contention_bench_op_str[] = {"dataset write", "dataset read",     "dataset create",
+                                                      "dataset open",  "attribute create", "attribute read"};
+
+/* The settings shared by all of the threads */
+typedef struct contention_bench_ctx_t {
+    hid_t    type_id;
+    size_t   type_size;
+    hsize_t  nelems; /* Number of elements in each thread's dataset */
+    unsigned nops;   /* Number of operations made by each thread */
+    unsigned nruns;
+} contention_bench_ctx_t;
+
+/* The objects that a single thread operates on */
+typedef struct contention_bench_thread_t {
+    const contention_bench_ctx_t *ctx;
+    H5TS_thread_t                 thread;
+    hid_t                         file_id; /* The thread's own file, if any */
+    hid_t                         group_id;
+    hid_t                         dset_id;
+    void                         *wbuf;
+    void                         *rbuf;
+    vol_bench_stats_t             stats;
+    hbool_t                       err_occurred;
+} contention_bench_thread_t;
+
+static void *
+contention_bench_thread(void *udata)
+{
+    contention_bench_thread_t    *thread   = (contention_bench_thread_t *)udata;
+    const contention_bench_ctx_t *ctx      = thread->ctx;
+    size_t                        nbytes   = (size_t)ctx->nelems * ctx->type_size;
+    hid_t                         space_id = H5I_INVALID_HID;
+    hid_t                         obj_id   = H5I_INVALID_HID;
+    int                           value    = 0;
+    char                          name[CONTENTION_BENCH_NAME_LENGTH];
+
+    if ((space_id = H5Screate(H5S_SCALAR)) < 0)
+        BENCH_ERROR;
+
+    for (unsigned i = 0; i < ctx->nops; i++) {
+        contention_bench_op_t op = (contention_bench_op_t)(i % CONTENTION_BENCH_NOPS);
+        herr_t                err;
+        double                t0;
+
+        HDsnprintf(name, sizeof(name), "obj%u", i);
+
+        t0 = vol_bench_now();
+
+        switch (op) {
+            case CONTENTION_BENCH_WRITE:
+                err = H5Dwrite(thread->dset_id, ctx->type_id, H5S_ALL, H5S_ALL, H5P_DEFAULT, thread->wbuf);
+                break;
+            case CONTENTION_BENCH_READ:
+                err = H5Dread(thread->dset_id, ctx->type_id, H5S_ALL, H5S_ALL, H5P_DEFAULT, thread->rbuf);
+                break;
+            case CONTENTION_BENCH_CREATE_DSET:
+                if ((obj_id = H5Dcreate2(thread->group_id, name, H5T_NATIVE_INT, space_id, H5P_DEFAULT,
+                                         H5P_DEFAULT, H5P_DEFAULT)) < 0)
+                    err = FAIL;
+                else
+                    err = H5Dclose(obj_id);
+                break;
+            case CONTENTION_BENCH_OPEN_DSET:
+                if ((obj_id = H5Dopen2(thread->group_id, CONTENTION_BENCH_DSET_NAME, H5P_DEFAULT)) < 0)
+                    err = FAIL;
+                else
+                    err = H5Dclose(obj_id);
+                break;
+            case CONTENTION_BENCH_CREATE_ATTR:
+                if ((obj_id = H5Acreate2(thread->group_id, name, H5T_NATIVE_INT, space_id, H5P_DEFAULT,
+                                         H5P_DEFAULT)) < 0)
+                    err = FAIL;
+                else if ((err = H5Awrite(obj_id, H5T_NATIVE_INT, &value)) >= 0)
+                    err = H5Aclose(obj_id);
+                break;
+            case CONTENTION_BENCH_READ_ATTR:
+                if ((obj_id = H5Aopen(thread->group_id, CONTENTION_BENCH_ATTR_NAME, H5P_DEFAULT)) < 0)
+                    err = FAIL;
+                else if ((err = H5Aread(obj_id, H5T_NATIVE_INT, &value)) >= 0)
+                    err = H5Aclose(obj_id);
+                break;
+            case CONTENTION_BENCH_NOPS:
+            default:
+                err = FAIL;
+                break;
+        }
+
+        if (err < 0) {
+            HDprintf("    %s failed\n", contention_bench_op_str[op]);
+            BENCH_ERROR;
+        }
+        obj_id = H5I_INVALID_HID;
+
+        if (vol_bench_stats_add(&thread->stats, vol_bench_now() - t0) < 0)
+            BENCH_ERROR;
+
+        if (op == CONTENTION_BENCH_READ && vol_bench_params_g.verify) {
+            hsize_t nmismatch;
+
+            if ((nmismatch = vol_bench_check_buffer(thread->rbuf, nbytes, 0)) > 0) {
+                HDprintf("    %llu bytes read from dataset didn't match what was written\n",
+                         (unsigned long long)nmismatch);
+                BENCH_ERROR;
+            }
+        }
+    }
+
+    if (H5Sclose(space_id) < 0)
+        BENCH_ERROR;
+
+    return NULL;
+
+error:
+    H5E_BEGIN_TRY
+    {
+        H5Dclose(obj_id);
+        H5Aclose(obj_id);
+        H5Sclose(space_id);
+    }
+    H5E_END_TRY;
+
+    /* The library doesn't release the error stack of a thread when it exits */
+    H5Eclear2(H5E_DEFAULT);
+
+    thread->err_occurred = TRUE;
+
+    return NULL;
+}
+
+/*
+ * Starts the given thread. H5TS_create_thread() ignores the result of
+ * pthread_create(), so threads are started with it directly wherever
+ * HDF5 uses pthreads.
+ */
+static herr_t
+contention_bench_start_thread(contention_bench_thread_t *thread)
+{
+#ifdef H5_HAVE_WIN_THREADS
+    thread->thread = H5TS_create_thread(contention_bench_thread, NULL, thread);
+
+    return (thread->thread != NULL) ? SUCCEED : FAIL;
+#else
+    return (0 == pthread_create(&thread->thread, NULL, contention_bench_thread, thread)) ? SUCCEED : FAIL;
+#endif
+}
+
+/*
+ * Runs the operations on the given number of threads, each in a group
+ * of its own either in the group of the shared file given or, if it is
+ * H5I_INVALID_HID, in a file of its own. Adds the latency of every
+ * operation to the given stats and returns the wall clock time taken
+ * by all of the threads, in seconds, or a negative value on failure.
+ */
+static double
+contention_bench_run(contention_bench_ctx_t *ctx, hid_t shared_group_id, int nthreads,
+                     vol_bench_stats_t *stats)
+{
+    contention_bench_thread_t *threads   = NULL;
+    size_t                     nbytes    = (size_t)ctx->nelems * ctx->type_size;
+    hid_t                      fspace_id = H5I_INVALID_HID;
+    hid_t                      aspace_id = H5I_INVALID_HID;
+    hid_t                      attr_id   = H5I_INVALID_HID;
+    double                     seconds   = -1.0;
+    double                     start;
+    int                        nstarted = 0;
+    int                        value    = 0;
+    char                       name[CONTENTION_BENCH_NAME_LENGTH];
+
+    if (NULL == (threads = HDcalloc((size_t)nthreads, sizeof(*threads))))
+        BENCH_ERROR;
+    for (int t = 0; t < nthreads; t++) {
+        threads[t].ctx      = ctx;
+        threads[t].file_id  = H5I_INVALID_HID;
+        threads[t].group_id = H5I_INVALID_HID;
+        threads[t].dset_id  = H5I_INVALID_HID;
+        vol_bench_stats_init(&threads[t].stats);
+    }
+
+    if ((fspace_id = H5Screate_simple(1, &ctx->nelems, NULL)) < 0)
+        BENCH_ERROR;
+    if ((aspace_id = H5Screate(H5S_SCALAR)) < 0)
+        BENCH_ERROR;
+
+    /* Set up the objects of each thread before any of them start */
+    ctx->nruns++;
+    for (int t = 0; t < nthreads; t++) {
+        contention_bench_thread_t *thread = &threads[t];
+        hid_t                      parent_id;
+
+        if (shared_group_id >= 0)
+            parent_id = shared_group_id;
+        else {
+            HDsnprintf(name, sizeof(name), "%s" CONTENTION_BENCH_FILE_NAME, test_path_prefix, t);
+
+            if ((thread->file_id = H5Fcreate(name, H5F_ACC_TRUNC, H5P_DEFAULT, H5P_DEFAULT)) < 0) {
+                HDprintf("    couldn't create file '%s'\n", name);
+                BENCH_ERROR;
+            }
+
+            parent_id = thread->file_id;
+        }
+
+        HDsnprintf(name, sizeof(name), "run%u_thread%d", ctx->nruns, t);
+        if ((thread->group_id = H5Gcreate2(parent_id, name, H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT)) < 0) {
+            HDprintf("    couldn't create group '%s'\n", name);
+            BENCH_ERROR;
+        }
+
+        if ((thread->dset_id = H5Dcreate2(thread->group_id, CONTENTION_BENCH_DSET_NAME, ctx->type_id,
+                                          fspace_id, H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT)) < 0) {
+            HDprintf("    couldn't create dataset '%s'\n", CONTENTION_BENCH_DSET_NAME);
+            BENCH_ERROR;
+        }
+
+        if ((attr_id = H5Acreate2(thread->group_id, CONTENTION_BENCH_ATTR_NAME, H5T_NATIVE_INT, aspace_id,
+                                  H5P_DEFAULT, H5P_DEFAULT)) < 0) {
+            HDprintf("    couldn't create attribute '%s'\n", CONTENTION_BENCH_ATTR_NAME);
+            BENCH_ERROR;
+        }
+        if (H5Awrite(attr_id, H5T_NATIVE_INT, &value) < 0)
+            BENCH_ERROR;
+        if (H5Aclose(attr_id) < 0)
+            BENCH_ERROR;
+        attr_id = H5I_INVALID_HID;
+
+        if (NULL == (thread->wbuf = HDmalloc(nbytes)) || NULL == (thread->rbuf = HDmalloc(nbytes)))
+            BENCH_ERROR;
+        vol_bench_fill_buffer(thread->wbuf, nbytes, 0);
+    }
+
+    start = vol_bench_now();
+
+    for (; nstarted < nthreads; nstarted++)
+        if (contention_bench_start_thread(&threads[nstarted]) < 0) {
+            HDprintf("    couldn't start thread %d of %d\n", nstarted + 1, nthreads);
+            break;
+        }
+
+    /* Only the threads that started can be joined */
+    for (int t = 0; t < nstarted; t++)
+        H5TS_wait_for_thread(threads[t].thread);
+    if (nstarted < nthreads)
+        BENCH_ERROR;
+
+    seconds = vol_bench_now() - start;
+
+    for (int t = 0; t < nthreads; t++) {
+        if (threads[t].err_occurred)
+            seconds = -1.0;
+
+        for (size_t i = 0; i < threads[t].stats.nsamples; i++)
+            if (vol_bench_stats_add(stats, threads[t].stats.samples[i]) < 0)
+                seconds = -1.0;
+    }
+
+error:
+    H5E_BEGIN_TRY
+    {
+        H5Aclose(attr_id);
+        H5Sclose(aspace_id);
+        H5Sclose(fspace_id);
+    }
+    H5E_END_TRY;
+
+    if (threads) {
+        for (int t = 0; t < nthreads; t++) {
+            contention_bench_thread_t *thread = &threads[t];
+
+            H5E_BEGIN_TRY
+            {
+                H5Dclose(thread->dset_id);
+                H5Gclose(thread->group_id);
+                H5Fclose(thread->file_id);
+            }
+            H5E_END_TRY;
+
+            if (thread->file_id >= 0) {
+                HDsnprintf(name, sizeof(name), "%s" CONTENTION_BENCH_FILE_NAME, test_path_prefix, t);
+                H5Fdelete(name, H5P_DEFAULT);
+            }
+
+            HDfree(thread->wbuf);
+            HDfree(thread->rbuf);
+            vol_bench_stats_free(&thread->stats);
+        }
+
+        HDfree(threads);
+    }
+
+    return seconds;
+}
+
+/*
+ * Runs a single thread, then each of the thread counts given, in
+ * either the shared file or in a file for each thread.
+ */
+static int
+contention_bench_sweep(contention_bench_ctx_t *ctx, hid_t shared_group_id, const hsize_t *counts,
+                       size_t ncounts)
+{
+    vol_bench_stats_t stats;
+    const char       *mode         = (shared_group_id >= 0) ? "shared file" : "per-thread files";
+    double            base_latency = 0.0;
+    char              name[CONTENTION_BENCH_NAME_LENGTH];
+
+    vol_bench_stats_init(&stats);
+
+    for (size_t c = 0; c <= ncounts; c++) {
+        int    nthreads = (c == 0) ? 1 : (int)counts[c - 1];
+        double wall_seconds, busy_seconds, lock_wait;
+
+        /* The baseline has already run a single thread */
+        if (c > 0 && nthreads == 1)
+            continue;
+
+        if ((wall_seconds = contention_bench_run(ctx, shared_group_id, nthreads, &stats)) < 0.0)
+            BENCH_ERROR;
+
+        busy_seconds = stats.total;
+        if (c == 0)
+            base_latency = busy_seconds / (double)stats.nsamples;
+
+        lock_wait = 0.0;
+        if (busy_seconds > 0.0)
+            lock_wait = (busy_seconds - base_latency * (double)stats.nsamples) / busy_seconds;
+        lock_wait = MAX(0.0, MIN(1.0, lock_wait));
+
+        /* Report the rate of all threads together over the wall clock time */
+        stats.total = wall_seconds;
+
+        HDsnprintf(name, sizeof(name), "%s %d thread%s", mode, nthreads, (nthreads > 1) ? "s" : "");
+        vol_bench_report_metric("contention", name, 0, &stats, "lock_wait", lock_wait);
+
+        vol_bench_stats_free(&stats);
+    }
+
+    return 0;
+
+error:
+    vol_bench_stats_free(&stats);
+
+    return 1;
+}
+
+int
+vol_contention_bench(void)
+{
+    contention_bench_ctx_t ctx;
+    hsize_t                counts[VOL_BENCH_MAX_LIST_VALUES];
+    size_t                 ncounts;
+    int                    nerrors  = 0;
+    hid_t                  file_id  = H5I_INVALID_HID;
+    hid_t                  group_id = H5I_INVALID_HID;
+
+    HDmemset(&ctx, 0, sizeof(ctx));
+
+    HDprintf("**********************************************\n");
+    HDprintf("*                                            *\n");
+    HDprintf("*         VOL Contention Benchmarks          *\n");
+    HDprintf("*                                            *\n");
+    HDprintf("**********************************************\n\n");
+
+    /* Make sure the connector supports the API functions being benchmarked */
+    if (!(vol_cap_flags_g & H5VL_CAP_FLAG_FILE_BASIC) || !(vol_cap_flags_g & H5VL_CAP_FLAG_GROUP_BASIC) ||
+        !(vol_cap_flags_g & H5VL_CAP_FLAG_DATASET_BASIC) || !(vol_cap_flags_g & H5VL_CAP_FLAG_ATTR_BASIC)) {
+        BENCH_SKIPPED("concurrent access",
+                      "API functions for basic file, group, dataset, or attribute aren't supported with "
+                      "this connector");
+        HDprintf("\n");
+        return 0;
+    }
+
+    /* This was checked when the command line was parsed */
+    if (vol_bench_parse_size_list(vol_bench_params_g.thread_counts, counts, &ncounts) < 0)
+        BENCH_ERROR;
+
+    ctx.type_id = vol_bench_type();
+    if (0 == (ctx.type_size = H5Tget_size(ctx.type_id)))
+        BENCH_ERROR;
+    ctx.nelems = MAX(1, vol_bench_params_g.xfer_size / ctx.type_size);
+    ctx.nops   = vol_bench_params_g.contention_ops;
+
+    if ((file_id = H5Fopen(vol_bench_filename, H5F_ACC_RDWR, H5P_DEFAULT)) < 0) {
+        HDprintf("    couldn't open file '%s'\n", vol_bench_filename);
+        BENCH_ERROR;
+    }
+
+    if ((group_id = H5Gcreate2(file_id, CONTENTION_BENCH_GROUP_NAME, H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT)) <
+        0) {
+        HDprintf("    couldn't create container group '%s'\n", CONTENTION_BENCH_GROUP_NAME);
+        BENCH_ERROR;
+    }
+
+    nerrors += contention_bench_sweep(&ctx, group_id, counts, ncounts);
+    nerrors += contention_bench_sweep(&ctx, H5I_INVALID_HID, counts, ncounts);
+
+    if (H5Gclose(group_id) < 0)
+        BENCH_ERROR;
+    if (H5Fclose(file_id) < 0)
+        BENCH_ERROR;
+
+    HDprintf("\n");
+
+    return nerrors;
+
+error:
+    H5E_BEGIN_TRY
+    {
+        H5Gclose(group_id);
+        H5Fclose(file_id);
+    }
+    H5E_END_TRY;
+
+    HDprintf("\n");
+
+    return nerrors + 1;
+}
+
+#else /* H5_HAVE_THREADSAFE */
+
+int
+vol_contention_bench(void)
+{
+    HDprintf("**********************************************\n");
+    HDprintf("*                                            *\n");
+    HDprintf("*         VOL Contention Benchmarks          *\n");
+    HDprintf("*                                            *\n");
+    HDprintf("**********************************************\n\n");
+
+    HDprintf("SKIPPED due to HDF5 library not being thread-safe\n\n");
+
+    return 0;
+}
+
+#endif /* H5_HAVE_THREADSAFE */
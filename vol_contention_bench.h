@@ -0,0 +1,32 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * Copyright by The HDF Group.                                               *
+ * All rights reserved.                                                      *
+ *                                                                           *
+ * This file is part of HDF5.  The full HDF5 copyright notice, including     *
+ * terms governing use, modification, and redistribution, is contained in    *
+ * the COPYING file, which can be found at the root of the source code       *
+ * distribution tree, or in https://support.hdfgroup.org/ftp/HDF5/releases.  *
+ * If you do not have access to either file, you may request a copy from     *
+ * help@hdfgroup.org.                                                        *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#ifndef VOL_CONTENTION_BENCH_H
+#define VOL_CONTENTION_BENCH_H
+
+#include "vol_bench.h"
+
+int vol_contention_bench(void);
+
+/*****************************************************
+ *                                                   *
+ *      VOL connector contention benchmark defines   *
+ *                                                   *
+ *****************************************************/
+
+#define CONTENTION_BENCH_GROUP_NAME  "contention_bench"
+#define CONTENTION_BENCH_FILE_NAME   "contention_bench_%d.h5"
+#define CONTENTION_BENCH_DSET_NAME   "data"
+#define CONTENTION_BENCH_ATTR_NAME   "attr"
+#define CONTENTION_BENCH_NAME_LENGTH 128
+
+#endif
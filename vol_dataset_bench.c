@@ -0,0 +1,609 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * Copyright by The HDF Group.                                               *
+ * All rights reserved.                                                      *
+ *                                                                           *
+ * This file is part of HDF5.  The full HDF5 copyright notice, including     *
+ * terms governing use, modification, and redistribution, is contained in    *
+ * the COPYING file, which can be found at the root of the source code       *
+ * distribution tree, or in https://support.hdfgroup.org/ftp/HDF5/releases.  *
+ * If you do not have access to either file, you may request a copy from     *
+ * help@hdfgroup.org.                                                        *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#include "vol_dataset_bench.h"
+
+/*
+ * The dataset that the throughput benchmarks operate on. This is
+ * a one-dimensional dataset of --size bytes of the element type
+ * selected with --type, so that the raw data I/O paths exercised
+ * by the dataset tests can be measured at arbitrary scale.
+ */
+typedef struct dataset_bench_dset_t {
+    hid_t   dset_id;
+    hid_t   type_id;
+    size_t  type_size;
+    hsize_t nelems;
+} dataset_bench_dset_t;
+
+static int bench_write_dataset_all(dataset_bench_dset_t *dset);
+static int bench_write_dataset_hyperslab(dataset_bench_dset_t *dset);
+static int bench_write_dataset_points(dataset_bench_dset_t *dset);
+static int bench_read_dataset_all(dataset_bench_dset_t *dset);
+static int bench_read_dataset_hyperslab(dataset_bench_dset_t *dset);
+static int bench_read_dataset_points(dataset_bench_dset_t *dset);
+
+/*
+ * The write benchmarks must run first, as the read
+ * benchmarks verify the data they have written.
+ */
+static int (*dataset_benches[])(dataset_bench_dset_t *dset) = {
+    bench_write_dataset_all,   bench_write_dataset_hyperslab, bench_write_dataset_points,
+    bench_read_dataset_all,    bench_read_dataset_hyperslab,  bench_read_dataset_points,
+};
+
+/*
+ * Fills or checks the pattern for a set of individually-selected
+ * elements, one element at a time, so that point selections can
+ * be verified against data written with any other selection.
+ */
+static void
+dataset_bench_fill_points(void *buf, size_t type_size, const hsize_t *coords, size_t npoints)
+{
+    for (size_t i = 0; i < npoints; i++)
+        vol_bench_fill_buffer((unsigned char *)buf + (i * type_size), type_size, coords[i] * type_size);
+}
+
+static hsize_t
+dataset_bench_check_points(const void *buf, size_t type_size, const hsize_t *coords, size_t npoints)
+{
+    hsize_t nmismatch = 0;
+
+    for (size_t i = 0; i < npoints; i++)
+        nmismatch += vol_bench_check_buffer((const unsigned char *)buf + (i * type_size), type_size,
+                                            coords[i] * type_size);
+
+    return nmismatch;
+}
+
+/*
+ * Returns the number of elements transferred by each hyperslab
+ * I/O operation, based on the --xfer-size option.
+ */
+static hsize_t
+dataset_bench_xfer_elems(dataset_bench_dset_t *dset)
+{
+    hsize_t xfer_elems = vol_bench_params_g.xfer_size / dset->type_size;
+
+    if (xfer_elems == 0)
+        xfer_elems = 1;
+    if (xfer_elems > dset->nelems)
+        xfer_elems = dset->nelems;
+
+    return xfer_elems;
+}
+
+/*
+ * Sets up the point selection used for the given iteration of a
+ * point selection benchmark. Points are spread evenly across the
+ * dataset and shifted on each iteration so that repeated reads
+ * or writes don't always touch the same elements.
+ */
+static herr_t
+dataset_bench_select_points(dataset_bench_dset_t *dset, hid_t fspace_id, hsize_t *coords, size_t npoints,
+                            unsigned iteration)
+{
+    hsize_t stride = dset->nelems / npoints;
+
+    for (size_t i = 0; i < npoints; i++)
+        coords[i] = ((hsize_t)i * stride) + (iteration % stride);
+
+    return H5Sselect_elements(fspace_id, H5S_SELECT_SET, npoints, coords);
+}
+
+/*
+ * Benchmarks writing the entire dataset with H5S_ALL.
+ */
+static int
+bench_write_dataset_all(dataset_bench_dset_t *dset)
+{
+    vol_bench_stats_t stats;
+    size_t            buf_size = (size_t)(dset->nelems * dset->type_size);
+    void             *buf      = NULL;
+
+    vol_bench_stats_init(&stats);
+
+    if ((hsize_t)buf_size != dset->nelems * dset->type_size || NULL == (buf = HDmalloc(buf_size))) {
+        BENCH_SKIPPED("write (H5S_ALL)", "couldn't allocate a buffer for the entire dataset");
+        return 0;
+    }
+
+    vol_bench_fill_buffer(buf, buf_size, 0);
+
+    for (unsigned i = 0; i < vol_bench_params_g.iterations; i++) {
+        double start = vol_bench_now();
+
+        if (H5Dwrite(dset->dset_id, dset->type_id, H5S_ALL, H5S_ALL, H5P_DEFAULT, buf) < 0) {
+            HDprintf("    couldn't write to dataset '%s'\n", DATASET_BENCH_THROUGHPUT_DSET_NAME);
+            BENCH_ERROR;
+        }
+
+        if (vol_bench_stats_add(&stats, vol_bench_now() - start) < 0)
+            BENCH_ERROR;
+    }
+
+    vol_bench_report("dataset", "write (H5S_ALL)", (hsize_t)buf_size * stats.nsamples, &stats);
+
+    HDfree(buf);
+    vol_bench_stats_free(&stats);
+
+    return 0;
+
+error:
+    HDfree(buf);
+    vol_bench_stats_free(&stats);
+
+    return 1;
+}
+
+/*
+ * Benchmarks writing the dataset in contiguous blocks of
+ * --xfer-size bytes, using a hyperslab selection for each.
+ */
+static int
+bench_write_dataset_hyperslab(dataset_bench_dset_t *dset)
+{
+    vol_bench_stats_t stats;
+    hsize_t           xfer_elems = dataset_bench_xfer_elems(dset);
+    hsize_t           nbytes     = 0;
+    hid_t             mspace_id  = H5I_INVALID_HID;
+    hid_t             fspace_id  = H5I_INVALID_HID;
+    void             *buf        = NULL;
+
+    vol_bench_stats_init(&stats);
+
+    if ((mspace_id = H5Screate_simple(1, &xfer_elems, NULL)) < 0)
+        BENCH_ERROR;
+    if ((fspace_id = H5Dget_space(dset->dset_id)) < 0)
+        BENCH_ERROR;
+
+    if (NULL == (buf = HDmalloc((size_t)(xfer_elems * dset->type_size))))
+        BENCH_ERROR;
+
+    for (unsigned i = 0; i < vol_bench_params_g.iterations; i++) {
+        for (hsize_t offset = 0; offset < dset->nelems; offset += xfer_elems) {
+            hsize_t count = MIN(xfer_elems, dset->nelems - offset);
+            hsize_t zero  = 0;
+            double  start;
+
+            if (H5Sselect_hyperslab(fspace_id, H5S_SELECT_SET, &offset, NULL, &count, NULL) < 0)
+                BENCH_ERROR;
+            if (H5Sselect_hyperslab(mspace_id, H5S_SELECT_SET, &zero, NULL, &count, NULL) < 0)
+                BENCH_ERROR;
+
+            vol_bench_fill_buffer(buf, (size_t)(count * dset->type_size), offset * dset->type_size);
+
+            start = vol_bench_now();
+
+            if (H5Dwrite(dset->dset_id, dset->type_id, mspace_id, fspace_id, H5P_DEFAULT, buf) < 0) {
+                HDprintf("    couldn't write to dataset '%s'\n", DATASET_BENCH_THROUGHPUT_DSET_NAME);
+                BENCH_ERROR;
+            }
+
+            if (vol_bench_stats_add(&stats, vol_bench_now() - start) < 0)
+                BENCH_ERROR;
+
+            nbytes += count * dset->type_size;
+        }
+    }
+
+    vol_bench_report("dataset", "write (hyperslab)", nbytes, &stats);
+
+    if (H5Sclose(mspace_id) < 0)
+        BENCH_ERROR;
+    if (H5Sclose(fspace_id) < 0)
+        BENCH_ERROR;
+
+    HDfree(buf);
+    vol_bench_stats_free(&stats);
+
+    return 0;
+
+error:
+    H5E_BEGIN_TRY
+    {
+        H5Sclose(mspace_id);
+        H5Sclose(fspace_id);
+    }
+    H5E_END_TRY;
+
+    HDfree(buf);
+    vol_bench_stats_free(&stats);
+
+    return 1;
+}
+
+/*
+ * Benchmarks writing up to --max-points elements spread
+ * across the dataset with a point selection.
+ */
+static int
+bench_write_dataset_points(dataset_bench_dset_t *dset)
+{
+    vol_bench_stats_t stats;
+    hsize_t           npoints   = MIN(vol_bench_params_g.max_points, dset->nelems);
+    hid_t             mspace_id = H5I_INVALID_HID;
+    hid_t             fspace_id = H5I_INVALID_HID;
+    hsize_t          *coords    = NULL;
+    void             *buf       = NULL;
+
+    vol_bench_stats_init(&stats);
+
+    if ((mspace_id = H5Screate_simple(1, &npoints, NULL)) < 0)
+        BENCH_ERROR;
+    if ((fspace_id = H5Dget_space(dset->dset_id)) < 0)
+        BENCH_ERROR;
+
+    if (NULL == (coords = HDmalloc((size_t)npoints * sizeof(hsize_t))))
+        BENCH_ERROR;
+    if (NULL == (buf = HDmalloc((size_t)(npoints * dset->type_size))))
+        BENCH_ERROR;
+
+    for (unsigned i = 0; i < vol_bench_params_g.iterations; i++) {
+        double start;
+
+        if (dataset_bench_select_points(dset, fspace_id, coords, (size_t)npoints, i) < 0)
+            BENCH_ERROR;
+
+        dataset_bench_fill_points(buf, dset->type_size, coords, (size_t)npoints);
+
+        start = vol_bench_now();
+
+        if (H5Dwrite(dset->dset_id, dset->type_id, mspace_id, fspace_id, H5P_DEFAULT, buf) < 0) {
+            HDprintf("    couldn't write to dataset '%s'\n", DATASET_BENCH_THROUGHPUT_DSET_NAME);
+            BENCH_ERROR;
+        }
+
+        if (vol_bench_stats_add(&stats, vol_bench_now() - start) < 0)
+            BENCH_ERROR;
+    }
+
+    vol_bench_report("dataset", "write (point selection)", npoints * dset->type_size * stats.nsamples,
+                     &stats);
+
+    if (H5Sclose(mspace_id) < 0)
+        BENCH_ERROR;
+    if (H5Sclose(fspace_id) < 0)
+        BENCH_ERROR;
+
+    HDfree(buf);
+    HDfree(coords);
+    vol_bench_stats_free(&stats);
+
+    return 0;
+
+error:
+    H5E_BEGIN_TRY
+    {
+        H5Sclose(mspace_id);
+        H5Sclose(fspace_id);
+    }
+    H5E_END_TRY;
+
+    HDfree(buf);
+    HDfree(coords);
+    vol_bench_stats_free(&stats);
+
+    return 1;
+}
+
+/*
+ * Benchmarks reading the entire dataset with H5S_ALL.
+ */
+static int
+bench_read_dataset_all(dataset_bench_dset_t *dset)
+{
+    vol_bench_stats_t stats;
+    size_t            buf_size = (size_t)(dset->nelems * dset->type_size);
+    void             *buf      = NULL;
+
+    vol_bench_stats_init(&stats);
+
+    if ((hsize_t)buf_size != dset->nelems * dset->type_size || NULL == (buf = HDmalloc(buf_size))) {
+        BENCH_SKIPPED("read (H5S_ALL)", "couldn't allocate a buffer for the entire dataset");
+        return 0;
+    }
+
+    for (unsigned i = 0; i < vol_bench_params_g.iterations; i++) {
+        double start = vol_bench_now();
+
+        if (H5Dread(dset->dset_id, dset->type_id, H5S_ALL, H5S_ALL, H5P_DEFAULT, buf) < 0) {
+            HDprintf("    couldn't read from dataset '%s'\n", DATASET_BENCH_THROUGHPUT_DSET_NAME);
+            BENCH_ERROR;
+        }
+
+        if (vol_bench_stats_add(&stats, vol_bench_now() - start) < 0)
+            BENCH_ERROR;
+
+        if (vol_bench_params_g.verify) {
+            hsize_t nmismatch;
+
+            if ((nmismatch = vol_bench_check_buffer(buf, buf_size, 0)) > 0) {
+                HDprintf("    %llu bytes read from dataset '%s' didn't match what was written\n",
+                         (unsigned long long)nmismatch, DATASET_BENCH_THROUGHPUT_DSET_NAME);
+                BENCH_ERROR;
+            }
+        }
+    }
+
+    vol_bench_report("dataset", "read (H5S_ALL)", (hsize_t)buf_size * stats.nsamples, &stats);
+
+    HDfree(buf);
+    vol_bench_stats_free(&stats);
+
+    return 0;
+
+error:
+    HDfree(buf);
+    vol_bench_stats_free(&stats);
+
+    return 1;
+}
+
+/*
+ * Benchmarks reading the dataset in contiguous blocks of
+ * --xfer-size bytes, using a hyperslab selection for each.
+ */
+static int
+bench_read_dataset_hyperslab(dataset_bench_dset_t *dset)
+{
+    vol_bench_stats_t stats;
+    hsize_t           xfer_elems = dataset_bench_xfer_elems(dset);
+    hsize_t           nbytes     = 0;
+    hid_t             mspace_id  = H5I_INVALID_HID;
+    hid_t             fspace_id  = H5I_INVALID_HID;
+    void             *buf        = NULL;
+
+    vol_bench_stats_init(&stats);
+
+    if ((mspace_id = H5Screate_simple(1, &xfer_elems, NULL)) < 0)
+        BENCH_ERROR;
+    if ((fspace_id = H5Dget_space(dset->dset_id)) < 0)
+        BENCH_ERROR;
+
+    if (NULL == (buf = HDmalloc((size_t)(xfer_elems * dset->type_size))))
+        BENCH_ERROR;
+
+    for (unsigned i = 0; i < vol_bench_params_g.iterations; i++) {
+        for (hsize_t offset = 0; offset < dset->nelems; offset += xfer_elems) {
+            hsize_t count = MIN(xfer_elems, dset->nelems - offset);
+            hsize_t zero  = 0;
+            double  start;
+
+            if (H5Sselect_hyperslab(fspace_id, H5S_SELECT_SET, &offset, NULL, &count, NULL) < 0)
+                BENCH_ERROR;
+            if (H5Sselect_hyperslab(mspace_id, H5S_SELECT_SET, &zero, NULL, &count, NULL) < 0)
+                BENCH_ERROR;
+
+            start = vol_bench_now();
+
+            if (H5Dread(dset->dset_id, dset->type_id, mspace_id, fspace_id, H5P_DEFAULT, buf) < 0) {
+                HDprintf("    couldn't read from dataset '%s'\n", DATASET_BENCH_THROUGHPUT_DSET_NAME);
+                BENCH_ERROR;
+            }
+
+            if (vol_bench_stats_add(&stats, vol_bench_now() - start) < 0)
+                BENCH_ERROR;
+
+            nbytes += count * dset->type_size;
+
+            if (vol_bench_params_g.verify) {
+                hsize_t nmismatch;
+
+                if ((nmismatch = vol_bench_check_buffer(buf, (size_t)(count * dset->type_size),
+                                                        offset * dset->type_size)) > 0) {
+                    HDprintf("    %llu bytes read from dataset '%s' didn't match what was written\n",
+                             (unsigned long long)nmismatch, DATASET_BENCH_THROUGHPUT_DSET_NAME);
+                    BENCH_ERROR;
+                }
+            }
+        }
+    }
+
+    vol_bench_report("dataset", "read (hyperslab)", nbytes, &stats);
+
+    if (H5Sclose(mspace_id) < 0)
+        BENCH_ERROR;
+    if (H5Sclose(fspace_id) < 0)
+        BENCH_ERROR;
+
+    HDfree(buf);
+    vol_bench_stats_free(&stats);
+
+    return 0;
+
+error:
+    H5E_BEGIN_TRY
+    {
+        H5Sclose(mspace_id);
+        H5Sclose(fspace_id);
+    }
+    H5E_END_TRY;
+
+    HDfree(buf);
+    vol_bench_stats_free(&stats);
+
+    return 1;
+}
+
+/*
+ * Benchmarks reading up to --max-points elements spread
+ * across the dataset with a point selection.
+ */
+static int
+bench_read_dataset_points(dataset_bench_dset_t *dset)
+{
+    vol_bench_stats_t stats;
+    hsize_t           npoints   = MIN(vol_bench_params_g.max_points, dset->nelems);
+    hid_t             mspace_id = H5I_INVALID_HID;
+    hid_t             fspace_id = H5I_INVALID_HID;
+    hsize_t          *coords    = NULL;
+    void             *buf       = NULL;
+
+    vol_bench_stats_init(&stats);
+
+    if ((mspace_id = H5Screate_simple(1, &npoints, NULL)) < 0)
+        BENCH_ERROR;
+    if ((fspace_id = H5Dget_space(dset->dset_id)) < 0)
+        BENCH_ERROR;
+
+    if (NULL == (coords = HDmalloc((size_t)npoints * sizeof(hsize_t))))
+        BENCH_ERROR;
+    if (NULL == (buf = HDmalloc((size_t)(npoints * dset->type_size))))
+        BENCH_ERROR;
+
+    for (unsigned i = 0; i < vol_bench_params_g.iterations; i++) {
+        double start;
+
+        if (dataset_bench_select_points(dset, fspace_id, coords, (size_t)npoints, i) < 0)
+            BENCH_ERROR;
+
+        start = vol_bench_now();
+
+        if (H5Dread(dset->dset_id, dset->type_id, mspace_id, fspace_id, H5P_DEFAULT, buf) < 0) {
+            HDprintf("    couldn't read from dataset '%s'\n", DATASET_BENCH_THROUGHPUT_DSET_NAME);
+            BENCH_ERROR;
+        }
+
+        if (vol_bench_stats_add(&stats, vol_bench_now() - start) < 0)
+            BENCH_ERROR;
+
+        if (vol_bench_params_g.verify) {
+            hsize_t nmismatch;
+
+            if ((nmismatch = dataset_bench_check_points(buf, dset->type_size, coords, (size_t)npoints)) > 0) {
+                HDprintf("    %llu bytes read from dataset '%s' didn't match what was written\n",
+                         (unsigned long long)nmismatch, DATASET_BENCH_THROUGHPUT_DSET_NAME);
+                BENCH_ERROR;
+            }
+        }
+    }
+
+    vol_bench_report("dataset", "read (point selection)", npoints * dset->type_size * stats.nsamples,
+                     &stats);
+
+    if (H5Sclose(mspace_id) < 0)
+        BENCH_ERROR;
+    if (H5Sclose(fspace_id) < 0)
+        BENCH_ERROR;
+
+    HDfree(buf);
+    HDfree(coords);
+    vol_bench_stats_free(&stats);
+
+    return 0;
+
+error:
+    H5E_BEGIN_TRY
+    {
+        H5Sclose(mspace_id);
+        H5Sclose(fspace_id);
+    }
+    H5E_END_TRY;
+
+    HDfree(buf);
+    HDfree(coords);
+    vol_bench_stats_free(&stats);
+
+    return 1;
+}
+
+int
+vol_dataset_bench(void)
+{
+    dataset_bench_dset_t dset;
+    hsize_t              dims[1];
+    size_t               i;
+    int                  nerrors   = 0;
+    hid_t                file_id   = H5I_INVALID_HID;
+    hid_t                group_id  = H5I_INVALID_HID;
+    hid_t                fspace_id = H5I_INVALID_HID;
+
+    HDprintf("**********************************************\n");
+    HDprintf("*                                            *\n");
+    HDprintf("*           VOL Dataset Benchmarks           *\n");
+    HDprintf("*                                            *\n");
+    HDprintf("**********************************************\n\n");
+
+    dset.dset_id = H5I_INVALID_HID;
+    dset.type_id = vol_bench_type();
+
+    /* Make sure the connector supports the API functions being benchmarked */
+    if (!(vol_cap_flags_g & H5VL_CAP_FLAG_FILE_BASIC) || !(vol_cap_flags_g & H5VL_CAP_FLAG_GROUP_BASIC) ||
+        !(vol_cap_flags_g & H5VL_CAP_FLAG_DATASET_BASIC)) {
+        BENCH_SKIPPED("dataset throughput",
+                      "API functions for basic file, group, or dataset aren't supported with this connector");
+        HDprintf("\n");
+        return 0;
+    }
+
+    if (0 == (dset.type_size = H5Tget_size(dset.type_id)))
+        BENCH_ERROR;
+
+    if (0 == (dset.nelems = vol_bench_params_g.dataset_size / dset.type_size)) {
+        HDprintf("    dataset size of %llu bytes is smaller than a single element\n",
+                 (unsigned long long)vol_bench_params_g.dataset_size);
+        BENCH_ERROR;
+    }
+
+    if ((file_id = H5Fopen(vol_bench_filename, H5F_ACC_RDWR, H5P_DEFAULT)) < 0) {
+        HDprintf("    couldn't open file '%s'\n", vol_bench_filename);
+        BENCH_ERROR;
+    }
+
+    if ((group_id = H5Gcreate2(file_id, DATASET_BENCH_GROUP_NAME, H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT)) < 0) {
+        HDprintf("    couldn't create container group '%s'\n", DATASET_BENCH_GROUP_NAME);
+        BENCH_ERROR;
+    }
+
+    dims[0] = dset.nelems;
+
+    if ((fspace_id = H5Screate_simple(1, dims, NULL)) < 0)
+        BENCH_ERROR;
+
+    if ((dset.dset_id = H5Dcreate2(group_id, DATASET_BENCH_THROUGHPUT_DSET_NAME, dset.type_id, fspace_id,
+                                   H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT)) < 0) {
+        HDprintf("    couldn't create dataset '%s'\n", DATASET_BENCH_THROUGHPUT_DSET_NAME);
+        BENCH_ERROR;
+    }
+
+    for (i = 0; i < ARRAY_LENGTH(dataset_benches); i++) {
+        nerrors += (*dataset_benches[i])(&dset) ? 1 : 0;
+    }
+
+    if (H5Sclose(fspace_id) < 0)
+        BENCH_ERROR;
+    if (H5Dclose(dset.dset_id) < 0)
+        BENCH_ERROR;
+    if (H5Gclose(group_id) < 0)
+        BENCH_ERROR;
+    if (H5Fclose(file_id) < 0)
+        BENCH_ERROR;
+
+    HDprintf("\n");
+
+    return nerrors;
+
+error:
+    H5E_BEGIN_TRY
+    {
+        H5Sclose(fspace_id);
+        H5Dclose(dset.dset_id);
+        H5Gclose(group_id);
+        H5Fclose(file_id);
+    }
+    H5E_END_TRY;
+
+    HDprintf("\n");
+
+    return nerrors + 1;
+}
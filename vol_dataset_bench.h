@@ -0,0 +1,30 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * Copyright by The HDF Group.                                               *
+ * All rights reserved.                                                      *
+ *                                                                           *
+ * This file is part of HDF5.  The full HDF5 copyright notice, including     *
+ * terms governing use, modification, and redistribution, is contained in    *
+ * the COPYING file, which can be found at the root of the source code       *
+ * distribution tree, or in https://support.hdfgroup.org/ftp/HDF5/releases.  *
+ * If you do not have access to either file, you may request a copy from     *
+ * help@hdfgroup.org.                                                        *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#ifndef VOL_DATASET_BENCH_H
+#define VOL_DATASET_BENCH_H
+
+#include "vol_bench.h"
+
+int vol_dataset_bench(void);
+
+/**************************************************
+ *                                                *
+ *      VOL connector Dataset benchmark defines   *
+ *                                                *
+ **************************************************/
+
+#define DATASET_BENCH_GROUP_NAME "dataset_bench"
+
+#define DATASET_BENCH_THROUGHPUT_DSET_NAME "throughput_dset"
+
+#endif
@@ -56,6 +56,7 @@ static int test_write_dataset_small_hyperslab(void);
 static int test_write_dataset_small_point_selection(void);
 static int test_write_dataset_data_verification(void);
 static int test_write_dataset_invalid_params(void);
+static int test_write_read_multi_dataset(void);
 static int test_dataset_builtin_type_conversion(void);
 static int test_dataset_compound_partial_io(void);
 static int test_dataset_set_extent_chunked_unlimited(void);
@@ -128,6 +129,7 @@ static int (*dataset_tests[])(void) = {
     test_write_dataset_small_point_selection,
     test_write_dataset_data_verification,
     test_write_dataset_invalid_params,
+    test_write_read_multi_dataset,
     test_dataset_builtin_type_conversion,
     test_dataset_compound_partial_io,
     test_dataset_set_extent_chunked_unlimited,
@@ -1197,7 +1199,7 @@ test_create_dataset_random_shapes(void)
 
     for (i = 0; i < DATASET_SHAPE_TEST_NUM_ITERATIONS; i++) {
         char name[100];
-        int  ndims = rand() % DATASET_SHAPE_TEST_MAX_DIMS + 1;
+        int  ndims = vol_test_random() % DATASET_SHAPE_TEST_MAX_DIMS + 1;
 
         if ((space_id = generate_random_dataspace(ndims, NULL, NULL, FALSE)) < 0) {
             H5_FAILED();
@@ -1581,7 +1583,7 @@ test_create_dataset_compound_types(void)
     if ((fspace_id = generate_random_dataspace(DATASET_COMPOUND_TYPE_TEST_DSET_RANK, NULL, NULL, FALSE)) < 0)
         TEST_ERROR;
 
-    num_passes = (rand() % DATASET_COMPOUND_TYPE_TEST_MAX_PASSES) + 1;
+    num_passes = (vol_test_random() % DATASET_COMPOUND_TYPE_TEST_MAX_PASSES) + 1;
 
     for (i = 0; i < (size_t)num_passes; i++) {
         size_t num_subtypes;
@@ -1597,7 +1599,7 @@ test_create_dataset_compound_types(void)
         for (j = 0; j < DATASET_COMPOUND_TYPE_TEST_MAX_SUBTYPES; j++)
             type_pool[j] = H5I_INVALID_HID;
 
-        num_subtypes = (size_t)(rand() % DATASET_COMPOUND_TYPE_TEST_MAX_SUBTYPES) + 1;
+        num_subtypes = (size_t)(vol_test_random() % DATASET_COMPOUND_TYPE_TEST_MAX_SUBTYPES) + 1;
 
         if ((compound_type = H5Tcreate(H5T_COMPOUND, 1)) < 0) {
             H5_FAILED();
@@ -1891,7 +1893,7 @@ test_create_dataset_array_types(void)
 
     /* Test creation of array with some different types */
     for (i = 0; i < DATASET_ARRAY_TYPE_TEST_RANK1; i++)
-        array_dims1[i] = (hsize_t)(rand() % MAX_DIM_SIZE + 1);
+        array_dims1[i] = (hsize_t)(vol_test_random() % MAX_DIM_SIZE + 1);
 
     if ((array_base_type_id1 = generate_random_datatype(H5T_ARRAY, FALSE)) < 0)
         TEST_ERROR;
@@ -1904,7 +1906,7 @@ test_create_dataset_array_types(void)
     }
 
     for (i = 0; i < DATASET_ARRAY_TYPE_TEST_RANK2; i++)
-        array_dims2[i] = (hsize_t)(rand() % MAX_DIM_SIZE + 1);
+        array_dims2[i] = (hsize_t)(vol_test_random() % MAX_DIM_SIZE + 1);
 
     if ((array_base_type_id2 = generate_random_datatype(H5T_ARRAY, FALSE)) < 0)
         TEST_ERROR;
@@ -1918,7 +1920,7 @@ test_create_dataset_array_types(void)
 
     /* Test nested arrays */
     for (i = 0; i < DATASET_ARRAY_TYPE_TEST_RANK3; i++)
-        array_dims3[i] = (hsize_t)(rand() % MAX_DIM_SIZE + 1);
+        array_dims3[i] = (hsize_t)(vol_test_random() % MAX_DIM_SIZE + 1);
 
     if ((array_base_type_id3 = generate_random_datatype(H5T_ARRAY, FALSE)) < 0)
         TEST_ERROR;
@@ -2747,7 +2749,7 @@ test_create_dataset_creation_properties(void)
                     size_t  j;
 
                     for (j = 0; j < DATASET_CREATION_PROPERTIES_TEST_CHUNK_DIM_RANK; j++)
-                        local_chunk_dims[j] = (hsize_t)(rand() % (int)dims[j] + 1);
+                        local_chunk_dims[j] = (hsize_t)(vol_test_random() % (int)dims[j] + 1);
 
                     if (H5Pset_chunk(dcpl_id, DATASET_CREATION_PROPERTIES_TEST_CHUNK_DIM_RANK,
                                      local_chunk_dims) < 0) {
@@ -3846,7 +3848,7 @@ test_dataset_property_lists(void)
         TEST_ERROR;
 
     for (i = 0; i < DATASET_PROPERTY_LIST_TEST_SPACE_RANK; i++)
-        chunk_dims[i] = (hsize_t)(rand() % (int)dims[i] + 1);
+        chunk_dims[i] = (hsize_t)(vol_test_random() % (int)dims[i] + 1);
 
     if ((dset_dtype1 = generate_random_datatype(H5T_NO_CLASS, FALSE)) < 0)
         TEST_ERROR;
@@ -4883,8 +4885,8 @@ error:
     {                                                                                                        \
         for ((I) = 0; (I) < DATASET_IO_POINT_NPOINTS; (I)++)                                                 \
             do {                                                                                             \
-                (POINTS)[2 * (I)]     = (hsize_t)(rand() % DATASET_IO_POINT_DIM_0);                          \
-                (POINTS)[2 * (I) + 1] = (hsize_t)(rand() % DATASET_IO_POINT_DIM_1);                          \
+                (POINTS)[2 * (I)]     = (hsize_t)(vol_test_random() % DATASET_IO_POINT_DIM_0);               \
+                (POINTS)[2 * (I) + 1] = (hsize_t)(vol_test_random() % DATASET_IO_POINT_DIM_1);               \
                 for ((J) = 0; ((J) < (I)) && (((POINTS)[2 * (I)] != (POINTS)[2 * (J)]) ||                    \
                                               ((POINTS)[2 * (I) + 1] != (POINTS)[2 * (J) + 1]));             \
                      (J)++)                                                                                  \
@@ -4972,7 +4974,7 @@ test_dataset_io_point_selections(void)
         /* Fill write buffer */
         for (i = 0; i < DATASET_IO_POINT_DIM_0; i++)
             for (j = 0; j < DATASET_IO_POINT_DIM_1; j++)
-                buf_all[i][j] = rand();
+                buf_all[i][j] = vol_test_random();
 
         /* Write data */
         if (H5Dwrite(dset_id, H5T_NATIVE_INT, H5S_ALL, H5S_ALL, H5P_DEFAULT, buf_all) < 0)
@@ -5011,7 +5013,7 @@ test_dataset_io_point_selections(void)
 
         /* Fill write buffer */
         for (i = 0; i < DATASET_IO_POINT_NPOINTS; i++)
-            buf_point[i] = rand();
+            buf_point[i] = vol_test_random();
 
         /* Write points from "all" memory buffer */
         if (H5Dwrite(dset_id, H5T_NATIVE_INT, mspace_id_all, fspace_id, H5P_DEFAULT, buf_point) < 0)
@@ -5078,7 +5080,7 @@ test_dataset_io_point_selections(void)
         /* Fill write buffer */
         for (i = 0; i < DATASET_IO_POINT_DIM_0; i++)
             for (j = 0; j < DATASET_IO_POINT_DIM_1; j++)
-                buf_all[i][j] = rand();
+                buf_all[i][j] = vol_test_random();
 
         /* Write data points->points */
         if (H5Dwrite(dset_id, H5T_NATIVE_INT, fspace_id, fspace_id, H5P_DEFAULT, buf_all) < 0)
@@ -5153,7 +5155,7 @@ test_dataset_io_point_selections(void)
         /* Fill write buffer */
         for (i = 0; i < DATASET_IO_POINT_DIM_0; i++)
             for (j = 0; j < DATASET_IO_POINT_DIM_1; j++)
-                buf_all[i][j] = rand();
+                buf_all[i][j] = vol_test_random();
 
         /* Write data points->points */
         if (H5Dwrite(dset_id, H5T_NATIVE_INT, mspace_id_full, fspace_id, H5P_DEFAULT, buf_all) < 0)
@@ -5227,7 +5229,7 @@ test_dataset_io_point_selections(void)
         /* Fill write buffer */
         for (i = 0; i < DATASET_IO_POINT_DIM_0; i++)
             for (j = 0; j < DATASET_IO_POINT_DIM_1; j++)
-                buf_all[i][j] = rand();
+                buf_all[i][j] = vol_test_random();
 
         /* Write data hlsab->points */
         if (H5Dwrite(dset_id, H5T_NATIVE_INT, mspace_id_full, fspace_id, H5P_DEFAULT, buf_all) < 0)
@@ -5303,7 +5305,7 @@ test_dataset_io_point_selections(void)
         /* Fill write buffer */
         for (i = 0; i < DATASET_IO_POINT_DIM_0; i++)
             for (j = 0; j < DATASET_IO_POINT_DIM_1; j++)
-                buf_all[i][j] = rand();
+                buf_all[i][j] = vol_test_random();
 
         /* Write data points->hslab */
         if (H5Dwrite(dset_id, H5T_NATIVE_INT, mspace_id_full, fspace_id, H5P_DEFAULT, buf_all) < 0)
@@ -6764,6 +6766,348 @@ error:
     return 1;
 }
 
+/*
+ * Fills a buffer for one of the datasets in the multi-dataset I/O
+ * test. The element type of each dataset cycles through int, double
+ * and short, so each is filled according to its index.
+ */
+static void
+dataset_multi_io_fill_buf(void *buf, size_t dset_idx, size_t nelems, int base)
+{
+    size_t i;
+
+    for (i = 0; i < nelems; i++) {
+        int value = base + (int)(dset_idx * DATASET_MULTI_IO_TEST_DSET_VALUE_STRIDE) + (int)i;
+
+        switch (dset_idx % 3) {
+            case 0:
+                ((int *)buf)[i] = value;
+                break;
+            case 1:
+                ((double *)buf)[i] = (double)value;
+                break;
+            default:
+                ((short *)buf)[i] = (short)value;
+                break;
+        }
+    }
+}
+
+/*
+ * A test to check that data can be written to and read from
+ * several datasets at once with H5Dwrite_multi and H5Dread_multi.
+ * The datasets have a mix of element types and use a mix of
+ * H5S_ALL, hyperslab and point selections. The data is checked
+ * against the result of writing or reading each dataset in turn
+ * with H5Dwrite or H5Dread.
+ */
+static int
+test_write_read_multi_dataset(void)
+{
+    hsize_t     dims[DATASET_MULTI_IO_TEST_SPACE_RANK] = {10, 10};
+    hsize_t     start[DATASET_MULTI_IO_TEST_SPACE_RANK];
+    hsize_t     count[DATASET_MULTI_IO_TEST_SPACE_RANK];
+    hsize_t     points[DATASET_MULTI_IO_TEST_NUM_POINTS * DATASET_MULTI_IO_TEST_SPACE_RANK];
+    hsize_t     mdims[1];
+    size_t      i;
+    size_t      nelems[DATASET_MULTI_IO_TEST_NUM_DSETS];
+    size_t      type_sizes[DATASET_MULTI_IO_TEST_NUM_DSETS];
+    hid_t       file_id         = H5I_INVALID_HID;
+    hid_t       container_group = H5I_INVALID_HID, group_id = H5I_INVALID_HID;
+    hid_t       dset_ids[DATASET_MULTI_IO_TEST_NUM_DSETS];
+    hid_t       type_ids[DATASET_MULTI_IO_TEST_NUM_DSETS];
+    hid_t       fspace_ids[DATASET_MULTI_IO_TEST_NUM_DSETS];
+    hid_t       mspace_ids[DATASET_MULTI_IO_TEST_NUM_DSETS];
+    hid_t       io_fspace_ids[DATASET_MULTI_IO_TEST_NUM_DSETS];
+    hid_t       io_mspace_ids[DATASET_MULTI_IO_TEST_NUM_DSETS];
+    void       *write_bufs[DATASET_MULTI_IO_TEST_NUM_DSETS];
+    void       *read_bufs[DATASET_MULTI_IO_TEST_NUM_DSETS];
+    const void *const_write_bufs[DATASET_MULTI_IO_TEST_NUM_DSETS];
+
+    for (i = 0; i < DATASET_MULTI_IO_TEST_NUM_DSETS; i++) {
+        dset_ids[i]   = H5I_INVALID_HID;
+        fspace_ids[i] = H5I_INVALID_HID;
+        mspace_ids[i] = H5I_INVALID_HID;
+        write_bufs[i] = NULL;
+        read_bufs[i]  = NULL;
+    }
+
+    TESTING_MULTIPART("multi-dataset I/O with H5Dwrite_multi and H5Dread_multi");
+
+    /* Make sure the connector supports the API functions being tested */
+    if (!(vol_cap_flags_g & H5VL_CAP_FLAG_FILE_BASIC) || !(vol_cap_flags_g & H5VL_CAP_FLAG_GROUP_BASIC) ||
+        !(vol_cap_flags_g & H5VL_CAP_FLAG_DATASET_BASIC)) {
+        SKIPPED();
+        HDprintf(
+            "    API functions for basic file, group, or dataset aren't supported with this connector\n");
+        return 0;
+    }
+
+    TESTING_2("test setup");
+
+    if ((file_id = H5Fopen(vol_test_filename, H5F_ACC_RDWR, H5P_DEFAULT)) < 0) {
+        H5_FAILED();
+        HDprintf("    couldn't open file '%s'\n", vol_test_filename);
+        goto error;
+    }
+
+    if ((container_group = H5Gopen2(file_id, DATASET_TEST_GROUP_NAME, H5P_DEFAULT)) < 0) {
+        H5_FAILED();
+        HDprintf("    couldn't open container group '%s'\n", DATASET_TEST_GROUP_NAME);
+        goto error;
+    }
+
+    if ((group_id = H5Gcreate2(container_group, DATASET_MULTI_IO_TEST_GROUP_NAME, H5P_DEFAULT, H5P_DEFAULT,
+                               H5P_DEFAULT)) < 0) {
+        H5_FAILED();
+        HDprintf("    couldn't create container sub-group '%s'\n", DATASET_MULTI_IO_TEST_GROUP_NAME);
+        goto error;
+    }
+
+    for (i = 0; i < DATASET_MULTI_IO_TEST_NUM_POINTS; i++) {
+        points[(i * DATASET_MULTI_IO_TEST_SPACE_RANK)]     = i;
+        points[(i * DATASET_MULTI_IO_TEST_SPACE_RANK) + 1] = i;
+    }
+
+    for (i = 0; i < DATASET_MULTI_IO_TEST_NUM_DSETS; i++) {
+        char dset_name[DATASET_MULTI_IO_TEST_DSET_NAME_BUF_SIZE];
+
+        switch (i % 3) {
+            case 0:
+                type_ids[i]   = H5T_NATIVE_INT;
+                type_sizes[i] = sizeof(int);
+                break;
+            case 1:
+                type_ids[i]   = H5T_NATIVE_DOUBLE;
+                type_sizes[i] = sizeof(double);
+                break;
+            default:
+                type_ids[i]   = H5T_NATIVE_SHORT;
+                type_sizes[i] = sizeof(short);
+                break;
+        }
+
+        if ((fspace_ids[i] = H5Screate_simple(DATASET_MULTI_IO_TEST_SPACE_RANK, dims, NULL)) < 0)
+            TEST_ERROR;
+
+        HDsnprintf(dset_name, DATASET_MULTI_IO_TEST_DSET_NAME_BUF_SIZE, "%s%zu",
+                   DATASET_MULTI_IO_TEST_DSET_NAME, i);
+
+        if ((dset_ids[i] = H5Dcreate2(group_id, dset_name, type_ids[i], fspace_ids[i], H5P_DEFAULT,
+                                      H5P_DEFAULT, H5P_DEFAULT)) < 0) {
+            H5_FAILED();
+            HDprintf("    couldn't create dataset '%s'\n", dset_name);
+            goto error;
+        }
+
+        /*
+         * Cycle through an H5S_ALL selection, a hyperslab selection
+         * of 5 rows of the dataset and a point selection along the
+         * dataset's diagonal.
+         */
+        switch ((i / 3) % 3) {
+            case 0:
+                nelems[i]        = (size_t)(dims[0] * dims[1]);
+                io_fspace_ids[i] = H5S_ALL;
+                io_mspace_ids[i] = H5S_ALL;
+                break;
+            case 1:
+                start[0] = 2;
+                start[1] = 0;
+                count[0] = 5;
+                count[1] = dims[1];
+
+                if (H5Sselect_hyperslab(fspace_ids[i], H5S_SELECT_SET, start, NULL, count, NULL) < 0)
+                    TEST_ERROR;
+
+                nelems[i]        = (size_t)(count[0] * count[1]);
+                io_fspace_ids[i] = fspace_ids[i];
+                break;
+            default:
+                if (H5Sselect_elements(fspace_ids[i], H5S_SELECT_SET, DATASET_MULTI_IO_TEST_NUM_POINTS,
+                                       points) < 0)
+                    TEST_ERROR;
+
+                nelems[i]        = DATASET_MULTI_IO_TEST_NUM_POINTS;
+                io_fspace_ids[i] = fspace_ids[i];
+                break;
+        }
+
+        if (io_fspace_ids[i] != H5S_ALL) {
+            mdims[0] = (hsize_t)nelems[i];
+
+            if ((mspace_ids[i] = H5Screate_simple(1, mdims, NULL)) < 0)
+                TEST_ERROR;
+
+            io_mspace_ids[i] = mspace_ids[i];
+        }
+
+        if (NULL == (write_bufs[i] = HDmalloc(nelems[i] * type_sizes[i])) ||
+            NULL == (read_bufs[i] = HDmalloc(nelems[i] * type_sizes[i]))) {
+            H5_FAILED();
+            HDprintf("    couldn't allocate buffers for dataset I/O\n");
+            goto error;
+        }
+
+        const_write_bufs[i] = write_bufs[i];
+    }
+
+    PASSED();
+
+    BEGIN_MULTIPART
+    {
+        PART_BEGIN(H5Dwrite_multi_read)
+        {
+            TESTING_2("H5Dwrite_multi then H5Dread");
+
+            for (i = 0; i < DATASET_MULTI_IO_TEST_NUM_DSETS; i++)
+                dataset_multi_io_fill_buf(write_bufs[i], i, nelems[i], 0);
+
+            if (H5Dwrite_multi(DATASET_MULTI_IO_TEST_NUM_DSETS, dset_ids, type_ids, io_mspace_ids,
+                               io_fspace_ids, H5P_DEFAULT, const_write_bufs) < 0) {
+                H5_FAILED();
+                HDprintf("    couldn't write to datasets with H5Dwrite_multi\n");
+                PART_ERROR(H5Dwrite_multi_read);
+            }
+
+            for (i = 0; i < DATASET_MULTI_IO_TEST_NUM_DSETS; i++) {
+                HDmemset(read_bufs[i], 0, nelems[i] * type_sizes[i]);
+
+                if (H5Dread(dset_ids[i], type_ids[i], io_mspace_ids[i], io_fspace_ids[i], H5P_DEFAULT,
+                            read_bufs[i]) < 0) {
+                    H5_FAILED();
+                    HDprintf("    couldn't read from dataset %zu\n", i);
+                    PART_ERROR(H5Dwrite_multi_read);
+                }
+
+                if (HDmemcmp(write_bufs[i], read_bufs[i], nelems[i] * type_sizes[i])) {
+                    H5_FAILED();
+                    HDprintf("    data verification failed for dataset %zu\n", i);
+                    PART_ERROR(H5Dwrite_multi_read);
+                }
+            }
+
+            PASSED();
+        }
+        PART_END(H5Dwrite_multi_read);
+
+        PART_BEGIN(H5Dwrite_read_multi)
+        {
+            TESTING_2("H5Dwrite then H5Dread_multi");
+
+            for (i = 0; i < DATASET_MULTI_IO_TEST_NUM_DSETS; i++) {
+                dataset_multi_io_fill_buf(write_bufs[i], i, nelems[i], DATASET_MULTI_IO_TEST_SECOND_BASE);
+
+                if (H5Dwrite(dset_ids[i], type_ids[i], io_mspace_ids[i], io_fspace_ids[i], H5P_DEFAULT,
+                             write_bufs[i]) < 0) {
+                    H5_FAILED();
+                    HDprintf("    couldn't write to dataset %zu\n", i);
+                    PART_ERROR(H5Dwrite_read_multi);
+                }
+
+                HDmemset(read_bufs[i], 0, nelems[i] * type_sizes[i]);
+            }
+
+            if (H5Dread_multi(DATASET_MULTI_IO_TEST_NUM_DSETS, dset_ids, type_ids, io_mspace_ids,
+                              io_fspace_ids, H5P_DEFAULT, read_bufs) < 0) {
+                H5_FAILED();
+                HDprintf("    couldn't read from datasets with H5Dread_multi\n");
+                PART_ERROR(H5Dwrite_read_multi);
+            }
+
+            for (i = 0; i < DATASET_MULTI_IO_TEST_NUM_DSETS; i++)
+                if (HDmemcmp(write_bufs[i], read_bufs[i], nelems[i] * type_sizes[i])) {
+                    H5_FAILED();
+                    HDprintf("    data verification failed for dataset %zu\n", i);
+                    PART_ERROR(H5Dwrite_read_multi);
+                }
+
+            PASSED();
+        }
+        PART_END(H5Dwrite_read_multi);
+
+        PART_BEGIN(H5Dwrite_multi_read_multi_single)
+        {
+            TESTING_2("H5Dwrite_multi then H5Dread_multi on a single dataset");
+
+            dataset_multi_io_fill_buf(write_bufs[1], 1, nelems[1], DATASET_MULTI_IO_TEST_THIRD_BASE);
+            HDmemset(read_bufs[1], 0, nelems[1] * type_sizes[1]);
+
+            if (H5Dwrite_multi(1, &dset_ids[1], &type_ids[1], &io_mspace_ids[1], &io_fspace_ids[1],
+                               H5P_DEFAULT, &const_write_bufs[1]) < 0) {
+                H5_FAILED();
+                HDprintf("    couldn't write to dataset with H5Dwrite_multi\n");
+                PART_ERROR(H5Dwrite_multi_read_multi_single);
+            }
+
+            if (H5Dread_multi(1, &dset_ids[1], &type_ids[1], &io_mspace_ids[1], &io_fspace_ids[1],
+                              H5P_DEFAULT, &read_bufs[1]) < 0) {
+                H5_FAILED();
+                HDprintf("    couldn't read from dataset with H5Dread_multi\n");
+                PART_ERROR(H5Dwrite_multi_read_multi_single);
+            }
+
+            if (HDmemcmp(write_bufs[1], read_bufs[1], nelems[1] * type_sizes[1])) {
+                H5_FAILED();
+                HDprintf("    data verification failed\n");
+                PART_ERROR(H5Dwrite_multi_read_multi_single);
+            }
+
+            PASSED();
+        }
+        PART_END(H5Dwrite_multi_read_multi_single);
+    }
+    END_MULTIPART;
+
+    TESTING_2("test cleanup");
+
+    for (i = 0; i < DATASET_MULTI_IO_TEST_NUM_DSETS; i++) {
+        HDfree(write_bufs[i]);
+        write_bufs[i] = NULL;
+        HDfree(read_bufs[i]);
+        read_bufs[i] = NULL;
+
+        if (mspace_ids[i] >= 0 && H5Sclose(mspace_ids[i]) < 0)
+            TEST_ERROR;
+        mspace_ids[i] = H5I_INVALID_HID;
+        if (H5Sclose(fspace_ids[i]) < 0)
+            TEST_ERROR;
+        fspace_ids[i] = H5I_INVALID_HID;
+        if (H5Dclose(dset_ids[i]) < 0)
+            TEST_ERROR;
+        dset_ids[i] = H5I_INVALID_HID;
+    }
+
+    if (H5Gclose(group_id) < 0)
+        TEST_ERROR;
+    if (H5Gclose(container_group) < 0)
+        TEST_ERROR;
+    if (H5Fclose(file_id) < 0)
+        TEST_ERROR;
+
+    PASSED();
+
+    return 0;
+
+error:
+    H5E_BEGIN_TRY
+    {
+        for (i = 0; i < DATASET_MULTI_IO_TEST_NUM_DSETS; i++) {
+            HDfree(write_bufs[i]);
+            HDfree(read_bufs[i]);
+            H5Sclose(mspace_ids[i]);
+            H5Sclose(fspace_ids[i]);
+            H5Dclose(dset_ids[i]);
+        }
+        H5Gclose(group_id);
+        H5Gclose(container_group);
+        H5Fclose(file_id);
+    }
+    H5E_END_TRY;
+
+    return 1;
+}
+
 /*
  * A test to ensure that data is read back correctly from a dataset after it has
  * been written, using type conversion with builtin types.
@@ -7619,7 +7963,7 @@ test_dataset_set_extent_chunked_unlimited(void)
 
     for (i = 0; i < DATASET_SET_EXTENT_CHUNKED_UNLIMITED_TEST_SPACE_RANK; i++) {
         max_dims[i]   = H5S_UNLIMITED;
-        chunk_dims[i] = (hsize_t)(rand() % MAX_DIM_SIZE + 1);
+        chunk_dims[i] = (hsize_t)(vol_test_random() % MAX_DIM_SIZE + 1);
     }
 
     if ((fspace_id = generate_random_dataspace(DATASET_SET_EXTENT_CHUNKED_UNLIMITED_TEST_SPACE_RANK, max_dims,
@@ -7651,7 +7995,7 @@ test_dataset_set_extent_chunked_unlimited(void)
         for (j = 0; j < DATASET_SET_EXTENT_CHUNKED_UNLIMITED_TEST_SPACE_RANK; j++) {
             /* Ensure that the new dimensionality doesn't match the old dimensionality. */
             do {
-                new_dims[j] = (hsize_t)(rand() % MAX_DIM_SIZE + 1);
+                new_dims[j] = (hsize_t)(vol_test_random() % MAX_DIM_SIZE + 1);
             } while (new_dims[j] == dims[j]);
         }
 
@@ -7707,7 +8051,7 @@ test_dataset_set_extent_chunked_unlimited(void)
         for (j = 0; j < DATASET_SET_EXTENT_CHUNKED_UNLIMITED_TEST_SPACE_RANK; j++) {
             /* Ensure that the new dimensionality doesn't match the old dimensionality. */
             do {
-                new_dims[j] = (hsize_t)(rand() % MAX_DIM_SIZE + 1);
+                new_dims[j] = (hsize_t)(vol_test_random() % MAX_DIM_SIZE + 1);
             } while (new_dims[j] == dims[j]);
         }
 
@@ -7851,10 +8195,10 @@ test_dataset_set_extent_chunked_fixed(void)
     }
 
     for (i = 0; i < DATASET_SET_EXTENT_CHUNKED_FIXED_TEST_SPACE_RANK; i++) {
-        dims[i]  = (hsize_t)(rand() % MAX_DIM_SIZE + 1);
+        dims[i]  = (hsize_t)(vol_test_random() % MAX_DIM_SIZE + 1);
         dims2[i] = dims[i];
         do {
-            chunk_dims[i] = (hsize_t)(rand() % MAX_DIM_SIZE + 1);
+            chunk_dims[i] = (hsize_t)(vol_test_random() % MAX_DIM_SIZE + 1);
         } while (chunk_dims[i] > dims[i]);
     }
 
@@ -7906,7 +8250,7 @@ test_dataset_set_extent_chunked_fixed(void)
                     break;
                 }
                 else
-                    new_dims[j] = (hsize_t)(rand() % MAX_DIM_SIZE + 1);
+                    new_dims[j] = (hsize_t)(vol_test_random() % MAX_DIM_SIZE + 1);
             } while (new_dims[j] >= dims[j]);
         }
 
@@ -7975,7 +8319,7 @@ test_dataset_set_extent_chunked_fixed(void)
                     break;
                 }
                 else
-                    new_dims[j] = (hsize_t)(rand() % MAX_DIM_SIZE + 1);
+                    new_dims[j] = (hsize_t)(vol_test_random() % MAX_DIM_SIZE + 1);
             } while (new_dims[j] >= dims2[j]);
         }
 
@@ -8635,10 +8979,10 @@ test_dataset_set_extent_invalid_params(void)
 
     for (i = 0; i < DATASET_SET_EXTENT_INVALID_PARAMS_TEST_SPACE_RANK; i++) {
         do {
-            new_dims[i] = (hsize_t)(rand() % MAX_DIM_SIZE + 1);
+            new_dims[i] = (hsize_t)(vol_test_random() % MAX_DIM_SIZE + 1);
         } while (new_dims[i] > dims[i]);
         do {
-            chunk_dims[i] = (hsize_t)(rand() % MAX_DIM_SIZE + 1);
+            chunk_dims[i] = (hsize_t)(vol_test_random() % MAX_DIM_SIZE + 1);
         } while (chunk_dims[i] > dims[i]);
     }
 
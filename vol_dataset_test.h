@@ -212,6 +212,16 @@ int vol_dataset_test(void);
 #define DATASET_WRITE_INVALID_PARAMS_TEST_GROUP_NAME      "dataset_write_invalid_params_test"
 #define DATASET_WRITE_INVALID_PARAMS_TEST_DSET_NAME       "dataset_write_invalid_params_dset"
 
+#define DATASET_MULTI_IO_TEST_SPACE_RANK         2
+#define DATASET_MULTI_IO_TEST_NUM_DSETS          9
+#define DATASET_MULTI_IO_TEST_NUM_POINTS         10
+#define DATASET_MULTI_IO_TEST_DSET_VALUE_STRIDE  1000
+#define DATASET_MULTI_IO_TEST_SECOND_BASE        100
+#define DATASET_MULTI_IO_TEST_THIRD_BASE         200
+#define DATASET_MULTI_IO_TEST_DSET_NAME_BUF_SIZE 64
+#define DATASET_MULTI_IO_TEST_GROUP_NAME         "dataset_multi_io_test"
+#define DATASET_MULTI_IO_TEST_DSET_NAME          "dataset_multi_io_dset"
+
 #define DATASET_DATA_BUILTIN_CONVERSION_TEST_DSET_SPACE_RANK 3
 #define DATASET_DATA_BUILTIN_CONVERSION_TEST_MEM_DTYPESIZE   sizeof(int)
 #define DATASET_DATA_BUILTIN_CONVERSION_TEST_MEM_DTYPE       H5T_NATIVE_INT
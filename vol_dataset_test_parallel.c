@@ -36,6 +36,7 @@ static int test_read_dataset_point_file_all_mem(void);
 static int test_read_dataset_all_file_point_mem(void);
 static int test_read_dataset_hyper_file_point_mem(void);
 static int test_read_dataset_point_file_hyper_mem(void);
+static int test_write_read_multi_dataset_collective(void);
 
 /*
  * Chunking tests
@@ -69,6 +70,7 @@ static int (*par_dataset_tests[])(void) = {
     test_read_dataset_all_file_point_mem,
     test_read_dataset_hyper_file_point_mem,
     test_read_dataset_point_file_hyper_mem,
+    test_write_read_multi_dataset_collective,
     test_write_multi_chunk_dataset_same_shape_read,
     test_write_multi_chunk_dataset_diff_shape_read,
     test_overwrite_multi_chunk_dataset_same_shape_read,
@@ -6141,6 +6143,335 @@ error:
     return 1;
 }
 
+/*
+ * A test to ensure that data written to several datasets at once
+ * with a collective H5Dwrite_multi call matches the data written
+ * to an identical set of datasets by calling H5Dwrite on each in
+ * turn. Each MPI rank writes a row of each dataset, and all of the
+ * datasets are then read back with a single collective call to
+ * H5Dread_multi. The datasets have a mix of element types.
+ */
+#define DATASET_MULTI_IO_COLLECTIVE_TEST_SPACE_RANK   2
+#define DATASET_MULTI_IO_COLLECTIVE_TEST_NUM_DSETS    6
+#define DATASET_MULTI_IO_COLLECTIVE_TEST_VALUE_STRIDE 1000
+#define DATASET_MULTI_IO_COLLECTIVE_TEST_NAME_BUF_LEN 64
+#define DATASET_MULTI_IO_COLLECTIVE_TEST_GROUP_NAME   "multi_dataset_collective_io_test"
+#define DATASET_MULTI_IO_COLLECTIVE_TEST_MULTI_NAME   "multi_write_dset"
+#define DATASET_MULTI_IO_COLLECTIVE_TEST_SINGLE_NAME  "single_write_dset"
+static int
+test_write_read_multi_dataset_collective(void)
+{
+    hsize_t    *dims = NULL;
+    hsize_t     start[DATASET_MULTI_IO_COLLECTIVE_TEST_SPACE_RANK];
+    hsize_t     count[DATASET_MULTI_IO_COLLECTIVE_TEST_SPACE_RANK];
+    size_t      i, j;
+    size_t      type_sizes[2 * DATASET_MULTI_IO_COLLECTIVE_TEST_NUM_DSETS];
+    hid_t       file_id         = H5I_INVALID_HID;
+    hid_t       fapl_id         = H5I_INVALID_HID;
+    hid_t       dxpl_id         = H5I_INVALID_HID;
+    hid_t       container_group = H5I_INVALID_HID, group_id = H5I_INVALID_HID;
+    hid_t       fspace_id = H5I_INVALID_HID;
+    hid_t       mspace_id = H5I_INVALID_HID;
+    hid_t       dset_ids[2 * DATASET_MULTI_IO_COLLECTIVE_TEST_NUM_DSETS];
+    hid_t       type_ids[2 * DATASET_MULTI_IO_COLLECTIVE_TEST_NUM_DSETS];
+    hid_t       mspace_ids[2 * DATASET_MULTI_IO_COLLECTIVE_TEST_NUM_DSETS];
+    hid_t       fspace_ids[2 * DATASET_MULTI_IO_COLLECTIVE_TEST_NUM_DSETS];
+    void       *write_bufs[DATASET_MULTI_IO_COLLECTIVE_TEST_NUM_DSETS];
+    void       *read_bufs[2 * DATASET_MULTI_IO_COLLECTIVE_TEST_NUM_DSETS];
+    const void *const_write_bufs[DATASET_MULTI_IO_COLLECTIVE_TEST_NUM_DSETS];
+
+    for (i = 0; i < 2 * DATASET_MULTI_IO_COLLECTIVE_TEST_NUM_DSETS; i++) {
+        dset_ids[i]  = H5I_INVALID_HID;
+        read_bufs[i] = NULL;
+        if (i < DATASET_MULTI_IO_COLLECTIVE_TEST_NUM_DSETS)
+            write_bufs[i] = NULL;
+    }
+
+    TESTING("collective multi-dataset I/O with H5Dwrite_multi and H5Dread_multi");
+
+    /* Make sure the connector supports the API functions being tested */
+    if (!(vol_cap_flags_g & H5VL_CAP_FLAG_FILE_BASIC) || !(vol_cap_flags_g & H5VL_CAP_FLAG_GROUP_BASIC) ||
+        !(vol_cap_flags_g & H5VL_CAP_FLAG_DATASET_BASIC)) {
+        SKIPPED();
+        HDprintf(
+            "    API functions for basic file, group, or dataset aren't supported with this connector\n");
+        return 0;
+    }
+
+    if ((fapl_id = create_mpi_fapl(MPI_COMM_WORLD, MPI_INFO_NULL, TRUE)) < 0)
+        TEST_ERROR;
+
+    if ((dxpl_id = H5Pcreate(H5P_DATASET_XFER)) < 0)
+        TEST_ERROR;
+    if (H5Pset_dxpl_mpio(dxpl_id, H5FD_MPIO_COLLECTIVE) < 0) {
+        H5_FAILED();
+        HDprintf("    couldn't set collective I/O on DXPL\n");
+        goto error;
+    }
+
+    if ((file_id = H5Fopen(vol_test_parallel_filename, H5F_ACC_RDWR, fapl_id)) < 0) {
+        H5_FAILED();
+        HDprintf("    couldn't open file '%s'\n", vol_test_parallel_filename);
+        goto error;
+    }
+
+    if ((container_group = H5Gopen2(file_id, DATASET_TEST_GROUP_NAME, H5P_DEFAULT)) < 0) {
+        H5_FAILED();
+        HDprintf("    couldn't open container group '%s'\n", DATASET_TEST_GROUP_NAME);
+        goto error;
+    }
+
+    if ((group_id = H5Gcreate2(container_group, DATASET_MULTI_IO_COLLECTIVE_TEST_GROUP_NAME, H5P_DEFAULT,
+                               H5P_DEFAULT, H5P_DEFAULT)) < 0) {
+        H5_FAILED();
+        HDprintf("    couldn't create container sub-group '%s'\n",
+                 DATASET_MULTI_IO_COLLECTIVE_TEST_GROUP_NAME);
+        goto error;
+    }
+
+    if (generate_random_parallel_dimensions(DATASET_MULTI_IO_COLLECTIVE_TEST_SPACE_RANK, &dims) < 0)
+        TEST_ERROR;
+
+    if ((fspace_id = H5Screate_simple(DATASET_MULTI_IO_COLLECTIVE_TEST_SPACE_RANK, dims, NULL)) < 0)
+        TEST_ERROR;
+    if ((mspace_id = H5Screate_simple(1, &dims[1], NULL)) < 0)
+        TEST_ERROR;
+
+    /*
+     * The first half of the datasets are written with H5Dwrite_multi
+     * and the second half, which match the first in type, are written
+     * with H5Dwrite.
+     */
+    for (i = 0; i < 2 * DATASET_MULTI_IO_COLLECTIVE_TEST_NUM_DSETS; i++) {
+        char   dset_name[DATASET_MULTI_IO_COLLECTIVE_TEST_NAME_BUF_LEN];
+        size_t idx = i % DATASET_MULTI_IO_COLLECTIVE_TEST_NUM_DSETS;
+
+        switch (idx % 3) {
+            case 0:
+                type_ids[i]   = H5T_NATIVE_INT;
+                type_sizes[i] = sizeof(int);
+                break;
+            case 1:
+                type_ids[i]   = H5T_NATIVE_DOUBLE;
+                type_sizes[i] = sizeof(double);
+                break;
+            default:
+                type_ids[i]   = H5T_NATIVE_SHORT;
+                type_sizes[i] = sizeof(short);
+                break;
+        }
+
+        HDsnprintf(dset_name, DATASET_MULTI_IO_COLLECTIVE_TEST_NAME_BUF_LEN, "%s%zu",
+                   (i < DATASET_MULTI_IO_COLLECTIVE_TEST_NUM_DSETS)
+                       ? DATASET_MULTI_IO_COLLECTIVE_TEST_MULTI_NAME
+                       : DATASET_MULTI_IO_COLLECTIVE_TEST_SINGLE_NAME,
+                   idx);
+
+        if ((dset_ids[i] = H5Dcreate2(group_id, dset_name, type_ids[i], fspace_id, H5P_DEFAULT, H5P_DEFAULT,
+                                      H5P_DEFAULT)) < 0) {
+            H5_FAILED();
+            HDprintf("    couldn't create dataset '%s'\n", dset_name);
+            goto error;
+        }
+
+        mspace_ids[i] = mspace_id;
+        fspace_ids[i] = fspace_id;
+    }
+
+    /* Each rank writes its own row of every dataset */
+    start[0] = (hsize_t)mpi_rank;
+    start[1] = 0;
+    count[0] = 1;
+    count[1] = dims[1];
+
+    if (H5Sselect_hyperslab(fspace_id, H5S_SELECT_SET, start, NULL, count, NULL) < 0) {
+        H5_FAILED();
+        HDprintf("    couldn't select hyperslab for dataset write\n");
+        goto error;
+    }
+
+    for (i = 0; i < DATASET_MULTI_IO_COLLECTIVE_TEST_NUM_DSETS; i++) {
+        if (NULL == (write_bufs[i] = HDmalloc((size_t)dims[1] * type_sizes[i]))) {
+            H5_FAILED();
+            HDprintf("    couldn't allocate buffer for dataset write\n");
+            goto error;
+        }
+
+        for (j = 0; j < (size_t)dims[1]; j++) {
+            int value = (int)(i * DATASET_MULTI_IO_COLLECTIVE_TEST_VALUE_STRIDE) + (mpi_rank * MAX_DIM_SIZE) +
+                        (int)j;
+
+            switch (i % 3) {
+                case 0:
+                    ((int *)write_bufs[i])[j] = value;
+                    break;
+                case 1:
+                    ((double *)write_bufs[i])[j] = (double)value;
+                    break;
+                default:
+                    ((short *)write_bufs[i])[j] = (short)value;
+                    break;
+            }
+        }
+
+        const_write_bufs[i] = write_bufs[i];
+    }
+
+    if (H5Dwrite_multi(DATASET_MULTI_IO_COLLECTIVE_TEST_NUM_DSETS, dset_ids, type_ids, mspace_ids, fspace_ids,
+                       dxpl_id, const_write_bufs) < 0) {
+        H5_FAILED();
+        HDprintf("    couldn't write to datasets with H5Dwrite_multi\n");
+        goto error;
+    }
+
+    for (i = 0; i < DATASET_MULTI_IO_COLLECTIVE_TEST_NUM_DSETS; i++) {
+        size_t single_idx = i + DATASET_MULTI_IO_COLLECTIVE_TEST_NUM_DSETS;
+
+        if (H5Dwrite(dset_ids[single_idx], type_ids[single_idx], mspace_id, fspace_id, dxpl_id,
+                     write_bufs[i]) < 0) {
+            H5_FAILED();
+            HDprintf("    couldn't write to dataset with H5Dwrite\n");
+            goto error;
+        }
+    }
+
+    /*
+     * Close and re-open the datasets to ensure that the data gets written.
+     */
+    for (i = 0; i < 2 * DATASET_MULTI_IO_COLLECTIVE_TEST_NUM_DSETS; i++) {
+        char dset_name[DATASET_MULTI_IO_COLLECTIVE_TEST_NAME_BUF_LEN];
+
+        if (H5Dclose(dset_ids[i]) < 0) {
+            H5_FAILED();
+            HDprintf("    failed to close dataset\n");
+            goto error;
+        }
+
+        HDsnprintf(dset_name, DATASET_MULTI_IO_COLLECTIVE_TEST_NAME_BUF_LEN, "%s%zu",
+                   (i < DATASET_MULTI_IO_COLLECTIVE_TEST_NUM_DSETS)
+                       ? DATASET_MULTI_IO_COLLECTIVE_TEST_MULTI_NAME
+                       : DATASET_MULTI_IO_COLLECTIVE_TEST_SINGLE_NAME,
+                   i % DATASET_MULTI_IO_COLLECTIVE_TEST_NUM_DSETS);
+
+        if ((dset_ids[i] = H5Dopen2(group_id, dset_name, H5P_DEFAULT)) < 0) {
+            H5_FAILED();
+            HDprintf("    couldn't open dataset '%s'\n", dset_name);
+            goto error;
+        }
+
+        if (NULL == (read_bufs[i] = HDcalloc(1, (size_t)(dims[0] * dims[1]) * type_sizes[i]))) {
+            H5_FAILED();
+            HDprintf("    couldn't allocate buffer for dataset read\n");
+            goto error;
+        }
+
+        mspace_ids[i] = H5S_ALL;
+        fspace_ids[i] = H5S_ALL;
+    }
+
+    if (H5Dread_multi(2 * DATASET_MULTI_IO_COLLECTIVE_TEST_NUM_DSETS, dset_ids, type_ids, mspace_ids,
+                      fspace_ids, dxpl_id, read_bufs) < 0) {
+        H5_FAILED();
+        HDprintf("    couldn't read from datasets with H5Dread_multi\n");
+        goto error;
+    }
+
+    for (i = 0; i < DATASET_MULTI_IO_COLLECTIVE_TEST_NUM_DSETS; i++) {
+        size_t single_idx = i + DATASET_MULTI_IO_COLLECTIVE_TEST_NUM_DSETS;
+
+        if (HDmemcmp(read_bufs[i], read_bufs[single_idx], (size_t)(dims[0] * dims[1]) * type_sizes[i])) {
+            H5_FAILED();
+            HDprintf("    data written with H5Dwrite_multi didn't match data written with H5Dwrite\n");
+            goto error;
+        }
+
+        for (j = 0; j < (size_t)(dims[0] * dims[1]); j++) {
+            int    expected = (int)(i * DATASET_MULTI_IO_COLLECTIVE_TEST_VALUE_STRIDE) +
+                           (int)((j / dims[1]) * MAX_DIM_SIZE) + (int)(j % dims[1]);
+            double actual;
+
+            switch (i % 3) {
+                case 0:
+                    actual = (double)((int *)read_bufs[i])[j];
+                    break;
+                case 1:
+                    actual = ((double *)read_bufs[i])[j];
+                    break;
+                default:
+                    expected = (int)(short)expected;
+                    actual   = (double)((short *)read_bufs[i])[j];
+                    break;
+            }
+
+            if (actual != (double)expected) {
+                H5_FAILED();
+                HDprintf("    data verification failed\n");
+                goto error;
+            }
+        }
+    }
+
+    for (i = 0; i < 2 * DATASET_MULTI_IO_COLLECTIVE_TEST_NUM_DSETS; i++) {
+        HDfree(read_bufs[i]);
+        read_bufs[i] = NULL;
+        if (i < DATASET_MULTI_IO_COLLECTIVE_TEST_NUM_DSETS) {
+            HDfree(write_bufs[i]);
+            write_bufs[i] = NULL;
+        }
+
+        if (H5Dclose(dset_ids[i]) < 0)
+            TEST_ERROR;
+        dset_ids[i] = H5I_INVALID_HID;
+    }
+
+    if (dims) {
+        HDfree(dims);
+        dims = NULL;
+    }
+
+    if (H5Sclose(mspace_id) < 0)
+        TEST_ERROR;
+    if (H5Sclose(fspace_id) < 0)
+        TEST_ERROR;
+    if (H5Gclose(group_id) < 0)
+        TEST_ERROR;
+    if (H5Gclose(container_group) < 0)
+        TEST_ERROR;
+    if (H5Pclose(dxpl_id) < 0)
+        TEST_ERROR;
+    if (H5Pclose(fapl_id) < 0)
+        TEST_ERROR;
+    if (H5Fclose(file_id) < 0)
+        TEST_ERROR;
+
+    PASSED();
+
+    return 0;
+
+error:
+    H5E_BEGIN_TRY
+    {
+        for (i = 0; i < 2 * DATASET_MULTI_IO_COLLECTIVE_TEST_NUM_DSETS; i++) {
+            HDfree(read_bufs[i]);
+            if (i < DATASET_MULTI_IO_COLLECTIVE_TEST_NUM_DSETS)
+                HDfree(write_bufs[i]);
+            H5Dclose(dset_ids[i]);
+        }
+        if (dims)
+            HDfree(dims);
+        H5Sclose(mspace_id);
+        H5Sclose(fspace_id);
+        H5Gclose(group_id);
+        H5Gclose(container_group);
+        H5Pclose(dxpl_id);
+        H5Pclose(fapl_id);
+        H5Fclose(file_id);
+    }
+    H5E_END_TRY;
+
+    return 1;
+}
+
 /*
  * A test to check that a dataset composed of multiple chunks
  * can be written and read correctly. When reading back the
@@ -0,0 +1,424 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * Copyright by The HDF Group.                                               *
+ * All rights reserved.                                                      *
+ *                                                                           *
+ * This file is part of HDF5.  The full HDF5 copyright notice, including     *
+ * terms governing use, modification, and redistribution, is contained in    *
+ * the COPYING file, which can be found at the root of the source code       *
+ * distribution tree, or in https://support.hdfgroup.org/ftp/HDF5/releases.  *
+ * If you do not have access to either file, you may request a copy from     *
+ * help@hdfgroup.org.                                                        *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+
+/*
+ * Benchmarks for group metadata operations at scale. For each group
+ * count given with --group-counts and each depth given with
+ * --group-depths, that many groups are created in a single parent
+ * group nested that many levels below a top-level group, and are then
+ * opened, queried with H5Gget_info_by_name and iterated over with
+ * H5Literate2. Every operation addresses its group by a path relative
+ * to the top-level group, so deeper groups also measure the cost of
+ * traversing the intermediate groups.
+ *
+ * Each configuration is run with the links in the parent group held
+ * in compact storage (as long as the group count fits) and in dense
+ * storage, set with H5Pset_link_phase_change. The file is opened with
+ * the latest library version bounds, as the native connector otherwise
+ * creates groups that use a symbol table rather than either of these.
+ * Along with the usual
+ * results, a histogram of the latency of each operation is printed,
+ * so that operations which slow down as a group grows stand out.
+ */
+
+#include "vol_group_bench.h"
+
+/* The groups created for a single configuration */
+typedef struct group_bench_config_t {
+    hsize_t ngroups;
+    hsize_t depth;
+    hbool_t dense;
+    char   *parent_path; /* Path of the parent group, relative to the top-level group */
+    char   *path;        /* Buffer for the path of a single group */
+    size_t  path_len;
+} group_bench_config_t;
+
+typedef struct group_bench_iter_ud_t {
+    vol_bench_stats_t *stats;
+    double             last;
+    hsize_t            nlinks;
+} group_bench_iter_ud_t;
+
+/*
+ * Returns the path of the given group, relative to the top-level group.
+ */
+static const char *
+group_bench_path(group_bench_config_t *config, hsize_t idx)
+{
+    HDsnprintf(config->path, config->path_len, "%s/g%llu", config->parent_path, (unsigned long long)idx);
+
+    return config->path;
+}
+
+static void
+group_bench_report(const char *op, group_bench_config_t *config, vol_bench_stats_t *stats)
+{
+    char name[GROUP_BENCH_NAME_LENGTH];
+
+    HDsnprintf(name, sizeof(name), "%s %llu depth %llu %s", op, (unsigned long long)config->ngroups,
+               (unsigned long long)config->depth, config->dense ? "dense" : "compact");
+
+    vol_bench_report("group", name, 0, stats);
+    vol_bench_stats_histogram(stats);
+}
+
+/*
+ * Times each step of H5Literate2 as the time since the previous
+ * link was visited, or since the iteration began for the first link.
+ */
+static herr_t
+group_bench_iter_cb(hid_t group_id, const char *name, const H5L_info2_t *info, void *op_data)
+{
+    group_bench_iter_ud_t *udata = (group_bench_iter_ud_t *)op_data;
+    double                 now   = vol_bench_now();
+
+    (void)group_id;
+    (void)name;
+    (void)info;
+
+    if (vol_bench_stats_add(udata->stats, now - udata->last) < 0)
+        return H5_ITER_ERROR;
+
+    udata->last = now;
+    udata->nlinks++;
+
+    return H5_ITER_CONT;
+}
+
+/*
+ * Creates the chain of groups leading down to the parent group of a
+ * configuration, with the parent group's link storage set as requested.
+ */
+static herr_t
+group_bench_create_parent(hid_t top_id, group_bench_config_t *config)
+{
+    hid_t  gcpl_id  = H5I_INVALID_HID;
+    hid_t  group_id = H5I_INVALID_HID;
+    size_t len      = 0;
+
+    if ((gcpl_id = H5Pcreate(H5P_GROUP_CREATE)) < 0)
+        BENCH_ERROR;
+
+    if (config->dense) {
+        if (H5Pset_link_phase_change(gcpl_id, 0, 0) < 0) {
+            HDprintf("    couldn't set link phase change on GCPL\n");
+            BENCH_ERROR;
+        }
+    }
+    else {
+        if (H5Pset_link_phase_change(gcpl_id, GROUP_BENCH_MAX_COMPACT, GROUP_BENCH_MAX_COMPACT - 1) < 0) {
+            HDprintf("    couldn't set link phase change on GCPL\n");
+            BENCH_ERROR;
+        }
+    }
+
+    config->parent_path[0] = '\0';
+
+    for (hsize_t i = 1; i <= config->depth; i++) {
+        len += (size_t)HDsnprintf(config->parent_path + len, config->path_len - len, "%sd%llu",
+                                  (i > 1) ? "/" : "", (unsigned long long)i);
+
+        if ((group_id = H5Gcreate2(top_id, config->parent_path, H5P_DEFAULT,
+                                   (i == config->depth) ? gcpl_id : H5P_DEFAULT, H5P_DEFAULT)) < 0) {
+            HDprintf("    couldn't create group '%s'\n", config->parent_path);
+            BENCH_ERROR;
+        }
+
+        if (H5Gclose(group_id) < 0)
+            BENCH_ERROR;
+        group_id = H5I_INVALID_HID;
+    }
+
+    if (H5Pclose(gcpl_id) < 0)
+        BENCH_ERROR;
+
+    return SUCCEED;
+
+error:
+    H5E_BEGIN_TRY
+    {
+        H5Gclose(group_id);
+        H5Pclose(gcpl_id);
+    }
+    H5E_END_TRY;
+
+    return FAIL;
+}
+
+/*
+ * Creates the groups of a single configuration under the given
+ * top-level group, then opens, queries and iterates over them.
+ */
+static int
+group_bench_config(hid_t top_id, group_bench_config_t *config)
+{
+    group_bench_iter_ud_t iter_udata;
+    vol_bench_stats_t     stats;
+    H5G_info_t            group_info;
+    hid_t                 group_id  = H5I_INVALID_HID;
+    hid_t                 parent_id = H5I_INVALID_HID;
+
+    vol_bench_stats_init(&stats);
+
+    if (group_bench_create_parent(top_id, config) < 0)
+        BENCH_ERROR;
+
+    for (hsize_t i = 0; i < config->ngroups; i++) {
+        const char *path = group_bench_path(config, i);
+        double      t0   = vol_bench_now();
+
+        if ((group_id = H5Gcreate2(top_id, path, H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT)) < 0) {
+            HDprintf("    couldn't create group '%s'\n", path);
+            BENCH_ERROR;
+        }
+
+        if (vol_bench_stats_add(&stats, vol_bench_now() - t0) < 0)
+            BENCH_ERROR;
+
+        if (H5Gclose(group_id) < 0)
+            BENCH_ERROR;
+        group_id = H5I_INVALID_HID;
+    }
+
+    group_bench_report("create", config, &stats);
+    vol_bench_stats_free(&stats);
+
+    for (unsigned n = 0; n < vol_bench_params_g.iterations; n++)
+        for (hsize_t i = 0; i < config->ngroups; i++) {
+            const char *path = group_bench_path(config, i);
+            double      t0   = vol_bench_now();
+
+            if ((group_id = H5Gopen2(top_id, path, H5P_DEFAULT)) < 0) {
+                HDprintf("    couldn't open group '%s'\n", path);
+                BENCH_ERROR;
+            }
+
+            if (vol_bench_stats_add(&stats, vol_bench_now() - t0) < 0)
+                BENCH_ERROR;
+
+            if (H5Gclose(group_id) < 0)
+                BENCH_ERROR;
+            group_id = H5I_INVALID_HID;
+        }
+
+    group_bench_report("open", config, &stats);
+    vol_bench_stats_free(&stats);
+
+    for (unsigned n = 0; n < vol_bench_params_g.iterations; n++)
+        for (hsize_t i = 0; i < config->ngroups; i++) {
+            const char *path = group_bench_path(config, i);
+            double      t0   = vol_bench_now();
+
+            if (H5Gget_info_by_name(top_id, path, &group_info, H5P_DEFAULT) < 0) {
+                HDprintf("    couldn't retrieve info for group '%s'\n", path);
+                BENCH_ERROR;
+            }
+
+            if (vol_bench_stats_add(&stats, vol_bench_now() - t0) < 0)
+                BENCH_ERROR;
+        }
+
+    group_bench_report("info", config, &stats);
+    vol_bench_stats_free(&stats);
+
+    if ((parent_id = H5Gopen2(top_id, config->parent_path, H5P_DEFAULT)) < 0) {
+        HDprintf("    couldn't open group '%s'\n", config->parent_path);
+        BENCH_ERROR;
+    }
+
+    if (H5Gget_info(parent_id, &group_info) < 0) {
+        HDprintf("    couldn't retrieve info for group '%s'\n", config->parent_path);
+        BENCH_ERROR;
+    }
+
+    if (group_info.nlinks != config->ngroups) {
+        HDprintf("    group '%s' had %llu links instead of %llu\n", config->parent_path,
+                 (unsigned long long)group_info.nlinks, (unsigned long long)config->ngroups);
+        BENCH_ERROR;
+    }
+
+    /* Connectors that don't use these storage types may not report them */
+    if (vol_bench_params_g.verify && group_info.storage_type != H5G_STORAGE_TYPE_UNKNOWN &&
+        group_info.storage_type != (config->dense ? H5G_STORAGE_TYPE_DENSE : H5G_STORAGE_TYPE_COMPACT)) {
+        HDprintf("    group '%s' didn't use %s link storage\n", config->parent_path,
+                 config->dense ? "dense" : "compact");
+        BENCH_ERROR;
+    }
+
+    for (unsigned n = 0; n < vol_bench_params_g.iterations; n++) {
+        iter_udata.stats  = &stats;
+        iter_udata.nlinks = 0;
+        iter_udata.last   = vol_bench_now();
+
+        if (H5Literate2(parent_id, H5_INDEX_NAME, H5_ITER_NATIVE, NULL, group_bench_iter_cb, &iter_udata) <
+            0) {
+            HDprintf("    couldn't iterate over links in group '%s'\n", config->parent_path);
+            BENCH_ERROR;
+        }
+
+        if (iter_udata.nlinks != config->ngroups) {
+            HDprintf("    iteration over group '%s' visited %llu links instead of %llu\n",
+                     config->parent_path, (unsigned long long)iter_udata.nlinks,
+                     (unsigned long long)config->ngroups);
+            BENCH_ERROR;
+        }
+    }
+
+    group_bench_report("iterate", config, &stats);
+    vol_bench_stats_free(&stats);
+
+    if (H5Gclose(parent_id) < 0)
+        BENCH_ERROR;
+
+    return 0;
+
+error:
+    H5E_BEGIN_TRY
+    {
+        H5Gclose(group_id);
+        H5Gclose(parent_id);
+    }
+    H5E_END_TRY;
+
+    vol_bench_stats_free(&stats);
+
+    return 1;
+}
+
+int
+vol_group_bench(void)
+{
+    group_bench_config_t config;
+    hsize_t              group_counts[VOL_BENCH_MAX_LIST_VALUES];
+    hsize_t              group_depths[VOL_BENCH_MAX_LIST_VALUES];
+    size_t               ngroup_counts, ngroup_depths;
+    int                  nerrors  = 0;
+    hid_t                fapl_id  = H5I_INVALID_HID;
+    hid_t                file_id  = H5I_INVALID_HID;
+    hid_t                group_id = H5I_INVALID_HID;
+    hid_t                top_id   = H5I_INVALID_HID;
+
+    HDmemset(&config, 0, sizeof(config));
+
+    HDprintf("**********************************************\n");
+    HDprintf("*                                            *\n");
+    HDprintf("*           VOL Group Benchmarks             *\n");
+    HDprintf("*                                            *\n");
+    HDprintf("**********************************************\n\n");
+
+    /* Make sure the connector supports the API functions being benchmarked */
+    if (!(vol_cap_flags_g & H5VL_CAP_FLAG_FILE_BASIC) || !(vol_cap_flags_g & H5VL_CAP_FLAG_GROUP_BASIC) ||
+        !(vol_cap_flags_g & H5VL_CAP_FLAG_GROUP_MORE) || !(vol_cap_flags_g & H5VL_CAP_FLAG_LINK_BASIC) ||
+        !(vol_cap_flags_g & H5VL_CAP_FLAG_ITERATE)) {
+        BENCH_SKIPPED("group metadata operations",
+                      "API functions for basic file, group, link, or iterate aren't supported with this "
+                      "connector");
+        HDprintf("\n");
+        return 0;
+    }
+
+    /* These were checked when the command line was parsed */
+    if (vol_bench_parse_size_list(vol_bench_params_g.group_counts, group_counts, &ngroup_counts) < 0 ||
+        vol_bench_parse_size_list(vol_bench_params_g.group_depths, group_depths, &ngroup_depths) < 0)
+        BENCH_ERROR;
+
+    if ((fapl_id = H5Pcreate(H5P_FILE_ACCESS)) < 0)
+        BENCH_ERROR;
+
+    if (H5Pset_libver_bounds(fapl_id, H5F_LIBVER_LATEST, H5F_LIBVER_LATEST) < 0) {
+        HDprintf("    couldn't set library version bounds on FAPL\n");
+        BENCH_ERROR;
+    }
+
+    if ((file_id = H5Fopen(vol_bench_filename, H5F_ACC_RDWR, fapl_id)) < 0) {
+        HDprintf("    couldn't open file '%s'\n", vol_bench_filename);
+        BENCH_ERROR;
+    }
+
+    if ((group_id = H5Gcreate2(file_id, GROUP_BENCH_GROUP_NAME, H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT)) < 0) {
+        HDprintf("    couldn't create container group '%s'\n", GROUP_BENCH_GROUP_NAME);
+        BENCH_ERROR;
+    }
+
+    for (size_t i = 0; i < ngroup_counts; i++)
+        for (size_t j = 0; j < ngroup_depths; j++)
+            for (int dense = 0; dense <= 1; dense++) {
+                char top_name[GROUP_BENCH_NAME_LENGTH];
+
+                config.ngroups = group_counts[i];
+                config.depth   = group_depths[j];
+                config.dense   = (hbool_t)dense;
+
+                if (!dense && config.ngroups > GROUP_BENCH_MAX_COMPACT) {
+                    HDsnprintf(top_name, sizeof(top_name), "groups %llu depth %llu compact",
+                               (unsigned long long)config.ngroups, (unsigned long long)config.depth);
+                    BENCH_SKIPPED(top_name, "too many groups to fit in compact link storage");
+                    continue;
+                }
+
+                /* Each level of the path is "dN/", followed by the name of a group */
+                config.path_len = (size_t)config.depth * (GROUP_BENCH_LINK_NAME_LENGTH + 2) +
+                                  GROUP_BENCH_LINK_NAME_LENGTH;
+                if (NULL == (config.parent_path = HDmalloc(config.path_len)))
+                    BENCH_ERROR;
+                if (NULL == (config.path = HDmalloc(config.path_len)))
+                    BENCH_ERROR;
+
+                /* Give each configuration its own top-level group */
+                HDsnprintf(top_name, sizeof(top_name), "groups_%zu_%zu_%s", i, j, dense ? "dense" : "compact");
+
+                if ((top_id = H5Gcreate2(group_id, top_name, H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT)) < 0) {
+                    HDprintf("    couldn't create group '%s'\n", top_name);
+                    BENCH_ERROR;
+                }
+
+                nerrors += group_bench_config(top_id, &config);
+
+                if (H5Gclose(top_id) < 0)
+                    BENCH_ERROR;
+                top_id = H5I_INVALID_HID;
+
+                HDfree(config.parent_path);
+                HDfree(config.path);
+                config.parent_path = NULL;
+                config.path        = NULL;
+            }
+
+    if (H5Gclose(group_id) < 0)
+        BENCH_ERROR;
+    if (H5Fclose(file_id) < 0)
+        BENCH_ERROR;
+    if (H5Pclose(fapl_id) < 0)
+        BENCH_ERROR;
+
+    HDprintf("\n");
+
+    return nerrors;
+
+error:
+    HDfree(config.parent_path);
+    HDfree(config.path);
+
+    H5E_BEGIN_TRY
+    {
+        H5Gclose(top_id);
+        H5Gclose(group_id);
+        H5Fclose(file_id);
+        H5Pclose(fapl_id);
+    }
+    H5E_END_TRY;
+
+    HDprintf("\n");
+
+    return nerrors + 1;
+}
@@ -0,0 +1,35 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * Copyright by The HDF Group.                                               *
+ * All rights reserved.                                                      *
+ *                                                                           *
+ * This file is part of HDF5.  The full HDF5 copyright notice, including     *
+ * terms governing use, modification, and redistribution, is contained in    *
+ * the COPYING file, which can be found at the root of the source code       *
+ * distribution tree, or in https://support.hdfgroup.org/ftp/HDF5/releases.  *
+ * If you do not have access to either file, you may request a copy from     *
+ * help@hdfgroup.org.                                                        *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+
+#ifndef VOL_GROUP_BENCH_H
+#define VOL_GROUP_BENCH_H
+
+#include "vol_bench.h"
+
+int vol_group_bench(void);
+
+/************************************************
+ *                                              *
+ *      VOL connector Group benchmark defines   *
+ *                                              *
+ ************************************************/
+
+#define GROUP_BENCH_GROUP_NAME "group_bench"
+
+/* The largest number of links a group can hold in compact storage */
+#define GROUP_BENCH_MAX_COMPACT 65535
+
+#define GROUP_BENCH_LINK_NAME_LENGTH 32
+#define GROUP_BENCH_NAME_LENGTH      128
+
+#endif
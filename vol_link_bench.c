@@ -0,0 +1,613 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * Copyright by The HDF Group.                                               *
+ * All rights reserved.                                                      *
+ *                                                                           *
+ * This file is part of HDF5.  The full HDF5 copyright notice, including     *
+ * terms governing use, modification, and redistribution, is contained in    *
+ * the COPYING file, which can be found at the root of the source code       *
+ * distribution tree, or in https://support.hdfgroup.org/ftp/HDF5/releases.  *
+ * If you do not have access to either file, you may request a copy from     *
+ * help@hdfgroup.org.                                                        *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+
+/*
+ * Benchmarks for link traversal over large graphs of groups. The
+ * graph is a tree of groups, --link-depth levels deep below its
+ * top-level group, in which every group has --link-fanout child
+ * groups. On top of the tree, a --link-soft fraction of the groups
+ * are given a soft link to a randomly chosen group, a --link-external
+ * fraction are given an external link and a --link-cycles fraction
+ * are given a hard link back to the top of the graph, making cycles.
+ *
+ * Once the graph is built, the benchmarks iterate over the links in
+ * every group with H5Literate2, visit the whole graph with H5Lvisit2,
+ * for each of the name and (if supported) creation order indexes in
+ * both increasing and decreasing order, and then look up every link by
+ * its path with H5Lexists and H5Lget_info2.
+ */
+
+#include "vol_link_bench.h"
+
+/* The links that a group may have on top of those to its children */
+#define LINK_BENCH_HAS_SOFT     0x01
+#define LINK_BENCH_HAS_EXTERNAL 0x02
+#define LINK_BENCH_HAS_CYCLE    0x04
+
+/*
+ * The shape of a link graph. Groups are numbered level by level,
+ * starting from the top-level group, so the k-th group in level l
+ * is a child of group k / fanout in level l - 1.
+ */
+typedef struct link_bench_graph_t {
+    unsigned       fanout;
+    unsigned       depth;
+    hbool_t        crt_order;   /* Whether link creation order is tracked and indexed */
+    hsize_t        nnodes;      /* Number of groups, including the top-level group */
+    hsize_t        nlinks;      /* Number of links created */
+    hsize_t       *level_start; /* Number of the first group in each level */
+    unsigned char *extra;       /* The LINK_BENCH_HAS_* flags of each group */
+    unsigned      *digits;      /* Scratch space for building paths */
+    char          *path;        /* Buffer for the path of a link */
+    char          *target;      /* Buffer for the target of a soft link */
+    size_t         path_len;
+} link_bench_graph_t;
+
+/* The name and type of each kind of extra link */
+typedef struct link_bench_extra_link_t {
+    unsigned char flag;
+    const char   *name;
+    H5L_type_t    type;
+} link_bench_extra_link_t;
+
+static const link_bench_extra_link_t link_bench_extra_links[] = {
+    {LINK_BENCH_HAS_SOFT, LINK_BENCH_SOFT_LINK_NAME, H5L_TYPE_SOFT},
+    {LINK_BENCH_HAS_EXTERNAL, LINK_BENCH_EXTERNAL_LINK_NAME, H5L_TYPE_EXTERNAL},
+    {LINK_BENCH_HAS_CYCLE, LINK_BENCH_CYCLE_LINK_NAME, H5L_TYPE_HARD},
+};
+
+typedef struct link_bench_iter_ud_t {
+    vol_bench_stats_t *stats;
+    double             last;
+    hsize_t            nlinks;
+} link_bench_iter_ud_t;
+
+static const H5_index_t link_bench_index_types[] = {H5_INDEX_NAME, H5_INDEX_CRT_ORDER};
+static const char *const link_bench_index_names[] = {"name", "crt-order"};
+
+static const H5_iter_order_t link_bench_orders[]      = {H5_ITER_INC, H5_ITER_DEC};
+static const char *const     link_bench_order_names[] = {"inc", "dec"};
+
+static void
+link_bench_graph_free(link_bench_graph_t *graph)
+{
+    HDfree(graph->level_start);
+    HDfree(graph->extra);
+    HDfree(graph->digits);
+    HDfree(graph->path);
+    HDfree(graph->target);
+
+    HDmemset(graph, 0, sizeof(*graph));
+}
+
+static herr_t
+link_bench_graph_init(link_bench_graph_t *graph, hbool_t crt_order)
+{
+    hsize_t level_size = 1;
+
+    HDmemset(graph, 0, sizeof(*graph));
+
+    graph->fanout    = vol_bench_params_g.link_fanout;
+    graph->depth     = vol_bench_params_g.link_depth;
+    graph->crt_order = crt_order;
+
+    if (NULL == (graph->level_start = HDmalloc((graph->depth + 2) * sizeof(hsize_t))))
+        BENCH_ERROR;
+
+    for (unsigned l = 0; l <= graph->depth; l++) {
+        graph->level_start[l] = graph->nnodes;
+        graph->nnodes += level_size;
+
+        if (graph->nnodes > LINK_BENCH_MAX_NODES) {
+            HDprintf("    link graph with fanout %u and depth %u has too many groups\n", graph->fanout,
+                     graph->depth);
+            BENCH_ERROR;
+        }
+
+        level_size *= graph->fanout;
+    }
+    graph->level_start[graph->depth + 1] = graph->nnodes;
+
+    if (NULL == (graph->extra = HDcalloc((size_t)graph->nnodes, 1)))
+        BENCH_ERROR;
+    if (NULL == (graph->digits = HDmalloc(graph->depth * sizeof(unsigned))))
+        BENCH_ERROR;
+
+    /* Each level of a path is "g<n>/", followed by the absolute path of the graph or a link name */
+    graph->path_len = (size_t)graph->depth * 16 +
+                      sizeof("/" LINK_BENCH_GROUP_NAME "/" LINK_BENCH_GRAPH_NAME) +
+                      sizeof(LINK_BENCH_EXTERNAL_LINK_NAME) + 1;
+    if (NULL == (graph->path = HDmalloc(graph->path_len)))
+        BENCH_ERROR;
+    if (NULL == (graph->target = HDmalloc(graph->path_len)))
+        BENCH_ERROR;
+
+    return SUCCEED;
+
+error:
+    link_bench_graph_free(graph);
+
+    return FAIL;
+}
+
+/*
+ * Returns the level of the given group in the graph.
+ */
+static unsigned
+link_bench_level(const link_bench_graph_t *graph, hsize_t node)
+{
+    unsigned l = 0;
+
+    while (node >= graph->level_start[l + 1])
+        l++;
+
+    return l;
+}
+
+/*
+ * Builds the path, relative to the top-level group of the graph, of
+ * the given group or, if link_name isn't NULL, of the link of that
+ * name in the group. prefix is prepended to the path.
+ */
+static const char *
+link_bench_path(link_bench_graph_t *graph, char *buf, const char *prefix, hsize_t node, const char *link_name)
+{
+    unsigned level = link_bench_level(graph, node);
+    hsize_t  k     = node - graph->level_start[level];
+    size_t   len;
+
+    for (unsigned l = level; l > 0; l--) {
+        graph->digits[l - 1] = (unsigned)(k % graph->fanout);
+        k /= graph->fanout;
+    }
+
+    len = (size_t)HDsnprintf(buf, graph->path_len, "%s", prefix);
+    for (unsigned l = 0; l < level; l++)
+        len += (size_t)HDsnprintf(buf + len, graph->path_len - len, "%sg%u", (len > 0) ? "/" : "",
+                                  graph->digits[l]);
+
+    if (link_name)
+        HDsnprintf(buf + len, graph->path_len - len, "%s%s", (len > 0) ? "/" : "", link_name);
+    else if (len == 0)
+        HDsnprintf(buf, graph->path_len, ".");
+
+    return buf;
+}
+
+static void
+link_bench_report(const char *op, const link_bench_graph_t *graph, vol_bench_stats_t *stats)
+{
+    char name[LINK_BENCH_NAME_LENGTH];
+
+    HDsnprintf(name, sizeof(name), "%s fanout %u depth %u", op, graph->fanout, graph->depth);
+
+    vol_bench_report("link", name, 0, stats);
+}
+
+static hbool_t
+link_bench_chance(double fraction)
+{
+    return ((double)vol_test_random() / ((double)VOL_TEST_RANDOM_MAX + 1.0)) < fraction;
+}
+
+/*
+ * Times each step of H5Literate2 and H5Lvisit2 as the time since
+ * the previous link was visited, or since the operation began for
+ * the first link.
+ */
+static herr_t
+link_bench_iter_cb(hid_t group_id, const char *name, const H5L_info2_t *info, void *op_data)
+{
+    link_bench_iter_ud_t *udata = (link_bench_iter_ud_t *)op_data;
+    double                now   = vol_bench_now();
+
+    (void)group_id;
+    (void)name;
+    (void)info;
+
+    if (vol_bench_stats_add(udata->stats, now - udata->last) < 0)
+        return H5_ITER_ERROR;
+
+    udata->last = now;
+    udata->nlinks++;
+
+    return H5_ITER_CONT;
+}
+
+/*
+ * Creates every group of the graph below the top-level group,
+ * followed by the extra soft, external and hard links.
+ */
+static int
+link_bench_build(hid_t top_id, link_bench_graph_t *graph)
+{
+    vol_bench_stats_t stats;
+    hid_t             gcpl_id  = H5I_INVALID_HID;
+    hid_t             group_id = H5I_INVALID_HID;
+    double            soft_fraction;
+    double            external_fraction;
+
+    vol_bench_stats_init(&stats);
+
+    soft_fraction     = (vol_cap_flags_g & H5VL_CAP_FLAG_SOFT_LINKS) ? vol_bench_params_g.link_soft : 0.0;
+    external_fraction =
+        (vol_cap_flags_g & H5VL_CAP_FLAG_EXTERNAL_LINKS) ? vol_bench_params_g.link_external : 0.0;
+
+    if ((gcpl_id = H5Pcreate(H5P_GROUP_CREATE)) < 0)
+        BENCH_ERROR;
+
+    if (graph->crt_order &&
+        H5Pset_link_creation_order(gcpl_id, H5P_CRT_ORDER_TRACKED | H5P_CRT_ORDER_INDEXED) < 0) {
+        HDprintf("    couldn't set link creation order tracking on GCPL\n");
+        BENCH_ERROR;
+    }
+
+    for (hsize_t node = 1; node < graph->nnodes; node++) {
+        const char *path = link_bench_path(graph, graph->path, "", node, NULL);
+        double      t0   = vol_bench_now();
+
+        if ((group_id = H5Gcreate2(top_id, path, H5P_DEFAULT, gcpl_id, H5P_DEFAULT)) < 0) {
+            HDprintf("    couldn't create group '%s'\n", path);
+            BENCH_ERROR;
+        }
+
+        if (vol_bench_stats_add(&stats, vol_bench_now() - t0) < 0)
+            BENCH_ERROR;
+
+        if (H5Gclose(group_id) < 0)
+            BENCH_ERROR;
+        group_id = H5I_INVALID_HID;
+
+        graph->nlinks++;
+    }
+
+    for (hsize_t node = 0; node < graph->nnodes; node++) {
+        if (link_bench_chance(soft_fraction)) {
+            hsize_t     target_node = (hsize_t)vol_test_random() % graph->nnodes;
+            const char *path = link_bench_path(graph, graph->path, "", node, LINK_BENCH_SOFT_LINK_NAME);
+            const char *target =
+                link_bench_path(graph, graph->target, "/" LINK_BENCH_GROUP_NAME "/" LINK_BENCH_GRAPH_NAME,
+                                target_node, NULL);
+            double t0 = vol_bench_now();
+
+            if (H5Lcreate_soft(target, top_id, path, H5P_DEFAULT, H5P_DEFAULT) < 0) {
+                HDprintf("    couldn't create soft link '%s'\n", path);
+                BENCH_ERROR;
+            }
+
+            if (vol_bench_stats_add(&stats, vol_bench_now() - t0) < 0)
+                BENCH_ERROR;
+
+            graph->extra[node] |= LINK_BENCH_HAS_SOFT;
+            graph->nlinks++;
+        }
+
+        if (link_bench_chance(external_fraction)) {
+            const char *path = link_bench_path(graph, graph->path, "", node, LINK_BENCH_EXTERNAL_LINK_NAME);
+            double      t0   = vol_bench_now();
+
+            if (H5Lcreate_external(vol_bench_filename, "/" LINK_BENCH_GROUP_NAME, top_id, path, H5P_DEFAULT,
+                                   H5P_DEFAULT) < 0) {
+                HDprintf("    couldn't create external link '%s'\n", path);
+                BENCH_ERROR;
+            }
+
+            if (vol_bench_stats_add(&stats, vol_bench_now() - t0) < 0)
+                BENCH_ERROR;
+
+            graph->extra[node] |= LINK_BENCH_HAS_EXTERNAL;
+            graph->nlinks++;
+        }
+
+        /* A link from the top-level group back to itself would add nothing over the others */
+        if (node > 0 && link_bench_chance(vol_bench_params_g.link_cycles)) {
+            const char *path = link_bench_path(graph, graph->path, "", node, LINK_BENCH_CYCLE_LINK_NAME);
+            double      t0   = vol_bench_now();
+
+            if (H5Lcreate_hard(top_id, ".", top_id, path, H5P_DEFAULT, H5P_DEFAULT) < 0) {
+                HDprintf("    couldn't create hard link '%s'\n", path);
+                BENCH_ERROR;
+            }
+
+            if (vol_bench_stats_add(&stats, vol_bench_now() - t0) < 0)
+                BENCH_ERROR;
+
+            graph->extra[node] |= LINK_BENCH_HAS_CYCLE;
+            graph->nlinks++;
+        }
+    }
+
+    link_bench_report("create", graph, &stats);
+    vol_bench_stats_free(&stats);
+
+    if (H5Pclose(gcpl_id) < 0)
+        BENCH_ERROR;
+
+    return 0;
+
+error:
+    H5E_BEGIN_TRY
+    {
+        H5Gclose(group_id);
+        H5Pclose(gcpl_id);
+    }
+    H5E_END_TRY;
+
+    vol_bench_stats_free(&stats);
+
+    return 1;
+}
+
+/*
+ * Iterates over the links in every group of the graph with
+ * H5Literate2, or over the whole graph with H5Lvisit2, using
+ * the given index and order.
+ */
+static int
+link_bench_traverse(hid_t top_id, link_bench_graph_t *graph, size_t idx, size_t order, hbool_t visit)
+{
+    link_bench_iter_ud_t udata;
+    vol_bench_stats_t    stats;
+    hid_t                group_id = H5I_INVALID_HID;
+    char                 op[LINK_BENCH_NAME_LENGTH];
+
+    vol_bench_stats_init(&stats);
+
+    udata.stats = &stats;
+
+    for (unsigned n = 0; n < vol_bench_params_g.iterations; n++) {
+        udata.nlinks = 0;
+
+        if (visit) {
+            udata.last = vol_bench_now();
+
+            if (H5Lvisit2(top_id, link_bench_index_types[idx], link_bench_orders[order], link_bench_iter_cb,
+                          &udata) < 0) {
+                HDprintf("    couldn't visit links in graph\n");
+                BENCH_ERROR;
+            }
+        }
+        else {
+            for (hsize_t node = 0; node < graph->nnodes; node++) {
+                const char *path = link_bench_path(graph, graph->path, "", node, NULL);
+
+                if ((group_id = H5Gopen2(top_id, path, H5P_DEFAULT)) < 0) {
+                    HDprintf("    couldn't open group '%s'\n", path);
+                    BENCH_ERROR;
+                }
+
+                udata.last = vol_bench_now();
+
+                if (H5Literate2(group_id, link_bench_index_types[idx], link_bench_orders[order], NULL,
+                                link_bench_iter_cb, &udata) < 0) {
+                    HDprintf("    couldn't iterate over links in group '%s'\n", path);
+                    BENCH_ERROR;
+                }
+
+                if (H5Gclose(group_id) < 0)
+                    BENCH_ERROR;
+                group_id = H5I_INVALID_HID;
+            }
+        }
+
+        /*
+         * Visiting the graph lists the hard links back to its top without
+         * following them, so both operations should see every link once.
+         */
+        if (udata.nlinks != graph->nlinks) {
+            HDprintf("    %s %llu links instead of %llu\n",
+                     visit ? "H5Lvisit2 visited" : "H5Literate2 iterated over",
+                     (unsigned long long)udata.nlinks, (unsigned long long)graph->nlinks);
+            BENCH_ERROR;
+        }
+    }
+
+    HDsnprintf(op, sizeof(op), "%s %s-%s", visit ? "visit" : "iterate", link_bench_index_names[idx],
+               link_bench_order_names[order]);
+    link_bench_report(op, graph, &stats);
+    vol_bench_stats_free(&stats);
+
+    return 0;
+
+error:
+    H5E_BEGIN_TRY
+    {
+        H5Gclose(group_id);
+    }
+    H5E_END_TRY;
+
+    vol_bench_stats_free(&stats);
+
+    return 1;
+}
+
+/*
+ * Looks up the link at the given path with H5Lexists or H5Lget_info2,
+ * adding the time taken to the given stats.
+ */
+static herr_t
+link_bench_lookup(hid_t top_id, const char *path, H5L_type_t type, hbool_t get_info, vol_bench_stats_t *stats)
+{
+    H5L_info2_t link_info;
+    htri_t      exists = TRUE;
+    herr_t      err    = SUCCEED;
+    double      t0     = vol_bench_now();
+
+    if (get_info)
+        err = H5Lget_info2(top_id, path, &link_info, H5P_DEFAULT);
+    else
+        exists = H5Lexists(top_id, path, H5P_DEFAULT);
+
+    if (vol_bench_stats_add(stats, vol_bench_now() - t0) < 0)
+        return FAIL;
+
+    if (err < 0 || exists <= 0) {
+        HDprintf("    couldn't %s link '%s'\n", get_info ? "retrieve info for" : "find", path);
+        return FAIL;
+    }
+
+    if (get_info && vol_bench_params_g.verify && link_info.type != type) {
+        HDprintf("    link '%s' had the wrong type\n", path);
+        return FAIL;
+    }
+
+    return SUCCEED;
+}
+
+/*
+ * Looks up every link in the graph by its path, relative
+ * to the top-level group, with H5Lexists or H5Lget_info2.
+ */
+static int
+link_bench_lookups(hid_t top_id, link_bench_graph_t *graph, hbool_t get_info)
+{
+    vol_bench_stats_t stats;
+
+    vol_bench_stats_init(&stats);
+
+    for (unsigned n = 0; n < vol_bench_params_g.iterations; n++)
+        for (hsize_t node = 0; node < graph->nnodes; node++) {
+            if (node > 0 &&
+                link_bench_lookup(top_id, link_bench_path(graph, graph->path, "", node, NULL), H5L_TYPE_HARD,
+                                  get_info, &stats) < 0)
+                BENCH_ERROR;
+
+            for (size_t i = 0; i < ARRAY_LENGTH(link_bench_extra_links); i++) {
+                const char *path;
+
+                if (!(graph->extra[node] & link_bench_extra_links[i].flag))
+                    continue;
+
+                path = link_bench_path(graph, graph->path, "", node, link_bench_extra_links[i].name);
+                if (link_bench_lookup(top_id, path, link_bench_extra_links[i].type, get_info, &stats) < 0)
+                    BENCH_ERROR;
+            }
+        }
+
+    link_bench_report(get_info ? "get-info" : "exists", graph, &stats);
+    vol_bench_stats_free(&stats);
+
+    return 0;
+
+error:
+    vol_bench_stats_free(&stats);
+
+    return 1;
+}
+
+int
+vol_link_bench(void)
+{
+    link_bench_graph_t graph;
+    size_t             nindexes;
+    int                nerrors  = 0;
+    hid_t              file_id  = H5I_INVALID_HID;
+    hid_t              group_id = H5I_INVALID_HID;
+    hid_t              top_id   = H5I_INVALID_HID;
+    hid_t              gcpl_id  = H5I_INVALID_HID;
+
+    HDmemset(&graph, 0, sizeof(graph));
+
+    HDprintf("**********************************************\n");
+    HDprintf("*                                            *\n");
+    HDprintf("*            VOL Link Benchmarks             *\n");
+    HDprintf("*                                            *\n");
+    HDprintf("**********************************************\n\n");
+
+    /* Make sure the connector supports the API functions being benchmarked */
+    if (!(vol_cap_flags_g & H5VL_CAP_FLAG_FILE_BASIC) || !(vol_cap_flags_g & H5VL_CAP_FLAG_GROUP_BASIC) ||
+        !(vol_cap_flags_g & H5VL_CAP_FLAG_LINK_BASIC) || !(vol_cap_flags_g & H5VL_CAP_FLAG_LINK_MORE) ||
+        !(vol_cap_flags_g & H5VL_CAP_FLAG_HARD_LINKS) || !(vol_cap_flags_g & H5VL_CAP_FLAG_ITERATE)) {
+        BENCH_SKIPPED("link traversal",
+                      "API functions for basic file, group, link, hard link, or iterate aren't supported "
+                      "with this connector");
+        HDprintf("\n");
+        return 0;
+    }
+
+    if (link_bench_graph_init(&graph, (vol_cap_flags_g & H5VL_CAP_FLAG_CREATION_ORDER) ? TRUE : FALSE) < 0)
+        BENCH_ERROR;
+
+    /* Only traverse the creation order index when it's tracked */
+    nindexes = graph.crt_order ? 2 : 1;
+
+    if ((file_id = H5Fopen(vol_bench_filename, H5F_ACC_RDWR, H5P_DEFAULT)) < 0) {
+        HDprintf("    couldn't open file '%s'\n", vol_bench_filename);
+        BENCH_ERROR;
+    }
+
+    if ((group_id = H5Gcreate2(file_id, LINK_BENCH_GROUP_NAME, H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT)) < 0) {
+        HDprintf("    couldn't create container group '%s'\n", LINK_BENCH_GROUP_NAME);
+        BENCH_ERROR;
+    }
+
+    if ((gcpl_id = H5Pcreate(H5P_GROUP_CREATE)) < 0)
+        BENCH_ERROR;
+
+    if (graph.crt_order &&
+        H5Pset_link_creation_order(gcpl_id, H5P_CRT_ORDER_TRACKED | H5P_CRT_ORDER_INDEXED) < 0) {
+        HDprintf("    couldn't set link creation order tracking on GCPL\n");
+        BENCH_ERROR;
+    }
+
+    if ((top_id = H5Gcreate2(group_id, LINK_BENCH_GRAPH_NAME, H5P_DEFAULT, gcpl_id, H5P_DEFAULT)) < 0) {
+        HDprintf("    couldn't create group '%s'\n", LINK_BENCH_GRAPH_NAME);
+        BENCH_ERROR;
+    }
+
+    /* Build the same links from run to run */
+    vol_test_random_begin(VOL_TEST_TIMER_INTERFACE, "link");
+
+    if (link_bench_build(top_id, &graph) > 0)
+        BENCH_ERROR;
+
+    for (size_t idx = 0; idx < nindexes; idx++)
+        for (size_t order = 0; order < ARRAY_LENGTH(link_bench_orders); order++) {
+            nerrors += link_bench_traverse(top_id, &graph, idx, order, FALSE);
+            nerrors += link_bench_traverse(top_id, &graph, idx, order, TRUE);
+        }
+
+    nerrors += link_bench_lookups(top_id, &graph, FALSE);
+    nerrors += link_bench_lookups(top_id, &graph, TRUE);
+
+    if (H5Pclose(gcpl_id) < 0)
+        BENCH_ERROR;
+    if (H5Gclose(top_id) < 0)
+        BENCH_ERROR;
+    if (H5Gclose(group_id) < 0)
+        BENCH_ERROR;
+    if (H5Fclose(file_id) < 0)
+        BENCH_ERROR;
+
+    link_bench_graph_free(&graph);
+
+    HDprintf("\n");
+
+    return nerrors;
+
+error:
+    H5E_BEGIN_TRY
+    {
+        H5Pclose(gcpl_id);
+        H5Gclose(top_id);
+        H5Gclose(group_id);
+        H5Fclose(file_id);
+    }
+    H5E_END_TRY;
+
+    link_bench_graph_free(&graph);
+
+    HDprintf("\n");
+
+    return nerrors + 1;
+}
@@ -0,0 +1,39 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * Copyright by The HDF Group.                                               *
+ * All rights reserved.                                                      *
+ *                                                                           *
+ * This file is part of HDF5.  The full HDF5 copyright notice, including     *
+ * terms governing use, modification, and redistribution, is contained in    *
+ * the COPYING file, which can be found at the root of the source code       *
+ * distribution tree, or in https://support.hdfgroup.org/ftp/HDF5/releases.  *
+ * If you do not have access to either file, you may request a copy from     *
+ * help@hdfgroup.org.                                                        *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+
+#ifndef VOL_LINK_BENCH_H
+#define VOL_LINK_BENCH_H
+
+#include "vol_bench.h"
+
+int vol_link_bench(void);
+
+/***********************************************
+ *                                             *
+ *      VOL connector Link benchmark defines   *
+ *                                             *
+ ***********************************************/
+
+#define LINK_BENCH_GROUP_NAME "link_bench"
+#define LINK_BENCH_GRAPH_NAME "graph"
+
+#define LINK_BENCH_SOFT_LINK_NAME     "soft"
+#define LINK_BENCH_EXTERNAL_LINK_NAME "external"
+#define LINK_BENCH_CYCLE_LINK_NAME    "cycle"
+
+/* The largest number of groups allowed in a link graph */
+#define LINK_BENCH_MAX_NODES ((hsize_t)1 << 32)
+
+#define LINK_BENCH_NAME_LENGTH 128
+
+#endif
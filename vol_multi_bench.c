@@ -0,0 +1,320 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * Copyright by The HDF Group.                                               *
+ * All rights reserved.                                                      *
+ *                                                                           *
+ * This file is part of HDF5.  The full HDF5 copyright notice, including     *
+ * terms governing use, modification, and redistribution, is contained in    *
+ * the COPYING file, which can be found at the root of the source code       *
+ * distribution tree, or in https://support.hdfgroup.org/ftp/HDF5/releases.  *
+ * If you do not have access to either file, you may request a copy from     *
+ * help@hdfgroup.org.                                                        *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+
+/*
+ * Benchmarks for multi-dataset I/O. For each dataset count given with
+ * --multi-dsets, the data of a --size byte dataset is split evenly
+ * across that many one-dimensional datasets, which are then written
+ * and read back both by calling H5Dwrite or H5Dread once for each
+ * dataset and by a single call to H5Dwrite_multi or H5Dread_multi.
+ * Each sample is a full pass over all of the datasets, and the results
+ * for the multi-dataset calls include their speedup over the
+ * per-dataset calls.
+ */
+
+#include "vol_multi_bench.h"
+
+/* The datasets accessed by a single multi-dataset I/O call */
+typedef struct multi_bench_dsets_t {
+    size_t       ndsets;
+    hsize_t      nelems;    /* Number of elements in each dataset */
+    size_t       type_size;
+    hid_t       *dset_ids;
+    hid_t       *type_ids;
+    hid_t       *space_ids; /* H5S_ALL for every dataset */
+    void        *buf;       /* The data for all of the datasets, one after another */
+    void       **bufs;      /* Pointers into buf for each dataset */
+    const void **const_bufs;
+} multi_bench_dsets_t;
+
+static void
+multi_bench_dsets_free(multi_bench_dsets_t *dsets)
+{
+    if (dsets->dset_ids) {
+        H5E_BEGIN_TRY
+        {
+            for (size_t i = 0; i < dsets->ndsets; i++)
+                H5Dclose(dsets->dset_ids[i]);
+        }
+        H5E_END_TRY;
+    }
+
+    HDfree(dsets->dset_ids);
+    HDfree(dsets->type_ids);
+    HDfree(dsets->space_ids);
+    HDfree(dsets->buf);
+    HDfree(dsets->bufs);
+    HDfree(dsets->const_bufs);
+
+    HDmemset(dsets, 0, sizeof(*dsets));
+}
+
+/*
+ * Creates the given number of datasets in the given group, along
+ * with the buffers and ID arrays needed to access them. The datasets
+ * are named after the index of the dataset count in --multi-dsets,
+ * as the same count may appear there more than once.
+ */
+static herr_t
+multi_bench_dsets_create(multi_bench_dsets_t *dsets, hid_t group_id, hid_t type_id, size_t list_idx,
+                         size_t ndsets)
+{
+    hid_t space_id = H5I_INVALID_HID;
+
+    HDmemset(dsets, 0, sizeof(*dsets));
+
+    if (0 == (dsets->type_size = H5Tget_size(type_id)))
+        BENCH_ERROR;
+
+    /* Every dataset has at least one element, whatever --size is */
+    dsets->ndsets = ndsets;
+    dsets->nelems = vol_bench_params_g.dataset_size / dsets->type_size / ndsets;
+    if (dsets->nelems == 0)
+        dsets->nelems = 1;
+
+    if (NULL == (dsets->dset_ids = HDmalloc(ndsets * sizeof(hid_t))))
+        BENCH_ERROR;
+    for (size_t i = 0; i < ndsets; i++)
+        dsets->dset_ids[i] = H5I_INVALID_HID;
+
+    if (NULL == (dsets->type_ids = HDmalloc(ndsets * sizeof(hid_t))))
+        BENCH_ERROR;
+    if (NULL == (dsets->space_ids = HDmalloc(ndsets * sizeof(hid_t))))
+        BENCH_ERROR;
+    if (NULL == (dsets->buf = HDmalloc(ndsets * (size_t)dsets->nelems * dsets->type_size)))
+        BENCH_ERROR;
+    if (NULL == (dsets->bufs = HDmalloc(ndsets * sizeof(void *))))
+        BENCH_ERROR;
+    if (NULL == (dsets->const_bufs = HDmalloc(ndsets * sizeof(const void *))))
+        BENCH_ERROR;
+
+    if ((space_id = H5Screate_simple(1, &dsets->nelems, NULL)) < 0)
+        BENCH_ERROR;
+
+    for (size_t i = 0; i < ndsets; i++) {
+        char dset_name[MULTI_BENCH_DSET_NAME_LENGTH];
+
+        HDsnprintf(dset_name, sizeof(dset_name), "multi_%zu_%zu", list_idx, i);
+
+        if ((dsets->dset_ids[i] = H5Dcreate2(group_id, dset_name, type_id, space_id, H5P_DEFAULT,
+                                             H5P_DEFAULT, H5P_DEFAULT)) < 0) {
+            HDprintf("    couldn't create dataset '%s'\n", dset_name);
+            BENCH_ERROR;
+        }
+
+        dsets->type_ids[i]   = type_id;
+        dsets->space_ids[i]  = H5S_ALL;
+        dsets->bufs[i]       = (unsigned char *)dsets->buf + (i * (size_t)dsets->nelems * dsets->type_size);
+        dsets->const_bufs[i] = dsets->bufs[i];
+    }
+
+    if (H5Sclose(space_id) < 0)
+        BENCH_ERROR;
+
+    return SUCCEED;
+
+error:
+    H5E_BEGIN_TRY
+    {
+        H5Sclose(space_id);
+    }
+    H5E_END_TRY;
+
+    multi_bench_dsets_free(dsets);
+
+    return FAIL;
+}
+
+/*
+ * Makes a single pass over all of the datasets, either with one
+ * I/O call per dataset or with a single multi-dataset I/O call,
+ * and returns the time taken in seconds, or a negative value on
+ * failure.
+ */
+static double
+multi_bench_pass(multi_bench_dsets_t *dsets, hbool_t write, hbool_t multi)
+{
+    herr_t err = SUCCEED;
+    double t0  = vol_bench_now();
+
+    if (multi) {
+        if (write)
+            err = H5Dwrite_multi(dsets->ndsets, dsets->dset_ids, dsets->type_ids, dsets->space_ids,
+                                 dsets->space_ids, H5P_DEFAULT, dsets->const_bufs);
+        else
+            err = H5Dread_multi(dsets->ndsets, dsets->dset_ids, dsets->type_ids, dsets->space_ids,
+                                dsets->space_ids, H5P_DEFAULT, dsets->bufs);
+    }
+    else {
+        for (size_t i = 0; i < dsets->ndsets && err >= 0; i++) {
+            if (write)
+                err = H5Dwrite(dsets->dset_ids[i], dsets->type_ids[i], H5S_ALL, H5S_ALL, H5P_DEFAULT,
+                               dsets->bufs[i]);
+            else
+                err = H5Dread(dsets->dset_ids[i], dsets->type_ids[i], H5S_ALL, H5S_ALL, H5P_DEFAULT,
+                              dsets->bufs[i]);
+        }
+    }
+
+    if (err < 0) {
+        HDprintf("    couldn't %s datasets with %s\n", write ? "write to" : "read from",
+                 multi ? (write ? "H5Dwrite_multi" : "H5Dread_multi") : (write ? "H5Dwrite" : "H5Dread"));
+        return -1.0;
+    }
+
+    return vol_bench_now() - t0;
+}
+
+/*
+ * Writes or reads all of the datasets, alternating between passes
+ * with per-dataset and multi-dataset I/O calls, and reports both
+ * sets of results along with the speedup of the multi-dataset calls.
+ */
+static int
+multi_bench_io(multi_bench_dsets_t *dsets, hbool_t write)
+{
+    vol_bench_stats_t looped_stats;
+    vol_bench_stats_t multi_stats;
+    hsize_t           nbytes = (hsize_t)dsets->ndsets * dsets->nelems * dsets->type_size;
+    hsize_t           total_nbytes;
+    char              name[MULTI_BENCH_NAME_LENGTH];
+
+    vol_bench_stats_init(&looped_stats);
+    vol_bench_stats_init(&multi_stats);
+
+    if (write)
+        vol_bench_fill_buffer(dsets->buf, (size_t)nbytes, 0);
+
+    for (unsigned i = 0; i < vol_bench_params_g.iterations; i++) {
+        for (int multi = 0; multi <= 1; multi++) {
+            double seconds;
+
+            if (!write)
+                HDmemset(dsets->buf, 0, (size_t)nbytes);
+
+            if ((seconds = multi_bench_pass(dsets, write, (hbool_t)multi)) < 0.0)
+                BENCH_ERROR;
+
+            if (vol_bench_stats_add(multi ? &multi_stats : &looped_stats, seconds) < 0)
+                BENCH_ERROR;
+
+            if (!write && vol_bench_params_g.verify) {
+                hsize_t nmismatch;
+
+                if ((nmismatch = vol_bench_check_buffer(dsets->buf, (size_t)nbytes, 0)) > 0) {
+                    HDprintf("    %llu bytes read from datasets with %s didn't match what was written\n",
+                             (unsigned long long)nmismatch, multi ? "H5Dread_multi" : "H5Dread");
+                    BENCH_ERROR;
+                }
+            }
+        }
+    }
+
+    total_nbytes = nbytes * vol_bench_params_g.iterations;
+
+    HDsnprintf(name, sizeof(name), "%s looped %zu datasets", write ? "write" : "read", dsets->ndsets);
+    vol_bench_report("multi", name, total_nbytes, &looped_stats);
+
+    HDsnprintf(name, sizeof(name), "%s multi %zu datasets", write ? "write" : "read", dsets->ndsets);
+    vol_bench_report_metric("multi", name, total_nbytes, &multi_stats, "speedup",
+                            multi_stats.total > 0.0 ? looped_stats.total / multi_stats.total : 0.0);
+
+    vol_bench_stats_free(&looped_stats);
+    vol_bench_stats_free(&multi_stats);
+
+    return 0;
+
+error:
+    vol_bench_stats_free(&looped_stats);
+    vol_bench_stats_free(&multi_stats);
+
+    return 1;
+}
+
+int
+vol_multi_bench(void)
+{
+    multi_bench_dsets_t dsets;
+    hsize_t             ndsets[VOL_BENCH_MAX_LIST_VALUES];
+    size_t              nndsets;
+    int                 nerrors  = 0;
+    hid_t               file_id  = H5I_INVALID_HID;
+    hid_t               group_id = H5I_INVALID_HID;
+    hid_t               type_id  = vol_bench_type();
+
+    HDmemset(&dsets, 0, sizeof(dsets));
+
+    HDprintf("**********************************************\n");
+    HDprintf("*                                            *\n");
+    HDprintf("*     VOL Multi-Dataset I/O Benchmarks       *\n");
+    HDprintf("*                                            *\n");
+    HDprintf("**********************************************\n\n");
+
+    /* Make sure the connector supports the API functions being benchmarked */
+    if (!(vol_cap_flags_g & H5VL_CAP_FLAG_FILE_BASIC) || !(vol_cap_flags_g & H5VL_CAP_FLAG_GROUP_BASIC) ||
+        !(vol_cap_flags_g & H5VL_CAP_FLAG_DATASET_BASIC)) {
+        BENCH_SKIPPED("multi-dataset I/O",
+                      "API functions for basic file, group, or dataset aren't supported with this connector");
+        HDprintf("\n");
+        return 0;
+    }
+
+    /* This was checked when the command line was parsed */
+    if (vol_bench_parse_size_list(vol_bench_params_g.multi_dsets, ndsets, &nndsets) < 0)
+        BENCH_ERROR;
+
+    if ((file_id = H5Fopen(vol_bench_filename, H5F_ACC_RDWR, H5P_DEFAULT)) < 0) {
+        HDprintf("    couldn't open file '%s'\n", vol_bench_filename);
+        BENCH_ERROR;
+    }
+
+    if ((group_id = H5Gcreate2(file_id, MULTI_BENCH_GROUP_NAME, H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT)) < 0) {
+        HDprintf("    couldn't create container group '%s'\n", MULTI_BENCH_GROUP_NAME);
+        BENCH_ERROR;
+    }
+
+    for (size_t i = 0; i < nndsets; i++) {
+        if (multi_bench_dsets_create(&dsets, group_id, type_id, i, (size_t)ndsets[i]) < 0) {
+            nerrors++;
+            continue;
+        }
+
+        nerrors += multi_bench_io(&dsets, TRUE);
+        nerrors += multi_bench_io(&dsets, FALSE);
+
+        multi_bench_dsets_free(&dsets);
+    }
+
+    if (H5Gclose(group_id) < 0)
+        BENCH_ERROR;
+    if (H5Fclose(file_id) < 0)
+        BENCH_ERROR;
+
+    HDprintf("\n");
+
+    return nerrors;
+
+error:
+    multi_bench_dsets_free(&dsets);
+
+    H5E_BEGIN_TRY
+    {
+        H5Gclose(group_id);
+        H5Fclose(file_id);
+    }
+    H5E_END_TRY;
+
+    HDprintf("\n");
+
+    return nerrors + 1;
+}
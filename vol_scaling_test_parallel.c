@@ -0,0 +1,546 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * Copyright by The HDF Group.                                               *
+ * All rights reserved.                                                      *
+ *                                                                           *
+ * This file is part of HDF5.  The full HDF5 copyright notice, including     *
+ * terms governing use, modification, and redistribution, is contained in    *
+ * the COPYING file, which can be found at the root of the source code       *
+ * distribution tree, or in https://support.hdfgroup.org/ftp/HDF5/releases.  *
+ * If you do not have access to either file, you may request a copy from     *
+ * help@hdfgroup.org.                                                        *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+/*
+ * Weak and strong scaling runs of parallel dataset I/O. Unlike the
+ * dataset tests, whose datasets hold at most a few kilobytes per rank,
+ * these tests size their dataset from the --weak or --strong option so
+ * that the same access patterns can be timed at increasing rank counts.
+ * Each rank times its own H5Dwrite and H5Dread calls; the timings are
+ * gathered on rank 0 with MPI_Reduce and printed as tables of minimum,
+ * average and maximum per-rank bandwidth, along with the aggregate
+ * bandwidth of all ranks together.
+ */
+
+#include <float.h>
+
+#include "vol_scaling_test_parallel.h"
+
+static int test_dataset_io_scaling(void);
+
+/*
+ * The array of parallel scaling tests to be performed.
+ */
+static int (*par_scaling_tests[])(void) = {
+    test_dataset_io_scaling,
+};
+
+vol_scaling_mode_t vol_scaling_mode_g   = VOL_SCALING_WEAK;
+hsize_t            vol_scaling_nbytes_g = VOL_SCALING_DEFAULT_NBYTES;
+
+/*
+ * A test to time parallel writes and reads of a dataset as the number
+ * of ranks grows, using the same selections as the dataset tests:
+ *
+ * - each rank selects its own row of the dataset with a hyperslab
+ * - each rank selects every element of its own row with a point selection
+ * - rank 0 selects the whole dataset and all other ranks select nothing
+ *
+ * Each selection is used with both collective and independent I/O, and
+ * the data read back is verified after the timings have been taken. As
+ * rank 0 needs a buffer for the whole dataset for the last selection, it
+ * is skipped once the dataset is larger than
+ * DATASET_IO_SCALING_TEST_ONE_PROC_ALL_MAX_NBYTES.
+ */
+#define DATASET_IO_SCALING_TEST_SPACE_RANK 2
+#define DATASET_IO_SCALING_TEST_DSET_DTYPE H5T_NATIVE_INT
+#define DATASET_IO_SCALING_TEST_DTYPE_SIZE sizeof(int)
+#define DATASET_IO_SCALING_TEST_ITERATIONS 3
+#define DATASET_IO_SCALING_TEST_ONE_PROC_ALL_MAX_NBYTES (1024 * 1024 * 1024)
+#define DATASET_IO_SCALING_TEST_GROUP_NAME "dataset_io_scaling_test"
+#define DATASET_IO_SCALING_TEST_DSET_NAME  "dataset_io_scaling"
+#define DATASET_IO_SCALING_TEST_NAME_LEN   128
+
+typedef enum dataset_io_scaling_sel_t {
+    DATASET_IO_SCALING_HYPERSLAB,
+    DATASET_IO_SCALING_POINT,
+    DATASET_IO_SCALING_ONE_PROC_ALL,
+    DATASET_IO_SCALING_NUM_SELS
+} dataset_io_scaling_sel_t;
+
+static const char *const dataset_io_scaling_sel_names[] = {"hyperslab", "point", "one-proc-all"};
+
+/* The bandwidths, in MB/s, of a single timed operation */
+typedef struct dataset_io_scaling_result_t {
+    const char *sel_name;
+    const char *xfer_mode;
+    const char *op;
+    double      min_bw; /* Lowest bandwidth of any rank that transferred data */
+    double      avg_bw; /* Average bandwidth of the ranks that transferred data */
+    double      max_bw; /* Highest bandwidth of any rank that transferred data */
+    double      agg_bw; /* Total bytes transferred over the time taken by the slowest rank */
+} dataset_io_scaling_result_t;
+
+/*
+ * Sets up the file and memory selections for the given selection type,
+ * returning the number of elements transferred by this rank and the
+ * index in the dataset of the first of them.
+ */
+static herr_t
+dataset_io_scaling_select(dataset_io_scaling_sel_t sel, hid_t fspace_id, hsize_t row_nelems,
+                          const hsize_t *points, hid_t *mspace_id_out, hsize_t *nelems_out,
+                          hsize_t *first_out)
+{
+    hsize_t start[DATASET_IO_SCALING_TEST_SPACE_RANK] = {(hsize_t)mpi_rank, 0};
+    hsize_t count[DATASET_IO_SCALING_TEST_SPACE_RANK] = {1, row_nelems};
+    hsize_t nelems;
+
+    switch (sel) {
+        case DATASET_IO_SCALING_HYPERSLAB:
+            if (H5Sselect_hyperslab(fspace_id, H5S_SELECT_SET, start, NULL, count, NULL) < 0)
+                return FAIL;
+            nelems = row_nelems;
+            break;
+
+        case DATASET_IO_SCALING_POINT:
+            if (H5Sselect_elements(fspace_id, H5S_SELECT_SET, (size_t)row_nelems, points) < 0)
+                return FAIL;
+            nelems = row_nelems;
+            break;
+
+        case DATASET_IO_SCALING_ONE_PROC_ALL:
+            if (MAINPROCESS) {
+                if (H5Sselect_all(fspace_id) < 0)
+                    return FAIL;
+                nelems = row_nelems * (hsize_t)mpi_size;
+            }
+            else {
+                if (H5Sselect_none(fspace_id) < 0)
+                    return FAIL;
+                nelems = 0;
+            }
+            break;
+
+        case DATASET_IO_SCALING_NUM_SELS:
+        default:
+            return FAIL;
+    }
+
+    if ((*mspace_id_out = H5Screate_simple(1, &nelems, NULL)) < 0)
+        return FAIL;
+
+    *nelems_out = nelems;
+    *first_out  = (sel == DATASET_IO_SCALING_ONE_PROC_ALL) ? 0 : (hsize_t)mpi_rank * row_nelems;
+
+    return SUCCEED;
+}
+
+/*
+ * Gathers the time taken by each rank to transfer the given number
+ * of bytes onto rank 0 and fills in the bandwidths of the result.
+ */
+static herr_t
+dataset_io_scaling_reduce(hsize_t nbytes, double seconds, dataset_io_scaling_result_t *result)
+{
+    hbool_t transferred = (nbytes > 0 && seconds > 0.0);
+    double  bw          = transferred ? ((double)nbytes / 1.0E6) / seconds : 0.0;
+    double  min_in      = transferred ? bw : DBL_MAX;
+    double  sums_in[3]  = {bw, transferred ? 1.0 : 0.0, (double)nbytes};
+    double  min_bw, max_bw, max_seconds;
+    double  sums[3];
+
+    if (MPI_SUCCESS != MPI_Reduce(&min_in, &min_bw, 1, MPI_DOUBLE, MPI_MIN, 0, MPI_COMM_WORLD))
+        return FAIL;
+    if (MPI_SUCCESS != MPI_Reduce(&bw, &max_bw, 1, MPI_DOUBLE, MPI_MAX, 0, MPI_COMM_WORLD))
+        return FAIL;
+    if (MPI_SUCCESS != MPI_Reduce(&seconds, &max_seconds, 1, MPI_DOUBLE, MPI_MAX, 0, MPI_COMM_WORLD))
+        return FAIL;
+    if (MPI_SUCCESS != MPI_Reduce(sums_in, sums, 3, MPI_DOUBLE, MPI_SUM, 0, MPI_COMM_WORLD))
+        return FAIL;
+
+    if (MAINPROCESS) {
+        result->min_bw = (sums[1] > 0.0) ? min_bw : 0.0;
+        result->max_bw = max_bw;
+        result->avg_bw = (sums[1] > 0.0) ? sums[0] / sums[1] : 0.0;
+        result->agg_bw = (max_seconds > 0.0) ? (sums[2] / 1.0E6) / max_seconds : 0.0;
+    }
+
+    return SUCCEED;
+}
+
+/*
+ * Times DATASET_IO_SCALING_TEST_ITERATIONS writes or reads of the
+ * dataset with the given selection and data transfer property list.
+ * Data read back is checked once all of the reads are done.
+ *
+ * The ranks agree on whether any of them has failed before each
+ * transfer, so that no rank enters a collective H5Dwrite or H5Dread
+ * that another rank has given up on. A rank that fails still makes
+ * every reduction, so that the ranks stay in step; the failure is
+ * only returned at the end.
+ */
+static herr_t
+dataset_io_scaling_run(hid_t dset_id, hid_t dxpl_id, dataset_io_scaling_sel_t sel, hbool_t write,
+                       hsize_t row_nelems, const hsize_t *points, int *buf,
+                       dataset_io_scaling_result_t *result)
+{
+    hsize_t nelems = 0;
+    hsize_t first  = 0;
+    hsize_t nbytes;
+    hsize_t i;
+    hid_t   fspace_id  = H5I_INVALID_HID;
+    hid_t   mspace_id  = H5I_INVALID_HID;
+    hbool_t failed     = FALSE;
+    hbool_t any_failed = FALSE;
+    double  seconds    = 0.0;
+
+    if ((fspace_id = H5Dget_space(dset_id)) < 0) {
+        HDprintf("    couldn't get dataset dataspace\n");
+        failed = TRUE;
+    }
+
+    if (!failed &&
+        dataset_io_scaling_select(sel, fspace_id, row_nelems, points, &mspace_id, &nelems, &first) < 0) {
+        HDprintf("    couldn't set up %s selection\n", dataset_io_scaling_sel_names[sel]);
+        failed = TRUE;
+    }
+
+    if (!failed) {
+        if (write)
+            for (i = 0; i < nelems; i++)
+                buf[i] = (int)(first + i);
+        else
+            HDmemset(buf, 0, (size_t)nelems * DATASET_IO_SCALING_TEST_DTYPE_SIZE);
+    }
+
+    for (int iter = 0; iter < DATASET_IO_SCALING_TEST_ITERATIONS; iter++) {
+        herr_t err;
+        double start;
+
+        /*
+         * Agree on whether any rank has failed, which also starts every rank's
+         * clock together so that the slowest rank sets the aggregate bandwidth
+         */
+        any_failed = failed;
+        if (MPI_SUCCESS != MPI_Allreduce(MPI_IN_PLACE, &any_failed, 1, MPI_C_BOOL, MPI_LOR, MPI_COMM_WORLD)) {
+            HDprintf("    MPI_Allreduce() failed\n");
+            failed = any_failed = TRUE;
+        }
+
+        if (any_failed)
+            break;
+
+        start = MPI_Wtime();
+
+        if (write)
+            err = H5Dwrite(dset_id, DATASET_IO_SCALING_TEST_DSET_DTYPE, mspace_id, fspace_id, dxpl_id, buf);
+        else
+            err = H5Dread(dset_id, DATASET_IO_SCALING_TEST_DSET_DTYPE, mspace_id, fspace_id, dxpl_id, buf);
+
+        seconds += MPI_Wtime() - start;
+
+        if (err < 0) {
+            HDprintf("    couldn't %s dataset '%s'\n", write ? "write to" : "read from",
+                     DATASET_IO_SCALING_TEST_DSET_NAME);
+            failed = TRUE;
+        }
+    }
+
+    if (!write && !any_failed)
+        for (i = 0; i < nelems; i++)
+            if (buf[i] != (int)(first + i)) {
+                HDprintf("    data verification failed at element %llu\n", (unsigned long long)(first + i));
+                failed = TRUE;
+                break;
+            }
+
+    nbytes = (failed || any_failed)
+                 ? 0
+                 : nelems * DATASET_IO_SCALING_TEST_DTYPE_SIZE * DATASET_IO_SCALING_TEST_ITERATIONS;
+    if (dataset_io_scaling_reduce(nbytes, seconds, result) < 0) {
+        HDprintf("    couldn't gather timings\n");
+        failed = TRUE;
+    }
+
+    if (mspace_id >= 0 && H5Sclose(mspace_id) < 0)
+        failed = TRUE;
+    if (fspace_id >= 0 && H5Sclose(fspace_id) < 0)
+        failed = TRUE;
+
+    return failed ? FAIL : SUCCEED;
+}
+
+static int
+test_dataset_io_scaling(void)
+{
+    dataset_io_scaling_result_t results[DATASET_IO_SCALING_NUM_SELS * 2 * 2];
+    size_t                      nresults = 0;
+    hsize_t                     dims[DATASET_IO_SCALING_TEST_SPACE_RANK];
+    hsize_t                     row_nelems;
+    hsize_t                     i;
+    hsize_t                     buf_nelems;
+    hbool_t                     one_proc_all;
+    hsize_t                    *points = NULL;
+    hid_t                       file_id         = H5I_INVALID_HID;
+    hid_t                       fapl_id         = H5I_INVALID_HID;
+    hid_t                       container_group = H5I_INVALID_HID, group_id = H5I_INVALID_HID;
+    hid_t                       dset_id   = H5I_INVALID_HID;
+    hid_t                       fspace_id = H5I_INVALID_HID;
+    hid_t                       dxpl_ids[2] = {H5I_INVALID_HID, H5I_INVALID_HID};
+    int                        *buf         = NULL;
+    char                        name[DATASET_IO_SCALING_TEST_NAME_LEN];
+
+    HDsnprintf(name, sizeof(name), "%s scaling of dataset I/O",
+               (vol_scaling_mode_g == VOL_SCALING_WEAK) ? "weak" : "strong");
+
+    TESTING_MULTIPART(name);
+
+    /* Make sure the connector supports the API functions being tested */
+    if (!(vol_cap_flags_g & H5VL_CAP_FLAG_FILE_BASIC) || !(vol_cap_flags_g & H5VL_CAP_FLAG_GROUP_BASIC) ||
+        !(vol_cap_flags_g & H5VL_CAP_FLAG_DATASET_BASIC)) {
+        SKIPPED();
+        HDprintf(
+            "    API functions for basic file, group, or dataset aren't supported with this connector\n");
+        return 0;
+    }
+
+    /*
+     * Every rank accesses a row of the dataset, so the number of
+     * elements in each row is what is fixed by the scaling mode
+     */
+    row_nelems = vol_scaling_nbytes_g / DATASET_IO_SCALING_TEST_DTYPE_SIZE;
+    if (vol_scaling_mode_g == VOL_SCALING_STRONG)
+        row_nelems /= (hsize_t)mpi_size;
+    if (row_nelems == 0) {
+        SKIPPED();
+        if (MAINPROCESS)
+            HDprintf("    %llu bytes is too small to give each of %d ranks a dataset element\n",
+                     (unsigned long long)vol_scaling_nbytes_g, mpi_size);
+        return 0;
+    }
+
+    dims[0] = (hsize_t)mpi_size;
+    dims[1] = row_nelems;
+
+    one_proc_all = (row_nelems <= DATASET_IO_SCALING_TEST_ONE_PROC_ALL_MAX_NBYTES /
+                                      DATASET_IO_SCALING_TEST_DTYPE_SIZE / dims[0]);
+    buf_nelems   = (MAINPROCESS && one_proc_all) ? dims[0] * row_nelems : row_nelems;
+
+    TESTING_2("test setup");
+
+    if ((fapl_id = create_mpi_fapl(MPI_COMM_WORLD, MPI_INFO_NULL, TRUE)) < 0)
+        TEST_ERROR;
+
+    if ((file_id = H5Fopen(vol_test_parallel_filename, H5F_ACC_RDWR, fapl_id)) < 0) {
+        H5_FAILED();
+        HDprintf("    couldn't open file '%s'\n", vol_test_parallel_filename);
+        goto error;
+    }
+
+    if ((container_group = H5Gopen2(file_id, DATASET_TEST_GROUP_NAME, H5P_DEFAULT)) < 0) {
+        H5_FAILED();
+        HDprintf("    couldn't open container group '%s'\n", DATASET_TEST_GROUP_NAME);
+        goto error;
+    }
+
+    if ((group_id = H5Gcreate2(container_group, DATASET_IO_SCALING_TEST_GROUP_NAME, H5P_DEFAULT, H5P_DEFAULT,
+                               H5P_DEFAULT)) < 0) {
+        H5_FAILED();
+        HDprintf("    couldn't create container sub-group '%s'\n", DATASET_IO_SCALING_TEST_GROUP_NAME);
+        goto error;
+    }
+
+    if ((fspace_id = H5Screate_simple(DATASET_IO_SCALING_TEST_SPACE_RANK, dims, NULL)) < 0)
+        TEST_ERROR;
+
+    if ((dset_id = H5Dcreate2(group_id, DATASET_IO_SCALING_TEST_DSET_NAME, DATASET_IO_SCALING_TEST_DSET_DTYPE,
+                              fspace_id, H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT)) < 0) {
+        H5_FAILED();
+        HDprintf("    couldn't create dataset '%s'\n", DATASET_IO_SCALING_TEST_DSET_NAME);
+        goto error;
+    }
+
+    for (size_t j = 0; j < 2; j++) {
+        if ((dxpl_ids[j] = H5Pcreate(H5P_DATASET_XFER)) < 0)
+            TEST_ERROR;
+        if (H5Pset_dxpl_mpio(dxpl_ids[j], j == 0 ? H5FD_MPIO_COLLECTIVE : H5FD_MPIO_INDEPENDENT) < 0) {
+            H5_FAILED();
+            HDprintf("    couldn't set MPI-IO transfer mode\n");
+            goto error;
+        }
+    }
+
+    /*
+     * Rank 0 needs a buffer for the whole dataset for the
+     * one-proc-all selection; the other ranks need one row
+     */
+    BEGIN_INDEPENDENT_OP(buf_alloc)
+    {
+        if (NULL == (buf = HDmalloc((size_t)buf_nelems * DATASET_IO_SCALING_TEST_DTYPE_SIZE))) {
+            H5_FAILED();
+            HDprintf("    couldn't allocate buffer for dataset I/O\n");
+            INDEPENDENT_OP_ERROR(buf_alloc);
+        }
+
+        if (NULL == (points = HDmalloc((size_t)row_nelems * DATASET_IO_SCALING_TEST_SPACE_RANK *
+                                       sizeof(hsize_t)))) {
+            H5_FAILED();
+            HDprintf("    couldn't allocate buffer for point selection\n");
+            INDEPENDENT_OP_ERROR(buf_alloc);
+        }
+    }
+    END_INDEPENDENT_OP(buf_alloc);
+
+    for (i = 0; i < row_nelems; i++) {
+        points[(i * DATASET_IO_SCALING_TEST_SPACE_RANK)]     = (hsize_t)mpi_rank;
+        points[(i * DATASET_IO_SCALING_TEST_SPACE_RANK) + 1] = i;
+    }
+
+    PASSED();
+
+    BEGIN_MULTIPART
+    {
+        for (int sel = 0; sel < DATASET_IO_SCALING_NUM_SELS; sel++) {
+            for (size_t j = 0; j < 2; j++) {
+                const char *xfer_mode = (j == 0) ? "collective" : "independent";
+                hbool_t     op_failed = FALSE;
+
+                HDsnprintf(name, sizeof(name), "%s selection, %s H5Dwrite then H5Dread",
+                           dataset_io_scaling_sel_names[sel], xfer_mode);
+
+                PART_BEGIN(dataset_io_scaling)
+                {
+                    TESTING_2(name);
+
+                    if (sel == DATASET_IO_SCALING_ONE_PROC_ALL && !one_proc_all) {
+                        SKIPPED();
+                        if (MAINPROCESS)
+                            HDprintf("    the dataset is larger than the %d bytes rank 0 may buffer\n",
+                                     DATASET_IO_SCALING_TEST_ONE_PROC_ALL_MAX_NBYTES);
+                        PART_EMPTY(dataset_io_scaling);
+                    }
+
+                    results[nresults].sel_name      = dataset_io_scaling_sel_names[sel];
+                    results[nresults].xfer_mode     = xfer_mode;
+                    results[nresults].op            = "write";
+                    results[nresults + 1].sel_name  = dataset_io_scaling_sel_names[sel];
+                    results[nresults + 1].xfer_mode = xfer_mode;
+                    results[nresults + 1].op        = "read";
+
+                    /* Both phases run on every rank, whatever happened in the first */
+                    if (dataset_io_scaling_run(dset_id, dxpl_ids[j], (dataset_io_scaling_sel_t)sel, TRUE,
+                                               row_nelems, points, buf, &results[nresults]) < 0)
+                        op_failed = TRUE;
+                    if (dataset_io_scaling_run(dset_id, dxpl_ids[j], (dataset_io_scaling_sel_t)sel, FALSE,
+                                               row_nelems, points, buf, &results[nresults + 1]) < 0)
+                        op_failed = TRUE;
+
+                    if (MPI_SUCCESS !=
+                        MPI_Allreduce(MPI_IN_PLACE, &op_failed, 1, MPI_C_BOOL, MPI_LOR, MPI_COMM_WORLD))
+                        op_failed = TRUE;
+
+                    if (op_failed) {
+                        H5_FAILED();
+                        PART_ERROR(dataset_io_scaling);
+                    }
+
+                    nresults += 2;
+
+                    PASSED();
+                }
+                PART_END(dataset_io_scaling);
+            }
+        }
+    }
+    END_MULTIPART;
+
+    if (MAINPROCESS) {
+        HDprintf("\n    %s scaling with %d ranks: %llu bytes per rank, %llu bytes total, %d iterations\n",
+                 (vol_scaling_mode_g == VOL_SCALING_WEAK) ? "Weak" : "Strong", mpi_size,
+                 (unsigned long long)(row_nelems * DATASET_IO_SCALING_TEST_DTYPE_SIZE),
+                 (unsigned long long)(dims[0] * row_nelems * DATASET_IO_SCALING_TEST_DTYPE_SIZE),
+                 DATASET_IO_SCALING_TEST_ITERATIONS);
+        HDprintf("    %-13s %-12s %-6s %12s %12s %12s %14s\n", "selection", "I/O mode", "op", "min MB/s",
+                 "avg MB/s", "max MB/s", "aggregate MB/s");
+        for (size_t j = 0; j < nresults; j++)
+            HDprintf("    %-13s %-12s %-6s %12.2f %12.2f %12.2f %14.2f\n", results[j].sel_name,
+                     results[j].xfer_mode, results[j].op, results[j].min_bw, results[j].avg_bw,
+                     results[j].max_bw, results[j].agg_bw);
+        HDprintf("\n");
+    }
+
+    TESTING_2("test cleanup");
+
+    HDfree(points);
+    points = NULL;
+    HDfree(buf);
+    buf = NULL;
+
+    for (size_t j = 0; j < 2; j++)
+        if (H5Pclose(dxpl_ids[j]) < 0)
+            TEST_ERROR;
+    if (H5Sclose(fspace_id) < 0)
+        TEST_ERROR;
+    if (H5Dclose(dset_id) < 0)
+        TEST_ERROR;
+    if (H5Gclose(group_id) < 0)
+        TEST_ERROR;
+    if (H5Gclose(container_group) < 0)
+        TEST_ERROR;
+    if (H5Pclose(fapl_id) < 0)
+        TEST_ERROR;
+    if (H5Fclose(file_id) < 0)
+        TEST_ERROR;
+
+    PASSED();
+
+    return 0;
+
+error:
+    H5E_BEGIN_TRY
+    {
+        if (points)
+            HDfree(points);
+        if (buf)
+            HDfree(buf);
+        H5Pclose(dxpl_ids[0]);
+        H5Pclose(dxpl_ids[1]);
+        H5Sclose(fspace_id);
+        H5Dclose(dset_id);
+        H5Gclose(group_id);
+        H5Gclose(container_group);
+        H5Pclose(fapl_id);
+        H5Fclose(file_id);
+    }
+    H5E_END_TRY;
+
+    return 1;
+}
+
+int
+vol_scaling_test_parallel(void)
+{
+    size_t i;
+    int    nerrors;
+
+    if (MAINPROCESS) {
+        HDprintf("**********************************************\n");
+        HDprintf("*                                            *\n");
+        HDprintf("*         VOL Parallel Scaling Tests         *\n");
+        HDprintf("*                                            *\n");
+        HDprintf("**********************************************\n\n");
+    }
+
+    for (i = 0, nerrors = 0; i < ARRAY_LENGTH(par_scaling_tests); i++) {
+        nerrors += (*par_scaling_tests[i])() ? 1 : 0;
+
+        if (MPI_SUCCESS != MPI_Barrier(MPI_COMM_WORLD)) {
+            if (MAINPROCESS)
+                HDprintf("    MPI_Barrier() failed!\n");
+        }
+    }
+
+    if (MAINPROCESS)
+        HDprintf("\n");
+
+    return nerrors;
+}
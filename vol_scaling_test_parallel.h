@@ -0,0 +1,34 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * Copyright by The HDF Group.                                               *
+ * All rights reserved.                                                      *
+ *                                                                           *
+ * This file is part of HDF5.  The full HDF5 copyright notice, including     *
+ * terms governing use, modification, and redistribution, is contained in    *
+ * the COPYING file, which can be found at the root of the source code       *
+ * distribution tree, or in https://support.hdfgroup.org/ftp/HDF5/releases.  *
+ * If you do not have access to either file, you may request a copy from     *
+ * help@hdfgroup.org.                                                        *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#ifndef VOL_SCALING_TEST_PARALLEL_H_
+#define VOL_SCALING_TEST_PARALLEL_H_
+
+#include "vol_test_parallel.h"
+
+int vol_scaling_test_parallel(void);
+
+/*
+ * The kind of scaling run, selected with the --weak and --strong
+ * options to h5vl_test_parallel. With weak scaling, the number of
+ * bytes given is the amount of data accessed by each MPI rank; with
+ * strong scaling, it is the total amount of data accessed by all
+ * ranks together.
+ */
+typedef enum vol_scaling_mode_t { VOL_SCALING_WEAK, VOL_SCALING_STRONG } vol_scaling_mode_t;
+
+#define VOL_SCALING_DEFAULT_NBYTES (1024 * 1024)
+
+extern vol_scaling_mode_t vol_scaling_mode_g;
+extern hsize_t            vol_scaling_nbytes_g;
+
+#endif /* VOL_SCALING_TEST_PARALLEL_H_ */
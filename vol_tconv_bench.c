@@ -0,0 +1,689 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * Copyright by The HDF Group.                                               *
+ * All rights reserved.                                                      *
+ *                                                                           *
+ * This file is part of HDF5.  The full HDF5 copyright notice, including     *
+ * terms governing use, modification, and redistribution, is contained in    *
+ * the COPYING file, which can be found at the root of the source code       *
+ * distribution tree, or in https://support.hdfgroup.org/ftp/HDF5/releases.  *
+ * If you do not have access to either file, you may request a copy from     *
+ * help@hdfgroup.org.                                                        *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+/*
+ * Benchmarks for datatype conversion during dataset I/O. For each of
+ * four conversion paths, --tconv-pairs datatypes of the matching class
+ * are picked with generate_random_datatype(), the generator used by the
+ * VOL tests, and each is paired with a datatype it converts to:
+ *
+ *  - integers, with another width or byte order
+ *  - floating-point numbers, single to double precision or back
+ *  - compound types, with a random subset of the members, each in its
+ *    native form
+ *  - enums, with the same member names mapped to other values
+ *
+ * A dataset of about --size bytes is created with the generated datatype
+ * and written and read with H5S_ALL, first with that datatype in memory,
+ * so that no conversion is done, then with the other datatype of the
+ * pair. Each converted result includes the rate at which the data was
+ * converted, in GB/s of the memory buffer, taken from the time spent
+ * beyond that of the unconverted I/O (or 0 if there was none).
+ */
+
+#include "vol_tconv_bench.h"
+
+/* The conversion paths benchmarked */
+typedef enum tconv_bench_path_t {
+    TCONV_BENCH_INTEGER,
+    TCONV_BENCH_FLOAT,
+    TCONV_BENCH_COMPOUND,
+    TCONV_BENCH_ENUM,
+    TCONV_BENCH_NPATHS
+} tconv_bench_path_t;
+
+static const char *const tconv_bench_path_str[]   = {"integer", "float", "compound", "enum"};
+static const H5T_class_t tconv_bench_path_class[] = {H5T_INTEGER, H5T_FLOAT, H5T_COMPOUND, H5T_ENUM};
+
+/* A dataset and the pair of datatypes it is accessed with */
+typedef struct tconv_bench_pair_t {
+    hid_t   file_type_id; /* The dataset's datatype */
+    hid_t   mem_type_id;  /* The datatype converted to and from */
+    size_t  file_type_size;
+    size_t  mem_type_size;
+    hsize_t nelems;
+    hid_t   dset_id;
+    void   *file_buf;   /* Data in the dataset's datatype */
+    void   *mem_buf;    /* Data in the converted datatype */
+    void   *read_buf;   /* Large enough for either datatype */
+    void   *expect_buf; /* What a converted read should return, with --verify */
+    void   *bkg_buf;
+    char    file_type_name[TCONV_BENCH_TYPE_NAME_LENGTH];
+    char    mem_type_name[TCONV_BENCH_TYPE_NAME_LENGTH];
+} tconv_bench_pair_t;
+
+/*
+ * Writes a short name for a datatype, e.g. i32be or f64le for
+ * integers and floating-point numbers and the number of members
+ * for compound and enum types.
+ */
+static void
+tconv_bench_type_name(hid_t type_id, char *name, size_t name_size)
+{
+    size_t      size  = H5Tget_size(type_id);
+    const char *order = (H5Tget_order(type_id) == H5T_ORDER_BE) ? "be" : "le";
+
+    switch (H5Tget_class(type_id)) {
+        case H5T_INTEGER:
+            HDsnprintf(name, name_size, "%c%zu%s", (H5Tget_sign(type_id) == H5T_SGN_NONE) ? 'u' : 'i',
+                       size * 8, (size > 1) ? order : "");
+            break;
+        case H5T_FLOAT:
+            HDsnprintf(name, name_size, "f%zu%s", size * 8, order);
+            break;
+        case H5T_COMPOUND:
+            HDsnprintf(name, name_size, "compound%d", H5Tget_nmembers(type_id));
+            break;
+        case H5T_ENUM:
+            HDsnprintf(name, name_size, "enum%d", H5Tget_nmembers(type_id));
+            break;
+        default:
+            HDsnprintf(name, name_size, "%zu-byte", size);
+            break;
+    }
+}
+
+/*
+ * Generates random datatypes until one of the given class comes up.
+ * Compact datatypes are asked for, so that the elements are small
+ * enough for a dataset to hold many of them.
+ */
+static hid_t
+tconv_bench_generate(H5T_class_t type_class)
+{
+    for (unsigned i = 0; i < TCONV_BENCH_MAX_TRIES; i++) {
+        hid_t type_id;
+
+        if ((type_id = generate_random_datatype(H5T_NO_CLASS, TRUE)) < 0)
+            return H5I_INVALID_HID;
+
+        if (H5Tget_class(type_id) == type_class)
+            return type_id;
+
+        H5Tclose(type_id);
+    }
+
+    HDprintf("    couldn't generate a datatype of the class needed\n");
+
+    return H5I_INVALID_HID;
+}
+
+/*
+ * Returns a copy of the native integer type of the given size and sign.
+ */
+static hid_t
+tconv_bench_native_int(size_t size, H5T_sign_t sign)
+{
+    hid_t type_id;
+
+    switch (size) {
+        case 1:
+            type_id = (sign == H5T_SGN_NONE) ? H5T_NATIVE_UINT8 : H5T_NATIVE_INT8;
+            break;
+        case 2:
+            type_id = (sign == H5T_SGN_NONE) ? H5T_NATIVE_UINT16 : H5T_NATIVE_INT16;
+            break;
+        case 4:
+            type_id = (sign == H5T_SGN_NONE) ? H5T_NATIVE_UINT32 : H5T_NATIVE_INT32;
+            break;
+        case 8:
+            type_id = (sign == H5T_SGN_NONE) ? H5T_NATIVE_UINT64 : H5T_NATIVE_INT64;
+            break;
+        default:
+            return H5I_INVALID_HID;
+    }
+
+    return H5Tcopy(type_id);
+}
+
+/*
+ * Creates the datatype that a generated datatype is converted to
+ * and from in memory.
+ */
+static hid_t
+tconv_bench_mem_type(hid_t file_type_id)
+{
+    hid_t *member_type_ids = NULL;
+    hid_t  member_type_id  = H5I_INVALID_HID;
+    hid_t  mem_type_id     = H5I_INVALID_HID;
+    char  *member_name     = NULL;
+    size_t size            = H5Tget_size(file_type_id);
+    int    nmembers        = 0;
+
+    switch (H5Tget_class(file_type_id)) {
+        case H5T_INTEGER:
+            /* Swap the byte order of foreign integers and change the width of native ones */
+            if (size == 1)
+                size = 2;
+            else if (H5Tget_order(file_type_id) == H5Tget_order(H5T_NATIVE_INT))
+                size /= 2;
+
+            if ((mem_type_id = tconv_bench_native_int(size, H5Tget_sign(file_type_id))) < 0)
+                BENCH_ERROR;
+            break;
+
+        case H5T_FLOAT:
+            if ((mem_type_id = H5Tcopy((size == sizeof(float)) ? H5T_NATIVE_DOUBLE : H5T_NATIVE_FLOAT)) < 0)
+                BENCH_ERROR;
+            break;
+
+        case H5T_COMPOUND: {
+            size_t offset = 0;
+            int    kept;
+
+            if ((nmembers = H5Tget_nmembers(file_type_id)) <= 0)
+                BENCH_ERROR;
+            if (NULL == (member_type_ids = HDmalloc((size_t)nmembers * sizeof(hid_t))))
+                BENCH_ERROR;
+            for (int i = 0; i < nmembers; i++)
+                member_type_ids[i] = H5I_INVALID_HID;
+
+            /* Keep a random subset of the members, which always includes one of them */
+            kept = vol_test_random() % nmembers;
+            size = 0;
+            for (int i = 0; i < nmembers; i++) {
+                if (i != kept && vol_test_random() % 2)
+                    continue;
+
+                if ((member_type_id = H5Tget_member_type(file_type_id, (unsigned)i)) < 0)
+                    BENCH_ERROR;
+                if ((member_type_ids[i] = H5Tget_native_type(member_type_id, H5T_DIR_DEFAULT)) < 0)
+                    BENCH_ERROR;
+                if (H5Tclose(member_type_id) < 0)
+                    BENCH_ERROR;
+                member_type_id = H5I_INVALID_HID;
+
+                size += H5Tget_size(member_type_ids[i]);
+            }
+
+            if ((mem_type_id = H5Tcreate(H5T_COMPOUND, size)) < 0)
+                BENCH_ERROR;
+
+            for (int i = 0; i < nmembers; i++) {
+                if (member_type_ids[i] < 0)
+                    continue;
+
+                if (NULL == (member_name = H5Tget_member_name(file_type_id, (unsigned)i)))
+                    BENCH_ERROR;
+                if (H5Tinsert(mem_type_id, member_name, offset, member_type_ids[i]) < 0)
+                    BENCH_ERROR;
+                H5free_memory(member_name);
+                member_name = NULL;
+
+                offset += H5Tget_size(member_type_ids[i]);
+            }
+            break;
+        }
+
+        case H5T_ENUM:
+            if ((nmembers = H5Tget_nmembers(file_type_id)) <= 0)
+                BENCH_ERROR;
+            if ((mem_type_id = H5Tenum_create(H5T_NATIVE_INT)) < 0)
+                BENCH_ERROR;
+
+            /* The same member names, numbered in order */
+            for (int i = 0; i < nmembers; i++) {
+                if (NULL == (member_name = H5Tget_member_name(file_type_id, (unsigned)i)))
+                    BENCH_ERROR;
+                if (H5Tenum_insert(mem_type_id, member_name, &i) < 0)
+                    BENCH_ERROR;
+                H5free_memory(member_name);
+                member_name = NULL;
+            }
+            break;
+
+        default:
+            HDprintf("    unsupported datatype class for conversion\n");
+            BENCH_ERROR;
+    }
+
+    if (member_type_ids) {
+        for (int i = 0; i < nmembers; i++)
+            if (member_type_ids[i] >= 0 && H5Tclose(member_type_ids[i]) < 0)
+                BENCH_ERROR;
+        HDfree(member_type_ids);
+    }
+
+    return mem_type_id;
+
+error:
+    H5E_BEGIN_TRY
+    {
+        if (member_type_ids)
+            for (int i = 0; i < nmembers; i++)
+                H5Tclose(member_type_ids[i]);
+        H5Tclose(member_type_id);
+        H5Tclose(mem_type_id);
+    }
+    H5E_END_TRY;
+
+    HDfree(member_type_ids);
+    if (member_name)
+        H5free_memory(member_name);
+
+    return H5I_INVALID_HID;
+}
+
+/*
+ * Fills one element of a native datatype with a value made from the
+ * element's index which converts cleanly: floating-point numbers that
+ * are exactly representable and enum values that are members of the
+ * enum. Other datatypes are filled with the usual byte pattern.
+ */
+static herr_t
+tconv_bench_fill_elem(unsigned char *elem, hid_t type_id, size_t idx)
+{
+    hid_t  sub_type_id = H5I_INVALID_HID;
+    size_t size;
+    int    nmembers;
+
+    if (0 == (size = H5Tget_size(type_id)))
+        BENCH_ERROR;
+
+    switch (H5Tget_class(type_id)) {
+        case H5T_FLOAT:
+            if (size == sizeof(float)) {
+                float value = (float)(idx % 65536) * 0.25f;
+
+                HDmemcpy(elem, &value, sizeof(value));
+            }
+            else {
+                double value = (double)(idx % 65536) * 0.25;
+
+                HDmemcpy(elem, &value, MIN(size, sizeof(value)));
+            }
+            break;
+
+        case H5T_ENUM:
+            if ((nmembers = H5Tget_nmembers(type_id)) <= 0)
+                BENCH_ERROR;
+            if (H5Tget_member_value(type_id, (unsigned)(idx % (size_t)nmembers), elem) < 0)
+                BENCH_ERROR;
+            break;
+
+        case H5T_COMPOUND:
+            if ((nmembers = H5Tget_nmembers(type_id)) <= 0)
+                BENCH_ERROR;
+
+            for (int i = 0; i < nmembers; i++) {
+                size_t offset = H5Tget_member_offset(type_id, (unsigned)i);
+
+                if ((sub_type_id = H5Tget_member_type(type_id, (unsigned)i)) < 0)
+                    BENCH_ERROR;
+                if (tconv_bench_fill_elem(elem + offset, sub_type_id, idx) < 0)
+                    BENCH_ERROR;
+                if (H5Tclose(sub_type_id) < 0)
+                    BENCH_ERROR;
+                sub_type_id = H5I_INVALID_HID;
+            }
+            break;
+
+        case H5T_ARRAY: {
+            size_t base_size;
+
+            if ((sub_type_id = H5Tget_super(type_id)) < 0)
+                BENCH_ERROR;
+            if (0 == (base_size = H5Tget_size(sub_type_id)))
+                BENCH_ERROR;
+
+            for (size_t j = 0; j < size / base_size; j++)
+                if (tconv_bench_fill_elem(elem + j * base_size, sub_type_id, idx + j) < 0)
+                    BENCH_ERROR;
+
+            if (H5Tclose(sub_type_id) < 0)
+                BENCH_ERROR;
+            break;
+        }
+
+        default:
+            vol_bench_fill_buffer(elem, size, (hsize_t)idx * size);
+            break;
+    }
+
+    return SUCCEED;
+
+error:
+    H5E_BEGIN_TRY
+    {
+        H5Tclose(sub_type_id);
+    }
+    H5E_END_TRY;
+
+    return FAIL;
+}
+
+static void
+tconv_bench_pair_free(tconv_bench_pair_t *pair)
+{
+    H5E_BEGIN_TRY
+    {
+        H5Dclose(pair->dset_id);
+        H5Tclose(pair->mem_type_id);
+        H5Tclose(pair->file_type_id);
+    }
+    H5E_END_TRY;
+
+    HDfree(pair->file_buf);
+    HDfree(pair->mem_buf);
+    HDfree(pair->read_buf);
+    HDfree(pair->expect_buf);
+    HDfree(pair->bkg_buf);
+
+    HDmemset(pair, 0, sizeof(*pair));
+    pair->file_type_id = H5I_INVALID_HID;
+    pair->mem_type_id  = H5I_INVALID_HID;
+    pair->dset_id      = H5I_INVALID_HID;
+}
+
+/*
+ * Picks a pair of datatypes for the given conversion path, creates
+ * a dataset with the generated one and fills the buffers for both.
+ */
+static herr_t
+tconv_bench_pair_create(tconv_bench_pair_t *pair, hid_t group_id, tconv_bench_path_t path, unsigned pair_idx)
+{
+    hid_t  space_id = H5I_INVALID_HID;
+    size_t max_size;
+    htri_t equal = TRUE;
+    char   dset_name[TCONV_BENCH_NAME_LENGTH];
+
+    HDmemset(pair, 0, sizeof(*pair));
+    pair->file_type_id = H5I_INVALID_HID;
+    pair->mem_type_id  = H5I_INVALID_HID;
+    pair->dset_id      = H5I_INVALID_HID;
+
+    /* A pair that needs no conversion is of no use, so try again if one comes up */
+    for (unsigned i = 0; i < TCONV_BENCH_MAX_TRIES && equal; i++) {
+        H5E_BEGIN_TRY
+        {
+            H5Tclose(pair->mem_type_id);
+            H5Tclose(pair->file_type_id);
+        }
+        H5E_END_TRY;
+        pair->file_type_id = H5I_INVALID_HID;
+        pair->mem_type_id  = H5I_INVALID_HID;
+
+        if ((pair->file_type_id = tconv_bench_generate(tconv_bench_path_class[path])) < 0)
+            BENCH_ERROR;
+        if ((pair->mem_type_id = tconv_bench_mem_type(pair->file_type_id)) < 0)
+            BENCH_ERROR;
+
+        if ((equal = H5Tequal(pair->file_type_id, pair->mem_type_id)) < 0)
+            BENCH_ERROR;
+    }
+    if (equal) {
+        HDprintf("    couldn't pick a pair of %s datatypes that need converting\n",
+                 tconv_bench_path_str[path]);
+        BENCH_ERROR;
+    }
+
+    if (0 == (pair->file_type_size = H5Tget_size(pair->file_type_id)))
+        BENCH_ERROR;
+    if (0 == (pair->mem_type_size = H5Tget_size(pair->mem_type_id)))
+        BENCH_ERROR;
+    max_size = MAX(pair->file_type_size, pair->mem_type_size);
+
+    tconv_bench_type_name(pair->file_type_id, pair->file_type_name, sizeof(pair->file_type_name));
+    tconv_bench_type_name(pair->mem_type_id, pair->mem_type_name, sizeof(pair->mem_type_name));
+
+    pair->nelems = MAX(1, vol_bench_params_g.dataset_size / pair->file_type_size);
+
+    if ((space_id = H5Screate_simple(1, &pair->nelems, NULL)) < 0)
+        BENCH_ERROR;
+
+    HDsnprintf(dset_name, sizeof(dset_name), "%s_%u", tconv_bench_path_str[path], pair_idx);
+    if ((pair->dset_id = H5Dcreate2(group_id, dset_name, pair->file_type_id, space_id, H5P_DEFAULT,
+                                    H5P_DEFAULT, H5P_DEFAULT)) < 0) {
+        HDprintf("    couldn't create dataset '%s'\n", dset_name);
+        BENCH_ERROR;
+    }
+
+    if (NULL == (pair->file_buf = HDmalloc((size_t)pair->nelems * pair->file_type_size)))
+        BENCH_ERROR;
+    if (NULL == (pair->mem_buf = HDmalloc((size_t)pair->nelems * pair->mem_type_size)))
+        BENCH_ERROR;
+    if (NULL == (pair->read_buf = HDmalloc((size_t)pair->nelems * max_size)))
+        BENCH_ERROR;
+
+    vol_bench_fill_buffer(pair->file_buf, (size_t)pair->nelems * pair->file_type_size, 0);
+    for (size_t i = 0; i < (size_t)pair->nelems; i++)
+        if (tconv_bench_fill_elem((unsigned char *)pair->mem_buf + i * pair->mem_type_size,
+                                  pair->mem_type_id, i) < 0)
+            BENCH_ERROR;
+
+    /*
+     * A converted read should return the data converted to the dataset's
+     * datatype and back, which isn't always what was written when the
+     * values don't fit in the dataset's datatype.
+     */
+    if (vol_bench_params_g.verify) {
+        if (NULL == (pair->expect_buf = HDmalloc((size_t)pair->nelems * max_size)))
+            BENCH_ERROR;
+        if (NULL == (pair->bkg_buf = HDcalloc((size_t)pair->nelems, max_size)))
+            BENCH_ERROR;
+
+        HDmemcpy(pair->expect_buf, pair->mem_buf, (size_t)pair->nelems * pair->mem_type_size);
+
+        if (H5Tconvert(pair->mem_type_id, pair->file_type_id, (size_t)pair->nelems, pair->expect_buf,
+                       pair->bkg_buf, H5P_DEFAULT) < 0)
+            BENCH_ERROR;
+        HDmemset(pair->bkg_buf, 0, (size_t)pair->nelems * max_size);
+        if (H5Tconvert(pair->file_type_id, pair->mem_type_id, (size_t)pair->nelems, pair->expect_buf,
+                       pair->bkg_buf, H5P_DEFAULT) < 0)
+            BENCH_ERROR;
+    }
+
+    if (H5Sclose(space_id) < 0)
+        BENCH_ERROR;
+
+    return SUCCEED;
+
+error:
+    H5E_BEGIN_TRY
+    {
+        H5Sclose(space_id);
+    }
+    H5E_END_TRY;
+
+    tconv_bench_pair_free(pair);
+
+    return FAIL;
+}
+
+/*
+ * Writes or reads the whole dataset, with or without conversion, and
+ * returns the time taken in seconds, or a negative value on failure.
+ */
+static double
+tconv_bench_pass(tconv_bench_pair_t *pair, hbool_t write, hbool_t convert)
+{
+    hid_t  type_id = convert ? pair->mem_type_id : pair->file_type_id;
+    herr_t err;
+    double t0 = vol_bench_now();
+
+    if (write)
+        err = H5Dwrite(pair->dset_id, type_id, H5S_ALL, H5S_ALL, H5P_DEFAULT,
+                       convert ? pair->mem_buf : pair->file_buf);
+    else
+        err = H5Dread(pair->dset_id, type_id, H5S_ALL, H5S_ALL, H5P_DEFAULT, pair->read_buf);
+
+    if (err < 0) {
+        HDprintf("    couldn't %s dataset %s conversion\n", write ? "write to" : "read from",
+                 convert ? "with" : "without");
+        return -1.0;
+    }
+
+    return vol_bench_now() - t0;
+}
+
+/*
+ * Writes and reads the dataset of a pair without and then with
+ * conversion, and reports the results along with the rate at which
+ * the data was converted.
+ */
+static int
+tconv_bench_pair_run(tconv_bench_pair_t *pair)
+{
+    vol_bench_stats_t stats[2][2]; /* Indexed by [write][convert] */
+    size_t            max_size    = MAX(pair->file_type_size, pair->mem_type_size);
+    hsize_t           file_nbytes = pair->nelems * pair->file_type_size * vol_bench_params_g.iterations;
+    hsize_t           mem_nbytes  = pair->nelems * pair->mem_type_size * vol_bench_params_g.iterations;
+    char              name[TCONV_BENCH_NAME_LENGTH];
+
+    for (int w = 0; w < 2; w++)
+        for (int c = 0; c < 2; c++)
+            vol_bench_stats_init(&stats[w][c]);
+
+    /* Each read follows a write of the same kind, so that it can be verified */
+    for (unsigned i = 0; i < vol_bench_params_g.iterations; i++) {
+        for (int convert = 0; convert <= 1; convert++) {
+            for (int write = 1; write >= 0; write--) {
+                double seconds;
+
+                if (!write)
+                    HDmemset(pair->read_buf, 0, (size_t)pair->nelems * max_size);
+
+                if ((seconds = tconv_bench_pass(pair, (hbool_t)write, (hbool_t)convert)) < 0.0)
+                    BENCH_ERROR;
+
+                if (vol_bench_stats_add(&stats[write][convert], seconds) < 0)
+                    BENCH_ERROR;
+
+                if (!write && vol_bench_params_g.verify) {
+                    const unsigned char *expect    = convert ? pair->expect_buf : pair->file_buf;
+                    const unsigned char *actual    = pair->read_buf;
+                    size_t               type_size = convert ? pair->mem_type_size : pair->file_type_size;
+                    hsize_t              nmismatch = 0;
+
+                    for (size_t j = 0; j < (size_t)pair->nelems * type_size; j++)
+                        if (actual[j] != expect[j])
+                            nmismatch++;
+
+                    if (nmismatch > 0) {
+                        HDprintf("    %llu bytes read from dataset %s conversion didn't match what was "
+                                 "written\n",
+                                 (unsigned long long)nmismatch, convert ? "with" : "without");
+                        BENCH_ERROR;
+                    }
+                }
+            }
+        }
+    }
+
+    for (int write = 1; write >= 0; write--) {
+        const char *op    = write ? "write" : "read";
+        double      extra = stats[write][1].total - stats[write][0].total;
+
+        HDsnprintf(name, sizeof(name), "%s %s", op, pair->file_type_name);
+        vol_bench_report("tconv", name, file_nbytes, &stats[write][0]);
+
+        if (write)
+            HDsnprintf(name, sizeof(name), "%s %s->%s", op, pair->mem_type_name, pair->file_type_name);
+        else
+            HDsnprintf(name, sizeof(name), "%s %s->%s", op, pair->file_type_name, pair->mem_type_name);
+        vol_bench_report_metric("tconv", name, mem_nbytes, &stats[write][1], "tconv_gbps",
+                                extra > 0.0 ? (double)mem_nbytes / extra / 1e9 : 0.0);
+    }
+
+    for (int w = 0; w < 2; w++)
+        for (int c = 0; c < 2; c++)
+            vol_bench_stats_free(&stats[w][c]);
+
+    return 0;
+
+error:
+    for (int w = 0; w < 2; w++)
+        for (int c = 0; c < 2; c++)
+            vol_bench_stats_free(&stats[w][c]);
+
+    return 1;
+}
+
+int
+vol_tconv_bench(void)
+{
+    tconv_bench_pair_t pair;
+    int                nerrors  = 0;
+    hid_t              file_id  = H5I_INVALID_HID;
+    hid_t              group_id = H5I_INVALID_HID;
+
+    HDmemset(&pair, 0, sizeof(pair));
+    pair.file_type_id = H5I_INVALID_HID;
+    pair.mem_type_id  = H5I_INVALID_HID;
+    pair.dset_id      = H5I_INVALID_HID;
+
+    HDprintf("**********************************************\n");
+    HDprintf("*                                            *\n");
+    HDprintf("*       VOL Type Conversion Benchmarks       *\n");
+    HDprintf("*                                            *\n");
+    HDprintf("**********************************************\n\n");
+
+    /* Make sure the connector supports the API functions being benchmarked */
+    if (!(vol_cap_flags_g & H5VL_CAP_FLAG_FILE_BASIC) || !(vol_cap_flags_g & H5VL_CAP_FLAG_GROUP_BASIC) ||
+        !(vol_cap_flags_g & H5VL_CAP_FLAG_DATASET_BASIC)) {
+        BENCH_SKIPPED("type conversion",
+                      "API functions for basic file, group, or dataset aren't supported with this connector");
+        HDprintf("\n");
+        return 0;
+    }
+
+    if ((file_id = H5Fopen(vol_bench_filename, H5F_ACC_RDWR, H5P_DEFAULT)) < 0) {
+        HDprintf("    couldn't open file '%s'\n", vol_bench_filename);
+        BENCH_ERROR;
+    }
+
+    if ((group_id = H5Gcreate2(file_id, TCONV_BENCH_GROUP_NAME, H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT)) < 0) {
+        HDprintf("    couldn't create container group '%s'\n", TCONV_BENCH_GROUP_NAME);
+        BENCH_ERROR;
+    }
+
+    /* Each path picks the same datatypes from run to run, whichever paths are run before it */
+    vol_test_random_begin(VOL_TEST_TIMER_INTERFACE, "tconv");
+
+    for (int path = 0; path < TCONV_BENCH_NPATHS; path++) {
+        vol_test_random_begin(VOL_TEST_TIMER_TEST, tconv_bench_path_str[path]);
+
+        for (unsigned i = 0; i < vol_bench_params_g.tconv_pairs; i++) {
+            if (tconv_bench_pair_create(&pair, group_id, (tconv_bench_path_t)path, i) < 0) {
+                nerrors++;
+                continue;
+            }
+
+            nerrors += tconv_bench_pair_run(&pair);
+
+            tconv_bench_pair_free(&pair);
+        }
+    }
+
+    if (H5Gclose(group_id) < 0)
+        BENCH_ERROR;
+    if (H5Fclose(file_id) < 0)
+        BENCH_ERROR;
+
+    HDprintf("\n");
+
+    return nerrors;
+
+error:
+    tconv_bench_pair_free(&pair);
+
+    H5E_BEGIN_TRY
+    {
+        H5Gclose(group_id);
+        H5Fclose(file_id);
+    }
+    H5E_END_TRY;
+
+    HDprintf("\n");
+
+    return nerrors + 1;
+}
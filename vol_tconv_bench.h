@@ -0,0 +1,34 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * Copyright by The HDF Group.                                               *
+ * All rights reserved.                                                      *
+ *                                                                           *
+ * This file is part of HDF5.  The full HDF5 copyright notice, including     *
+ * terms governing use, modification, and redistribution, is contained in    *
+ * the COPYING file, which can be found at the root of the source code       *
+ * distribution tree, or in https://support.hdfgroup.org/ftp/HDF5/releases.  *
+ * If you do not have access to either file, you may request a copy from     *
+ * help@hdfgroup.org.                                                        *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#ifndef VOL_TCONV_BENCH_H
+#define VOL_TCONV_BENCH_H
+
+#include "vol_bench.h"
+
+int vol_tconv_bench(void);
+
+/**********************************************************
+ *                                                        *
+ *      VOL connector type conversion benchmark defines   *
+ *                                                        *
+ **********************************************************/
+
+#define TCONV_BENCH_GROUP_NAME "tconv_bench"
+
+/* The number of datatypes generated while looking for one of a given class */
+#define TCONV_BENCH_MAX_TRIES 1000
+
+#define TCONV_BENCH_TYPE_NAME_LENGTH 32
+#define TCONV_BENCH_NAME_LENGTH      128
+
+#endif
@@ -40,14 +40,14 @@
 #include "vol_async_test.h"
 #endif
 
-char vol_test_filename[VOL_TEST_FILENAME_MAX_LENGTH];
+VOL_TEST_THREAD_LOCAL char vol_test_filename[VOL_TEST_FILENAME_MAX_LENGTH];
 
 const char *test_path_prefix;
 
-size_t n_tests_run_g;
-size_t n_tests_passed_g;
-size_t n_tests_failed_g;
-size_t n_tests_skipped_g;
+VOL_TEST_THREAD_LOCAL size_t n_tests_run_g;
+VOL_TEST_THREAD_LOCAL size_t n_tests_passed_g;
+VOL_TEST_THREAD_LOCAL size_t n_tests_failed_g;
+VOL_TEST_THREAD_LOCAL size_t n_tests_skipped_g;
 
 uint64_t vol_cap_flags_g;
 
@@ -56,46 +56,52 @@ uint64_t vol_cap_flags_g;
  * - name
  * - test function
  * - enabled by default
+ * - able to run at the same time as other tests; tests which
+ *   look at the state of the whole library, like the number of
+ *   open files, must have the library to themselves
  */
 #ifdef H5VL_TEST_HAS_ASYNC
 #define VOL_TESTS                                                                                            \
-    X(VOL_TEST_NULL, "", NULL, 0)                                                                            \
-    X(VOL_TEST_FILE, "file", vol_file_test, 1)                                                               \
-    X(VOL_TEST_GROUP, "group", vol_group_test, 1)                                                            \
-    X(VOL_TEST_DATASET, "dataset", vol_dataset_test, 1)                                                      \
-    X(VOL_TEST_DATATYPE, "datatype", vol_datatype_test, 1)                                                   \
-    X(VOL_TEST_ATTRIBUTE, "attribute", vol_attribute_test, 1)                                                \
-    X(VOL_TEST_LINK, "link", vol_link_test, 1)                                                               \
-    X(VOL_TEST_OBJECT, "object", vol_object_test, 1)                                                         \
-    X(VOL_TEST_MISC, "misc", vol_misc_test, 1)                                                               \
-    X(VOL_TEST_ASYNC, "async", vol_async_test, 1)                                                            \
-    X(VOL_TEST_MAX, "", NULL, 0)
+    X(VOL_TEST_NULL, "", NULL, 0, 0)                                                                         \
+    X(VOL_TEST_FILE, "file", vol_file_test, 1, 0)                                                            \
+    X(VOL_TEST_GROUP, "group", vol_group_test, 1, 1)                                                         \
+    X(VOL_TEST_DATASET, "dataset", vol_dataset_test, 1, 1)                                                   \
+    X(VOL_TEST_DATATYPE, "datatype", vol_datatype_test, 1, 1)                                                \
+    X(VOL_TEST_ATTRIBUTE, "attribute", vol_attribute_test, 1, 1)                                             \
+    X(VOL_TEST_LINK, "link", vol_link_test, 1, 1)                                                            \
+    X(VOL_TEST_OBJECT, "object", vol_object_test, 1, 1)                                                      \
+    X(VOL_TEST_MISC, "misc", vol_misc_test, 1, 1)                                                            \
+    X(VOL_TEST_ASYNC, "async", vol_async_test, 1, 1)                                                         \
+    X(VOL_TEST_MAX, "", NULL, 0, 0)
 #else
 #define VOL_TESTS                                                                                            \
-    X(VOL_TEST_NULL, "", NULL, 0)                                                                            \
-    X(VOL_TEST_FILE, "file", vol_file_test, 1)                                                               \
-    X(VOL_TEST_GROUP, "group", vol_group_test, 1)                                                            \
-    X(VOL_TEST_DATASET, "dataset", vol_dataset_test, 1)                                                      \
-    X(VOL_TEST_DATATYPE, "datatype", vol_datatype_test, 1)                                                   \
-    X(VOL_TEST_ATTRIBUTE, "attribute", vol_attribute_test, 1)                                                \
-    X(VOL_TEST_LINK, "link", vol_link_test, 1)                                                               \
-    X(VOL_TEST_OBJECT, "object", vol_object_test, 1)                                                         \
-    X(VOL_TEST_MISC, "misc", vol_misc_test, 1)                                                               \
-    X(VOL_TEST_MAX, "", NULL, 0)
+    X(VOL_TEST_NULL, "", NULL, 0, 0)                                                                         \
+    X(VOL_TEST_FILE, "file", vol_file_test, 1, 0)                                                            \
+    X(VOL_TEST_GROUP, "group", vol_group_test, 1, 1)                                                         \
+    X(VOL_TEST_DATASET, "dataset", vol_dataset_test, 1, 1)                                                   \
+    X(VOL_TEST_DATATYPE, "datatype", vol_datatype_test, 1, 1)                                                \
+    X(VOL_TEST_ATTRIBUTE, "attribute", vol_attribute_test, 1, 1)                                             \
+    X(VOL_TEST_LINK, "link", vol_link_test, 1, 1)                                                            \
+    X(VOL_TEST_OBJECT, "object", vol_object_test, 1, 1)                                                      \
+    X(VOL_TEST_MISC, "misc", vol_misc_test, 1, 1)                                                            \
+    X(VOL_TEST_MAX, "", NULL, 0, 0)
 #endif
 
-#define X(a, b, c, d) a,
+#define X(a, b, c, d, e) a,
 enum vol_test_type { VOL_TESTS };
 #undef X
-#define X(a, b, c, d) b,
+#define X(a, b, c, d, e) b,
 static char *const vol_test_name[] = {VOL_TESTS};
 #undef X
-#define X(a, b, c, d) c,
+#define X(a, b, c, d, e) c,
 static int (*vol_test_func[])(void) = {VOL_TESTS};
 #undef X
-#define X(a, b, c, d) d,
+#define X(a, b, c, d, e) d,
 static int vol_test_enabled[] = {VOL_TESTS};
 #undef X
+#define X(a, b, c, d, e) e,
+static const int vol_test_shared[] = {VOL_TESTS};
+#undef X
 
 static enum vol_test_type
 vol_test_name_to_type(const char *test_name)
@@ -108,6 +114,15 @@ vol_test_name_to_type(const char *test_name)
     return ((i == VOL_TEST_MAX) ? VOL_TEST_NULL : i);
 }
 
+static void
+vol_test_run_interface(enum vol_test_type i)
+{
+    vol_test_timer_begin(VOL_TEST_TIMER_INTERFACE, vol_test_name[i]);
+    vol_test_random_begin(VOL_TEST_TIMER_INTERFACE, vol_test_name[i]);
+    (void)vol_test_func[i]();
+    vol_test_timer_end_interface();
+}
+
 static void
 vol_test_run(void)
 {
@@ -115,9 +130,156 @@ vol_test_run(void)
 
     for (i = VOL_TEST_FILE; i < VOL_TEST_MAX; i++)
         if (vol_test_enabled[i])
-            (void)vol_test_func[i]();
+            vol_test_run_interface(i);
+}
+
+#ifdef H5_HAVE_THREADSAFE
+/*
+ * Running the tests on a pool of threads. Each thread repeatedly takes
+ * the next enabled interface and runs its tests against a container
+ * file of its own. Interfaces whose tests cannot share the library with
+ * other tests are run first, before any threads are started. The test
+ * counters of each thread are added up once all of the threads have
+ * finished.
+ */
+typedef struct vol_test_worker_t {
+    H5TS_thread_t thread;
+    hid_t         fapl_id;
+    size_t        n_tests_run;
+    size_t        n_tests_passed;
+    size_t        n_tests_failed;
+    size_t        n_tests_skipped;
+    hbool_t       err_occurred;
+} vol_test_worker_t;
+
+static enum vol_test_type vol_test_next_g = VOL_TEST_FILE;
+
+static herr_t
+vol_test_run_isolated(enum vol_test_type i, hid_t fapl_id)
+{
+    herr_t ret_value = SUCCEED;
+
+    HDsnprintf(vol_test_filename, VOL_TEST_FILENAME_MAX_LENGTH, "%s%s_%s", test_path_prefix, vol_test_name[i],
+               TEST_FILE_NAME);
+
+    if (vol_test_thread_begin() < 0)
+        return FAIL;
+
+    if (create_test_container(vol_test_filename, vol_cap_flags_g) < 0) {
+        HDfprintf(stderr, "Unable to create testing container file '%s'\n", vol_test_filename);
+        ret_value = FAIL;
+    }
+    else {
+        vol_test_run_interface(i);
+        H5Fdelete(vol_test_filename, fapl_id);
+    }
+
+    if (vol_test_thread_end() < 0)
+        ret_value = FAIL;
+
+    return ret_value;
 }
 
+static void *
+vol_test_worker(void *udata)
+{
+    vol_test_worker_t *worker = (vol_test_worker_t *)udata;
+
+    n_tests_run_g     = 0;
+    n_tests_passed_g  = 0;
+    n_tests_failed_g  = 0;
+    n_tests_skipped_g = 0;
+
+    for (;;) {
+        enum vol_test_type i;
+
+        vol_test_lock();
+        while (vol_test_next_g < VOL_TEST_MAX &&
+               (!vol_test_enabled[vol_test_next_g] || !vol_test_shared[vol_test_next_g]))
+            vol_test_next_g++;
+        i = vol_test_next_g;
+        if (vol_test_next_g < VOL_TEST_MAX)
+            vol_test_next_g++;
+        vol_test_unlock();
+
+        if (i == VOL_TEST_MAX)
+            break;
+
+        if (vol_test_run_isolated(i, worker->fapl_id) < 0)
+            worker->err_occurred = TRUE;
+    }
+
+    /*
+     * The library doesn't release what is left on the error stack
+     * of a thread when it exits, which would keep it from closing
+     */
+    H5Eclear2(H5E_DEFAULT);
+
+    worker->n_tests_run     = n_tests_run_g;
+    worker->n_tests_passed  = n_tests_passed_g;
+    worker->n_tests_failed  = n_tests_failed_g;
+    worker->n_tests_skipped = n_tests_skipped_g;
+
+    return NULL;
+}
+
+static herr_t
+vol_test_run_threads(int nthreads, hid_t fapl_id)
+{
+    vol_test_worker_t *workers   = NULL;
+    int                nshared   = 0;
+    herr_t             ret_value = SUCCEED;
+
+    if (vol_test_thread_init() < 0) {
+        ret_value = FAIL;
+        goto done;
+    }
+
+    for (enum vol_test_type i = VOL_TEST_FILE; i < VOL_TEST_MAX; i++) {
+        if (!vol_test_enabled[i])
+            continue;
+
+        if (vol_test_shared[i])
+            nshared++;
+        else if (vol_test_run_isolated(i, fapl_id) < 0)
+            ret_value = FAIL;
+    }
+
+    /* No more threads are needed than there are sets of tests to run */
+    if (nshared == 0)
+        goto done;
+    nthreads = MIN(nthreads, nshared);
+
+    if (NULL == (workers = HDcalloc((size_t)nthreads, sizeof(*workers)))) {
+        HDfprintf(stderr, "Unable to allocate test threads\n");
+        ret_value = FAIL;
+        goto done;
+    }
+
+    for (int t = 0; t < nthreads; t++) {
+        workers[t].fapl_id = fapl_id;
+        workers[t].thread  = H5TS_create_thread(vol_test_worker, NULL, &workers[t]);
+    }
+
+    for (int t = 0; t < nthreads; t++) {
+        H5TS_wait_for_thread(workers[t].thread);
+
+        n_tests_run_g += workers[t].n_tests_run;
+        n_tests_passed_g += workers[t].n_tests_passed;
+        n_tests_failed_g += workers[t].n_tests_failed;
+        n_tests_skipped_g += workers[t].n_tests_skipped;
+
+        if (workers[t].err_occurred)
+            ret_value = FAIL;
+    }
+
+done:
+    HDfree(workers);
+
+    return ret_value;
+}
+#endif
+
 /******************************************************************************/
 
 int
@@ -125,24 +287,82 @@ main(int argc, char **argv)
 {
     const char *vol_connector_string;
     const char *vol_connector_name;
-    unsigned    seed;
+    uint64_t    seed;
     hid_t       fapl_id                   = H5I_INVALID_HID;
     hid_t       default_con_id            = H5I_INVALID_HID;
     hid_t       registered_con_id         = H5I_INVALID_HID;
     char       *vol_connector_string_copy = NULL;
     char       *vol_connector_info        = NULL;
+    const char *report_filename           = NULL;
+    int         nthreads                  = 1;
+    hbool_t     interface_selected        = FALSE;
+    hbool_t     seed_selected             = FALSE;
     hbool_t     err_occurred              = FALSE;
 
-    /* Simple argument checking, TODO can improve that later */
-    if (argc > 1) {
-        enum vol_test_type i = vol_test_name_to_type(argv[1]);
-        if (i != VOL_TEST_NULL) {
-            /* Run only specific VOL test */
-            memset(vol_test_enabled, 0, sizeof(vol_test_enabled));
+    /*
+     * Parse the command line. Any interface names given select only
+     * those sets of tests to be run, e.g. "h5vl_test group dataset".
+     */
+    for (int arg = 1; arg < argc; arg++) {
+        enum vol_test_type i;
+
+        if (!HDstrcmp(argv[arg], "--report")) {
+            if (++arg >= argc) {
+                HDfprintf(stderr, "Option '--report' requires a filename\n");
+                HDexit(EXIT_FAILURE);
+            }
+
+            report_filename = argv[arg];
+            continue;
+        }
+
+        /* Replay the random numbers of an earlier run */
+        if (!HDstrcmp(argv[arg], "--seed")) {
+            char *end = NULL;
+
+            if (++arg < argc)
+                seed = HDstrtoull(argv[arg], &end, 10);
+            if (!end || end == argv[arg] || *end != '\0') {
+                HDfprintf(stderr, "Option '--seed' requires a number\n");
+                HDexit(EXIT_FAILURE);
+            }
+
+            seed_selected = TRUE;
+            continue;
+        }
+
+        /* Run the tests of different interfaces on a pool of threads */
+        if (!HDstrcmp(argv[arg], "--threads")) {
+            char *end = NULL;
+
+            if (++arg < argc)
+                nthreads = (int)HDstrtol(argv[arg], &end, 10);
+            if (!end || end == argv[arg] || *end != '\0' || nthreads < 1) {
+                HDfprintf(stderr, "Option '--threads' requires a positive number\n");
+                HDexit(EXIT_FAILURE);
+            }
+
+            continue;
+        }
+
+        if ((i = vol_test_name_to_type(argv[arg])) != VOL_TEST_NULL) {
+            /* Run only specific VOL tests */
+            if (!interface_selected) {
+                memset(vol_test_enabled, 0, sizeof(vol_test_enabled));
+                interface_selected = TRUE;
+            }
             vol_test_enabled[i] = 1;
         }
     }
 
+#ifndef H5_HAVE_THREADSAFE
+    if (nthreads > 1) {
+        HDfprintf(stderr, "Option '--threads' requires a thread-safe build of HDF5; running tests on a "
+                          "single thread\n");
+        nthreads = 1;
+    }
+#endif
+
 #ifdef H5_HAVE_PARALLEL
     /* If HDF5 was built with parallel enabled, go ahead and call MPI_Init before
      * running these tests. Even though these are meant to be serial tests, they will
@@ -159,8 +379,9 @@ main(int argc, char **argv)
     n_tests_failed_g  = 0;
     n_tests_skipped_g = 0;
 
-    seed = (unsigned)HDtime(NULL);
-    srand(seed);
+    if (!seed_selected)
+        seed = (uint64_t)HDtime(NULL);
+    vol_test_random_seed(seed);
 
     if (NULL == (vol_connector_string = HDgetenv("HDF5_VOL_CONNECTOR"))) {
         HDprintf("No VOL connector selected; using native VOL connector\n");
@@ -197,8 +418,15 @@ main(int argc, char **argv)
     HDprintf("Running VOL tests with VOL connector '%s' and info string '%s'\n\n", vol_connector_name,
              vol_connector_info ? vol_connector_info : "");
     HDprintf("Test parameters:\n");
-    HDprintf("  - Test file name: '%s'\n", vol_test_filename);
-    HDprintf("  - Test seed: %u\n", seed);
+    if (nthreads > 1) {
+        HDprintf("  - Test file names: '%s<interface>_%s'\n", test_path_prefix, TEST_FILE_NAME);
+        HDprintf("  - Test threads: %d\n", nthreads);
+    }
+    else
+        HDprintf("  - Test file name: '%s'\n", vol_test_filename);
+    HDprintf("  - Test seed: %llu\n", (unsigned long long)seed);
+    if (report_filename)
+        HDprintf("  - Timing report: '%s'\n", report_filename);
     HDprintf("\n\n");
 
     if ((fapl_id = H5Pcreate(H5P_FILE_ACCESS)) < 0) {
@@ -265,21 +493,43 @@ main(int argc, char **argv)
         goto done;
     }
 
-    /*
-     * Create the file that will be used for all of the tests,
-     * except for those which test file creation.
-     */
-    if (create_test_container(vol_test_filename, vol_cap_flags_g) < 0) {
-        HDfprintf(stderr, "Unable to create testing container file '%s'\n", vol_test_filename);
-        err_occurred = TRUE;
-        goto done;
+#ifdef H5_HAVE_THREADSAFE
+    if (nthreads > 1) {
+        /*
+         * Run all the tests that are enabled on a pool of threads,
+         * each of which creates the files for its tests itself
+         */
+        if (vol_test_run_threads(nthreads, fapl_id) < 0)
+            err_occurred = TRUE;
     }
+    else
+#endif
+    {
+        /*
+         * Create the file that will be used for all of the tests,
+         * except for those which test file creation.
+         */
+        if (create_test_container(vol_test_filename, vol_cap_flags_g) < 0) {
+            HDfprintf(stderr, "Unable to create testing container file '%s'\n", vol_test_filename);
+            err_occurred = TRUE;
+            goto done;
+        }
 
-    /* Run all the tests that are enabled */
-    vol_test_run();
+        /* Run all the tests that are enabled */
+        vol_test_run();
 
-    HDprintf("Cleaning up testing files\n");
-    H5Fdelete(vol_test_filename, fapl_id);
+        HDprintf("Cleaning up testing files\n");
+        H5Fdelete(vol_test_filename, fapl_id);
+    }
+
+    if (report_filename) {
+        if (vol_test_timer_write_report(report_filename) < 0) {
+            HDfprintf(stderr, "Unable to write timing report '%s'\n", report_filename);
+            err_occurred = TRUE;
+        }
+        else
+            HDprintf("Wrote timing report to '%s'\n", report_filename);
+    }
 
     if (n_tests_run_g > 0) {
         HDprintf("%ld/%ld (%.2f%%) VOL tests passed with VOL connector '%s'\n", (long)n_tests_passed_g,
@@ -296,6 +546,8 @@ main(int argc, char **argv)
 done:
     HDfree(vol_connector_string_copy);
 
+    vol_test_timer_free();
+
     if (default_con_id >= 0 && H5VLclose(default_con_id) < 0) {
         HDfprintf(stderr, "Unable to close VOL connector ID\n");
         err_occurred = TRUE;
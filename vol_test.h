@@ -19,6 +19,13 @@
 #include "h5vl_test_config.h"
 #include "vol_test_util.h"
 
+/*
+ * Send test output to the stream of the current thread, which is
+ * stdout unless tests are running on several threads
+ */
+#undef HDprintf
+#define HDprintf(...) HDfprintf(VOL_TEST_STDOUT, __VA_ARGS__)
+
 /* Define H5VL_VERSION if not already defined */
 #ifndef H5VL_VERSION
 #define H5VL_VERSION 0
@@ -45,7 +52,7 @@ H5TEST_DLLVAR MPI_Info h5_io_info_g; /* MPI INFO object for IO */
 /*
  * Print the current location on the standard output stream.
  */
-#define AT() printf("   at %s:%d in %s()...\n", __FILE__, __LINE__, __func__);
+#define AT() HDprintf("   at %s:%d in %s()...\n", __FILE__, __LINE__, __func__);
 
 /*
  * The name of the test is printed by saying TESTING("something") which will
@@ -55,45 +62,57 @@ H5TEST_DLLVAR MPI_Info h5_io_info_g; /* MPI INFO object for IO */
  * should print additional information to stdout indented by at least four
  * spaces.  If the h5_errors() is used for automatic error handling then
  * the H5_FAILED() macro is invoked automatically when an API function fails.
+ *
+ * These macros also record the wall clock and CPU time taken by each test
+ * and test part; see vol_test_timer_begin() and vol_test_timer_end(). Each
+ * test and test part also gets its own stream of random numbers; see
+ * vol_test_random_begin().
  */
 #define TESTING(WHAT)                                                                                        \
     {                                                                                                        \
-        printf("Testing %-62s", WHAT);                                                                       \
+        HDprintf("Testing %-62s", WHAT);                                                                     \
         n_tests_run_g++;                                                                                     \
-        fflush(stdout);                                                                                      \
+        vol_test_timer_begin(VOL_TEST_TIMER_TEST, WHAT);                                                     \
+        vol_test_random_begin(VOL_TEST_TIMER_TEST, WHAT);                                                    \
+        HDfflush(VOL_TEST_STDOUT);                                                                           \
     }
 #define TESTING_2(WHAT)                                                                                      \
     {                                                                                                        \
-        printf("  Testing %-60s", WHAT);                                                                     \
+        HDprintf("  Testing %-60s", WHAT);                                                                   \
         n_tests_run_g++;                                                                                     \
-        fflush(stdout);                                                                                      \
+        vol_test_timer_begin(VOL_TEST_TIMER_PART, WHAT);                                                     \
+        vol_test_random_begin(VOL_TEST_TIMER_PART, WHAT);                                                    \
+        HDfflush(VOL_TEST_STDOUT);                                                                           \
     }
 #define PASSED()                                                                                             \
     {                                                                                                        \
-        puts(" PASSED");                                                                                     \
+        vol_test_timer_end(VOL_TEST_RESULT_PASSED);                                                          \
+        HDprintf(" PASSED\n");                                                                               \
         n_tests_passed_g++;                                                                                  \
-        fflush(stdout);                                                                                      \
+        HDfflush(VOL_TEST_STDOUT);                                                                           \
     }
 #define H5_FAILED()                                                                                          \
     {                                                                                                        \
-        puts("*FAILED*");                                                                                    \
+        vol_test_timer_end(VOL_TEST_RESULT_FAILED);                                                          \
+        HDprintf("*FAILED*\n");                                                                              \
         n_tests_failed_g++;                                                                                  \
-        fflush(stdout);                                                                                      \
+        HDfflush(VOL_TEST_STDOUT);                                                                           \
     }
 #define H5_WARNING()                                                                                         \
     {                                                                                                        \
-        puts("*WARNING*");                                                                                   \
-        fflush(stdout);                                                                                      \
+        HDprintf("*WARNING*\n");                                                                             \
+        HDfflush(VOL_TEST_STDOUT);                                                                           \
     }
 #define SKIPPED()                                                                                            \
     {                                                                                                        \
-        puts(" -SKIP-");                                                                                     \
+        vol_test_timer_end(VOL_TEST_RESULT_SKIPPED);                                                         \
+        HDprintf(" -SKIP-\n");                                                                               \
         n_tests_skipped_g++;                                                                                 \
-        fflush(stdout);                                                                                      \
+        HDfflush(VOL_TEST_STDOUT);                                                                           \
     }
 #define PUTS_ERROR(s)                                                                                        \
     {                                                                                                        \
-        puts(s);                                                                                             \
+        HDprintf("%s\n", s);                                                                                 \
         AT();                                                                                                \
         goto error;                                                                                          \
     }
@@ -105,21 +124,21 @@ H5TEST_DLLVAR MPI_Info h5_io_info_g; /* MPI INFO object for IO */
     }
 #define STACK_ERROR                                                                                          \
     {                                                                                                        \
-        H5Eprint2(H5E_DEFAULT, stdout);                                                                      \
+        H5Eprint2(H5E_DEFAULT, VOL_TEST_STDOUT);                                                             \
         goto error;                                                                                          \
     }
 #define FAIL_STACK_ERROR                                                                                     \
     {                                                                                                        \
         H5_FAILED();                                                                                         \
         AT();                                                                                                \
-        H5Eprint2(H5E_DEFAULT, stdout);                                                                      \
+        H5Eprint2(H5E_DEFAULT, VOL_TEST_STDOUT);                                                             \
         goto error;                                                                                          \
     }
 #define FAIL_PUTS_ERROR(s)                                                                                   \
     {                                                                                                        \
         H5_FAILED();                                                                                         \
         AT();                                                                                                \
-        puts(s);                                                                                             \
+        HDprintf("%s\n", s);                                                                                 \
         goto error;                                                                                          \
     }
 
@@ -128,9 +147,10 @@ H5TEST_DLLVAR MPI_Info h5_io_info_g; /* MPI INFO object for IO */
  */
 #define TESTING_MULTIPART(WHAT)                                                                              \
     {                                                                                                        \
-        printf("Testing %-62s", WHAT);                                                                       \
-        HDputs("");                                                                                          \
-        fflush(stdout);                                                                                      \
+        HDprintf("Testing %-62s\n", WHAT);                                                                   \
+        vol_test_timer_begin(VOL_TEST_TIMER_MULTIPART, WHAT);                                                \
+        vol_test_random_begin(VOL_TEST_TIMER_MULTIPART, WHAT);                                               \
+        HDfflush(VOL_TEST_STDOUT);                                                                           \
     }
 
 /*
@@ -187,7 +207,7 @@ H5TEST_DLLVAR MPI_Info h5_io_info_g; /* MPI INFO object for IO */
 
 /* The name of the file that all of the tests will operate on */
 #define TEST_FILE_NAME "vol_test.h5"
-extern char vol_test_filename[];
+extern VOL_TEST_THREAD_LOCAL char vol_test_filename[];
 
 extern const char *test_path_prefix;
 
@@ -223,10 +243,10 @@ extern const char *test_path_prefix;
  * Global variables to keep track of statistics on the
  * number of tests skipped, failed and run total.
  */
-extern size_t n_tests_run_g;
-extern size_t n_tests_passed_g;
-extern size_t n_tests_failed_g;
-extern size_t n_tests_skipped_g;
+extern VOL_TEST_THREAD_LOCAL size_t n_tests_run_g;
+extern VOL_TEST_THREAD_LOCAL size_t n_tests_passed_g;
+extern VOL_TEST_THREAD_LOCAL size_t n_tests_failed_g;
+extern VOL_TEST_THREAD_LOCAL size_t n_tests_skipped_g;
 
 extern uint64_t vol_cap_flags_g;
 #endif
@@ -21,6 +21,7 @@
 #include "vol_link_test_parallel.h"
 #include "vol_object_test_parallel.h"
 #include "vol_misc_test_parallel.h"
+#include "vol_scaling_test_parallel.h"
 #ifdef H5VL_TEST_HAS_ASYNC
 #include "vol_async_test_parallel.h"
 #endif
@@ -29,10 +30,10 @@ char vol_test_parallel_filename[VOL_TEST_FILENAME_MAX_LENGTH];
 
 const char *test_path_prefix;
 
-size_t n_tests_run_g;
-size_t n_tests_passed_g;
-size_t n_tests_failed_g;
-size_t n_tests_skipped_g;
+VOL_TEST_THREAD_LOCAL size_t n_tests_run_g;
+VOL_TEST_THREAD_LOCAL size_t n_tests_passed_g;
+VOL_TEST_THREAD_LOCAL size_t n_tests_failed_g;
+VOL_TEST_THREAD_LOCAL size_t n_tests_skipped_g;
 
 int      mpi_size, mpi_rank;
 uint64_t vol_cap_flags_g;
@@ -55,6 +56,7 @@ uint64_t vol_cap_flags_g;
     X(VOL_TEST_OBJECT, "object", vol_object_test_parallel, 1)                                                \
     X(VOL_TEST_MISC, "misc", vol_misc_test_parallel, 1)                                                      \
     X(VOL_TEST_ASYNC, "async", vol_async_test_parallel, 1)                                                   \
+    X(VOL_TEST_SCALING, "scaling", vol_scaling_test_parallel, 0)                                             \
     X(VOL_TEST_MAX, "", NULL, 0)
 #else
 #define VOL_PARALLEL_TESTS                                                                                   \
@@ -67,6 +69,7 @@ uint64_t vol_cap_flags_g;
     X(VOL_TEST_LINK, "link", vol_link_test_parallel, 1)                                                      \
     X(VOL_TEST_OBJECT, "object", vol_object_test_parallel, 1)                                                \
     X(VOL_TEST_MISC, "misc", vol_misc_test_parallel, 1)                                                      \
+    X(VOL_TEST_SCALING, "scaling", vol_scaling_test_parallel, 0)                                             \
     X(VOL_TEST_MAX, "", NULL, 0)
 #endif
 
@@ -100,8 +103,12 @@ vol_test_run(void)
     enum vol_test_type i;
 
     for (i = VOL_TEST_FILE; i < VOL_TEST_MAX; i++)
-        if (vol_test_enabled[i])
+        if (vol_test_enabled[i]) {
+            vol_test_timer_begin(VOL_TEST_TIMER_INTERFACE, vol_test_name[i]);
+            vol_test_random_begin(VOL_TEST_TIMER_INTERFACE, vol_test_name[i]);
             (void)vol_test_func[i]();
+            vol_test_timer_end_interface();
+        }
 }
 
 hid_t
@@ -148,7 +155,7 @@ generate_random_parallel_dimensions(int space_rank, hsize_t **dims_out)
             if (i == 0)
                 dims[i] = (hsize_t)mpi_size;
             else
-                dims[i] = (hsize_t)((rand() % MAX_DIM_SIZE) + 1);
+                dims[i] = (hsize_t)((vol_test_random() % MAX_DIM_SIZE) + 1);
         }
     }
 
@@ -174,12 +181,15 @@ main(int argc, char **argv)
 {
     const char *vol_connector_string;
     const char *vol_connector_name;
-    unsigned    seed;
+    uint64_t    seed;
     hid_t       fapl_id                   = H5I_INVALID_HID;
     hid_t       default_con_id            = H5I_INVALID_HID;
     hid_t       registered_con_id         = H5I_INVALID_HID;
     char       *vol_connector_string_copy = NULL;
     char       *vol_connector_info        = NULL;
+    const char *report_filename           = NULL;
+    hbool_t     interface_selected        = FALSE;
+    hbool_t     seed_selected             = FALSE;
     int         required                  = MPI_THREAD_MULTIPLE;
     int         provided;
 
@@ -200,12 +210,70 @@ main(int argc, char **argv)
             HDprintf("** INFO: couldn't initialize with MPI_THREAD_MULTIPLE threading support **\n");
     }
 
-    /* Simple argument checking, TODO can improve that later */
-    if (argc > 1) {
-        enum vol_test_type i = vol_test_name_to_type(argv[1]);
-        if (i != VOL_TEST_NULL) {
-            /* Run only specific VOL test */
-            memset(vol_test_enabled, 0, sizeof(vol_test_enabled));
+    /*
+     * Parse the command line. Any interface names given select only
+     * those sets of tests to be run, e.g. "h5vl_test_parallel dataset".
+     */
+    for (int arg = 1; arg < argc; arg++) {
+        enum vol_test_type i;
+
+        if (!HDstrcmp(argv[arg], "--report")) {
+            if (++arg >= argc) {
+                if (MAINPROCESS)
+                    HDfprintf(stderr, "Option '--report' requires a filename\n");
+                MPI_Finalize();
+                HDexit(EXIT_FAILURE);
+            }
+
+            report_filename = argv[arg];
+            continue;
+        }
+
+        /* Replay the random numbers of an earlier run */
+        if (!HDstrcmp(argv[arg], "--seed")) {
+            char *end = NULL;
+
+            if (++arg < argc)
+                seed = HDstrtoull(argv[arg], &end, 10);
+            if (!end || end == argv[arg] || *end != '\0') {
+                if (MAINPROCESS)
+                    HDfprintf(stderr, "Option '--seed' requires a number\n");
+                MPI_Finalize();
+                HDexit(EXIT_FAILURE);
+            }
+
+            seed_selected = TRUE;
+            continue;
+        }
+
+        /*
+         * Either scaling option selects the scaling tests, which
+         * aren't otherwise run unless named on the command line
+         */
+        if (!HDstrcmp(argv[arg], "--weak") || !HDstrcmp(argv[arg], "--strong")) {
+            vol_scaling_mode_g = !HDstrcmp(argv[arg], "--weak") ? VOL_SCALING_WEAK : VOL_SCALING_STRONG;
+
+            if (++arg >= argc || vol_test_parse_size(argv[arg], &vol_scaling_nbytes_g) < 0) {
+                if (MAINPROCESS)
+                    HDfprintf(stderr, "Option '%s' requires a size, e.g. 64M\n", argv[arg - 1]);
+                MPI_Finalize();
+                HDexit(EXIT_FAILURE);
+            }
+
+            if (!interface_selected) {
+                memset(vol_test_enabled, 0, sizeof(vol_test_enabled));
+                interface_selected = TRUE;
+            }
+            vol_test_enabled[VOL_TEST_SCALING] = 1;
+            continue;
+        }
+
+        if ((i = vol_test_name_to_type(argv[arg])) != VOL_TEST_NULL) {
+            /* Run only specific VOL tests */
+            if (!interface_selected) {
+                memset(vol_test_enabled, 0, sizeof(vol_test_enabled));
+                interface_selected = TRUE;
+            }
             vol_test_enabled[i] = 1;
         }
     }
@@ -222,19 +290,19 @@ main(int argc, char **argv)
     n_tests_failed_g  = 0;
     n_tests_skipped_g = 0;
 
-    if (MAINPROCESS) {
-        seed = (unsigned)HDtime(NULL);
+    if (MAINPROCESS && !seed_selected) {
+        seed = (uint64_t)HDtime(NULL);
     }
 
     if (mpi_size > 1) {
-        if (MPI_SUCCESS != MPI_Bcast(&seed, 1, MPI_UNSIGNED, 0, MPI_COMM_WORLD)) {
+        if (MPI_SUCCESS != MPI_Bcast(&seed, 1, MPI_UINT64_T, 0, MPI_COMM_WORLD)) {
             if (MAINPROCESS)
                 HDfprintf(stderr, "Couldn't broadcast test seed\n");
             goto error;
         }
     }
 
-    srand(seed);
+    vol_test_random_seed(seed);
 
     if (NULL == (test_path_prefix = HDgetenv(HDF5_API_TEST_PATH_PREFIX)))
         test_path_prefix = "";
@@ -284,7 +352,14 @@ main(int argc, char **argv)
         HDprintf("Test parameters:\n");
         HDprintf("  - Test file name: '%s'\n", vol_test_parallel_filename);
         HDprintf("  - Number of MPI ranks: %d\n", mpi_size);
-        HDprintf("  - Test seed: %u\n", seed);
+        HDprintf("  - Test seed: %llu\n", (unsigned long long)seed);
+        if (report_filename)
+            HDprintf("  - Timing report: '%s'\n", report_filename);
+        if (vol_test_enabled[VOL_TEST_SCALING])
+            HDprintf("  - %s scaling: %llu bytes %s\n",
+                     (vol_scaling_mode_g == VOL_SCALING_WEAK) ? "Weak" : "Strong",
+                     (unsigned long long)vol_scaling_nbytes_g,
+                     (vol_scaling_mode_g == VOL_SCALING_WEAK) ? "per rank" : "in total");
         HDprintf("\n\n");
     }
 
@@ -388,6 +463,15 @@ main(int argc, char **argv)
         HDprintf("Cleaning up testing files\n");
     H5Fdelete(vol_test_parallel_filename, fapl_id);
 
+    /* Timings are reported from rank 0's point of view */
+    if (report_filename && MAINPROCESS) {
+        if (vol_test_timer_write_report(report_filename) < 0)
+            HDfprintf(stderr, "    failed to write timing report '%s'\n", report_filename);
+        else
+            HDprintf("Wrote timing report to '%s'\n", report_filename);
+    }
+    vol_test_timer_free();
+
     if (n_tests_run_g > 0) {
         if (MAINPROCESS)
             HDprintf("The below statistics are minimum values due to the possibility of some ranks failing a "
@@ -54,6 +54,8 @@ extern char vol_test_parallel_filename[];
             fflush(stdout);                                                                                  \
         }                                                                                                    \
         n_tests_run_g++;                                                                                     \
+        vol_test_timer_begin(VOL_TEST_TIMER_TEST, WHAT);                                                     \
+        vol_test_random_begin(VOL_TEST_TIMER_TEST, WHAT);                                                    \
     }
 #define TESTING_2(WHAT)                                                                                      \
     {                                                                                                        \
@@ -62,9 +64,12 @@ extern char vol_test_parallel_filename[];
             fflush(stdout);                                                                                  \
         }                                                                                                    \
         n_tests_run_g++;                                                                                     \
+        vol_test_timer_begin(VOL_TEST_TIMER_PART, WHAT);                                                     \
+        vol_test_random_begin(VOL_TEST_TIMER_PART, WHAT);                                                    \
     }
 #define PASSED()                                                                                             \
     {                                                                                                        \
+        vol_test_timer_end(VOL_TEST_RESULT_PASSED);                                                          \
         if (MAINPROCESS) {                                                                                   \
             puts(" PASSED");                                                                                 \
             fflush(stdout);                                                                                  \
@@ -73,6 +78,7 @@ extern char vol_test_parallel_filename[];
     }
 #define H5_FAILED()                                                                                          \
     {                                                                                                        \
+        vol_test_timer_end(VOL_TEST_RESULT_FAILED);                                                          \
         if (MAINPROCESS) {                                                                                   \
             puts("*FAILED*");                                                                                \
             fflush(stdout);                                                                                  \
@@ -88,6 +94,7 @@ extern char vol_test_parallel_filename[];
     }
 #define SKIPPED()                                                                                            \
     {                                                                                                        \
+        vol_test_timer_end(VOL_TEST_RESULT_SKIPPED);                                                         \
         if (MAINPROCESS) {                                                                                   \
             puts(" -SKIP-");                                                                                 \
             fflush(stdout);                                                                                  \
@@ -142,6 +149,8 @@ extern char vol_test_parallel_filename[];
             HDputs("");                                                                                      \
             fflush(stdout);                                                                                  \
         }                                                                                                    \
+        vol_test_timer_begin(VOL_TEST_TIMER_MULTIPART, WHAT);                                                \
+        vol_test_random_begin(VOL_TEST_TIMER_MULTIPART, WHAT);                                               \
     }
 
 /*
@@ -96,7 +96,7 @@ hid_t
 generate_random_datatype(H5T_class_t parent_class, hbool_t is_compact)
 {
     generate_datatype_func gen_func;
-    static int             depth = 0;
+    static VOL_TEST_THREAD_LOCAL int depth = 0;
     size_t                 type_size;
     hid_t                  datatype  = H5I_INVALID_HID;
     hid_t                  ret_value = H5I_INVALID_HID;
@@ -104,7 +104,7 @@ generate_random_datatype(H5T_class_t parent_class, hbool_t is_compact)
     depth++;
 
 roll_datatype:
-    switch (rand() % H5T_NCLASSES) {
+    switch (vol_test_random() % H5T_NCLASSES) {
         case H5T_INTEGER:
             gen_func = generate_random_datatype_integer;
             break;
@@ -217,7 +217,7 @@ generate_random_datatype_integer(H5T_class_t H5_ATTR_UNUSED parent_class, hbool_
     hid_t datatype     = H5I_INVALID_HID;
     hid_t ret_value    = H5I_INVALID_HID;
 
-    switch (rand() % NUM_PREDEFINED_INT_TYPES) {
+    switch (vol_test_random() % NUM_PREDEFINED_INT_TYPES) {
         case 0:
             type_to_copy = H5T_STD_I8BE;
             break;
@@ -294,7 +294,7 @@ generate_random_datatype_float(H5T_class_t H5_ATTR_UNUSED parent_class, hbool_t
     hid_t datatype     = H5I_INVALID_HID;
     hid_t ret_value    = H5I_INVALID_HID;
 
-    switch (rand() % NUM_PREDEFINED_FLOAT_TYPES) {
+    switch (vol_test_random() % NUM_PREDEFINED_FLOAT_TYPES) {
         case 0:
             type_to_copy = H5T_IEEE_F32BE;
             break;
@@ -341,9 +341,9 @@ generate_random_datatype_string(H5T_class_t H5_ATTR_UNUSED parent_class, hbool_t
      * fixed-length strings, but these may change in the future.
      */
 #if 0 /* Currently, all VL types are disabled */
-    if (0 == (rand() % 2)) {
+    if (0 == (vol_test_random() % 2)) {
 #endif
-    if ((datatype = H5Tcreate(H5T_STRING, (size_t)(rand() % STRING_TYPE_MAX_SIZE) + 1)) < 0) {
+    if ((datatype = H5Tcreate(H5T_STRING, (size_t)(vol_test_random() % STRING_TYPE_MAX_SIZE) + 1)) < 0) {
         HDprintf("    couldn't create fixed-length string datatype\n");
         goto done;
     }
@@ -404,7 +404,7 @@ generate_random_datatype_compound(H5T_class_t H5_ATTR_UNUSED parent_class, hbool
         goto done;
     }
 
-    num_members = (size_t)(rand() % COMPOUND_TYPE_MAX_MEMBERS + 1);
+    num_members = (size_t)(vol_test_random() % COMPOUND_TYPE_MAX_MEMBERS + 1);
 
     for (size_t i = 0; i < num_members; i++) {
         size_t member_size;
@@ -461,7 +461,7 @@ generate_random_datatype_reference(H5T_class_t H5_ATTR_UNUSED parent_class, hboo
     hid_t ret_value = H5I_INVALID_HID;
 
 #if 0 /* Region references are currently unsupported */
-    if (0 == (rand() % 2)) {
+    if (0 == (vol_test_random() % 2)) {
 #endif
     if ((datatype = H5Tcopy(H5T_STD_REF_OBJ)) < 0) {
         HDprintf("    couldn't copy object reference datatype\n");
@@ -502,7 +502,7 @@ generate_random_datatype_enum(H5T_class_t H5_ATTR_UNUSED parent_class, hbool_t H
         goto done;
     }
 
-    num_members = (size_t)(rand() % ENUM_TYPE_MAX_MEMBERS + 1);
+    num_members = (size_t)(vol_test_random() % ENUM_TYPE_MAX_MEMBERS + 1);
 
     if (NULL == (enum_member_vals = HDmalloc(num_members * sizeof(int)))) {
         HDprintf("    couldn't allocate space for enum members\n");
@@ -517,7 +517,7 @@ generate_random_datatype_enum(H5T_class_t H5_ATTR_UNUSED parent_class, hbool_t H
         HDsnprintf(name, ENUM_TYPE_MAX_MEMBER_NAME_LENGTH, "enum_val%zu", i);
 
         do {
-            enum_val = rand();
+            enum_val = vol_test_random();
 
             /* Check for uniqueness of enum member */
             unique = TRUE;
@@ -556,7 +556,7 @@ generate_random_datatype_array(H5T_class_t H5_ATTR_UNUSED parent_class, hbool_t
     hid_t    datatype      = H5I_INVALID_HID;
     hid_t    ret_value     = H5I_INVALID_HID;
 
-    ndims = (unsigned)(rand() % ARRAY_TYPE_MAX_DIMS + 1);
+    ndims = (unsigned)(vol_test_random() % ARRAY_TYPE_MAX_DIMS + 1);
 
     if (NULL == (array_dims = HDmalloc(ndims * sizeof(*array_dims)))) {
         HDprintf("    couldn't allocate space for array datatype dims\n");
@@ -564,7 +564,7 @@ generate_random_datatype_array(H5T_class_t H5_ATTR_UNUSED parent_class, hbool_t
     }
 
     for (size_t i = 0; i < ndims; i++)
-        array_dims[i] = (hsize_t)(rand() % MAX_DIM_SIZE + 1);
+        array_dims[i] = (hsize_t)(vol_test_random() % MAX_DIM_SIZE + 1);
 
     if ((base_datatype = generate_random_datatype(H5T_ARRAY, is_compact)) < 0) {
         HDprintf("    couldn't create array base datatype\n");
@@ -619,9 +619,9 @@ generate_random_dataspace(int rank, const hsize_t *max_dims, hsize_t *dims_out,
      */
     for (i = 0; i < (size_t)rank; i++) {
         if (is_compact)
-            dataspace_dims[i] = (hsize_t)(rand() % COMPACT_SPACE_MAX_DIM_SIZE + 1);
+            dataspace_dims[i] = (hsize_t)(vol_test_random() % COMPACT_SPACE_MAX_DIM_SIZE + 1);
         else
-            dataspace_dims[i] = (hsize_t)(rand() % MAX_DIM_SIZE + 1);
+            dataspace_dims[i] = (hsize_t)(vol_test_random() % MAX_DIM_SIZE + 1);
 
         if (dims_out)
             dims_out[i] = dataspace_dims[i];
@@ -793,3 +793,624 @@ done:
 
     return ret_value;
 }
+
+/*
+ * Parses a size string such as "512", "64K" or "10G" into a
+ * number of bytes, where the K, M, G and T suffixes are powers
+ * of 1024. Fails if the suffix would overflow the value.
+ */
+herr_t
+vol_test_parse_size(const char *str, hsize_t *size_out)
+{
+    unsigned long long value;
+    char              *end = NULL;
+
+    errno = 0;
+    value = HDstrtoull(str, &end, 10);
+    if (errno || end == str)
+        return FAIL;
+
+    switch (*end) {
+        case 'T':
+        case 't':
+            if (value > ULLONG_MAX / 1024)
+                return FAIL;
+            value *= 1024;
+            /* FALLTHROUGH */
+        case 'G':
+        case 'g':
+            if (value > ULLONG_MAX / 1024)
+                return FAIL;
+            value *= 1024;
+            /* FALLTHROUGH */
+        case 'M':
+        case 'm':
+            if (value > ULLONG_MAX / 1024)
+                return FAIL;
+            value *= 1024;
+            /* FALLTHROUGH */
+        case 'K':
+        case 'k':
+            if (value > ULLONG_MAX / 1024)
+                return FAIL;
+            value *= 1024;
+            end++;
+            break;
+        default:
+            break;
+    }
+
+    if (*end != '\0')
+        return FAIL;
+
+    *size_out = (hsize_t)value;
+
+    return SUCCEED;
+}
+
+/*
+ * Timing of the regions delimited by the TESTING family of macros.
+ *
+ * Each call to vol_test_timer_begin() appends a record to an array of
+ * timing records and opens it at the nesting level for its kind. A
+ * record is closed by the matching PASSED(), H5_FAILED() or SKIPPED()
+ * macro, which calls vol_test_timer_end(). Multipart tests have no
+ * closing macro of their own, so their record is closed when the next
+ * test begins or when the current interface ends.
+ *
+ * When tests run on several threads, each thread has its own set of open
+ * regions while the records of all threads go to the one array, which is
+ * then only accessed with vol_test_lock() held. CPU time is then counted
+ * for the thread running a region rather than for the whole process.
+ */
+#define VOL_TEST_TIMER_LEVEL_INTERFACE 0
+#define VOL_TEST_TIMER_LEVEL_TEST      1
+#define VOL_TEST_TIMER_LEVEL_PART      2
+#define VOL_TEST_TIMER_NLEVELS         3
+
+typedef struct vol_test_timing_t {
+    char                 *interface_name;
+    char                 *test_name;
+    char                 *part_name;
+    vol_test_timer_kind_t kind;
+    vol_test_result_t     result;
+    size_t                nfailed_children;
+    size_t                npassed_children;
+    double                wall_seconds;
+    double                cpu_seconds;
+} vol_test_timing_t;
+
+typedef struct vol_test_open_timer_t {
+    hbool_t open;
+    size_t  record;
+    double  wall_start;
+    double  cpu_start;
+} vol_test_open_timer_t;
+
+static vol_test_timing_t                          *timings_g       = NULL;
+static size_t                                      ntimings_g      = 0;
+static size_t                                      timings_alloc_g = 0;
+static VOL_TEST_THREAD_LOCAL vol_test_open_timer_t open_timers_g[VOL_TEST_TIMER_NLEVELS];
+static VOL_TEST_THREAD_LOCAL clockid_t             cpu_clock_g = CLOCK_PROCESS_CPUTIME_ID;
+
+static const char *const vol_test_result_str[] = {"none", "passed", "failed", "skipped"};
+static const char *const vol_test_kind_str[]   = {"interface", "test", "multipart", "part"};
+
+static double
+vol_test_clock(clockid_t clock_id)
+{
+    struct timespec ts;
+
+    if (HDclock_gettime(clock_id, &ts) < 0)
+        return 0.0;
+
+    return (double)ts.tv_sec + ((double)ts.tv_nsec / 1.0E9);
+}
+
+static void
+vol_test_timer_close(int level, vol_test_result_t result)
+{
+    vol_test_timing_t *record;
+
+    if (!open_timers_g[level].open)
+        return;
+
+    record               = &timings_g[open_timers_g[level].record];
+    record->wall_seconds = vol_test_clock(CLOCK_MONOTONIC) - open_timers_g[level].wall_start;
+    record->cpu_seconds  = vol_test_clock(cpu_clock_g) - open_timers_g[level].cpu_start;
+
+    /* Regions without a closing macro derive their result from their children */
+    if (result == VOL_TEST_RESULT_NONE && record->kind != VOL_TEST_TIMER_TEST) {
+        if (record->nfailed_children)
+            result = VOL_TEST_RESULT_FAILED;
+        else if (record->npassed_children)
+            result = VOL_TEST_RESULT_PASSED;
+        else if (record->kind == VOL_TEST_TIMER_MULTIPART && record->result != VOL_TEST_RESULT_NONE)
+            result = record->result;
+    }
+
+    record->result = result;
+
+    /* Propagate the result to the enclosing region */
+    for (int parent = level - 1; parent >= 0; parent--) {
+        if (open_timers_g[parent].open) {
+            vol_test_timing_t *parent_record = &timings_g[open_timers_g[parent].record];
+
+            if (result == VOL_TEST_RESULT_FAILED)
+                parent_record->nfailed_children++;
+            else if (result == VOL_TEST_RESULT_PASSED)
+                parent_record->npassed_children++;
+
+            break;
+        }
+    }
+
+    open_timers_g[level].open = FALSE;
+}
+
+/*
+ * Begins timing a region of the given kind. Any regions at the
+ * same or a deeper nesting level that are still open are closed
+ * first.
+ */
+void
+vol_test_timer_begin(vol_test_timer_kind_t kind, const char *name)
+{
+    vol_test_timing_t *record;
+    int                level;
+
+    switch (kind) {
+        case VOL_TEST_TIMER_INTERFACE:
+            level = VOL_TEST_TIMER_LEVEL_INTERFACE;
+            break;
+        case VOL_TEST_TIMER_TEST:
+        case VOL_TEST_TIMER_MULTIPART:
+            level = VOL_TEST_TIMER_LEVEL_TEST;
+            break;
+        case VOL_TEST_TIMER_PART:
+        default:
+            level = VOL_TEST_TIMER_LEVEL_PART;
+            break;
+    }
+
+    vol_test_lock();
+
+    for (int i = VOL_TEST_TIMER_NLEVELS - 1; i >= level; i--)
+        vol_test_timer_close(i, VOL_TEST_RESULT_NONE);
+
+    if (ntimings_g == timings_alloc_g) {
+        size_t             new_alloc = timings_alloc_g ? 2 * timings_alloc_g : 256;
+        vol_test_timing_t *tmp_realloc;
+
+        if (NULL == (tmp_realloc = HDrealloc(timings_g, new_alloc * sizeof(*timings_g)))) {
+            vol_test_unlock();
+            return;
+        }
+
+        timings_g       = tmp_realloc;
+        timings_alloc_g = new_alloc;
+    }
+
+    record = &timings_g[ntimings_g];
+    HDmemset(record, 0, sizeof(*record));
+    record->kind = kind;
+
+    /* Inherit the names of the enclosing regions */
+    if (level > VOL_TEST_TIMER_LEVEL_INTERFACE && open_timers_g[VOL_TEST_TIMER_LEVEL_INTERFACE].open)
+        record->interface_name =
+            HDstrdup(timings_g[open_timers_g[VOL_TEST_TIMER_LEVEL_INTERFACE].record].interface_name);
+    if (level > VOL_TEST_TIMER_LEVEL_TEST && open_timers_g[VOL_TEST_TIMER_LEVEL_TEST].open)
+        record->test_name = HDstrdup(timings_g[open_timers_g[VOL_TEST_TIMER_LEVEL_TEST].record].test_name);
+
+    if (level == VOL_TEST_TIMER_LEVEL_INTERFACE)
+        record->interface_name = HDstrdup(name);
+    else if (level == VOL_TEST_TIMER_LEVEL_TEST)
+        record->test_name = HDstrdup(name);
+    else
+        record->part_name = HDstrdup(name);
+
+    open_timers_g[level].open       = TRUE;
+    open_timers_g[level].record     = ntimings_g++;
+    open_timers_g[level].cpu_start  = vol_test_clock(cpu_clock_g);
+    open_timers_g[level].wall_start = vol_test_clock(CLOCK_MONOTONIC);
+
+    vol_test_unlock();
+}
+
+/*
+ * Ends timing of the innermost open test or test part with the
+ * given result. Calls made when no test or part is open (e.g., a
+ * second H5_FAILED() for the same failure) are ignored.
+ */
+void
+vol_test_timer_end(vol_test_result_t result)
+{
+    vol_test_lock();
+
+    if (open_timers_g[VOL_TEST_TIMER_LEVEL_PART].open)
+        vol_test_timer_close(VOL_TEST_TIMER_LEVEL_PART, result);
+    else if (open_timers_g[VOL_TEST_TIMER_LEVEL_TEST].open) {
+        vol_test_timing_t *record = &timings_g[open_timers_g[VOL_TEST_TIMER_LEVEL_TEST].record];
+
+        /* Multipart tests stay open until the next test begins */
+        if (record->kind == VOL_TEST_TIMER_MULTIPART)
+            record->result = result;
+        else
+            vol_test_timer_close(VOL_TEST_TIMER_LEVEL_TEST, result);
+    }
+
+    vol_test_unlock();
+}
+
+/*
+ * Ends timing of the current interface, along with any tests
+ * still open within it.
+ */
+void
+vol_test_timer_end_interface(void)
+{
+    vol_test_lock();
+
+    for (int i = VOL_TEST_TIMER_NLEVELS - 1; i >= VOL_TEST_TIMER_LEVEL_INTERFACE; i--)
+        vol_test_timer_close(i, VOL_TEST_RESULT_NONE);
+
+    vol_test_unlock();
+}
+
+static void
+vol_test_write_csv_field(FILE *f, const char *str)
+{
+    HDfputc('"', f);
+    for (; str && *str; str++) {
+        if (*str == '"')
+            HDfputc('"', f);
+        HDfputc(*str, f);
+    }
+    HDfputc('"', f);
+}
+
+static void
+vol_test_write_json_string(FILE *f, const char *str)
+{
+    HDfputc('"', f);
+    for (; str && *str; str++) {
+        if (*str == '"' || *str == '\\')
+            HDfputc('\\', f);
+        HDfputc(*str, f);
+    }
+    HDfputc('"', f);
+}
+
+/*
+ * Writes the timing records collected so far to the given file.
+ * A filename ending in ".json" produces a JSON document; any other
+ * filename produces CSV with one row per interface, test and part.
+ */
+herr_t
+vol_test_timer_write_report(const char *filename)
+{
+    size_t  name_len;
+    hbool_t json;
+    FILE   *f         = NULL;
+    herr_t  ret_value = SUCCEED;
+
+    if (!filename || (*filename == '\0')) {
+        HDprintf("    invalid report filename\n");
+        ret_value = FAIL;
+        goto done;
+    }
+
+    vol_test_timer_end_interface();
+
+    name_len = HDstrlen(filename);
+    json     = (name_len > 5) && !HDstrcmp(filename + name_len - 5, ".json");
+
+    if (NULL == (f = HDfopen(filename, "w"))) {
+        HDprintf("    couldn't open report file '%s'\n", filename);
+        ret_value = FAIL;
+        goto done;
+    }
+
+    if (json)
+        HDfprintf(f, "{\n  \"timings\": [\n");
+    else
+        HDfprintf(f, "interface,test,part,kind,result,wall_seconds,cpu_seconds\n");
+
+    for (size_t i = 0; i < ntimings_g; i++) {
+        vol_test_timing_t *record = &timings_g[i];
+
+        if (json) {
+            HDfprintf(f, "    {\"interface\": ");
+            vol_test_write_json_string(f, record->interface_name);
+            HDfprintf(f, ", \"test\": ");
+            vol_test_write_json_string(f, record->test_name);
+            HDfprintf(f, ", \"part\": ");
+            vol_test_write_json_string(f, record->part_name);
+            HDfprintf(f, ", \"kind\": \"%s\", \"result\": \"%s\"", vol_test_kind_str[record->kind],
+                      vol_test_result_str[record->result]);
+            HDfprintf(f, ", \"wall_seconds\": %.9f, \"cpu_seconds\": %.9f}%s\n", record->wall_seconds,
+                      record->cpu_seconds, (i < ntimings_g - 1) ? "," : "");
+        }
+        else {
+            vol_test_write_csv_field(f, record->interface_name);
+            HDfputc(',', f);
+            vol_test_write_csv_field(f, record->test_name);
+            HDfputc(',', f);
+            vol_test_write_csv_field(f, record->part_name);
+            HDfprintf(f, ",%s,%s,%.9f,%.9f\n", vol_test_kind_str[record->kind],
+                      vol_test_result_str[record->result], record->wall_seconds, record->cpu_seconds);
+        }
+    }
+
+    if (json)
+        HDfprintf(f, "  ]\n}\n");
+
+done:
+    if (f && HDfclose(f) < 0) {
+        HDprintf("    couldn't close report file '%s'\n", filename);
+        ret_value = FAIL;
+    }
+
+    return ret_value;
+}
+
+/*
+ * Frees the timing records collected so far.
+ */
+void
+vol_test_timer_free(void)
+{
+    for (size_t i = 0; i < ntimings_g; i++) {
+        HDfree(timings_g[i].interface_name);
+        HDfree(timings_g[i].test_name);
+        HDfree(timings_g[i].part_name);
+    }
+
+    HDfree(timings_g);
+    timings_g       = NULL;
+    ntimings_g      = 0;
+    timings_alloc_g = 0;
+
+    HDmemset(open_timers_g, 0, sizeof(open_timers_g));
+}
+
+/*
+ * Pseudo-random numbers for the tests.
+ *
+ * The numbers come from a xoshiro256** generator. Rather than one stream
+ * shared by every test, each region begun by the TESTING family of macros
+ * starts its own stream, whose state is derived from the master seed and
+ * the names of the region and of the regions enclosing it. What a test
+ * generates therefore depends only on the seed and on its name, not on
+ * which tests ran before it, so that a test can be replayed on its own
+ * with the seed printed by the run in which it failed. The same holds
+ * when tests run on several threads, each of which has its own streams.
+ */
+static uint64_t                       vol_test_random_seed_g = 0;
+static VOL_TEST_THREAD_LOCAL uint64_t vol_test_random_keys_g[VOL_TEST_TIMER_NLEVELS];
+static VOL_TEST_THREAD_LOCAL uint64_t vol_test_random_state_g[4];
+
+static uint64_t
+vol_test_random_splitmix(uint64_t *x)
+{
+    uint64_t z = (*x += UINT64_C(0x9e3779b97f4a7c15));
+
+    z = (z ^ (z >> 30)) * UINT64_C(0xbf58476d1ce4e5b9);
+    z = (z ^ (z >> 27)) * UINT64_C(0x94d049bb133111eb);
+
+    return z ^ (z >> 31);
+}
+
+static uint64_t
+vol_test_random_rotl(uint64_t x, int k)
+{
+    return (x << k) | (x >> (64 - k));
+}
+
+static void
+vol_test_random_set_state(uint64_t key)
+{
+    for (size_t i = 0; i < 4; i++)
+        vol_test_random_state_g[i] = vol_test_random_splitmix(&key);
+}
+
+/*
+ * Sets the master seed from which all of the streams are derived and
+ * starts the stream used outside of any region.
+ */
+void
+vol_test_random_seed(uint64_t seed)
+{
+    vol_test_random_seed_g = seed;
+
+    HDmemset(vol_test_random_keys_g, 0, sizeof(vol_test_random_keys_g));
+    vol_test_random_set_state(seed);
+}
+
+uint64_t
+vol_test_random_get_seed(void)
+{
+    return vol_test_random_seed_g;
+}
+
+/*
+ * Starts the stream for a region of the given kind and name, which is
+ * the key of the enclosing region (or the master seed for an interface)
+ * hashed together with the name.
+ */
+void
+vol_test_random_begin(vol_test_timer_kind_t kind, const char *name)
+{
+    uint64_t key;
+    int      level;
+
+    switch (kind) {
+        case VOL_TEST_TIMER_INTERFACE:
+            level = VOL_TEST_TIMER_LEVEL_INTERFACE;
+            break;
+        case VOL_TEST_TIMER_TEST:
+        case VOL_TEST_TIMER_MULTIPART:
+            level = VOL_TEST_TIMER_LEVEL_TEST;
+            break;
+        case VOL_TEST_TIMER_PART:
+        default:
+            level = VOL_TEST_TIMER_LEVEL_PART;
+            break;
+    }
+
+    key = (level == VOL_TEST_TIMER_LEVEL_INTERFACE) ? vol_test_random_seed_g
+                                                    : vol_test_random_keys_g[level - 1];
+
+    /* FNV-1a over the name, starting from the enclosing key */
+    key ^= UINT64_C(0xcbf29ce484222325);
+    for (const char *p = name; p && *p; p++) {
+        key ^= (uint64_t)(unsigned char)*p;
+        key *= UINT64_C(0x100000001b3);
+    }
+
+    vol_test_random_keys_g[level] = key;
+    vol_test_random_set_state(key);
+}
+
+/*
+ * Returns the next number, from 0 to VOL_TEST_RANDOM_MAX, in the stream
+ * of the current region. This is used in place of rand().
+ */
+int
+vol_test_random(void)
+{
+    uint64_t *s      = vol_test_random_state_g;
+    uint64_t  result = vol_test_random_rotl(s[1] * 5, 7) * 9;
+    uint64_t  t      = s[1] << 17;
+
+    s[2] ^= s[0];
+    s[3] ^= s[1];
+    s[1] ^= s[2];
+    s[0] ^= s[3];
+    s[2] ^= t;
+    s[3] = vol_test_random_rotl(s[3], 45);
+
+    return (int)(result >> 33);
+}
+
+/*
+ * Running tests on several threads.
+ *
+ * With a thread-safe build of HDF5, h5vl_test can run the tests of
+ * different interfaces at the same time on a pool of threads. State that
+ * belongs to the tests being run, such as the test counters and the
+ * current test file, is kept per thread. Output is buffered per thread
+ * while a set of tests runs and then written to stdout as a whole, so
+ * that the lines of different sets of tests do not interleave.
+ */
+VOL_TEST_THREAD_LOCAL FILE *vol_test_stdout_g = NULL;
+
+#ifdef H5_HAVE_THREADSAFE
+static H5TS_mutex_simple_t vol_test_mutex_g;
+static hbool_t             vol_test_threaded_g = FALSE;
+#endif
+
+/*
+ * Prepares for running tests on several threads. Must be called
+ * before any threads are started.
+ */
+herr_t
+vol_test_thread_init(void)
+{
+#ifdef H5_HAVE_THREADSAFE
+    if (!vol_test_threaded_g) {
+        H5TS_mutex_init(&vol_test_mutex_g);
+        vol_test_threaded_g = TRUE;
+    }
+
+    return SUCCEED;
+#else
+    HDfprintf(stderr, "Running tests on several threads requires a thread-safe build of HDF5\n");
+
+    return FAIL;
+#endif
+}
+
+/*
+ * Acquires and releases the lock that protects the state shared by all
+ * threads. These do nothing unless tests run on several threads.
+ */
+void
+vol_test_lock(void)
+{
+#ifdef H5_HAVE_THREADSAFE
+    if (vol_test_threaded_g)
+        H5TS_mutex_lock_simple(&vol_test_mutex_g);
+#endif
+}
+
+void
+vol_test_unlock(void)
+{
+#ifdef H5_HAVE_THREADSAFE
+    if (vol_test_threaded_g)
+        H5TS_mutex_unlock_simple(&vol_test_mutex_g);
+#endif
+}
+
+/*
+ * Starts buffering the output of the current thread and timing the CPU
+ * time of the thread rather than the process.
+ */
+herr_t
+vol_test_thread_begin(void)
+{
+    if (vol_test_stdout_g)
+        return SUCCEED;
+
+    if (NULL == (vol_test_stdout_g = HDtmpfile())) {
+        HDfprintf(stderr, "Unable to create output buffer for test thread\n");
+        return FAIL;
+    }
+
+#ifdef CLOCK_THREAD_CPUTIME_ID
+    cpu_clock_g = CLOCK_THREAD_CPUTIME_ID;
+#endif
+
+    return SUCCEED;
+}
+
+/*
+ * Writes the output buffered by the current thread to stdout and stops
+ * buffering it.
+ */
+herr_t
+vol_test_thread_end(void)
+{
+    char   buf[4096];
+    size_t nread;
+    FILE  *f         = vol_test_stdout_g;
+    herr_t ret_value = SUCCEED;
+
+    if (!f)
+        return SUCCEED;
+
+    vol_test_stdout_g = NULL;
+    cpu_clock_g       = CLOCK_PROCESS_CPUTIME_ID;
+
+    HDrewind(f);
+
+    vol_test_lock();
+
+    while ((nread = HDfread(buf, 1, sizeof(buf), f)) > 0)
+        if (HDfwrite(buf, 1, nread, stdout) != nread) {
+            ret_value = FAIL;
+            break;
+        }
+    if (HDferror(f))
+        ret_value = FAIL;
+
+    HDfflush(stdout);
+
+    vol_test_unlock();
+
+    if (HDfclose(f) < 0)
+        ret_value = FAIL;
+
+    return ret_value;
+}
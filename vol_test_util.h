@@ -15,10 +15,77 @@
 
 #include "hdf5.h"
 
+/*
+ * The kinds of regions timed by the TESTING family of macros. An
+ * interface region covers an entire set of tests (e.g., "group"),
+ * a test region covers a TESTING() test or a TESTING_MULTIPART()
+ * test and a part region covers a single TESTING_2() part.
+ */
+typedef enum vol_test_timer_kind_t {
+    VOL_TEST_TIMER_INTERFACE,
+    VOL_TEST_TIMER_TEST,
+    VOL_TEST_TIMER_MULTIPART,
+    VOL_TEST_TIMER_PART
+} vol_test_timer_kind_t;
+
+/* The result recorded for a timed region */
+typedef enum vol_test_result_t {
+    VOL_TEST_RESULT_NONE,
+    VOL_TEST_RESULT_PASSED,
+    VOL_TEST_RESULT_FAILED,
+    VOL_TEST_RESULT_SKIPPED
+} vol_test_result_t;
+
+/* The largest number returned by vol_test_random() */
+#define VOL_TEST_RANDOM_MAX 0x7fffffff
+
+/*
+ * Storage class for the state that each thread running tests keeps
+ * for itself. Tests only run on more than one thread (see the
+ * "--threads" option of h5vl_test) with a thread-safe build of HDF5.
+ */
+#ifdef H5_HAVE_THREADSAFE
+#if defined(_MSC_VER)
+#define VOL_TEST_THREAD_LOCAL __declspec(thread)
+#elif defined(__STDC_VERSION__) && (__STDC_VERSION__ >= 201112L)
+#define VOL_TEST_THREAD_LOCAL _Thread_local
+#else
+#define VOL_TEST_THREAD_LOCAL __thread
+#endif
+#else
+#define VOL_TEST_THREAD_LOCAL
+#endif
+
+/*
+ * The stream that test output is written to. This is a buffer private
+ * to the current thread between vol_test_thread_begin() and
+ * vol_test_thread_end() and is stdout otherwise.
+ */
+extern VOL_TEST_THREAD_LOCAL FILE *vol_test_stdout_g;
+#define VOL_TEST_STDOUT (vol_test_stdout_g ? vol_test_stdout_g : stdout)
+
 hid_t  generate_random_datatype(H5T_class_t parent_class, hbool_t is_compact);
 hid_t  generate_random_dataspace(int rank, const hsize_t *max_dims, hsize_t *dims_out, hbool_t is_compact);
 int    create_test_container(char *filename, uint64_t vol_cap_flags);
 herr_t prefix_filename(const char *prefix, const char *filename, char **filename_out);
 herr_t remove_test_file(const char *prefix, const char *filename);
+herr_t vol_test_parse_size(const char *str, hsize_t *size_out);
+
+void   vol_test_timer_begin(vol_test_timer_kind_t kind, const char *name);
+void   vol_test_timer_end(vol_test_result_t result);
+void   vol_test_timer_end_interface(void);
+herr_t vol_test_timer_write_report(const char *filename);
+void   vol_test_timer_free(void);
+
+void     vol_test_random_seed(uint64_t seed);
+uint64_t vol_test_random_get_seed(void);
+void     vol_test_random_begin(vol_test_timer_kind_t kind, const char *name);
+int      vol_test_random(void);
+
+herr_t vol_test_thread_init(void);
+void   vol_test_lock(void);
+void   vol_test_unlock(void);
+herr_t vol_test_thread_begin(void);
+herr_t vol_test_thread_end(void);
 
 #endif /* VOL_TEST_UTIL_H_ */